@@ -11,31 +11,48 @@
 // Task priorities. Higher number higher priority
 #define STABILIZER_TASK_PRI 5
 #define SENSORS_TASK_PRI 4
+#define ADC_TASK_PRI 3
 #define UDP_TX_TASK_PRI 3
 #define UDP_RX_TASK_PRI 3
 #define SYSTEM_TASK_PRI 2
+#define BOOT_STEP_TASK_PRI 2
 #define LEDSEQCMD_TASK_PRI 1
+#define KERNEL_BENCH_TASK_PRI 1
+#define MOTOR_CHAR_TASK_PRI 1
+#define SYSID_TASK_PRI 1
+#define WORKER_AUX_TASK_PRI 1
 #define PM_TASK_PRI 0
 
 // Task names
 #define SYSTEM_TASK_NAME "SYSTEM"
 #define LEDSEQCMD_TASK_NAME "LEDSEQCMD"
 #define PM_TASK_NAME "PWRMGNT"
+#define ADC_TASK_NAME "ADC"
 #define SENSORS_TASK_NAME "SENSORS"
 #define STABILIZER_TASK_NAME "STABILIZER"
 #define UDP_TX_TASK_NAME "UDP_TX"
 #define UDP_RX_TASK_NAME "UDP_RX"
+#define KERNEL_BENCH_TASK_NAME "KBENCH"
+#define MOTOR_CHAR_TASK_NAME "MOTORCHAR"
+#define SYSID_TASK_NAME "SYSID"
+#define WORKER_AUX_TASK_NAME "WORKER"
 
 #define configBASE_STACK_SIZE CONFIG_BASE_STACK_SIZE
 
 // Task stack sizes
 #define SYSTEM_TASK_STACKSIZE (6 * configBASE_STACK_SIZE)
+#define BOOT_STEP_TASK_STACKSIZE (6 * configBASE_STACK_SIZE)
 #define LEDSEQCMD_TASK_STACKSIZE (2 * configBASE_STACK_SIZE)
 #define PM_TASK_STACKSIZE (4 * configBASE_STACK_SIZE)
+#define ADC_TASK_STACKSIZE (2 * configBASE_STACK_SIZE)
 #define SENSORS_TASK_STACKSIZE (5 * configBASE_STACK_SIZE)
 #define STABILIZER_TASK_STACKSIZE (5 * configBASE_STACK_SIZE)
 #define UDP_TX_TASK_STACKSIZE (2 * configBASE_STACK_SIZE)
 #define UDP_RX_TASK_STACKSIZE (4 * configBASE_STACK_SIZE)
+#define KERNEL_BENCH_TASK_STACKSIZE (3 * configBASE_STACK_SIZE)
+#define MOTOR_CHAR_TASK_STACKSIZE (3 * configBASE_STACK_SIZE)
+#define SYSID_TASK_STACKSIZE (3 * configBASE_STACK_SIZE)
+#define WORKER_AUX_TASK_STACKSIZE (3 * configBASE_STACK_SIZE)
 
 /**
  * This is the threshold for a propeller/motor to pass. It calculates the variance of the accelerometer X+Y
@@ -1,9 +1,10 @@
 #ifndef PM_H_
 #define PM_H_
 
+#include <stdbool.h>
+#include <stdint.h>
 #include "esp_idf_version.h"
 // #include "syslink.h"  // syslink protocol is not used in ESP32 version
-#include "driver/adc.h"
 // #include "deck.h"
 
 #ifndef CRITICAL_LOW_VOLTAGE
@@ -38,20 +39,21 @@
 #define PM_BAT_ADC_FOR_3_VOLT (int32_t)(((3.0f / PM_BAT_DIVIDER) / 2.8f) * 4096)
 #define PM_BAT_ADC_FOR_1p2_VOLT (int32_t)(((1.2f / PM_BAT_DIVIDER) / 2.8f) * 4096)
 
-#define PM_BAT_IIR_SHIFT 8
 /**
  * Set PM_BAT_WANTED_LPF_CUTOFF_HZ to the wanted cut-off freq in Hz.
+ * The slow estimate drives the battery level and low-voltage states.
  */
 #define PM_BAT_WANTED_LPF_CUTOFF_HZ 1
 
 /**
- * Attenuation should be between 1 to 256.
- *
- * f0 = fs / 2*pi*attenuation.
- * attenuation = fs / 2*pi*f0
+ * Sag compensation: a faster estimate follows the voltage drop under throttle,
+ * the motor outputs are scaled by PM_BAT_SAG_REF_VOLTAGE / voltage (1S cell,
+ * limited to [1, PM_BAT_SAG_MAX_SCALE]).
  */
-#define PM_BAT_IIR_LPF_ATTENUATION (int)(ADC_SAMPLING_FREQ / (int)(2 * 3.1415f * PM_BAT_WANTED_LPF_CUTOFF_HZ))
-#define PM_BAT_IIR_LPF_ATT_FACTOR (int)((1 << PM_BAT_IIR_SHIFT) / PM_BAT_IIR_LPF_ATTENUATION)
+#define PM_BAT_SAG_LPF_CUTOFF_HZ 20
+#define PM_BAT_SAG_REF_VOLTAGE 4.0f
+#define PM_BAT_SAG_MAX_SCALE 1.25f
+#define PM_BAT_SAG_MIN_VALID_VOLTAGE 2.5f // below: reading invalid (USB only), no compensation
 
 typedef enum
 {
@@ -105,10 +107,21 @@ float pmGetBatteryVoltageMin(void);
 float pmGetBatteryVoltageMax(void);
 
 /**
- * Updates and calculates battery values.
- * Should be called for every new adcValues sample.
+ * Updates and filters battery values.
+ * Called by the ADC task for every averaged DMA frame (ADC_BLOCK_RATE_HZ).
  */
-// void pmBatteryUpdate(AdcGroup* adcValues);
+void pmBatteryUpdate(void);
+
+/**
+ * Returns the fast-filtered battery voltage, following sag under load
+ */
+float pmGetBatteryVoltageLoaded(void);
+
+/**
+ * Returns the factor (>= 1) by which the motor outputs should be scaled to
+ * compensate for battery sag, 1 when the compensation is disabled
+ */
+float pmGetThrustScale(void);
 
 /**
  * Returns true if the battery is below its low capacity threshold for an
@@ -22,6 +22,11 @@
 // 电池信息包通道定义
 #define BATTERY_INFO_CHANNEL 0
 
+// 一阶低通系数, 按ADC帧率 (ADC_BLOCK_RATE_HZ) 更新
+#define PM_LPF_ALPHA(FC) ((2 * 3.1415f * (FC)) / (ADC_BLOCK_RATE_HZ + 2 * 3.1415f * (FC)))
+#define PM_BAT_LPF_ALPHA PM_LPF_ALPHA(PM_BAT_WANTED_LPF_CUTOFF_HZ)
+#define PM_BAT_SAG_LPF_ALPHA PM_LPF_ALPHA(PM_BAT_SAG_LPF_CUTOFF_HZ)
+
 typedef struct _PmSyslinkInfo
 {
   union
@@ -45,6 +50,9 @@ static float batteryVoltage;
 static uint16_t batteryVoltageMV;
 static float batteryVoltageMin = 6.0;
 static float batteryVoltageMax = 0.0;
+static float batteryVoltageLoaded;
+static float thrustScale = 1.0f;
+static bool batteryFilterPrimed;
 
 static float extBatteryVoltage;
 static uint16_t extBatteryVoltageMV;
@@ -96,6 +104,9 @@ void pmInit(void)
 
   pmEnableExtBatteryVoltMeasuring(CONFIG_ADC1_PIN, 2); // ADC1 PIN is fixed to ADC channel
   ESP_LOGI("PM", "pmEnableExtBatteryVoltMeasuring done");
+#if CONFIG_ADC1_CURRENT_PIN >= 0
+  pmEnableExtBatteryCurrMeasuring(CONFIG_ADC1_CURRENT_PIN, CONFIG_ADC1_CURRENT_AMP_PER_VOLT / 1000.0f);
+#endif
 
   pmSyslinkInfo.pgood = false;
   pmSyslinkInfo.chg = false;
@@ -154,6 +165,57 @@ float pmGetBatteryVoltage(void)
   return batteryVoltage;
 }
 
+float pmGetBatteryVoltageLoaded(void)
+{
+  return batteryVoltageLoaded;
+}
+
+float pmGetThrustScale(void)
+{
+  return thrustScale;
+}
+
+/**
+ * Called from the ADC task for every averaged DMA frame. The slow estimate
+ * feeds the battery level and states, the fast one follows sag under load.
+ */
+void pmBatteryUpdate(void)
+{
+  if (!isInit)
+  {
+    return;
+  }
+
+  float voltage = pmMeasureExtBatteryVoltage();
+  extBatteryCurrent = pmMeasureExtBatteryCurrent();
+
+  if (!batteryFilterPrimed)
+  {
+    extBatteryVoltage = voltage;
+    batteryVoltageLoaded = voltage;
+    batteryFilterPrimed = true;
+  }
+  else
+  {
+    extBatteryVoltage += PM_BAT_LPF_ALPHA * (voltage - extBatteryVoltage);
+    batteryVoltageLoaded += PM_BAT_SAG_LPF_ALPHA * (voltage - batteryVoltageLoaded);
+  }
+  extBatteryVoltageMV = (uint16_t)(extBatteryVoltage * 1000);
+  pmSetBatteryVoltage(extBatteryVoltage);
+
+#ifdef CONFIG_BATTERY_SAG_COMPENSATION
+  if (batteryVoltageLoaded > PM_BAT_SAG_MIN_VALID_VOLTAGE)
+  {
+    float scale = PM_BAT_SAG_REF_VOLTAGE / batteryVoltageLoaded;
+    thrustScale = scale < 1.0f ? 1.0f : (scale > PM_BAT_SAG_MAX_SCALE ? PM_BAT_SAG_MAX_SCALE : scale);
+  }
+  else
+  {
+    thrustScale = 1.0f;
+  }
+#endif
+}
+
 float pmGetBatteryVoltageMin(void)
 {
   return batteryVoltageMin;
@@ -289,11 +351,8 @@ void pmTask(void *param)
 
   while (1)
   {
+    // Voltage and current are filtered by pmBatteryUpdate() from the ADC task
     vTaskDelay(M2T(100));
-    extBatteryVoltage = pmMeasureExtBatteryVoltage();
-    extBatteryVoltageMV = (uint16_t)(extBatteryVoltage * 1000);
-    extBatteryCurrent = pmMeasureExtBatteryCurrent();
-    pmSetBatteryVoltage(extBatteryVoltage);
     batteryLevel = pmBatteryChargeFromVoltage(pmGetBatteryVoltage()) * 10;
 
     // 上电时只打印一次电池电压信息
@@ -58,6 +58,10 @@
 #define GYRO_VARIANCE_THRESHOLD_Z (400000) // Z-axis: 400k (was 200k)
 #define ESP_INTR_FLAG_DEFAULT 0
 
+#define SENSORS_STARTUP_TIMEOUT_MS 2000 // 上电后等待MPU6050应答的最长时间
+#define SENSORS_RESET_TIMEOUT_MS 100    // 等待MPU6050复位完成的最长时间
+#define SENSORS_READY_POLL_MS 2         // 就绪轮询间隔
+
 #define PITCH_CALIB (CONFIG_PITCH_CALIB * 1.0 / 100)
 #define ROLL_CALIB (CONFIG_ROLL_CALIB * 1.0 / 100)
 
@@ -196,7 +200,6 @@ static void sensorsTask(void *param)
 {
     // TODO:
     systemWaitStart();
-    vTaskDelay(M2T(200));
     DEBUG_PRINTD("xTaskCreate sensorsTask IN");
     sensorsSetupSlaveRead(); //
     DEBUG_PRINTD("xTaskCreate sensorsTask SetupSlave done");
@@ -379,24 +382,44 @@ void processAccGyroMeasurements(const uint8_t *buffer)
     sensorsAccAlignToGravity(&accScaled, &sensorData.acc);
     applyAxis3fLpf((lpf2pData *)(&accLpf), &sensorData.acc);
 }
-static void sensorsDeviceInit(void)
+
+/**
+ * 轮询直到条件满足, 代替固定延时
+ * @return false 超时
+ */
+static bool sensorsPollReady(bool (*isReady)(void), uint32_t timeoutMs)
 {
-    // Only MPU6050 is supported
+    TickType_t start = xTaskGetTickCount();
 
-    // Wait for sensors to startup
-    while (xTaskGetTickCount() < 2000)
+    while (!isReady())
     {
-        vTaskDelay(M2T(50));
-    };
+        if (xTaskGetTickCount() - start > M2T(timeoutMs))
+        {
+            return false;
+        }
+        vTaskDelay(M2T(SENSORS_READY_POLL_MS));
+    }
+    return true;
+}
 
-    i2cdevInit(I2C0_DEV);
+static bool mpu6050Answering(void)
+{
+    return mpu6050GetDeviceID() == 0b110100;
+}
 
-    // 扫描I2C总线查找设备
-    DEBUG_PRINTI("Starting I2C bus scan...");
-    i2cdrvScanBus(&sensorsBus);
-    vTaskDelay(M2T(100));
+static bool mpu6050ResetDone(void)
+{
+    return !mpu6050GetDeviceReset();
+}
 
+static void sensorsDeviceInit(void)
+{
+    // Only MPU6050 is supported
+    i2cdevInit(I2C0_DEV);
     mpu6050Init(I2C0_DEV);
+
+    // Wait for sensors to startup: poll WHO_AM_I instead of a fixed delay
+    sensorsPollReady(mpu6050Answering, SENSORS_STARTUP_TIMEOUT_MS);
     DEBUG_PRINTI("MPU6050 initialized, testing connection...");
 
     if (mpu6050TestConnection() == true)
@@ -404,15 +427,16 @@ static void sensorsDeviceInit(void)
         DEBUG_PRINTI("MPU6050 I2C connection [OK].\n");
 
         mpu6050Reset();
-        vTaskDelay(M2T(50));
+        // Wait until registers are reset (DEVICE_RESET clears itself)
+        if (!sensorsPollReady(mpu6050ResetDone, SENSORS_RESET_TIMEOUT_MS))
+        {
+            DEBUG_PRINTW("MPU6050 reset timeout");
+        }
         // Activate mpu6050
         mpu6050SetSleepEnabled(false);
-        // Delay until registers are reset
-        vTaskDelay(M2T(100));
-        // Set x-axis gyro as clock source
+        // Set x-axis gyro as clock source. No settle delay: the gyro bias
+        // estimator only accepts a low-variance window, which gates arming
         mpu6050SetClockSource(MPU6050_CLOCK_PLL_XGYRO);
-        // Delay until clock is set and stable
-        vTaskDelay(M2T(200));
         // Enable temp sensor
         mpu6050SetTempSensorEnabled(true);
         // Disable interrupts
@@ -459,6 +483,10 @@ static void sensorsDeviceInit(void)
     {
         DEBUG_PRINTE("MPU6050 I2C connection [FAIL].\n");
         DEBUG_PRINTW("Sensor not connected. Please check your hardware!\n");
+
+        // 扫描I2C总线查找设备 (仅用于故障诊断)
+        DEBUG_PRINTI("Starting I2C bus scan...");
+        i2cdrvScanBus(&sensorsBus);
     }
 
     // Only MPU6050 is supported - other sensors removed
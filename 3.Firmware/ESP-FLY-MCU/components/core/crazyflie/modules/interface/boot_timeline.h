@@ -0,0 +1,94 @@
+/**
+ * @file boot_timeline.h
+ * @brief 启动时间线与并行启动
+ *
+ * 记录上电到可飞行之间各里程碑的时间 (esp_timer微秒, 不含二级引导程序),
+ * 启动完成后通过串口打印; 新登记的上位机客户端会以控制台日志的形式收到一份报告.
+ * 相互独立的初始化步骤 (WiFi、IMU、电机自检) 在各自的任务中并行执行.
+ */
+
+#ifndef __BOOT_TIMELINE_H__
+#define __BOOT_TIMELINE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============ 可配置参数 ============
+#define BOOT_TIMELINE_MAX_MARKS 24 // 时间线最大条目数
+#define BOOT_STEP_MAX 4            // 最多同时并行的启动步骤
+#define BOOT_LINE_MAX 64           // 单行报告最大长度 (含结尾'\0')
+
+/**
+ * @brief 时间线条目
+ *
+ * 里程碑的startUs与endUs相同; 并行步骤记录起止时间与执行结果
+ */
+typedef struct
+{
+    const char *name;
+    uint32_t startUs;
+    uint32_t endUs;
+    bool ok;
+} BootMark_t;
+
+/**
+ * @brief 启动步骤函数, 返回自检结果
+ */
+typedef bool (*BootStepFn)(void);
+
+/**
+ * @brief 记录一个里程碑 (可在任意任务中调用)
+ *
+ * @param name 里程碑名称, 须为静态字符串
+ */
+void bootTimelineMark(const char *name);
+
+/**
+ * @brief 记录最后一个里程碑 (可飞行) 并通过串口打印整条时间线
+ */
+void bootTimelineFinish(void);
+
+/**
+ * @brief 启动时间线是否已完成
+ */
+bool bootTimelineIsFinished(void);
+
+/**
+ * @brief 已记录的条目数
+ */
+int bootTimelineCount(void);
+
+/**
+ * @brief 读取一个条目
+ *
+ * @return false 索引越界或条目尚未写完
+ */
+bool bootTimelineGet(int index, BootMark_t *mark);
+
+/**
+ * @brief 将一个条目格式化为单行文本
+ *
+ * @return 文本长度, 0=无此条目
+ */
+int bootTimelineFormat(int index, char *buf, int size);
+
+/**
+ * @brief 在独立任务中启动一个初始化步骤
+ *
+ * @param name 步骤名称, 须为静态字符串
+ * @param fn 步骤函数
+ * @return false 步骤数超过BOOT_STEP_MAX或任务创建失败 (此时在当前任务中同步执行)
+ */
+bool bootStepStart(const char *name, BootStepFn fn);
+
+/**
+ * @brief 等待已启动的所有步骤完成
+ *
+ * 超时后仍继续等待未完成的步骤 (返回时所有步骤任务都已结束), 超时计为自检失败
+ *
+ * @param timeoutMs 超时 (毫秒)
+ * @return true 全部在超时前完成且自检通过
+ */
+bool bootStepJoin(uint32_t timeoutMs);
+
+#endif // __BOOT_TIMELINE_H__
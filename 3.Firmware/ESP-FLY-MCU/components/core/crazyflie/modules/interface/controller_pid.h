@@ -18,4 +18,13 @@ void controllerPid(control_t *control, setpoint_t *setpoint,
  */
 void controllerPidGetRateDesired(float *roll, float *pitch, float *yaw);
 
+/**
+ * Add an excitation to the desired rate fed to the rate PID, on top of the
+ * attitude PID output. Used by system identification, zero otherwise.
+ * @param roll  Roll rate excitation (deg/s)
+ * @param pitch Pitch rate excitation (deg/s)
+ * @param yaw   Yaw rate excitation (deg/s)
+ */
+void controllerPidSetRateExcitation(float roll, float pitch, float yaw);
+
 #endif //__CONTROLLER_PID_H__
@@ -0,0 +1,58 @@
+/**
+ * @file kernel_bench.h
+ * @brief 飞控关键内核的片上微基准测试
+ *
+ * 用CPU周期计数器 (CCOUNT) 测量姿态融合、PID、滤波、协议解析与DSP库等内核
+ * 每次调用的周期数 (最小/平均/最大), 结果附带固件版本, 通过BENCH_RESULT包发送给上位机.
+ * 测试由上位机的BENCH_REQUEST命令或启动选项 (KERNEL_BENCH_ON_BOOT) 触发,
+ * 在稳定器循环末尾分片执行, 且仅在电机全部停转时运行.
+ */
+
+#ifndef __KERNEL_BENCH_H__
+#define __KERNEL_BENCH_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============ 可配置参数 ============
+#define KERNEL_BENCH_DEFAULT_ITERATIONS 1000 // 请求未指定时每个内核的调用次数
+#define KERNEL_BENCH_CHUNK 50                // 每个稳定器周期最多执行的调用次数
+#define KERNEL_BENCH_MAX_KERNELS 16
+
+/**
+ * @brief 单个内核的测试结果 (周期数已扣除计时开销)
+ */
+typedef struct
+{
+    const char *name;
+    uint16_t iterations;
+    uint32_t cyclesMin;
+    uint32_t cyclesMean;
+    uint32_t cyclesMax;
+} KernelBenchResult_t;
+
+/**
+ * @brief 初始化基准测试模块 (创建结果上报任务)
+ */
+void kernelBenchInit(void);
+
+/**
+ * @brief 模块是否已初始化
+ */
+bool kernelBenchTest(void);
+
+/**
+ * @brief 请求一轮基准测试
+ *
+ * @param client 结果发送目标客户端, TRANSPORT_CLIENT_NONE时广播
+ * @param iterations 每个内核的调用次数, 0=默认
+ * @return false 上一轮测试尚未结束
+ */
+bool kernelBenchRequest(uint8_t client, uint16_t iterations);
+
+/**
+ * @brief 执行一片测试, 由稳定器任务在每个周期末尾调用
+ */
+void kernelBenchStep(void);
+
+#endif // __KERNEL_BENCH_H__
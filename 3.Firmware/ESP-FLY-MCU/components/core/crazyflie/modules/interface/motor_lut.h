@@ -0,0 +1,89 @@
+/**
+ * @file motor_lut.h
+ * @brief 电机推力线性化与电池电压补偿查找表
+ *
+ * 推力曲线表把与升力成正比的推力指令 (0-65535) 映射为参考电压下的PWM占空比,
+ * 电压补偿表按带载电池电压 (pmGetBatteryVoltageLoaded) 给出占空比系数 参考电压/电压.
+ * 启用后代替pmGetThrustScale()的压降补偿 (Kconfig中MOTOR_THRUST_LUT选中BATTERY_SAG_COMPENSATION). 两张表在启动或标定后预先计算,
+ * 混控器中每个电机只做一次表内插值和一次定点乘法, 开销与油门无关.
+ *
+ * 推力曲线来自测试台标定: 固件依次以若干占空比同时驱动四个电机, 记录带载电池电压,
+ * 按 推力 ∝ (占空比 × 带载电压)^2 推算各点的相对推力, 标定数据保存在NVS中.
+ * 未标定时使用不含压降的理想曲线 (占空比 = sqrt(推力)).
+ *
+ * 标定过程中每个采样间隔检查一次中止条件: 上位机中止请求, 电机测试关闭, 紧急停止,
+ * 请求方客户端超时 (链路丢失) 和电池电压过低, 任一满足即停止全部电机.
+ */
+
+#ifndef __MOTOR_LUT_H__
+#define __MOTOR_LUT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============ 可配置参数 ============
+#define MOTOR_LUT_THRUST_SHIFT 5                                   // 推力表分段数 = 2^n
+#define MOTOR_LUT_THRUST_POINTS ((1 << MOTOR_LUT_THRUST_SHIFT) + 1) // 推力表点数
+#define MOTOR_LUT_VOLTAGE_MIN 3.0f                                 // 电压表起点 (V)
+#define MOTOR_LUT_VOLTAGE_STEP 0.1f                                // 电压表步长 (V)
+#define MOTOR_LUT_VOLTAGE_POINTS 14                                // 3.0V - 4.3V
+#define MOTOR_LUT_FACTOR_SHIFT 12                                  // 电压系数定点格式 Q12
+#define MOTOR_LUT_FACTOR_MIN 0.8f
+#define MOTOR_LUT_FACTOR_MAX 1.25f
+
+#define MOTOR_CHAR_STEPS 8         // 标定点数 (占空比均分到100%)
+#define MOTOR_CHAR_SETTLE_MS 800   // 每点转速稳定时间
+#define MOTOR_CHAR_MEASURE_MS 400  // 每点电压平均时间
+#define MOTOR_CHAR_SAMPLE_MS 10    // 电压采样间隔
+
+/**
+ * @brief 标定请求动作 (与MOTOR_CHAR_REQUEST包的action字段一致)
+ */
+typedef enum
+{
+    MOTOR_CHAR_QUERY = 0, // 上报当前使用的曲线
+    MOTOR_CHAR_RUN = 1,   // 运行标定并保存到NVS
+    MOTOR_CHAR_RESET = 2, // 清除NVS中的标定, 恢复理想曲线
+    MOTOR_CHAR_ABORT = 3, // 中止正在进行的标定
+} MotorCharAction;
+
+/**
+ * @brief 初始化: 从NVS加载标定数据并生成查找表, 创建标定任务
+ */
+void motorLutInit(void);
+
+/**
+ * @brief 模块是否已初始化
+ */
+bool motorLutTest(void);
+
+/**
+ * @brief 更新电压补偿系数, 由混控器每个周期调用一次
+ *
+ * @param voltage 带载电池电压 (V), 低于PM_BAT_SAG_MIN_VALID_VOLTAGE时不补偿
+ */
+void motorLutUpdateBattery(float voltage);
+
+/**
+ * @brief 推力指令转换为PWM占空比 (查表插值并乘以电压补偿系数)
+ *
+ * @param thrust 推力指令 (0-65535, 与升力成正比)
+ * @return PWM占空比 (0-65535)
+ */
+uint16_t motorLutApply(uint16_t thrust);
+
+/**
+ * @brief 请求标定相关动作, 结果通过MOTOR_CHAR_RESULT包发送
+ *
+ * @param client 结果发送目标客户端, TRANSPORT_CLIENT_NONE时广播
+ * @param action MotorCharAction, MOTOR_CHAR_ABORT在标定进行中也会被接受
+ * @return false 上一个请求尚未完成
+ */
+bool motorLutRequest(uint8_t client, uint8_t action);
+
+/**
+ * @brief 中止正在进行的标定 (任意任务中调用, 未在标定时无作用)
+ */
+void motorLutAbort(void);
+
+#endif // __MOTOR_LUT_H__
@@ -6,6 +6,10 @@ void sensfusion6Init(void);
 bool sensfusion6Test(void);
 
 void sensfusion6UpdateQ(float gx, float gy, float gz, float ax, float ay, float az, float dt);
+// Gyro-only propagation (deg/s), cheap enough for every sample
+void sensfusion6Predict(float gx, float gy, float gz, float dt);
+// Accelerometer correction (g), dt is the interval between corrections
+void sensfusion6Correct(float ax, float ay, float az, float dt);
 void sensfusion6GetQuaternion(float *qx, float *qy, float *qz, float *qw);
 void sensfusion6GetEulerRPY(float *roll, float *pitch, float *yaw);
 float sensfusion6GetAccZWithoutGravity(const float ax, const float ay, const float az);
@@ -31,6 +31,11 @@ void stabilizerSetEmergencyStop();
  */
 void stabilizerResetEmergencyStop();
 
+/**
+ * @return True if the emergency stop is active (motors held at zero).
+ */
+bool stabilizerIsEmergencyStop(void);
+
 /**
  * Restart the countdown until emergercy stop will be enabled.
  *
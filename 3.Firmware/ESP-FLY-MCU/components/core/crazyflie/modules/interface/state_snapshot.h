@@ -0,0 +1,52 @@
+/**
+ * state_snapshot.h - Per-tick flight state publication
+ *
+ * The stabilizer publishes one coherent copy of its state, sensor, setpoint
+ * and control data at the end of every tick. Consumers running in other tasks
+ * (possibly on the other core) read it without locks and without ever
+ * delaying the stabilizer loop.
+ */
+#ifndef __STATE_SNAPSHOT_H__
+#define __STATE_SNAPSHOT_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "stabilizer_types.h"
+
+#define STATE_SNAPSHOT_MOTORS 4
+
+typedef struct stateSnapshot_s
+{
+  uint32_t tick;      // stabilizer tick that produced the data, 0 = nothing published yet
+  uint32_t timestamp; // FreeRTOS tick count (ms) at publication
+  sensorData_t sensorData;
+  state_t state;
+  setpoint_t setpoint;
+  control_t control;
+  attitude_t rateDesired; // output of the attitude (outer) PID loop, deg/s
+  uint16_t motors[STATE_SNAPSHOT_MOTORS]; // PWM ratio applied in this tick
+} stateSnapshot_t;
+
+/**
+ * Start publishing a new snapshot. Returns the buffer to fill; it is not
+ * visible to readers until stateSnapshotCommit(). Single writer only
+ * (the stabilizer task).
+ */
+stateSnapshot_t *stateSnapshotBegin(void);
+
+/**
+ * Make the snapshot filled since stateSnapshotBegin() the latest one.
+ */
+void stateSnapshotCommit(void);
+
+/**
+ * Copy the latest published snapshot. Never blocks the writer: a copy torn
+ * by a concurrent publication is detected and retried.
+ *
+ * @param snapshot Destination
+ * @return The stabilizer tick of the copied snapshot, 0 if none published yet
+ */
+uint32_t stateSnapshotRead(stateSnapshot_t *snapshot);
+
+#endif // __STATE_SNAPSHOT_H__
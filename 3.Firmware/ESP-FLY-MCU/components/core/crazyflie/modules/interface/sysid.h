@@ -0,0 +1,108 @@
+/**
+ * @file sysid.h
+ * @brief 角速度环系统辨识 (阶跃/扫频激励)
+ *
+ * 在某一轴的期望角速度上叠加阶跃或指数扫频激励, 按内环频率 (ATTITUDE_RATE) 把期望角速度、
+ * 陀螺仪角速度和内环输出记录到RAM. 激励结束后由辨识任务用xtensa_rfft做Welch谱估计,
+ * 得到闭环 (期望→陀螺仪) 与对象 (内环输出→陀螺仪) 的频率响应, 连同原始记录发送给上位机,
+ * 由上位机估计带宽和延迟并给出角速度环增益建议.
+ * 姿态外环保持工作, 须在有油门时进行, 飞机应固定在只允许被测轴转动的测试台上.
+ */
+
+#ifndef __SYSID_H__
+#define __SYSID_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "stabilizer_types.h"
+
+// ============ 可配置参数 ============
+#define SYSID_MAX_SAMPLES 2048        // 记录缓冲样本数 (500Hz下约4秒)
+#define SYSID_MIN_SAMPLES 100         // 最短激励
+#define SYSID_FFT_SIZE 512            // Welch分段长度 (频率分辨率 = 采样率 / 分段长度)
+#define SYSID_MAX_BINS 64             // 上报的最大频点数, 相邻FFT频点合并
+#define SYSID_SAMPLES_PER_PACKET 8    // 每个SYSID_SAMPLES包的样本数
+#define SYSID_MAX_AMPLITUDE 400.0f    // 最大激励幅值 (度/秒)
+#define SYSID_MAX_TILT 35.0f          // 横滚/俯仰超过该角度时中止 (度)
+
+/**
+ * @brief 激励信号 (与SYSID_REQUEST包的signal字段一致)
+ */
+typedef enum
+{
+    SYSID_SIGNAL_STEP = 0,    // 激励时长的10%处跳变到幅值, 60%处回零
+    SYSID_SIGNAL_CHIRP = 1,   // 从起始频率到终止频率的指数扫频正弦
+    SYSID_SIGNAL_ABORT = 255, // 中止当前辨识
+} SysidSignal;
+
+/**
+ * @brief 辨识状态 (与SYSID_STATUS包的state字段一致)
+ */
+typedef enum
+{
+    SYSID_STATE_DONE = 0,
+    SYSID_STATE_RUNNING = 1,
+    SYSID_STATE_ANALYZING = 2,
+    SYSID_STATE_REJECTED = 3,
+    SYSID_STATE_ABORTED = 4,
+} SysidState;
+
+/**
+ * @brief 拒绝/中止原因 (与SYSID_STATUS包的reason字段一致)
+ */
+typedef enum
+{
+    SYSID_REASON_NONE = 0,
+    SYSID_REASON_BUSY = 1,        // 上一次辨识尚未结束
+    SYSID_REASON_NOT_READY = 2,   // 零偏校准未完成
+    SYSID_REASON_BAD_REQUEST = 3, // 参数超出范围
+    SYSID_REASON_NO_MEMORY = 4,   // 记录缓冲分配失败
+    SYSID_REASON_NO_THRUST = 5,   // 油门为0 (含指令超时)
+    SYSID_REASON_TILT = 6,        // 倾角超限
+    SYSID_REASON_USER = 7,        // 上位机中止
+} SysidReason;
+
+/**
+ * @brief 辨识参数
+ */
+typedef struct
+{
+    uint8_t axis;        // 0=横滚, 1=俯仰, 2=偏航
+    uint8_t signal;      // SysidSignal
+    uint16_t durationMs; // 激励时长
+    float amplitude;     // 激励幅值 (度/秒)
+    float fStart;        // 扫频起始频率 (Hz)
+    float fEnd;          // 扫频终止频率 (Hz)
+} SysidConfig;
+
+/**
+ * @brief 初始化 (创建辨识任务)
+ */
+void sysidInit(void);
+
+/**
+ * @brief 模块是否已初始化
+ */
+bool sysidTest(void);
+
+/**
+ * @brief 请求一次辨识, 进度与结果通过SYSID_STATUS/SYSID_FRF/SYSID_SAMPLES包发送
+ *
+ * @param client 结果发送目标客户端, TRANSPORT_CLIENT_NONE时广播
+ * @param config 辨识参数
+ * @return false 请求被拒绝 (已向client发送原因)
+ */
+bool sysidRequest(uint8_t client, const SysidConfig *config);
+
+/**
+ * @brief 中止正在进行的激励, 在下一个内环周期生效
+ */
+void sysidAbort(void);
+
+/**
+ * @brief 记录一个样本并更新激励, 由稳定器任务在controller()之后每个周期调用
+ */
+void sysidStep(const sensorData_t *sensors, const state_t *state, const control_t *control, uint32_t tick);
+
+#endif // __SYSID_H__
@@ -2,23 +2,67 @@
 #define __WORKER_H
 
 #include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Job priorities. Each executor drains its HIGH queue before NORMAL and
+ * NORMAL before LOW; a running job is never preempted by a queued one.
+ */
+typedef enum
+{
+  WORKER_PRIO_HIGH = 0,
+  WORKER_PRIO_NORMAL,
+  WORKER_PRIO_LOW,
+  WORKER_PRIO_COUNT
+} workerPriority_t;
+
+/**
+ * Run the job on the executor pinned to the core the caller is NOT running on,
+ * so it executes concurrently with the caller instead of waiting for it to
+ * block. Ignored on single core builds.
+ */
+#define WORKER_OTHER_CORE 0x01
+
+/**
+ * Deferred job descriptor. Define it once with WORKER_JOB_DEFINE; the executor
+ * keeps the time accounting of every submission in it.
+ */
+typedef struct workerJob_s
+{
+  void (*function)(void *);
+  const char *name;
+  workerPriority_t priority;
+  uint8_t flags;
+
+  // Statistics, updated by the executors under the worker job lock
+  uint32_t runs;
+  uint32_t dropped;      // submissions rejected because the queue was full
+  uint64_t totalUs;      // accumulated execution time
+  uint32_t maxUs;        // longest single execution
+  uint32_t maxLatencyUs; // longest time spent queued
+  struct workerJob_s *next;
+} workerJob_t;
+
+#define WORKER_JOB_DEFINE(NAME, FUNCTION, PRIORITY, FLAGS) \
+  static workerJob_t NAME = {.function = (FUNCTION), .name = #NAME, .priority = (PRIORITY), .flags = (FLAGS)}
 
 void workerInit();
 
 bool workerTest();
 
 /**
- * Light printf implementation
+ * Worker loop of the main executor
  *
  * This function exectute the worker loop and never returns except if the worker
- * module has not been initialized.
+ * module has not been initialized. It is run by the system task once the
+ * system is started.
  */
 void workerLoop();
 
 /**
  * Schedule a function for execution by the worker loop
  * The function will be executed as soon as possible by the worker loop.
- * Scheduled functions are stacked in a FIFO queue.
+ * Scheduled functions are queued at WORKER_PRIO_NORMAL and accounted together.
  *
  * @param function Function to be executed
  * @param arg      Argument that will be passed to the function when executed
@@ -26,4 +70,20 @@ void workerLoop();
  */
 int workerSchedule(void (*function)(void *), void *arg);
 
+/**
+ * Submit a job to its priority queue. Never blocks, so it can be called from
+ * the stabilizer loop.
+ *
+ * @param job Job descriptor (see WORKER_JOB_DEFINE)
+ * @param arg Argument that will be passed to the job function
+ * @return    0 in case of success, ENOMEM if the queue is full.
+ */
+int workerSubmit(workerJob_t *job, void *arg);
+
+/**
+ * Print the run count, execution time and queue latency of every job that
+ * has been submitted so far.
+ */
+void workerPrintStats(void);
+
 #endif //__WORKER_H
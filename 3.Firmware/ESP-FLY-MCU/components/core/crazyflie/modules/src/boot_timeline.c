@@ -0,0 +1,219 @@
+/**
+ * @file boot_timeline.c
+ * @brief 启动时间线与并行启动实现
+ *
+ * 条目槽位通过原子自增分配, 写完后再置有效标志, 多个启动任务可同时记录.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+
+#include "boot_timeline.h"
+#include "config.h"
+#include "usec_time.h"
+#include "stm32_legacy.h"
+
+#define DEBUG_MODULE "BOOT"
+#include "debug_cf.h"
+
+// ============ 内部状态 ============
+static BootMark_t marks[BOOT_TIMELINE_MAX_MARKS];
+static bool markValid[BOOT_TIMELINE_MAX_MARKS];
+static uint32_t markCount = 0;
+static bool finished = false;
+
+typedef struct
+{
+    const char *name;
+    BootStepFn fn;
+} BootStep;
+
+static BootStep steps[BOOT_STEP_MAX];
+static bool stepOk[BOOT_STEP_MAX];
+static int stepCount = 0; // 仅由系统任务启动与等待步骤
+static EventGroupHandle_t stepDone = NULL;
+
+// ============ 内部函数 ============
+
+static void record(const char *name, uint32_t startUs, uint32_t endUs, bool ok)
+{
+    uint32_t i = __atomic_fetch_add(&markCount, 1, __ATOMIC_RELAXED);
+    if (i >= BOOT_TIMELINE_MAX_MARKS)
+    {
+        return;
+    }
+
+    marks[i] = (BootMark_t){.name = name, .startUs = startUs, .endUs = endUs, .ok = ok};
+    __atomic_store_n(&markValid[i], true, __ATOMIC_RELEASE);
+}
+
+static void runStep(int index)
+{
+    uint32_t startUs = (uint32_t)usecTimestamp();
+    stepOk[index] = steps[index].fn();
+    record(steps[index].name, startUs, (uint32_t)usecTimestamp(), stepOk[index]);
+    xEventGroupSetBits(stepDone, 1 << index);
+}
+
+static void bootStepTask(void *param)
+{
+    runStep((int)(intptr_t)param);
+    vTaskDelete(NULL);
+}
+
+// ============ 时间线 ============
+
+void bootTimelineMark(const char *name)
+{
+    uint32_t now = (uint32_t)usecTimestamp();
+    record(name, now, now, true);
+}
+
+void bootTimelineFinish(void)
+{
+    char line[BOOT_LINE_MAX];
+
+    if (finished)
+    {
+        return;
+    }
+
+    bootTimelineMark("flight ready");
+    finished = true;
+
+    DEBUG_PRINTI("Boot timeline:");
+    for (int i = 0; i < bootTimelineCount(); i++)
+    {
+        if (bootTimelineFormat(i, line, sizeof(line)) > 0)
+        {
+            DEBUG_PRINTI("%s", line);
+        }
+    }
+}
+
+bool bootTimelineIsFinished(void)
+{
+    return finished;
+}
+
+int bootTimelineCount(void)
+{
+    uint32_t count = __atomic_load_n(&markCount, __ATOMIC_RELAXED);
+    return count < BOOT_TIMELINE_MAX_MARKS ? count : BOOT_TIMELINE_MAX_MARKS;
+}
+
+bool bootTimelineGet(int index, BootMark_t *mark)
+{
+    if (index < 0 || index >= bootTimelineCount() ||
+        !__atomic_load_n(&markValid[index], __ATOMIC_ACQUIRE))
+    {
+        return false;
+    }
+
+    *mark = marks[index];
+    return true;
+}
+
+int bootTimelineFormat(int index, char *buf, int size)
+{
+    BootMark_t mark;
+    int len;
+
+    if (!bootTimelineGet(index, &mark))
+    {
+        return 0;
+    }
+
+    // 时间以毫秒显示, 保留一位小数
+    uint32_t endTenths = mark.endUs / 100;
+    if (mark.endUs == mark.startUs)
+    {
+        len = snprintf(buf, size, "BOOT %5lu.%lu ms  %s",
+                       (unsigned long)(endTenths / 10), (unsigned long)(endTenths % 10), mark.name);
+    }
+    else
+    {
+        uint32_t durTenths = (mark.endUs - mark.startUs) / 100;
+        len = snprintf(buf, size, "BOOT %5lu.%lu ms  %s (%lu.%lu ms)%s",
+                       (unsigned long)(endTenths / 10), (unsigned long)(endTenths % 10), mark.name,
+                       (unsigned long)(durTenths / 10), (unsigned long)(durTenths % 10),
+                       mark.ok ? "" : " FAIL");
+    }
+
+    if (len < 0)
+    {
+        return 0;
+    }
+    return len < size ? len : size - 1;
+}
+
+// ============ 并行启动 ============
+
+bool bootStepStart(const char *name, BootStepFn fn)
+{
+    if (stepDone == NULL)
+    {
+        stepDone = xEventGroupCreate();
+    }
+
+    if (stepCount >= BOOT_STEP_MAX)
+    {
+        DEBUG_PRINTE("Too many boot steps, running %s inline", name);
+        uint32_t startUs = (uint32_t)usecTimestamp();
+        bool ok = fn();
+        record(name, startUs, (uint32_t)usecTimestamp(), ok);
+        return false;
+    }
+
+    int index = stepCount++;
+    steps[index] = (BootStep){.name = name, .fn = fn};
+
+    if (xTaskCreate(bootStepTask, name, BOOT_STEP_TASK_STACKSIZE, (void *)(intptr_t)index,
+                    BOOT_STEP_TASK_PRI, NULL) != pdPASS)
+    {
+        DEBUG_PRINTE("Boot step task %s create failed, running inline", name);
+        runStep(index);
+        return false;
+    }
+    return true;
+}
+
+bool bootStepJoin(uint32_t timeoutMs)
+{
+    bool pass = true;
+
+    if (stepCount == 0)
+    {
+        return true;
+    }
+
+    EventBits_t all = (1 << stepCount) - 1;
+    EventBits_t done = xEventGroupWaitBits(stepDone, all, pdTRUE, pdTRUE, M2T(timeoutMs));
+
+    if ((done & all) != all)
+    {
+        for (int i = 0; i < stepCount; i++)
+        {
+            if (!(done & (1 << i)))
+            {
+                DEBUG_PRINTE("Boot step %s timeout, waiting for it to finish", steps[i].name);
+            }
+        }
+        pass = false;
+
+        // 超时的步骤任务仍在运行: 后续初始化 (如stabilizerInit → sensorsInit) 不能与之并发,
+        // 其槽位也不能复用, 因此继续等到全部完成 (超时只计为自检失败)
+        xEventGroupWaitBits(stepDone, all, pdTRUE, pdTRUE, portMAX_DELAY);
+    }
+
+    for (int i = 0; i < stepCount; i++)
+    {
+        pass &= stepOk[i];
+    }
+
+    stepCount = 0;
+    return pass;
+}
@@ -15,6 +15,7 @@ static bool tiltCompensationEnabled = false;
 
 static attitude_t attitudeDesired;
 static attitude_t rateDesired;
+static attitude_t rateExcitation; // system identification input, see sysid.c
 static float actuatorThrust;
 
 static float cmd_thrust;
@@ -109,6 +110,11 @@ void controllerPid(control_t *control, setpoint_t *setpoint,
       attitudeControllerResetPitchAttitudePID();
     }
 
+    // Identification excitation, zero outside of an identification run
+    rateDesired.roll += rateExcitation.roll;
+    rateDesired.pitch += rateExcitation.pitch;
+    rateDesired.yaw += rateExcitation.yaw;
+
     // TODO: Investigate possibility to subtract gyro drift.
     attitudeControllerCorrectRatePID(sensors->gyro.x, -sensors->gyro.y, sensors->gyro.z,
                                      rateDesired.roll, rateDesired.pitch, rateDesired.yaw);
@@ -171,4 +177,11 @@ void controllerPidGetRateDesired(float *roll, float *pitch, float *yaw)
   {
     *yaw = rateDesired.yaw;
   }
+}
+
+void controllerPidSetRateExcitation(float roll, float pitch, float yaw)
+{
+  rateExcitation.roll = roll;
+  rateExcitation.pitch = pitch;
+  rateExcitation.yaw = yaw;
 }
\ No newline at end of file
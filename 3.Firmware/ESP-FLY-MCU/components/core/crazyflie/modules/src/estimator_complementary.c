@@ -36,8 +36,19 @@
 #include "config.h"
 #include "zero_calib.h"
 
-#define ATTITUDE_UPDATE_RATE RATE_250_HZ
-#define ATTITUDE_UPDATE_DT 1.0 / ATTITUDE_UPDATE_RATE
+// Gyro propagation runs on every sensor sample, the accelerometer correction
+// at a (configurable) lower rate
+#define ATTITUDE_PREDICT_RATE RATE_MAIN_LOOP
+#define ATTITUDE_PREDICT_DT (1.0f / ATTITUDE_PREDICT_RATE)
+
+#ifdef CONFIG_ESTIMATOR_ACC_CORRECT_RATE
+#define ATTITUDE_CORRECT_RATE CONFIG_ESTIMATOR_ACC_CORRECT_RATE
+#else
+#define ATTITUDE_CORRECT_RATE RATE_250_HZ
+#endif
+#define ATTITUDE_CORRECT_DT (1.0f / ATTITUDE_CORRECT_RATE)
+
+_Static_assert(RATE_MAIN_LOOP % ATTITUDE_CORRECT_RATE == 0, "correction rate must divide the main loop rate");
 
 #define POS_UPDATE_RATE RATE_100_HZ
 #define POS_UPDATE_DT 1.0 / POS_UPDATE_RATE
@@ -69,40 +80,43 @@ bool estimatorComplementaryTest(void)
 void estimatorComplementary(state_t *state, sensorData_t *sensorData, control_t *control, const uint32_t tick)
 {
   sensorsAcquire(sensorData, tick); // Read sensors at full rate (1000Hz)
-  if (RATE_DO_EXECUTE(ATTITUDE_UPDATE_RATE, tick))
+
+  // Predict: integrate every gyro sample
+  sensfusion6Predict(sensorData->gyro.x, sensorData->gyro.y, sensorData->gyro.z, ATTITUDE_PREDICT_DT);
+
+  // Correct: pull towards the accelerometer gravity vector
+  if (RATE_DO_EXECUTE(ATTITUDE_CORRECT_RATE, tick))
   {
-    sensfusion6UpdateQ(sensorData->gyro.x, sensorData->gyro.y, sensorData->gyro.z,
-                       sensorData->acc.x, sensorData->acc.y, sensorData->acc.z,
-                       ATTITUDE_UPDATE_DT);
-
-    // Save attitude, adjusted for the legacy CF2 body coordinate system
-    sensfusion6GetEulerRPY(&state->attitude.roll, &state->attitude.pitch, &state->attitude.yaw);
-
-    // Auto zero-point calibration
-    if (!zero_calib_is_done())
-    {
-      // Calibration phase: feed raw angles into calibration algorithm
-      zero_calib_update(state->attitude.pitch, state->attitude.roll);
-    }
-    else
-    {
-      // Normal phase: apply auto-calibrated offset compensation
-      state->attitude.pitch -= zero_calib_get_pitch_offset();
-      state->attitude.roll -= zero_calib_get_roll_offset();
-    }
-
-    // Save quaternion, hopefully one day this could be used in a better controller.
-    // Note that this is not adjusted for the legacy coordinate system
-    sensfusion6GetQuaternion(
-        &state->attitudeQuaternion.x,
-        &state->attitudeQuaternion.y,
-        &state->attitudeQuaternion.z,
-        &state->attitudeQuaternion.w);
-
-    state->acc.z = sensfusion6GetAccZWithoutGravity(sensorData->acc.x,
-                                                    sensorData->acc.y,
-                                                    sensorData->acc.z);
+    sensfusion6Correct(sensorData->acc.x, sensorData->acc.y, sensorData->acc.z, ATTITUDE_CORRECT_DT);
   }
+
+  // Save attitude, adjusted for the legacy CF2 body coordinate system
+  sensfusion6GetEulerRPY(&state->attitude.roll, &state->attitude.pitch, &state->attitude.yaw);
+
+  // Auto zero-point calibration
+  if (!zero_calib_is_done())
+  {
+    // Calibration phase: feed raw angles into calibration algorithm
+    zero_calib_update(state->attitude.pitch, state->attitude.roll);
+  }
+  else
+  {
+    // Normal phase: apply auto-calibrated offset compensation
+    state->attitude.pitch -= zero_calib_get_pitch_offset();
+    state->attitude.roll -= zero_calib_get_roll_offset();
+  }
+
+  // Save quaternion, hopefully one day this could be used in a better controller.
+  // Note that this is not adjusted for the legacy coordinate system
+  sensfusion6GetQuaternion(
+      &state->attitudeQuaternion.x,
+      &state->attitudeQuaternion.y,
+      &state->attitudeQuaternion.z,
+      &state->attitudeQuaternion.w);
+
+  state->acc.z = sensfusion6GetAccZWithoutGravity(sensorData->acc.x,
+                                                  sensorData->acc.y,
+                                                  sensorData->acc.z);
 }
 
 __attribute__((unused)) static bool latestTofMeasurement(tofMeasurement_t *tofMeasurement)
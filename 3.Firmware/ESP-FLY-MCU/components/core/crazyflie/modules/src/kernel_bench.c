@@ -0,0 +1,431 @@
+/**
+ * @file kernel_bench.c
+ * @brief 飞控关键内核的片上微基准测试实现
+ *
+ * 测试在稳定器任务中执行, 与姿态估计串行, 不会和估计器争用四元数等全局状态;
+ * 会修改全局状态的内核在每片测试前后保存/恢复现场.
+ * 每次调用单独计时并关中断, 先测空函数得到计时开销再从各内核结果中扣除.
+ * 结果由低优先级的上报任务逐包发送, 同时通过串口打印.
+ */
+
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "esp_cpu.h"
+#include "esp_app_desc.h"
+#include "sdkconfig.h"
+
+#include "kernel_bench.h"
+#include "config.h"
+#include "sensfusion6.h"
+#include "pid.h"
+#include "filter.h"
+#include "motors.h"
+#include "xtensa_math.h"
+#include "packet_codec.h"
+#include "transport.h"
+#include "data_sender.h"
+#include "stm32_legacy.h"
+
+#define DEBUG_MODULE "KBENCH"
+#include "debug_cf.h"
+
+#define BENCH_BIQUAD_BLOCK 32
+#define BENCH_REPORT_INTERVAL_MS 20 // 结果包间隔, 避免挤占遥测
+
+typedef struct
+{
+    const char *name;
+    void (*enter)(void); // 首片测试前调用; 若有leave, 则每片前后与leave成对调用 (可为NULL)
+    void (*run)(void);
+    void (*leave)(void); // 恢复现场 (可为NULL)
+} BenchKernel;
+
+typedef struct
+{
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+} BenchStats;
+
+typedef enum
+{
+    BENCH_IDLE = 0,
+    BENCH_RUN,
+    BENCH_REPORT,
+} BenchPhase;
+
+// ============ 内部状态 ============
+static bool isInit = false;
+static TaskHandle_t reportTaskHandle = NULL;
+static portMUX_TYPE benchLock = portMUX_INITIALIZER_UNLOCKED;
+
+static bool busy = false;
+static BenchPhase phase = BENCH_IDLE;
+static uint8_t reqClient = TRANSPORT_CLIENT_NONE;
+static uint16_t reqIterations = KERNEL_BENCH_DEFAULT_ITERATIONS;
+
+static int current = 0;   // 当前内核序号 (仅稳定器任务访问)
+static uint16_t done = 0; // 当前内核已完成的调用次数
+
+static volatile float sink; // 防止结果被优化掉
+static float input = 0.0f;
+
+// ============ 被测内核 ============
+
+static void runEmpty(void)
+{
+}
+
+// sensfusion6: 保存/恢复估计器的全局状态 (算法选择须与sensfusion6.c一致)
+extern float qw, qx, qy, qz;
+#ifndef MADWICK_QUATERNION_IMU
+extern float integralFBx, integralFBy, integralFBz;
+#endif
+static float savedFusion[7];
+
+static void fusionEnter(void)
+{
+    savedFusion[0] = qw;
+    savedFusion[1] = qx;
+    savedFusion[2] = qy;
+    savedFusion[3] = qz;
+#ifndef MADWICK_QUATERNION_IMU
+    savedFusion[4] = integralFBx;
+    savedFusion[5] = integralFBy;
+    savedFusion[6] = integralFBz;
+#endif
+}
+
+static void fusionRun(void)
+{
+    input += 0.001f;
+    sensfusion6UpdateQ(input, -input, 0.5f * input, 0.01f, -0.02f, 1.0f, 0.001f);
+}
+
+// 拆分后的估计器: 每个样本一次预测, 按校正频率一次校正, 每个样本一次欧拉角输出
+static void fusionPredictRun(void)
+{
+    input += 0.001f;
+    sensfusion6Predict(input, -input, 0.5f * input, 0.001f);
+}
+
+static void fusionCorrectRun(void)
+{
+    input += 0.001f;
+    sensfusion6Correct(0.01f + input * 0.001f, -0.02f, 1.0f, 0.004f);
+}
+
+static void fusionEulerRun(void)
+{
+    float roll, pitch, yaw;
+    sensfusion6GetEulerRPY(&roll, &pitch, &yaw);
+    sink = roll + pitch + yaw;
+}
+
+static void fusionLeave(void)
+{
+    qw = savedFusion[0];
+    qx = savedFusion[1];
+    qy = savedFusion[2];
+    qz = savedFusion[3];
+#ifndef MADWICK_QUATERNION_IMU
+    integralFBx = savedFusion[4];
+    integralFBy = savedFusion[5];
+    integralFBz = savedFusion[6];
+#endif
+}
+
+// pidUpdate: 独立的PID对象, 带D项滤波
+static PidObject benchPid;
+
+static void pidEnter(void)
+{
+    pidInit(&benchPid, 0.0f, 250.0f, 500.0f, 2.5f, 0.001f, 1000.0f, 80.0f, true);
+}
+
+static void pidRun(void)
+{
+    input += 0.001f;
+    sink = pidUpdate(&benchPid, input, true);
+}
+
+// lpf2pApply: 二阶Butterworth低通
+static lpf2pData benchLpf;
+
+static void lpfEnter(void)
+{
+    lpf2pInit(&benchLpf, 1000.0f, 80.0f);
+}
+
+static void lpfRun(void)
+{
+    input += 0.001f;
+    sink = lpf2pApply(&benchLpf, input);
+}
+
+// packet_encode / packet_parse: 高频遥测帧
+static uint8_t benchFrame[PKT_FRAME_LEN_HIGH_FREQ_DATA];
+static uint16_t benchFrameLen = 0;
+
+static void packetEnter(void)
+{
+    HighFreqDataPacket_t data = {0};
+    data.roll = 1.0f;
+    data.pitch = -2.0f;
+    data.yaw = 3.0f;
+    benchFrameLen = packet_encodeHighFreqData(benchFrame, sizeof(benchFrame), &data);
+}
+
+static void packetEncodeRun(void)
+{
+    HighFreqDataPacket_t data = {0};
+    data.roll = input;
+    sink = packet_encodeHighFreqData(benchFrame, sizeof(benchFrame), &data);
+}
+
+static void packetParseRun(void)
+{
+    PacketFrame_t frame;
+    sink = packet_parse(benchFrame, benchFrameLen, &frame);
+}
+
+// dsp_lib: 单级双二阶滤波 (单点/整块) 与3x3矩阵乘
+static xtensa_biquad_casd_df1_inst_f32 benchBiquad;
+static float benchBiquadCoeffs[5] = {0.0675f, 0.1349f, 0.0675f, 1.1430f, -0.4128f};
+static float benchBiquadState[4];
+static float benchBlockIn[BENCH_BIQUAD_BLOCK];
+static float benchBlockOut[BENCH_BIQUAD_BLOCK];
+
+static void biquadEnter(void)
+{
+    xtensa_biquad_cascade_df1_init_f32(&benchBiquad, 1, benchBiquadCoeffs, benchBiquadState);
+    for (int i = 0; i < BENCH_BIQUAD_BLOCK; i++)
+    {
+        benchBlockIn[i] = (float)(i % 7) - 3.0f;
+    }
+}
+
+static void biquad1Run(void)
+{
+    xtensa_biquad_cascade_df1_f32(&benchBiquad, benchBlockIn, benchBlockOut, 1);
+}
+
+static void biquadBlockRun(void)
+{
+    xtensa_biquad_cascade_df1_f32(&benchBiquad, benchBlockIn, benchBlockOut, BENCH_BIQUAD_BLOCK);
+}
+
+static float benchMatA[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+static float benchMatB[9] = {9, 8, 7, 6, 5, 4, 3, 2, 1};
+static float benchMatC[9];
+static xtensa_matrix_instance_f32 benchA = {3, 3, benchMatA};
+static xtensa_matrix_instance_f32 benchB = {3, 3, benchMatB};
+static xtensa_matrix_instance_f32 benchC = {3, 3, benchMatC};
+
+static void matmulRun(void)
+{
+    xtensa_mat_mult_f32(&benchA, &benchB, &benchC);
+}
+
+// 第0项为空函数, 用于标定计时开销, 不上报
+static const BenchKernel kernels[] = {
+    {"empty", NULL, runEmpty, NULL},
+    {"sensfusion6", fusionEnter, fusionRun, fusionLeave},
+    {"fusion.predict", fusionEnter, fusionPredictRun, fusionLeave},
+    {"fusion.correct", fusionEnter, fusionCorrectRun, fusionLeave},
+    {"fusion.euler", NULL, fusionEulerRun, NULL},
+    {"pidUpdate", pidEnter, pidRun, NULL},
+    {"lpf2pApply", lpfEnter, lpfRun, NULL},
+    {"packet_encode", packetEnter, packetEncodeRun, NULL},
+    {"packet_parse", packetEnter, packetParseRun, NULL},
+    {"dsp.biquad1", biquadEnter, biquad1Run, NULL},
+    {"dsp.biquad32", biquadEnter, biquadBlockRun, NULL},
+    {"dsp.matmul3x3", NULL, matmulRun, NULL},
+};
+
+#define KERNEL_COUNT ((int)(sizeof(kernels) / sizeof(kernels[0])))
+_Static_assert(KERNEL_COUNT <= KERNEL_BENCH_MAX_KERNELS, "too many bench kernels");
+
+static BenchStats stats[KERNEL_COUNT];
+
+// ============ 内部函数 ============
+
+static uint32_t measure(void (*run)(void))
+{
+    portENTER_CRITICAL(&benchLock);
+    uint32_t start = esp_cpu_get_cycle_count();
+    run();
+    uint32_t cycles = esp_cpu_get_cycle_count() - start;
+    portEXIT_CRITICAL(&benchLock);
+    return cycles;
+}
+
+static bool motorsIdle(void)
+{
+    for (int i = 0; i < NBR_OF_MOTORS; i++)
+    {
+        if (motorsGetRatio(i) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint32_t subtractOverhead(uint32_t cycles, uint32_t overhead)
+{
+    return cycles > overhead ? cycles - overhead : 0;
+}
+
+static void getResult(int index, KernelBenchResult_t *result)
+{
+    uint32_t overhead = stats[0].min;
+    uint32_t mean = (uint32_t)(stats[index].sum / reqIterations);
+
+    result->name = kernels[index].name;
+    result->iterations = reqIterations;
+    result->cyclesMin = subtractOverhead(stats[index].min, overhead);
+    result->cyclesMean = subtractOverhead(mean, overhead);
+    result->cyclesMax = subtractOverhead(stats[index].max, overhead);
+}
+
+static void kernelBenchReportTask(void *param)
+{
+    const esp_app_desc_t *app = esp_app_get_description();
+    KernelBenchResult_t result;
+    BenchResultPacket_t packet;
+    uint8_t frame[PKT_FRAME_LEN_BENCH_RESULT];
+
+    while (1)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        DEBUG_PRINTI("Kernel bench, fw %s, %d MHz, %u iterations:", app->version,
+                     CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ, reqIterations);
+        for (int i = 1; i < KERNEL_COUNT; i++)
+        {
+            getResult(i, &result);
+            DEBUG_PRINTI("%-16s min %5lu  mean %5lu  max %5lu cycles", result.name,
+                         (unsigned long)result.cyclesMin, (unsigned long)result.cyclesMean,
+                         (unsigned long)result.cyclesMax);
+
+            memset(&packet, 0, sizeof(packet));
+            packet.kernel = i - 1;
+            packet.kernel_count = KERNEL_COUNT - 1;
+            packet.iterations = result.iterations;
+            packet.cycles_min = result.cyclesMin;
+            packet.cycles_mean = result.cyclesMean;
+            packet.cycles_max = result.cyclesMax;
+            packet.cpu_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ;
+            strncpy(packet.name, result.name, sizeof(packet.name));
+            strncpy(packet.fw_version, app->version, sizeof(packet.fw_version));
+
+            uint16_t len = packet_encodeBenchResult(frame, sizeof(frame), &packet);
+            dataSenderSendFrame(reqClient, frame, len);
+            vTaskDelay(M2T(BENCH_REPORT_INTERVAL_MS));
+        }
+
+        __atomic_store_n(&phase, BENCH_IDLE, __ATOMIC_RELEASE);
+        __atomic_store_n(&busy, false, __ATOMIC_RELEASE);
+    }
+}
+
+// ============ 公共接口 ============
+
+void kernelBenchInit(void)
+{
+    if (isInit)
+    {
+        return;
+    }
+
+    xTaskCreate(kernelBenchReportTask, KERNEL_BENCH_TASK_NAME, KERNEL_BENCH_TASK_STACKSIZE, NULL,
+                KERNEL_BENCH_TASK_PRI, &reportTaskHandle);
+    isInit = true;
+
+#ifdef CONFIG_KERNEL_BENCH_ON_BOOT
+    kernelBenchRequest(TRANSPORT_CLIENT_NONE, 0);
+#endif
+}
+
+bool kernelBenchTest(void)
+{
+    return isInit;
+}
+
+bool kernelBenchRequest(uint8_t client, uint16_t iterations)
+{
+    bool expected = false;
+
+    if (!isInit ||
+        !__atomic_compare_exchange_n(&busy, &expected, true, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        return false;
+    }
+
+    reqClient = client;
+    reqIterations = iterations ? iterations : KERNEL_BENCH_DEFAULT_ITERATIONS;
+    __atomic_store_n(&phase, BENCH_RUN, __ATOMIC_RELEASE);
+    DEBUG_PRINTI("Kernel bench requested, %u iterations", reqIterations);
+    return true;
+}
+
+void kernelBenchStep(void)
+{
+    if (__atomic_load_n(&phase, __ATOMIC_ACQUIRE) != BENCH_RUN || !motorsIdle())
+    {
+        return;
+    }
+
+    const BenchKernel *kernel = &kernels[current];
+    BenchStats *s = &stats[current];
+    if (done == 0)
+    {
+        *s = (BenchStats){.min = UINT32_MAX, .max = 0, .sum = 0};
+    }
+
+    uint16_t n = reqIterations - done;
+    if (n > KERNEL_BENCH_CHUNK)
+    {
+        n = KERNEL_BENCH_CHUNK;
+    }
+
+    if (kernel->enter && (done == 0 || kernel->leave))
+    {
+        kernel->enter();
+    }
+    for (uint16_t i = 0; i < n; i++)
+    {
+        uint32_t cycles = measure(kernel->run);
+        if (cycles < s->min)
+        {
+            s->min = cycles;
+        }
+        if (cycles > s->max)
+        {
+            s->max = cycles;
+        }
+        s->sum += cycles;
+    }
+    if (kernel->leave)
+    {
+        kernel->leave();
+    }
+
+    done += n;
+    if (done < reqIterations)
+    {
+        return;
+    }
+
+    done = 0;
+    if (++current < KERNEL_COUNT)
+    {
+        return;
+    }
+
+    current = 0;
+    __atomic_store_n(&phase, BENCH_REPORT, __ATOMIC_RELEASE);
+    xTaskNotifyGive(reportTaskHandle);
+}
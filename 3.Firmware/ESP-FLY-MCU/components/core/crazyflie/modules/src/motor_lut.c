@@ -0,0 +1,520 @@
+/**
+ * @file motor_lut.c
+ * @brief 电机推力线性化与电池电压补偿查找表实现
+ *
+ * 查找表由标定任务生成, 混控器 (稳定器任务) 只读. 推力表与电压表作为一组双缓冲:
+ * 新表写入备用缓冲后再切换指针, 混控器始终读到同一组完整的表.
+ *
+ * 推力表输出参考电压 (标定开始时的空载电压) 下的等效占空比, 即 占空比 × 带载电压 / 参考电压,
+ * 电压表按带载电压 (20Hz滤波) 给出 参考电压 / 带载电压, 两者相乘还原为当前电压下的占空比.
+ * 标定时的带载压降因此不会被电压系数重复补偿.
+ * NVS中只保存原始标定数据 (各点占空比与带载电压), 启动时重新生成表.
+ * 标定以MOTOR_CHAR_SAMPLE_MS为间隔分片等待, 每片之后检查中止条件, 结束时总是停止全部电机.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "nvs.h"
+
+#include "motor_lut.h"
+#include "config.h"
+#include "motors.h"
+#include "pm_esplane.h"
+#include "power_distribution.h"
+#include "stabilizer.h"
+#include "zero_calib.h"
+#include "packet_codec.h"
+#include "transport.h"
+#include "data_sender.h"
+#include "stm32_legacy.h"
+
+#define DEBUG_MODULE "MOTORLUT"
+#include "debug_cf.h"
+
+#define MOTOR_LUT_NVS_NAMESPACE "motor_lut"
+#define MOTOR_LUT_NVS_KEY "char"
+#define MOTOR_LUT_NVS_VERSION 1
+#define MOTOR_CHAR_REPORT_INTERVAL_MS 20 // 结果包间隔, 避免挤占遥测
+
+/**
+ * @brief 标定数据 (NVS中保存的原始测量值)
+ */
+typedef struct
+{
+    uint16_t version;
+    uint16_t restMv;                     // 标定开始时的空载电压
+    uint16_t duty[MOTOR_CHAR_STEPS];     // 各点占空比
+    uint16_t loadedMv[MOTOR_CHAR_STEPS]; // 各点带载电压
+} MotorCharData;
+
+// ============ 内部状态 ============
+static bool isInit = false;
+static TaskHandle_t charTaskHandle = NULL;
+
+static bool busy = false;
+static bool abortRequested = false;
+static uint8_t reqClient = TRANSPORT_CLIENT_NONE;
+static uint8_t reqAction = MOTOR_CHAR_QUERY;
+
+static MotorCharData charData;
+static bool charValid = false; // charData来自标定 (否则为理想曲线)
+
+/**
+ * @brief 一组查找表 (整体切换)
+ */
+typedef struct
+{
+    uint16_t thrust[MOTOR_LUT_THRUST_POINTS];  // 推力 → 参考电压下的占空比
+    uint16_t voltage[MOTOR_LUT_VOLTAGE_POINTS]; // 带载电压 → 占空比系数 (Q12)
+} MotorLutTables;
+
+static MotorLutTables tableSets[2];
+static const MotorLutTables *volatile tables = &tableSets[0];
+static float referenceVoltage = PM_BAT_SAG_REF_VOLTAGE;
+static volatile uint32_t voltageFactor = 1 << MOTOR_LUT_FACTOR_SHIFT;
+
+// ============ 查找表生成 ============
+
+/**
+ * @brief 标定点的相对推力 (0-1): 推力 ∝ (占空比 × 带载电压)^2, 以最大点归一化
+ *
+ * duty输出为参考电压 (restMv) 下产生同样推力的等效占空比
+ */
+static void charThrustPoints(const MotorCharData *data, float *duty, float *thrust, int *count)
+{
+    float maxEffort = 0.0f;
+    int n = 0;
+
+    duty[n] = 0.0f;
+    thrust[n++] = 0.0f;
+    for (int i = 0; i < MOTOR_CHAR_STEPS; i++)
+    {
+        float d = data->duty[i] / 65535.0f;
+        float effort = d * data->loadedMv[i];
+        // 测量噪声可能造成非单调, 非单调的点不参与插值
+        if (effort <= maxEffort)
+        {
+            continue;
+        }
+        maxEffort = effort;
+        duty[n] = effort / data->restMv;
+        thrust[n++] = effort * effort;
+    }
+    for (int i = 1; i < n; i++)
+    {
+        thrust[i] /= maxEffort * maxEffort;
+    }
+    *count = n;
+}
+
+static void buildThrustTable(uint16_t *table)
+{
+    float duty[MOTOR_CHAR_STEPS + 1];
+    float thrust[MOTOR_CHAR_STEPS + 1];
+    int count = 0;
+
+    if (charValid)
+    {
+        charThrustPoints(&charData, duty, thrust, &count);
+    }
+
+    for (int i = 0; i < MOTOR_LUT_THRUST_POINTS; i++)
+    {
+        float f = (float)i / (MOTOR_LUT_THRUST_POINTS - 1);
+        float d;
+
+        if (count < 2)
+        {
+            d = sqrtf(f); // 理想曲线: 推力 ∝ 占空比^2
+        }
+        else
+        {
+            // 在标定点之间按推力线性插值出占空比
+            int k = 1;
+            while (k < count - 1 && thrust[k] < f)
+            {
+                k++;
+            }
+            float span = thrust[k] - thrust[k - 1];
+            float t = span > 0.0f ? (f - thrust[k - 1]) / span : 1.0f;
+            d = duty[k - 1] + t * (duty[k] - duty[k - 1]);
+        }
+        table[i] = (uint16_t)(fminf(fmaxf(d, 0.0f), 1.0f) * 65535.0f + 0.5f);
+    }
+}
+
+static void buildVoltageTable(uint16_t *table)
+{
+    for (int i = 0; i < MOTOR_LUT_VOLTAGE_POINTS; i++)
+    {
+        float v = MOTOR_LUT_VOLTAGE_MIN + i * MOTOR_LUT_VOLTAGE_STEP;
+        float factor = fminf(fmaxf(referenceVoltage / v, MOTOR_LUT_FACTOR_MIN), MOTOR_LUT_FACTOR_MAX);
+        table[i] = (uint16_t)(factor * (1 << MOTOR_LUT_FACTOR_SHIFT) + 0.5f);
+    }
+}
+
+static void rebuildTables(void)
+{
+    MotorLutTables *spare = (tables == &tableSets[0]) ? &tableSets[1] : &tableSets[0];
+
+    referenceVoltage = charValid ? charData.restMv / 1000.0f : PM_BAT_SAG_REF_VOLTAGE;
+    buildThrustTable(spare->thrust);
+    buildVoltageTable(spare->voltage);
+    __atomic_store_n(&tables, spare, __ATOMIC_RELEASE);
+}
+
+// ============ NVS ============
+
+static bool loadCharData(void)
+{
+    nvs_handle_t handle;
+    size_t size = sizeof(charData);
+
+    if (nvs_open(MOTOR_LUT_NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK)
+    {
+        return false;
+    }
+    esp_err_t err = nvs_get_blob(handle, MOTOR_LUT_NVS_KEY, &charData, &size);
+    nvs_close(handle);
+
+    return err == ESP_OK && size == sizeof(charData) && charData.version == MOTOR_LUT_NVS_VERSION;
+}
+
+static bool storeCharData(bool erase)
+{
+    nvs_handle_t handle;
+    esp_err_t err;
+
+    if (nvs_open(MOTOR_LUT_NVS_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK)
+    {
+        return false;
+    }
+    if (erase)
+    {
+        err = nvs_erase_key(handle, MOTOR_LUT_NVS_KEY);
+        err = (err == ESP_ERR_NVS_NOT_FOUND) ? ESP_OK : err;
+    }
+    else
+    {
+        err = nvs_set_blob(handle, MOTOR_LUT_NVS_KEY, &charData, sizeof(charData));
+    }
+    if (err == ESP_OK)
+    {
+        err = nvs_commit(handle);
+    }
+    nvs_close(handle);
+    return err == ESP_OK;
+}
+
+// ============ 测试台标定 ============
+
+static bool motorsIdle(void)
+{
+    for (int i = 0; i < NBR_OF_MOTORS; i++)
+    {
+        if (motorsGetRatio(i) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void setAllMotors(uint16_t duty)
+{
+    for (int i = 0; i < NBR_OF_MOTORS; i++)
+    {
+        motorsSetRatio(i, duty);
+    }
+}
+
+/**
+ * @brief 标定的中止条件: 中止请求 (含电机测试关闭), 紧急停止, 请求方客户端超时
+ */
+static bool charShouldAbort(void)
+{
+    if (__atomic_load_n(&abortRequested, __ATOMIC_ACQUIRE))
+    {
+        DEBUG_PRINTW("Characterization aborted by request");
+        return true;
+    }
+    if (stabilizerIsEmergencyStop())
+    {
+        DEBUG_PRINTW("Characterization aborted by emergency stop");
+        return true;
+    }
+    if (reqClient != TRANSPORT_CLIENT_NONE && !(transportGetClientMask() & (1 << reqClient)))
+    {
+        DEBUG_PRINTW("Characterization aborted, client %u lost", reqClient);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 分片等待, 每片之后检查中止条件
+ * @return false 需要中止
+ */
+static bool waitAbortable(uint32_t ms)
+{
+    for (uint32_t t = 0; t < ms; t += MOTOR_CHAR_SAMPLE_MS)
+    {
+        vTaskDelay(M2T(MOTOR_CHAR_SAMPLE_MS));
+        if (charShouldAbort())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 平均带载电压, 每次采样之后检查中止条件
+ * @return false 需要中止
+ */
+static bool measureLoadedMv(uint16_t *mv)
+{
+    float sum = 0.0f;
+    int n = 0;
+
+    for (int t = 0; t < MOTOR_CHAR_MEASURE_MS; t += MOTOR_CHAR_SAMPLE_MS)
+    {
+        sum += pmGetBatteryVoltageLoaded();
+        n++;
+        if (!waitAbortable(MOTOR_CHAR_SAMPLE_MS))
+        {
+            return false;
+        }
+    }
+    *mv = (uint16_t)(sum / n * 1000.0f);
+    return true;
+}
+
+/**
+ * @brief 依次以各标定点占空比驱动四个电机并记录带载电压
+ *
+ * @param aborted 输出: 是否因中止条件结束
+ * @return false 条件不满足, 电池电压过低或被中止, 已停止电机
+ */
+static bool runCharacterization(MotorCharData *data, bool *aborted)
+{
+    *aborted = false;
+    if (!zero_calib_is_done() || !motorsIdle())
+    {
+        DEBUG_PRINTW("Characterization needs idle motors after calibration");
+        return false;
+    }
+
+    powerDistributionSetMotorTestMode(true);
+    data->version = MOTOR_LUT_NVS_VERSION;
+    bool ok = measureLoadedMv(&data->restMv);
+    *aborted = !ok;
+    DEBUG_PRINTI("Characterization started, rest %umV", data->restMv);
+
+    for (int i = 0; i < MOTOR_CHAR_STEPS && ok; i++)
+    {
+        data->duty[i] = (uint16_t)((i + 1) * 65535UL / MOTOR_CHAR_STEPS);
+        setAllMotors(data->duty[i]);
+        if (!waitAbortable(MOTOR_CHAR_SETTLE_MS) || !measureLoadedMv(&data->loadedMv[i]))
+        {
+            *aborted = true;
+            ok = false;
+            break;
+        }
+        DEBUG_PRINTI("  duty %5u  loaded %umV", data->duty[i], data->loadedMv[i]);
+
+        if (data->loadedMv[i] < PM_BAT_LOW_VOLTAGE * 1000)
+        {
+            DEBUG_PRINTW("Battery too low, characterization aborted");
+            ok = false;
+        }
+    }
+
+    powerStop();
+    powerDistributionSetMotorTestMode(false);
+    return ok;
+}
+
+// ============ 结果上报 ============
+
+static void sendResult(uint8_t status, uint8_t step, uint16_t duty, uint16_t loadedMv, uint16_t thrust)
+{
+    MotorCharResultPacket_t packet;
+    uint8_t frame[PKT_FRAME_LEN_MOTOR_CHAR_RESULT];
+
+    memset(&packet, 0, sizeof(packet));
+    packet.status = status;
+    packet.step = step;
+    packet.step_count = MOTOR_CHAR_STEPS;
+    packet.duty = duty;
+    packet.rest_mv = charValid ? charData.restMv : 0;
+    packet.loaded_mv = loadedMv;
+    packet.thrust = thrust;
+
+    uint16_t len = packet_encodeMotorCharResult(frame, sizeof(frame), &packet);
+    dataSenderSendFrame(reqClient, frame, len);
+    vTaskDelay(M2T(MOTOR_CHAR_REPORT_INTERVAL_MS));
+}
+
+/**
+ * @brief 按标定点上报当前曲线: 已标定时为测量值, 否则为理想曲线上的对应点
+ */
+static void reportCurve(void)
+{
+    float effort[MOTOR_CHAR_STEPS];
+    float maxEffort = 0.0f;
+
+    for (int i = 0; i < MOTOR_CHAR_STEPS; i++)
+    {
+        float d = (charValid ? charData.duty[i] : (i + 1) * 65535UL / MOTOR_CHAR_STEPS) / 65535.0f;
+        effort[i] = charValid ? d * charData.loadedMv[i] : d;
+        maxEffort = fmaxf(maxEffort, effort[i]);
+    }
+
+    for (int i = 0; i < MOTOR_CHAR_STEPS; i++)
+    {
+        uint16_t duty = charValid ? charData.duty[i] : (uint16_t)((i + 1) * 65535UL / MOTOR_CHAR_STEPS);
+        float f = maxEffort > 0.0f ? (effort[i] / maxEffort) * (effort[i] / maxEffort) : 0.0f;
+        sendResult(charValid ? 1 : 0, i, duty, charValid ? charData.loadedMv[i] : 0, (uint16_t)(f * 65535.0f));
+    }
+}
+
+static void motorCharTask(void *param)
+{
+    MotorCharData measured;
+    bool aborted;
+
+    while (1)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        switch (reqAction)
+        {
+        case MOTOR_CHAR_RUN:
+            sendResult(2, 0, 0, 0, 0);
+            if (runCharacterization(&measured, &aborted))
+            {
+                charData = measured;
+                charValid = true;
+                rebuildTables();
+                if (!storeCharData(false))
+                {
+                    DEBUG_PRINTE("Failed to store characterization in NVS");
+                }
+                reportCurve();
+            }
+            else
+            {
+                sendResult(aborted ? 4 : 3, 0, 0, 0, 0);
+            }
+            break;
+
+        case MOTOR_CHAR_RESET:
+            charValid = false;
+            rebuildTables();
+            storeCharData(true);
+            DEBUG_PRINTI("Characterization cleared, using ideal curve");
+            reportCurve();
+            break;
+
+        default:
+            reportCurve();
+            break;
+        }
+
+        __atomic_store_n(&busy, false, __ATOMIC_RELEASE);
+    }
+}
+
+// ============ 公共接口 ============
+
+void motorLutInit(void)
+{
+    if (isInit)
+    {
+        return;
+    }
+
+    charValid = loadCharData();
+    rebuildTables();
+    DEBUG_PRINTI("Thrust curve: %s, reference %.2fV", charValid ? "characterized" : "ideal",
+                 (double)referenceVoltage);
+
+    xTaskCreate(motorCharTask, MOTOR_CHAR_TASK_NAME, MOTOR_CHAR_TASK_STACKSIZE, NULL, MOTOR_CHAR_TASK_PRI,
+                &charTaskHandle);
+    isInit = true;
+}
+
+bool motorLutTest(void)
+{
+    return isInit;
+}
+
+void motorLutUpdateBattery(float voltage)
+{
+    const uint16_t *table = __atomic_load_n(&tables, __ATOMIC_ACQUIRE)->voltage;
+    float pos = (voltage - MOTOR_LUT_VOLTAGE_MIN) / MOTOR_LUT_VOLTAGE_STEP;
+
+    if (voltage < PM_BAT_SAG_MIN_VALID_VOLTAGE)
+    {
+        // 电池电压尚未有效 (启动或采样异常), 不补偿
+        voltageFactor = 1 << MOTOR_LUT_FACTOR_SHIFT;
+    }
+    else if (pos <= 0.0f)
+    {
+        voltageFactor = table[0];
+    }
+    else if (pos >= MOTOR_LUT_VOLTAGE_POINTS - 1)
+    {
+        voltageFactor = table[MOTOR_LUT_VOLTAGE_POINTS - 1];
+    }
+    else
+    {
+        int i = (int)pos;
+        float t = pos - i;
+        voltageFactor = (uint32_t)(table[i] + t * (table[i + 1] - table[i]));
+    }
+}
+
+uint16_t motorLutApply(uint16_t thrust)
+{
+    const uint16_t *table = __atomic_load_n(&tables, __ATOMIC_ACQUIRE)->thrust;
+    const uint32_t segment = 16 - MOTOR_LUT_THRUST_SHIFT;
+    uint32_t i = thrust >> segment;
+    uint32_t frac = thrust & ((1u << segment) - 1);
+
+    int32_t duty = table[i] + (((int32_t)table[i + 1] - table[i]) * (int32_t)frac >> segment);
+    uint32_t scaled = ((uint32_t)duty * voltageFactor) >> MOTOR_LUT_FACTOR_SHIFT;
+    return scaled > UINT16_MAX ? UINT16_MAX : (uint16_t)scaled;
+}
+
+bool motorLutRequest(uint8_t client, uint8_t action)
+{
+    bool expected = false;
+
+    if (action == MOTOR_CHAR_ABORT)
+    {
+        motorLutAbort();
+        return isInit;
+    }
+
+    if (!isInit ||
+        !__atomic_compare_exchange_n(&busy, &expected, true, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        return false;
+    }
+
+    reqClient = client;
+    reqAction = action;
+    __atomic_store_n(&abortRequested, false, __ATOMIC_RELEASE);
+    xTaskNotifyGive(charTaskHandle);
+    return true;
+}
+
+void motorLutAbort(void)
+{
+    // 未在标定时置位无作用, 下一次请求前清除
+    __atomic_store_n(&abortRequested, true, __ATOMIC_RELEASE);
+}
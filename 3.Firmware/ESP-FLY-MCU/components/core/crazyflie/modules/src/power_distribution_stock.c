@@ -7,6 +7,8 @@
 #include "num.h"
 #include "platform.h"
 #include "motors.h"
+#include "pm_esplane.h"
+#include "motor_lut.h"
 #define DEBUG_MODULE "PWR_DIST"
 #include "debug_cf.h"
 
@@ -90,6 +92,25 @@ void powerDistribution(const control_t *control)
                               control->yaw);
 #endif
 
+#ifdef CONFIG_MOTOR_THRUST_LUT
+  // 推力线性化 + 电池压降补偿查找表 (代替下面的thrustScale, 同样使用快速滤波的带载电压)
+  motorLutUpdateBattery(pmGetBatteryVoltageLoaded());
+  motorPower.m1 = motorLutApply(motorPower.m1);
+  motorPower.m2 = motorLutApply(motorPower.m2);
+  motorPower.m3 = motorLutApply(motorPower.m3);
+  motorPower.m4 = motorLutApply(motorPower.m4);
+#else
+  // 电池压降补偿: 电压跌落时按比例放大输出, 保持同一指令下的推力
+  float thrustScale = pmGetThrustScale();
+  if (thrustScale != 1.0f)
+  {
+    motorPower.m1 = limitThrust(motorPower.m1 * thrustScale);
+    motorPower.m2 = limitThrust(motorPower.m2 * thrustScale);
+    motorPower.m3 = limitThrust(motorPower.m3 * thrustScale);
+    motorPower.m4 = limitThrust(motorPower.m4 * thrustScale);
+  }
+#endif
+
   if (motorSetEnable)
   {
     motorsSetRatio(MOTOR_M1, motorPowerSet.m1);
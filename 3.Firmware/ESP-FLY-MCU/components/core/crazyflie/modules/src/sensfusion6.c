@@ -1,4 +1,5 @@
 #include <math.h>
+#include <stdint.h>
 
 #include "sensfusion6.h"
 #include "physicalConstants.h"
@@ -39,6 +40,8 @@ static bool isInit;
 static bool isCalibrated = false;
 
 static void sensfusion6UpdateQImpl(float gx, float gy, float gz, float ax, float ay, float az, float dt);
+static void sensfusion6PredictImpl(float gx, float gy, float gz, float dt);
+static void sensfusion6CorrectImpl(float ax, float ay, float az, float dt);
 static float sensfusion6GetAccZ(const float ax, const float ay, const float az);
 static void estimatedGravityDirection(float *gx, float *gy, float *gz);
 
@@ -70,6 +73,27 @@ void sensfusion6UpdateQ(float gx, float gy, float gz, float ax, float ay, float
   }
 }
 
+// Split form of sensfusion6UpdateQ: the gyro propagation is cheap and runs on
+// every sample, the accelerometer correction may run at a lower rate. The
+// correction uses the same gains, integrated over its own (longer) dt.
+void sensfusion6Predict(float gx, float gy, float gz, float dt)
+{
+  sensfusion6PredictImpl(gx, gy, gz, dt);
+  estimatedGravityDirection(&gravX, &gravY, &gravZ);
+}
+
+void sensfusion6Correct(float ax, float ay, float az, float dt)
+{
+  sensfusion6CorrectImpl(ax, ay, az, dt);
+  estimatedGravityDirection(&gravX, &gravY, &gravZ);
+
+  if (!isCalibrated)
+  {
+    baseZacc = sensfusion6GetAccZ(ax, ay, az);
+    isCalibrated = true;
+  }
+}
+
 #ifdef MADWICK_QUATERNION_IMU
 // Implementation of Madgwick's IMU and AHRS algorithms.
 // See: http://www.x-io.co.uk/open-source-ahrs-with-x-imu
@@ -145,6 +169,77 @@ static void sensfusion6UpdateQImpl(float gx, float gy, float gz, float ax, float
   qy *= recipNorm;
   qz *= recipNorm;
 }
+
+static void sensfusion6PredictImpl(float gx, float gy, float gz, float dt)
+{
+  float recipNorm;
+  float qa, qb, qc;
+
+  // Rate of change of quaternion from gyroscope, integrated directly
+  gx *= (0.5f * dt);
+  gy *= (0.5f * dt);
+  gz *= (0.5f * dt);
+  qa = qw;
+  qb = qx;
+  qc = qy;
+  qw += (-qb * gx - qc * gy - qz * gz);
+  qx += (qa * gx + qc * gz - qz * gy);
+  qy += (qa * gy - qb * gz + qz * gx);
+  qz += (qa * gz + qb * gy - qc * gx);
+
+  recipNorm = invSqrt(qw * qw + qx * qx + qy * qy + qz * qz);
+  qw *= recipNorm;
+  qx *= recipNorm;
+  qy *= recipNorm;
+  qz *= recipNorm;
+}
+
+static void sensfusion6CorrectImpl(float ax, float ay, float az, float dt)
+{
+  float recipNorm;
+  float s0, s1, s2, s3;
+  float _2qw, _2qx, _2qy, _2qz, _4qw, _4qx, _4qy, _8qx, _8qy, qwqw, qxqx, qyqy, qzqz;
+
+  if ((ax == 0.0f) && (ay == 0.0f) && (az == 0.0f))
+    return;
+
+  recipNorm = invSqrt(ax * ax + ay * ay + az * az);
+  ax *= recipNorm;
+  ay *= recipNorm;
+  az *= recipNorm;
+
+  _2qw = 2.0f * qw;
+  _2qx = 2.0f * qx;
+  _2qy = 2.0f * qy;
+  _2qz = 2.0f * qz;
+  _4qw = 4.0f * qw;
+  _4qx = 4.0f * qx;
+  _4qy = 4.0f * qy;
+  _8qx = 8.0f * qx;
+  _8qy = 8.0f * qy;
+  qwqw = qw * qw;
+  qxqx = qx * qx;
+  qyqy = qy * qy;
+  qzqz = qz * qz;
+
+  // Gradient decent algorithm corrective step
+  s0 = _4qw * qyqy + _2qy * ax + _4qw * qxqx - _2qx * ay;
+  s1 = _4qx * qzqz - _2qz * ax + 4.0f * qwqw * qx - _2qw * ay - _4qx + _8qx * qxqx + _8qx * qyqy + _4qx * az;
+  s2 = 4.0f * qwqw * qy + _2qw * ax + _4qy * qzqz - _2qz * ay - _4qy + _8qy * qxqx + _8qy * qyqy + _4qy * az;
+  s3 = 4.0f * qxqx * qz - _2qx * ax + 4.0f * qyqy * qz - _2qy * ay;
+  recipNorm = invSqrt(s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3);
+
+  qw -= beta * s0 * recipNorm * dt;
+  qx -= beta * s1 * recipNorm * dt;
+  qy -= beta * s2 * recipNorm * dt;
+  qz -= beta * s3 * recipNorm * dt;
+
+  recipNorm = invSqrt(qw * qw + qx * qx + qy * qy + qz * qz);
+  qw *= recipNorm;
+  qx *= recipNorm;
+  qy *= recipNorm;
+  qz *= recipNorm;
+}
 #else // MAHONY_QUATERNION_IMU
 // Madgwick's implementation of Mayhony's AHRS algorithm.
 // See: http://www.x-io.co.uk/open-source-ahrs-with-x-imu
@@ -224,6 +319,78 @@ static void sensfusion6UpdateQImpl(float gx, float gy, float gz, float ax, float
   qy *= recipNorm;
   qz *= recipNorm;
 }
+
+// Rotate the quaternion by the body rate (rad/s) over dt and renormalise
+static void integrateRate(float gx, float gy, float gz, float dt)
+{
+  float recipNorm;
+  float qa, qb, qc;
+
+  gx *= (0.5f * dt);
+  gy *= (0.5f * dt);
+  gz *= (0.5f * dt);
+  qa = qw;
+  qb = qx;
+  qc = qy;
+  qw += (-qb * gx - qc * gy - qz * gz);
+  qx += (qa * gx + qc * gz - qz * gy);
+  qy += (qa * gy - qb * gz + qz * gx);
+  qz += (qa * gz + qb * gy - qc * gx);
+
+  recipNorm = invSqrt(qw * qw + qx * qx + qy * qy + qz * qz);
+  qw *= recipNorm;
+  qx *= recipNorm;
+  qy *= recipNorm;
+  qz *= recipNorm;
+}
+
+static void sensfusion6PredictImpl(float gx, float gy, float gz, float dt)
+{
+  // Gyro plus the integral (bias) feedback learnt by the correction step
+  integrateRate(gx * M_PI_F / 180 + integralFBx,
+                gy * M_PI_F / 180 + integralFBy,
+                gz * M_PI_F / 180 + integralFBz, dt);
+}
+
+static void sensfusion6CorrectImpl(float ax, float ay, float az, float dt)
+{
+  float recipNorm;
+  float halfvx, halfvy, halfvz;
+  float halfex, halfey, halfez;
+
+  // Skip if accelerometer measurement invalid (avoids NaN in accelerometer normalisation)
+  if ((ax == 0.0f) && (ay == 0.0f) && (az == 0.0f))
+    return;
+
+  recipNorm = invSqrt(ax * ax + ay * ay + az * az);
+  ax *= recipNorm;
+  ay *= recipNorm;
+  az *= recipNorm;
+
+  halfvx = qx * qz - qw * qy;
+  halfvy = qw * qx + qy * qz;
+  halfvz = qw * qw - 0.5f + qz * qz;
+
+  halfex = (ay * halfvz - az * halfvy);
+  halfey = (az * halfvx - ax * halfvz);
+  halfez = (ax * halfvy - ay * halfvx);
+
+  if (twoKi > 0.0f)
+  {
+    integralFBx += twoKi * halfex * dt;
+    integralFBy += twoKi * halfey * dt;
+    integralFBz += twoKi * halfez * dt;
+  }
+  else
+  {
+    integralFBx = 0.0f;
+    integralFBy = 0.0f;
+    integralFBz = 0.0f;
+  }
+
+  // Proportional feedback as a rotation over the correction interval
+  integrateRate(twoKp * halfex, twoKp * halfey, twoKp * halfez, dt);
+}
 #endif
 
 void sensfusion6GetQuaternion(float *q_x, float *q_y, float *q_z, float *q_w)
@@ -269,7 +436,7 @@ float invSqrt(float x)
 {
   float halfx = 0.5f * x;
   float y = x;
-  long i = *(long *)&y;
+  int32_t i = *(int32_t *)&y; // 32-bit on every target, long is 64-bit on LP64 hosts
   i = 0x5f3759df - (i >> 1);
   y = *(float *)&i;
   y = y * (1.5f - (halfx * y * y));
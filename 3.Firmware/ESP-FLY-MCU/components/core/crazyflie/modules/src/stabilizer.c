@@ -35,6 +35,12 @@ static inline uint32_t quatcompress(const float q[4])
 #include "attitude_controller.h"
 #include "zero_calib.h"
 #include "status_led.h"
+#include "boot_timeline.h"
+#include "kernel_bench.h"
+#include "sysid.h"
+#include "worker.h"
+#include "state_snapshot.h"
+#include "controller_pid.h"
 
 static bool isInit;
 static bool emergencyStop = false;
@@ -60,10 +66,12 @@ typedef enum
 {
   configureAcc,
   measureNoiseFloor,
+  waitNoiseFloor,
   measureProp,
   testBattery,
   restartBatTest,
   evaluateResult,
+  waitResult,
   testDone
 } TestState;
 #ifdef RUN_PROP_TEST_AT_STARTUP
@@ -124,6 +132,21 @@ static float accVarZ[NBR_OF_MOTORS];
 static uint8_t motorPass = 0;
 static uint16_t motorTestCount = 0;
 
+// Propeller test sample buffers, evaluated by worker jobs outside the stabilizer loop
+NO_DMA_CCM_SAFE_ZERO_INIT static float accX[PROPTEST_NBR_OF_VARIANCE_VALUES];
+NO_DMA_CCM_SAFE_ZERO_INIT static float accY[PROPTEST_NBR_OF_VARIANCE_VALUES];
+NO_DMA_CCM_SAFE_ZERO_INIT static float accZ[PROPTEST_NBR_OF_VARIANCE_VALUES];
+static float accVarXnf;
+static float accVarYnf;
+static float accVarZnf;
+static uint8_t nrFailedTests = 0;
+static volatile bool propJobDone;
+
+static void propVarianceJob(void *arg);
+static void propEvaluateJob(void *arg);
+WORKER_JOB_DEFINE(propVarianceWork, propVarianceJob, WORKER_PRIO_HIGH, WORKER_OTHER_CORE);
+WORKER_JOB_DEFINE(propEvaluateWork, propEvaluateJob, WORKER_PRIO_NORMAL, 0);
+
 STATIC_MEM_TASK_ALLOC(stabilizerTask, STABILIZER_TASK_STACKSIZE);
 
 static void stabilizerTask(void *param);
@@ -177,6 +200,30 @@ static void compressSetpoint()
   setpointCompressed.az = setpoint.acceleration.z * 1000.0f;
 }
 
+_Static_assert(STATE_SNAPSHOT_MOTORS == NBR_OF_MOTORS, "snapshot motor count");
+
+/** Publish the data of this tick for the telemetry and logging tasks
+ */
+static void publishSnapshot(uint32_t tick)
+{
+  stateSnapshot_t *snapshot = stateSnapshotBegin();
+
+  snapshot->tick = tick;
+  snapshot->timestamp = T2M(xTaskGetTickCount());
+  snapshot->sensorData = sensorData;
+  snapshot->state = state;
+  snapshot->setpoint = setpoint;
+  snapshot->control = control;
+  controllerPidGetRateDesired(&snapshot->rateDesired.roll, &snapshot->rateDesired.pitch,
+                              &snapshot->rateDesired.yaw);
+  for (int m = 0; m < NBR_OF_MOTORS; m++)
+  {
+    snapshot->motors[m] = (uint16_t)motorsGetRatio(m);
+  }
+
+  stateSnapshotCommit();
+}
+
 void stabilizerInit(StateEstimatorType estimator)
 {
   if (isInit)
@@ -205,7 +252,8 @@ bool stabilizerTest(void)
   pass &= sensorsTest();
   pass &= stateEstimatorTest();
   pass &= controllerTest();
-  pass &= powerDistributionTest();
+  // powerDistributionTest() (motor self test) runs as a boot step in systemTask,
+  // concurrently with the IMU bring-up
 
   return pass;
 }
@@ -252,6 +300,7 @@ static void stabilizerTask(void *param)
   }
 
   DEBUG_PRINTI("Sensor calibration done. Starting angle zero-point calibration...\n");
+  bootTimelineMark("gyro bias found");
 
   // Wait for angle zero-point calibration to complete
   // During this phase, the estimator feeds pitch/roll into zero_calib_update()
@@ -261,6 +310,7 @@ static void stabilizerTask(void *param)
   {
     sensorsWaitDataReady();
     stateEstimator(&state, &sensorData, &control, tick);
+    publishSnapshot(tick);
     tick++;
     // Yield to let other tasks run
     if (tick % 1000 == 0)
@@ -272,6 +322,7 @@ static void stabilizerTask(void *param)
   // Angle calibration complete - switch to green LED
   statusLedSet(STATUS_LED_NORMAL);
   DEBUG_PRINTI("Angle calibration done. Ready to fly.\n");
+  bootTimelineFinish();
 
   // Re-initialize tick
   tick = 1;
@@ -317,6 +368,7 @@ static void stabilizerTask(void *param)
       compressSetpoint();
 
       controller(&control, &setpoint, &sensorData, &state, tick);
+      sysidStep(&sensorData, &state, &control, tick);
 
       checkEmergencyStopTimeout();
 
@@ -331,6 +383,10 @@ static void stabilizerTask(void *param)
       }
     }
     calcSensorToOutputLatency(&sensorData);
+    publishSnapshot(tick);
+
+    // Microbenchmark slice, only runs on request while the motors are stopped
+    kernelBenchStep();
 
     tick++;
     STATS_CNT_RATE_EVENT(&stabilizerRate);
@@ -356,6 +412,11 @@ void stabilizerResetEmergencyStop()
   emergencyStop = false;
 }
 
+bool stabilizerIsEmergencyStop(void)
+{
+  return emergencyStop;
+}
+
 void stabilizerSetEmergencyStopTimeout(int timeout)
 {
   emergencyStop = false;
@@ -398,20 +459,95 @@ static bool evaluateTest(float low, float high, float value, uint8_t motor)
   return true;
 }
 
+/** Variance of the sampled accelerations, arg is the motor index or -1 for the noise floor
+ */
+static void propVarianceJob(void *arg)
+{
+  int motor = (int)(intptr_t)arg;
+  float varX = variance(accX, PROPTEST_NBR_OF_VARIANCE_VALUES);
+  float varY = variance(accY, PROPTEST_NBR_OF_VARIANCE_VALUES);
+  float varZ = variance(accZ, PROPTEST_NBR_OF_VARIANCE_VALUES);
+
+  if (motor < 0)
+  {
+    accVarXnf = varX;
+    accVarYnf = varY;
+    accVarZnf = varZ;
+    DEBUG_PRINTI("Acc noise floor variance X+Y:%f, (Z:%f)\n",
+                 (double)accVarXnf + (double)accVarYnf, (double)accVarZnf);
+  }
+  else
+  {
+    accVarX[motor] = varX;
+    accVarY[motor] = varY;
+    accVarZ[motor] = varZ;
+    DEBUG_PRINTI("Motor M%d variance X+Y:%f (Z:%f)\n",
+                 motor + 1, (double)accVarX[motor] + (double)accVarY[motor],
+                 (double)accVarZ[motor]);
+  }
+  propJobDone = true;
+}
+
+/** Evaluate the propeller test and beep the failed motors. The stabilizer
+ * waits in waitResult meanwhile, so the beeps are not overridden.
+ */
+static void propEvaluateJob(void *arg)
+{
+  for (int m = 0; m < NBR_OF_MOTORS; m++)
+  {
+    if (!evaluateTest(0, PROPELLER_BALANCE_TEST_THRESHOLD, accVarX[m] + accVarY[m], m))
+    {
+      nrFailedTests++;
+      for (int j = 0; j < 3; j++)
+      {
+        motorsBeep(m, true, testsound[m], (uint16_t)(MOTORS_TIM_BEEP_CLK_FREQ / A4) / 20);
+        vTaskDelay(M2T(MOTORS_TEST_ON_TIME_MS));
+        motorsBeep(m, false, 0, 0);
+        vTaskDelay(M2T(100));
+      }
+    }
+  }
+#ifdef PLAY_STARTUP_MELODY_ON_MOTORS
+  if (nrFailedTests == 0)
+  {
+    for (int m = 0; m < NBR_OF_MOTORS; m++)
+    {
+      motorsBeep(m, true, testsound[m], (uint16_t)(MOTORS_TIM_BEEP_CLK_FREQ / A4) / 20);
+      vTaskDelay(M2T(MOTORS_TEST_ON_TIME_MS));
+      motorsBeep(m, false, 0, 0);
+      vTaskDelay(M2T(MOTORS_TEST_DELAY_TIME_MS));
+    }
+  }
+#endif
+  motorTestCount++;
+  propJobDone = true;
+}
+
+/** Submit a propeller test job to the worker. Never runs it inline: the
+ * evaluation beeps block for seconds. On a full queue the caller keeps its
+ * state and retries on the next tick.
+ * @return true if the job was accepted, propJobDone is set when it finishes
+ */
+static bool propStartJob(workerJob_t *job, void *arg)
+{
+  // Cleared before submitting, the job may finish on the other core first
+  propJobDone = false;
+  if (workerSubmit(job, arg) != 0)
+  {
+    propJobDone = true;
+    return false;
+  }
+  return true;
+}
+
 static void testProps(sensorData_t *sensors)
 {
   static uint32_t i = 0;
-  NO_DMA_CCM_SAFE_ZERO_INIT static float accX[PROPTEST_NBR_OF_VARIANCE_VALUES];
-  NO_DMA_CCM_SAFE_ZERO_INIT static float accY[PROPTEST_NBR_OF_VARIANCE_VALUES];
-  NO_DMA_CCM_SAFE_ZERO_INIT static float accZ[PROPTEST_NBR_OF_VARIANCE_VALUES];
-  static float accVarXnf;
-  static float accVarYnf;
-  static float accVarZnf;
   static int motorToTest = 0;
-  static uint8_t nrFailedTests = 0;
   static float idleVoltage;
   static float minSingleLoadedVoltage[NBR_OF_MOTORS];
   static float minLoadedVoltage;
+  static bool varianceQueued = false;
 
   if (testState == configureAcc)
   {
@@ -426,18 +562,25 @@ static void testProps(sensorData_t *sensors)
   }
   if (testState == measureNoiseFloor)
   {
-    accX[i] = sensors->acc.x;
-    accY[i] = sensors->acc.y;
-    accZ[i] = sensors->acc.z;
+    if (i < PROPTEST_NBR_OF_VARIANCE_VALUES)
+    {
+      accX[i] = sensors->acc.x;
+      accY[i] = sensors->acc.y;
+      accZ[i] = sensors->acc.z;
+      i++;
+    }
 
-    if (++i >= PROPTEST_NBR_OF_VARIANCE_VALUES)
+    if (i >= PROPTEST_NBR_OF_VARIANCE_VALUES && propStartJob(&propVarianceWork, (void *)(intptr_t)-1))
     {
       i = 0;
-      accVarXnf = variance(accX, PROPTEST_NBR_OF_VARIANCE_VALUES);
-      accVarYnf = variance(accY, PROPTEST_NBR_OF_VARIANCE_VALUES);
-      accVarZnf = variance(accZ, PROPTEST_NBR_OF_VARIANCE_VALUES);
-      DEBUG_PRINTI("Acc noise floor variance X+Y:%f, (Z:%f)\n",
-                   (double)accVarXnf + (double)accVarYnf, (double)accVarZnf);
+      testState = waitNoiseFloor;
+    }
+  }
+  else if (testState == waitNoiseFloor)
+  {
+    // The buffers are reused by measureProp
+    if (propJobDone)
+    {
       testState = measureProp;
     }
   }
@@ -463,17 +606,13 @@ static void testProps(sensorData_t *sensors)
     {
       motorsSetRatio(motorToTest, 0);
     }
-    else if (i == PROPTEST_NBR_OF_VARIANCE_VALUES)
+    else if (i >= PROPTEST_NBR_OF_VARIANCE_VALUES && !varianceQueued)
     {
-      accVarX[motorToTest] = variance(accX, PROPTEST_NBR_OF_VARIANCE_VALUES);
-      accVarY[motorToTest] = variance(accY, PROPTEST_NBR_OF_VARIANCE_VALUES);
-      accVarZ[motorToTest] = variance(accZ, PROPTEST_NBR_OF_VARIANCE_VALUES);
-      DEBUG_PRINTI("Motor M%d variance X+Y:%f (Z:%f)\n",
-                   motorToTest + 1, (double)accVarX[motorToTest] + (double)accVarY[motorToTest],
-                   (double)accVarZ[motorToTest]);
+      varianceQueued = propStartJob(&propVarianceWork, (void *)(intptr_t)motorToTest);
     }
-    else if (i >= 1000)
+    else if (i >= 1000 && varianceQueued && propJobDone)
     {
+      varianceQueued = false;
       i = 0;
       motorToTest++;
       if (motorToTest >= NBR_OF_MOTORS)
@@ -530,33 +669,16 @@ static void testProps(sensorData_t *sensors)
   }
   else if (testState == evaluateResult)
   {
-    for (int m = 0; m < NBR_OF_MOTORS; m++)
+    if (propStartJob(&propEvaluateWork, NULL))
     {
-      if (!evaluateTest(0, PROPELLER_BALANCE_TEST_THRESHOLD, accVarX[m] + accVarY[m], m))
-      {
-        nrFailedTests++;
-        for (int j = 0; j < 3; j++)
-        {
-          motorsBeep(m, true, testsound[m], (uint16_t)(MOTORS_TIM_BEEP_CLK_FREQ / A4) / 20);
-          vTaskDelay(M2T(MOTORS_TEST_ON_TIME_MS));
-          motorsBeep(m, false, 0, 0);
-          vTaskDelay(M2T(100));
-        }
-      }
+      testState = waitResult;
     }
-#ifdef PLAY_STARTUP_MELODY_ON_MOTORS
-    if (nrFailedTests == 0)
+  }
+  else if (testState == waitResult)
+  {
+    if (propJobDone)
     {
-      for (int m = 0; m < NBR_OF_MOTORS; m++)
-      {
-        motorsBeep(m, true, testsound[m], (uint16_t)(MOTORS_TIM_BEEP_CLK_FREQ / A4) / 20);
-        vTaskDelay(M2T(MOTORS_TEST_ON_TIME_MS));
-        motorsBeep(m, false, 0, 0);
-        vTaskDelay(M2T(MOTORS_TEST_DELAY_TIME_MS));
-      }
+      testState = testDone;
     }
-#endif
-    motorTestCount++;
-    testState = testDone;
   }
 }
\ No newline at end of file
@@ -0,0 +1,70 @@
+/**
+ * state_snapshot.c - Per-tick flight state publication
+ *
+ * Triple buffer with a sequence counter per slot (seqlock). The writer always
+ * fills a slot that is not the latest one, so a reader copying the latest slot
+ * is only disturbed if it is preempted for two whole stabilizer ticks. The
+ * slot sequence is odd while the slot is being written; a reader retries when
+ * it sees an odd sequence or when the sequence changed during its copy.
+ */
+#include <string.h>
+
+#include "state_snapshot.h"
+
+#define STATE_SNAPSHOT_SLOTS 3
+
+typedef struct
+{
+  uint32_t seq;
+  stateSnapshot_t data;
+} snapshotSlot_t;
+
+static snapshotSlot_t slots[STATE_SNAPSHOT_SLOTS];
+static uint32_t latest;  // index of the latest committed slot
+static uint32_t writing; // index of the slot being filled (writer only)
+
+stateSnapshot_t *stateSnapshotBegin(void)
+{
+  snapshotSlot_t *slot;
+
+  writing = (__atomic_load_n(&latest, __ATOMIC_RELAXED) + 1) % STATE_SNAPSHOT_SLOTS;
+  slot = &slots[writing];
+
+  // Odd sequence: readers of this slot will retry
+  __atomic_store_n(&slot->seq, slot->seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  return &slot->data;
+}
+
+void stateSnapshotCommit(void)
+{
+  snapshotSlot_t *slot = &slots[writing];
+
+  __atomic_store_n(&slot->seq, slot->seq + 1, __ATOMIC_RELEASE);
+  __atomic_store_n(&latest, writing, __ATOMIC_RELEASE);
+}
+
+uint32_t stateSnapshotRead(stateSnapshot_t *snapshot)
+{
+  const snapshotSlot_t *slot;
+  uint32_t seq;
+
+  while (1)
+  {
+    slot = &slots[__atomic_load_n(&latest, __ATOMIC_ACQUIRE)];
+    seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+    if (seq & 1)
+    {
+      continue;
+    }
+
+    memcpy(snapshot, &slot->data, sizeof(*snapshot));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq)
+    {
+      return snapshot->tick;
+    }
+  }
+}
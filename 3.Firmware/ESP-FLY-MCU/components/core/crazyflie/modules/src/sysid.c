@@ -0,0 +1,466 @@
+/**
+ * @file sysid.c
+ * @brief 角速度环系统辨识实现
+ *
+ * 稳定器任务在每个内环周期记录一个样本并计算下一周期的激励, 激励通过
+ * controllerPidSetRateExcitation() 叠加在外环输出的期望角速度上.
+ * 记录完成或中止后通知辨识任务: 扫频时先做Welch谱估计 (Hann窗, 50%重叠),
+ * 再逐包发送频率响应和原始记录.
+ *
+ * 记录的期望角速度d = 外环输出 + 激励r, 外环输出含陀螺仪/姿态噪声经反馈的成分,
+ * 与输出噪声相关, 以d为参考 (Syd/Sdd) 的估计有偏. 因此以注入的激励r为工具变量:
+ * 角速度环闭环 T = Sry/Srd, 对象 P = Sry/Sru, 相干值 |Sry|²/(Srr·Syy).
+ * r由excitation()按样本序号重新生成 (第i个样本记录时生效的正是excitation(i)), 不占记录缓冲.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "sysid.h"
+#include "config.h"
+#include "controller_pid.h"
+#include "math3d.h"
+#include "zero_calib.h"
+#include "xtensa_math.h"
+#include "packet_codec.h"
+#include "transport.h"
+#include "data_sender.h"
+#include "stm32_legacy.h"
+
+#define DEBUG_MODULE "SYSID"
+#include "debug_cf.h"
+
+#define SYSID_SAMPLE_RATE ATTITUDE_RATE
+#define SYSID_REPORT_INTERVAL_MS 10 // 结果包间隔, 避免挤占遥测
+#define SYSID_RATE_SCALE 10.0f      // 角速度记录单位 0.1度/秒
+
+typedef enum
+{
+    PHASE_IDLE = 0,
+    PHASE_RUN,
+    PHASE_ANALYZE,
+    PHASE_ABORTED,
+} SysidPhase;
+
+/**
+ * @brief 一个内环周期的记录 (与SYSID_SAMPLES包中的样本格式一致)
+ */
+typedef struct
+{
+    int16_t rate;   // 期望角速度 (含激励)
+    int16_t gyro;   // 陀螺仪角速度, 符号与角速度环一致
+    int16_t output; // 角速度环输出
+} __attribute__((packed)) SysidSample;
+
+_Static_assert(SYSID_SAMPLES_PER_PACKET * sizeof(SysidSample) == sizeof(((SysidSamplesPacket_t *)0)->samples),
+               "sysid sample block size mismatch");
+
+/**
+ * @brief 合并后频点的谱累加值
+ */
+typedef struct
+{
+    float freq;
+    float srr, syy;      // 自谱
+    float sryRe, sryIm;  // 互谱 conj(R)·Y
+    float srdRe, srdIm;  // 互谱 conj(R)·D (D: 记录的期望角速度)
+    float sruRe, sruIm;  // 互谱 conj(R)·U
+} SysidBin;
+
+// ============ 内部状态 ============
+static bool isInit = false;
+static TaskHandle_t taskHandle = NULL;
+
+static bool busy = false;
+static SysidPhase phase = PHASE_IDLE;
+static bool abortRequested = false;
+static uint8_t reqClient = TRANSPORT_CLIENT_NONE;
+static SysidConfig config;
+static uint8_t abortReason = SYSID_REASON_NONE;
+
+static SysidSample *samples = NULL;
+static uint16_t sampleCount = 0;
+static uint16_t sampleIndex = 0; // 仅稳定器任务访问
+
+// ============ 内部函数 ============
+
+static void sendStatus(uint8_t client, uint8_t state, uint8_t reason, uint16_t count)
+{
+    SysidStatusPacket_t packet;
+    uint8_t frame[PKT_FRAME_LEN_SYSID_STATUS];
+
+    memset(&packet, 0, sizeof(packet));
+    packet.state = state;
+    packet.axis = config.axis;
+    packet.signal = config.signal;
+    packet.reason = reason;
+    packet.sample_rate_hz = SYSID_SAMPLE_RATE;
+    packet.sample_count = count;
+
+    uint16_t len = packet_encodeSysidStatus(frame, sizeof(frame), &packet);
+    dataSenderSendFrame(client, frame, len);
+}
+
+static int16_t saturate16(float value)
+{
+    if (value > INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    if (value < INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+    return (int16_t)lrintf(value);
+}
+
+/**
+ * @brief 第i个样本的激励值 (度/秒)
+ */
+static float excitation(uint16_t i)
+{
+    if (config.signal == SYSID_SIGNAL_STEP)
+    {
+        return (i >= sampleCount / 10 && i < sampleCount * 6 / 10) ? config.amplitude : 0.0f;
+    }
+
+    // 指数扫频: f(t) = f0 * k^(t/T), 相位为其积分
+    float duration = (float)sampleCount / SYSID_SAMPLE_RATE;
+    float lnk = logf(config.fEnd / config.fStart);
+    float t = (float)i / SYSID_SAMPLE_RATE;
+    float angle = 2.0f * (float)M_PI * config.fStart * duration / lnk * (expf(t / duration * lnk) - 1.0f);
+    return config.amplitude * sinf(angle);
+}
+
+static void setExcitation(float value)
+{
+    controllerPidSetRateExcitation(config.axis == 0 ? value : 0.0f, config.axis == 1 ? value : 0.0f,
+                                   config.axis == 2 ? value : 0.0f);
+}
+
+static void stopRun(SysidPhase next, uint8_t reason)
+{
+    setExcitation(0.0f);
+    abortReason = reason;
+    __atomic_store_n(&phase, next, __ATOMIC_RELEASE);
+    xTaskNotifyGive(taskHandle);
+}
+
+/**
+ * @brief Welch谱估计, 相邻FFT频点按扫频范围合并为最多SYSID_MAX_BINS个频点
+ *
+ * @return 频点数, 0表示内存不足或频率范围内没有频点
+ */
+static int estimateSpectra(SysidBin *bins)
+{
+    const int n = SYSID_FFT_SIZE;
+    const float df = (float)SYSID_SAMPLE_RATE / n;
+    xtensa_rfft_fast_instance_f32 fft;
+
+    int kLo = (int)ceilf(config.fStart / df);
+    int kHi = (int)floorf(config.fEnd / df);
+    kLo = kLo < 1 ? 1 : kLo;
+    kHi = kHi > n / 2 - 1 ? n / 2 - 1 : kHi;
+    if (kHi < kLo || xtensa_rfft_fast_init_f32(&fft, n) != XTENSA_MATH_SUCCESS)
+    {
+        return 0;
+    }
+
+    int group = (kHi - kLo + SYSID_MAX_BINS) / SYSID_MAX_BINS;
+    int binCount = (kHi - kLo) / group + 1;
+
+    // window | in | R | D | Y | U
+    float *work = malloc(6 * n * sizeof(float));
+    if (work == NULL)
+    {
+        return 0;
+    }
+    float *window = work;
+    float *in = work + n;
+    float *spectrum[4] = {work + 2 * n, work + 3 * n, work + 4 * n, work + 5 * n};
+
+    for (int i = 0; i < n; i++)
+    {
+        window[i] = 0.5f - 0.5f * cosf(2.0f * (float)M_PI * i / n);
+    }
+    memset(bins, 0, binCount * sizeof(SysidBin));
+    for (int k = kLo; k <= kHi; k++)
+    {
+        bins[(k - kLo) / group].freq += k * df;
+    }
+    for (int b = 0; b < binCount; b++)
+    {
+        int members = (b == binCount - 1) ? (kHi - kLo) - b * group + 1 : group;
+        bins[b].freq /= members;
+    }
+
+    for (int start = 0; start + n <= sampleCount; start += n / 2)
+    {
+        const SysidSample *seg = &samples[start];
+
+        // 0: 激励r, 1: 期望角速度d, 2: 陀螺仪y, 3: 输出u
+        for (int c = 0; c < 4; c++)
+        {
+            float mean = 0.0f;
+            for (int i = 0; i < n; i++)
+            {
+                in[i] = c == 0 ? excitation(start + i)
+                               : (c == 1 ? seg[i].rate : (c == 2 ? seg[i].gyro : seg[i].output));
+                mean += in[i];
+            }
+            mean /= n;
+            for (int i = 0; i < n; i++)
+            {
+                in[i] = (in[i] - mean) * window[i];
+            }
+            xtensa_rfft_fast_f32(&fft, in, spectrum[c], 0);
+        }
+
+        for (int k = kLo; k <= kHi; k++)
+        {
+            SysidBin *bin = &bins[(k - kLo) / group];
+            float rRe = spectrum[0][2 * k], rIm = spectrum[0][2 * k + 1];
+            float dRe = spectrum[1][2 * k], dIm = spectrum[1][2 * k + 1];
+            float yRe = spectrum[2][2 * k], yIm = spectrum[2][2 * k + 1];
+            float uRe = spectrum[3][2 * k], uIm = spectrum[3][2 * k + 1];
+
+            bin->srr += rRe * rRe + rIm * rIm;
+            bin->syy += yRe * yRe + yIm * yIm;
+            bin->sryRe += rRe * yRe + rIm * yIm;
+            bin->sryIm += rRe * yIm - rIm * yRe;
+            bin->srdRe += rRe * dRe + rIm * dIm;
+            bin->srdIm += rRe * dIm - rIm * dRe;
+            bin->sruRe += rRe * uRe + rIm * uIm;
+            bin->sruIm += rRe * uIm - rIm * uRe;
+        }
+    }
+
+    free(work);
+    return binCount;
+}
+
+static void reportFrequencyResponse(void)
+{
+    SysidBin *bins = malloc(SYSID_MAX_BINS * sizeof(SysidBin));
+    SysidFrfPacket_t packet;
+    uint8_t frame[PKT_FRAME_LEN_SYSID_FRF];
+
+    int binCount = bins ? estimateSpectra(bins) : 0;
+    for (int b = 0; b < binCount; b++)
+    {
+        const SysidBin *bin = &bins[b];
+        float sry = sqrtf(bin->sryRe * bin->sryRe + bin->sryIm * bin->sryIm);
+        float srd = sqrtf(bin->srdRe * bin->srdRe + bin->srdIm * bin->srdIm);
+        float sru = sqrtf(bin->sruRe * bin->sruRe + bin->sruIm * bin->sruIm);
+        float sryPhase = atan2f(bin->sryIm, bin->sryRe);
+        float closedPhase = sryPhase - atan2f(bin->srdIm, bin->srdRe);
+        float plantPhase = sryPhase - atan2f(bin->sruIm, bin->sruRe);
+
+        memset(&packet, 0, sizeof(packet));
+        packet.bin = b;
+        packet.bin_count = binCount;
+        packet.freq = bin->freq;
+        // 期望角速度与陀螺仪记录单位相同, 闭环增益无量纲
+        packet.closed_gain = srd > 0.0f ? sry / srd : 0.0f;
+        packet.closed_phase = degrees(atan2f(sinf(closedPhase), cosf(closedPhase)));
+        // 陀螺仪以0.1度/秒记录, 对象增益换算为 度/秒/单位输出
+        packet.plant_gain = sru > 0.0f ? sry / sru / SYSID_RATE_SCALE : 0.0f;
+        packet.plant_phase = degrees(atan2f(sinf(plantPhase), cosf(plantPhase)));
+        packet.coherence = bin->srr > 0.0f && bin->syy > 0.0f ? sry * sry / (bin->srr * bin->syy) : 0.0f;
+
+        uint16_t len = packet_encodeSysidFrf(frame, sizeof(frame), &packet);
+        dataSenderSendFrame(reqClient, frame, len);
+        vTaskDelay(M2T(SYSID_REPORT_INTERVAL_MS));
+    }
+
+    if (binCount == 0)
+    {
+        DEBUG_PRINTW("No frequency response (%u samples, %.1f-%.1fHz)", sampleCount,
+                     (double)config.fStart, (double)config.fEnd);
+    }
+    free(bins);
+}
+
+static void reportSamples(void)
+{
+    SysidSamplesPacket_t packet;
+    uint8_t frame[PKT_FRAME_LEN_SYSID_SAMPLES];
+
+    for (uint16_t i = 0; i < sampleCount; i += SYSID_SAMPLES_PER_PACKET)
+    {
+        uint16_t count = sampleCount - i;
+        if (count > SYSID_SAMPLES_PER_PACKET)
+        {
+            count = SYSID_SAMPLES_PER_PACKET;
+        }
+
+        memset(&packet, 0, sizeof(packet));
+        packet.index = i;
+        packet.count = count;
+        memcpy(packet.samples, &samples[i], count * sizeof(SysidSample));
+
+        uint16_t len = packet_encodeSysidSamples(frame, sizeof(frame), &packet);
+        dataSenderSendFrame(reqClient, frame, len);
+        vTaskDelay(M2T(SYSID_REPORT_INTERVAL_MS));
+    }
+}
+
+static void sysidTask(void *param)
+{
+    while (1)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        if (__atomic_load_n(&phase, __ATOMIC_ACQUIRE) == PHASE_ABORTED)
+        {
+            DEBUG_PRINTW("Identification aborted (reason %u)", abortReason);
+            sendStatus(reqClient, SYSID_STATE_ABORTED, abortReason, 0);
+        }
+        else
+        {
+            sendStatus(reqClient, SYSID_STATE_ANALYZING, SYSID_REASON_NONE, sampleCount);
+            if (config.signal == SYSID_SIGNAL_CHIRP)
+            {
+                reportFrequencyResponse();
+            }
+            reportSamples();
+            sendStatus(reqClient, SYSID_STATE_DONE, SYSID_REASON_NONE, sampleCount);
+            DEBUG_PRINTI("Identification done, %u samples", sampleCount);
+        }
+
+        free(samples);
+        samples = NULL;
+        __atomic_store_n(&phase, PHASE_IDLE, __ATOMIC_RELEASE);
+        __atomic_store_n(&busy, false, __ATOMIC_RELEASE);
+    }
+}
+
+static uint8_t checkConfig(const SysidConfig *cfg)
+{
+    if (cfg->axis > 2 || !(cfg->amplitude > 0.0f && cfg->amplitude <= SYSID_MAX_AMPLITUDE))
+    {
+        return SYSID_REASON_BAD_REQUEST;
+    }
+    if (cfg->signal == SYSID_SIGNAL_CHIRP &&
+        !(cfg->fStart > 0.0f && cfg->fEnd > cfg->fStart && cfg->fEnd <= SYSID_SAMPLE_RATE / 2))
+    {
+        return SYSID_REASON_BAD_REQUEST;
+    }
+    if (cfg->signal != SYSID_SIGNAL_STEP && cfg->signal != SYSID_SIGNAL_CHIRP)
+    {
+        return SYSID_REASON_BAD_REQUEST;
+    }
+    return zero_calib_is_done() ? SYSID_REASON_NONE : SYSID_REASON_NOT_READY;
+}
+
+// ============ 公共接口 ============
+
+void sysidInit(void)
+{
+    if (isInit)
+    {
+        return;
+    }
+
+    xTaskCreate(sysidTask, SYSID_TASK_NAME, SYSID_TASK_STACKSIZE, NULL, SYSID_TASK_PRI, &taskHandle);
+    isInit = true;
+}
+
+bool sysidTest(void)
+{
+    return isInit;
+}
+
+bool sysidRequest(uint8_t client, const SysidConfig *cfg)
+{
+    bool expected = false;
+
+    if (!isInit ||
+        !__atomic_compare_exchange_n(&busy, &expected, true, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        sendStatus(client, SYSID_STATE_REJECTED, SYSID_REASON_BUSY, 0);
+        return false;
+    }
+
+    config = *cfg;
+    uint8_t reason = checkConfig(cfg);
+
+    // 扫频至少需要一个完整的FFT分段
+    uint32_t count = (uint32_t)cfg->durationMs * SYSID_SAMPLE_RATE / 1000;
+    uint32_t minCount = cfg->signal == SYSID_SIGNAL_CHIRP ? SYSID_FFT_SIZE : SYSID_MIN_SAMPLES;
+    count = count < minCount ? minCount : (count > SYSID_MAX_SAMPLES ? SYSID_MAX_SAMPLES : count);
+
+    if (reason == SYSID_REASON_NONE)
+    {
+        samples = malloc(count * sizeof(SysidSample));
+        reason = samples ? SYSID_REASON_NONE : SYSID_REASON_NO_MEMORY;
+    }
+    if (reason != SYSID_REASON_NONE)
+    {
+        sendStatus(client, SYSID_STATE_REJECTED, reason, 0);
+        __atomic_store_n(&busy, false, __ATOMIC_RELEASE);
+        return false;
+    }
+
+    reqClient = client;
+    sampleCount = (uint16_t)count;
+    sampleIndex = 0;
+    __atomic_store_n(&abortRequested, false, __ATOMIC_RELAXED);
+    sendStatus(client, SYSID_STATE_RUNNING, SYSID_REASON_NONE, sampleCount);
+    DEBUG_PRINTI("Identification started: axis %u, signal %u, %u samples, %.0fdps", config.axis,
+                 config.signal, sampleCount, (double)config.amplitude);
+
+    __atomic_store_n(&phase, PHASE_RUN, __ATOMIC_RELEASE);
+    return true;
+}
+
+void sysidAbort(void)
+{
+    __atomic_store_n(&abortRequested, true, __ATOMIC_RELEASE);
+}
+
+void sysidStep(const sensorData_t *sensors, const state_t *state, const control_t *control, uint32_t tick)
+{
+    if (__atomic_load_n(&phase, __ATOMIC_ACQUIRE) != PHASE_RUN || !RATE_DO_EXECUTE(SYSID_SAMPLE_RATE, tick))
+    {
+        return;
+    }
+
+    if (__atomic_load_n(&abortRequested, __ATOMIC_ACQUIRE))
+    {
+        stopRun(PHASE_ABORTED, SYSID_REASON_USER);
+        return;
+    }
+    if (control->thrust == 0)
+    {
+        stopRun(PHASE_ABORTED, SYSID_REASON_NO_THRUST);
+        return;
+    }
+    if (fabsf(state->attitude.roll) > SYSID_MAX_TILT || fabsf(state->attitude.pitch) > SYSID_MAX_TILT)
+    {
+        stopRun(PHASE_ABORTED, SYSID_REASON_TILT);
+        return;
+    }
+
+    // 与角速度环使用相同的信号与符号 (见controllerPid)
+    attitude_t rate;
+    float gyro[3] = {sensors->gyro.x, -sensors->gyro.y, sensors->gyro.z};
+    int16_t output[3] = {control->roll, control->pitch, -control->yaw};
+    controllerPidGetRateDesired(&rate.roll, &rate.pitch, &rate.yaw);
+    float rates[3] = {rate.roll, rate.pitch, rate.yaw};
+
+    SysidSample *sample = &samples[sampleIndex];
+    sample->rate = saturate16(rates[config.axis] * SYSID_RATE_SCALE);
+    sample->gyro = saturate16(gyro[config.axis] * SYSID_RATE_SCALE);
+    sample->output = output[config.axis];
+
+    if (++sampleIndex >= sampleCount)
+    {
+        stopRun(PHASE_ANALYZE, SYSID_REASON_NONE);
+        return;
+    }
+    setExcitation(excitation(sampleIndex));
+}
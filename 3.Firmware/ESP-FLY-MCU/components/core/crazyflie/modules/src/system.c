@@ -14,11 +14,17 @@
 #include "system.h"
 #include "platform.h"
 #include "worker.h"
-#include "wifi_esp32.h"
+#include "transport.h"
 #include "data_sender.h"
 #include "protocol_dispatcher.h"
 #include "comm.h"
 #include "stabilizer.h"
+#include "sensors.h"
+#include "power_distribution.h"
+#include "boot_timeline.h"
+#include "kernel_bench.h"
+#include "sysid.h"
+#include "motor_lut.h"
 #include "commander.h"
 #include "stm32_legacy.h"
 #include "status_led.h"
@@ -27,6 +33,8 @@
 #include "static_mem.h"
 #include "cfassert.h"
 
+#define BOOT_STEP_TIMEOUT_MS 5000 // 并行启动步骤的最长等待时间
+
 #ifndef START_DISARMED
 #define ARM_INIT true
 #else
@@ -48,6 +56,9 @@ static StaticSemaphore_t canStartMutexBuffer;
 
 /* Private functions */
 static void systemTask(void *arg);
+static bool bootTransport(void);
+static bool bootSensors(void);
+static bool bootMotors(void);
 
 /* Public functions */
 void systemLaunch(void)
@@ -78,23 +89,37 @@ void systemTask(void *arg)
 {
   bool pass = true;
 
+  bootTimelineMark("system task");
+
   // ledInit(); // LED disabled
   // ledSet(CHG_LED, 1); // LED disabled
-  wifiInit();
-  dataSenderInit();
-  vTaskDelay(M2T(500));
   // Init the high-levels modules
   systemInit();
+
+  // WiFi bring-up, IMU settle and motor self test do not depend on each other:
+  // run them concurrently and wait for all of them before the stabilizer starts
+  bootStepStart("transport", bootTransport);
+  bootStepStart("imu", bootSensors);
+  powerDistributionInit();
+  motorLutInit();
+  bootStepStart("motors", bootMotors);
+
+  dataSenderInit();
   commInit();
   commanderInit();
   protocolDispatcherInit();
 
+  pass &= bootStepJoin(BOOT_STEP_TIMEOUT_MS);
+  DEBUG_PRINTI("bootSteps(%s) = %d ", transportName(), pass);
+  bootTimelineMark("boot steps joined");
+
+  // Sensors and motors are already initialized by the boot steps
   StateEstimatorType estimator = anyEstimator;
   stabilizerInit(estimator);
+  kernelBenchInit();
+  sysidInit();
 
   /* Test each modules */
-  pass &= wifiTest();
-  DEBUG_PRINTI("wifiTest = %d ", pass);
   pass &= commTest();
   DEBUG_PRINTI("commTest = %d ", pass);
   pass &= commanderTest();
@@ -109,6 +134,7 @@ void systemTask(void *arg)
   {
     selftestPassed = 1;
     systemStart();
+    bootTimelineMark("system start");
     DEBUG_PRINTI("systemStart ! selftestPassed = %d", selftestPassed);
     // System started, entering angle calibration phase
     statusLedSet(STATUS_LED_CALIBRATING); // Blue LED blinking - angle calibration in progress
@@ -127,6 +153,23 @@ void systemTask(void *arg)
     vTaskDelay(portMAX_DELAY);
 }
 
+static bool bootTransport(void)
+{
+  transportInit(TRANSPORT_DEFAULT);
+  return transportTest();
+}
+
+static bool bootSensors(void)
+{
+  sensorsInit();
+  return sensorsTest();
+}
+
+static bool bootMotors(void)
+{
+  return powerDistributionTest();
+}
+
 /* Global system variables */
 void systemStart()
 {
@@ -1,66 +1,266 @@
+/**
+ * worker.c - Prioritized deferred-work executor
+ *
+ * Slow or non-deterministic work (logging, variance loops, motor beeps, ...)
+ * is submitted from time critical tasks and executed later by an executor.
+ * The main executor is the system task running workerLoop(). On dual core
+ * targets one auxiliary executor is pinned to each core for jobs flagged
+ * WORKER_OTHER_CORE.
+ *
+ * Every executor owns one bounded queue per priority and a counting semaphore
+ * holding the number of queued items, so it sleeps until work arrives and then
+ * always picks the highest priority item first. Submission never blocks: a full
+ * queue rejects the job and counts it as dropped.
+ */
 #include "worker.h"
 
 #include <errno.h>
+#include <inttypes.h>
 
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
-#include "static_mem.h"
+#include "semphr.h"
+#include "sdkconfig.h"
 
-// #include "console.h" // Console removed
+#include "config.h"
+#include "usec_time.h"
+#include "stm32_legacy.h"
+#define DEBUG_MODULE "WORKER"
+#include "debug_cf.h"
 
-#define WORKER_QUEUE_LENGTH 5
+#define WORKER_QUEUE_LENGTH_HIGH 4
+#define WORKER_QUEUE_LENGTH_NORMAL 8
+#define WORKER_QUEUE_LENGTH_LOW 8
+#define WORKER_AUX_QUEUE_LENGTH 4
+
+#ifdef CONFIG_FREERTOS_UNICORE
+#define WORKER_AUX_EXECUTORS 0
+#else
+#define WORKER_AUX_EXECUTORS portNUM_PROCESSORS
+#endif
+
+#ifndef CONFIG_WORKER_STATS_INTERVAL
+#define CONFIG_WORKER_STATS_INTERVAL 0
+#endif
 
 struct worker_work
 {
   void (*function)(void *);
   void *arg;
+  workerJob_t *job;
+  uint32_t queuedUs;
 };
 
-static xQueueHandle workerQueue;
-STATIC_MEM_QUEUE_ALLOC(workerQueue, WORKER_QUEUE_LENGTH, sizeof(struct worker_work));
+typedef struct
+{
+  xQueueHandle queue[WORKER_PRIO_COUNT];
+  SemaphoreHandle_t pending; // number of items in all queues
+} workerExecutor_t;
+
+static bool isInit;
+static workerExecutor_t mainExecutor;
+#if WORKER_AUX_EXECUTORS > 0
+static workerExecutor_t auxExecutor[WORKER_AUX_EXECUTORS];
+#endif
+
+// Accounting for the plain workerSchedule() calls
+static workerJob_t scheduledJob = {.name = "workerSchedule", .priority = WORKER_PRIO_NORMAL};
+
+// scheduledJob is always the tail of the list, so a job is listed iff next != NULL
+static workerJob_t *jobList = &scheduledJob;
+// Guards jobList and the job statistics, which every executor and submitter updates
+static portMUX_TYPE jobLock = portMUX_INITIALIZER_UNLOCKED;
+
+static bool workerExecutorCreate(workerExecutor_t *exec, const int *lengths)
+{
+  int total = 0;
+
+  for (int p = 0; p < WORKER_PRIO_COUNT; p++)
+  {
+    exec->queue[p] = xQueueCreate(lengths[p], sizeof(struct worker_work));
+    if (!exec->queue[p])
+      return false;
+    total += lengths[p];
+  }
+
+  exec->pending = xSemaphoreCreateCounting(total, 0);
+  return exec->pending != NULL;
+}
+
+static void workerRunOne(workerExecutor_t *exec)
+{
+  struct worker_work work;
+  int p;
+
+  for (p = 0; p < WORKER_PRIO_COUNT; p++)
+  {
+    if (xQueueReceive(exec->queue[p], &work, 0) == pdTRUE)
+      break;
+  }
+  if (p == WORKER_PRIO_COUNT)
+    return;
+
+  uint32_t start = (uint32_t)usecTimestamp();
+  work.function(work.arg);
+  uint32_t end = (uint32_t)usecTimestamp();
+
+  workerJob_t *job = work.job;
+  uint32_t elapsed = end - start;
+  uint32_t latency = start - work.queuedUs;
+
+  portENTER_CRITICAL(&jobLock);
+  job->runs++;
+  job->totalUs += elapsed;
+  if (elapsed > job->maxUs)
+    job->maxUs = elapsed;
+  if (latency > job->maxLatencyUs)
+    job->maxLatencyUs = latency;
+  portEXIT_CRITICAL(&jobLock);
+}
+
+#if WORKER_AUX_EXECUTORS > 0
+static void workerAuxTask(void *param)
+{
+  workerExecutor_t *exec = (workerExecutor_t *)param;
+
+  while (1)
+  {
+    xSemaphoreTake(exec->pending, portMAX_DELAY);
+    workerRunOne(exec);
+  }
+}
+#endif
 
 void workerInit()
 {
-  if (workerQueue)
+  static const int mainLengths[WORKER_PRIO_COUNT] = {
+      WORKER_QUEUE_LENGTH_HIGH, WORKER_QUEUE_LENGTH_NORMAL, WORKER_QUEUE_LENGTH_LOW};
+
+  if (isInit)
+    return;
+
+  if (!workerExecutorCreate(&mainExecutor, mainLengths))
     return;
 
-  workerQueue = STATIC_MEM_QUEUE_CREATE(workerQueue);
-  // DEBUG_QUEUE_MONITOR_REGISTER(workerQueue); // Queue monitor disabled
+#if WORKER_AUX_EXECUTORS > 0
+  static const int auxLengths[WORKER_PRIO_COUNT] = {
+      WORKER_AUX_QUEUE_LENGTH, WORKER_AUX_QUEUE_LENGTH, WORKER_AUX_QUEUE_LENGTH};
+
+  for (int core = 0; core < WORKER_AUX_EXECUTORS; core++)
+  {
+    if (!workerExecutorCreate(&auxExecutor[core], auxLengths) ||
+        xTaskCreatePinnedToCore(workerAuxTask, WORKER_AUX_TASK_NAME, WORKER_AUX_TASK_STACKSIZE,
+                                &auxExecutor[core], WORKER_AUX_TASK_PRI, NULL, core) != pdPASS)
+    {
+      return;
+    }
+  }
+#endif
+
+  isInit = true;
 }
 
 bool workerTest()
 {
-  return (workerQueue != NULL);
+  return isInit;
 }
 
 void workerLoop()
 {
-  struct worker_work work;
+  TickType_t lastStats = xTaskGetTickCount();
 
-  if (!workerQueue)
+  if (!isInit)
     return;
 
   while (1)
   {
-    xQueueReceive(workerQueue, &work, portMAX_DELAY);
+#if CONFIG_WORKER_STATS_INTERVAL > 0
+    if (xSemaphoreTake(mainExecutor.pending, M2T(1000)) == pdTRUE)
+      workerRunOne(&mainExecutor);
 
-    if (work.function)
-      work.function(work.arg);
+    if (xTaskGetTickCount() - lastStats >= M2T(CONFIG_WORKER_STATS_INTERVAL * 1000))
+    {
+      lastStats = xTaskGetTickCount();
+      workerPrintStats();
+    }
+#else
+    (void)lastStats;
+    xSemaphoreTake(mainExecutor.pending, portMAX_DELAY);
+    workerRunOne(&mainExecutor);
+#endif
   }
 }
 
-int workerSchedule(void (*function)(void *), void *arg)
+static int workerEnqueue(workerJob_t *job, void (*function)(void *), void *arg)
 {
+  workerExecutor_t *exec = &mainExecutor;
   struct worker_work work;
 
-  if (!function)
-    return ENOEXEC;
+  if (!isInit)
+    return ENOMEM;
+
+  if (!job->next && job != &scheduledJob)
+  {
+    portENTER_CRITICAL(&jobLock);
+    if (!job->next)
+    {
+      job->next = jobList;
+      jobList = job;
+    }
+    portEXIT_CRITICAL(&jobLock);
+  }
+
+#if WORKER_AUX_EXECUTORS > 0
+  if (job->flags & WORKER_OTHER_CORE)
+    exec = &auxExecutor[(xPortGetCoreID() + 1) % WORKER_AUX_EXECUTORS];
+#endif
 
   work.function = function;
   work.arg = arg;
-  if (xQueueSend(workerQueue, &work, 0) == pdFALSE)
+  work.job = job;
+  work.queuedUs = (uint32_t)usecTimestamp();
+  if (xQueueSend(exec->queue[job->priority], &work, 0) == pdFALSE)
+  {
+    portENTER_CRITICAL(&jobLock);
+    job->dropped++;
+    portEXIT_CRITICAL(&jobLock);
     return ENOMEM;
+  }
+  xSemaphoreGive(exec->pending);
 
   return 0;
 }
+
+int workerSchedule(void (*function)(void *), void *arg)
+{
+  if (!function)
+    return ENOEXEC;
+
+  return workerEnqueue(&scheduledJob, function, arg);
+}
+
+int workerSubmit(workerJob_t *job, void *arg)
+{
+  if (!job || !job->function || job->priority >= WORKER_PRIO_COUNT)
+    return ENOEXEC;
+
+  return workerEnqueue(job, job->function, arg);
+}
+
+void workerPrintStats(void)
+{
+  for (workerJob_t *job = jobList; job; job = job->next)
+  {
+    // Snapshot under the lock so the counters of one line are consistent
+    portENTER_CRITICAL(&jobLock);
+    workerJob_t stats = *job;
+    portEXIT_CRITICAL(&jobLock);
+
+    uint32_t mean = stats.runs ? (uint32_t)(stats.totalUs / stats.runs) : 0;
+
+    DEBUG_PRINTI("%-20s runs %" PRIu32 " dropped %" PRIu32 " mean %" PRIu32 "us max %" PRIu32
+                 "us latency max %" PRIu32 "us",
+                 stats.name, stats.runs, stats.dropped, mean, stats.maxUs, stats.maxLatencyUs);
+  }
+}
@@ -18,13 +18,23 @@
  *
  * adc.c - Analog Digital Conversion
  *
- *
+ * The battery (and optional current sense) channels are sampled continuously
+ * by the ADC digital controller and moved to memory by DMA. adcTask averages
+ * each DMA frame per channel, converts it with the eFuse calibration and hands
+ * the result to the power management (pmBatteryUpdate) at ADC_BLOCK_RATE_HZ.
  */
 
-#include "esp_idf_version.h"
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "esp_log.h"
-#include "driver/adc.h"
-#include "esp_adc_cal.h"
+#include "esp_adc/adc_continuous.h"
+#include "esp_adc/adc_cali.h"
+#include "esp_adc/adc_cali_scheme.h"
+#if SOC_ADC_DIG_IIR_FILTER_SUPPORTED
+#include "esp_adc/adc_filter.h"
+#endif
 #include "adc_esp32.h"
 #include "config.h"
 #include "pm_esplane.h"
@@ -32,60 +42,153 @@
 #define DEBUG_MODULE "ADC"
 #include "debug_cf.h"
 
-static bool isInit;
-
-static esp_adc_cal_characteristics_t *adc_chars;
-#ifdef CONFIG_IDF_TARGET_ESP32
-static const adc_channel_t channel = ADC_CHANNEL_7; // GPIO35 if ADC1
-#elif defined(CONFIG_IDF_TARGET_ESP32S2) || defined(CONFIG_IDF_TARGET_ESP32S3)
-static const adc_channel_t channel = ADC_CHANNEL_1; // GPIO2 if ADC1
-#elif defined(CONFIG_IDF_TARGET_ESP32C3)
-static const adc_channel_t channel = ADC_CHANNEL_3; // GPIO3 if ADC1
+#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#define ADC_OUTPUT_TYPE ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ADC_GET_CHANNEL(p) ((p)->type1.channel)
+#define ADC_GET_DATA(p) ((p)->type1.data)
+#else
+#define ADC_OUTPUT_TYPE ADC_DIGI_OUTPUT_FORMAT_TYPE2
+#define ADC_GET_CHANNEL(p) ((p)->type2.channel)
+#define ADC_GET_DATA(p) ((p)->type2.data)
 #endif
 
-static const adc_bits_width_t width = ADC_WIDTH_MAX - 1;
-static const adc_atten_t atten = ADC_ATTEN_DB_11; // 11dB attenuation (ADC_ATTEN_DB_11) gives full-scale voltage 3.9V
+#define ADC_MAX_CHANNELS 2
+#define ADC_FRAME_BYTES ADC_FRAME_ALIGN(ADC_FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES)
+#define ADC_FRAME_ALIGN(x) \
+    (((x) + SOC_ADC_DIGI_DATA_BYTES_PER_CONV - 1) / SOC_ADC_DIGI_DATA_BYTES_PER_CONV * SOC_ADC_DIGI_DATA_BYTES_PER_CONV)
+
+static bool isInit;
+
+static const adc_atten_t atten = ADC_ATTEN_DB_12; // full-scale voltage ~3.1V after calibration
 static const adc_unit_t unit = ADC_UNIT_1;
-#define DEFAULT_VREF 1100 // Use adc2_vref_to_gpio() to obtain a better estimate
-#define NO_OF_SAMPLES 30  // Multisampling
 
-static void print_char_val_type(esp_adc_cal_value_t val_type)
+static adc_continuous_handle_t adcHandle;
+static adc_cali_handle_t adcCali;
+static bool adcCaliValid;
+
+typedef struct
+{
+    uint32_t pin;
+    adc_channel_t channel;
+    volatile float voltage; // latest frame average, V at the pin
+} AdcChannelState;
+
+static AdcChannelState channels[ADC_MAX_CHANNELS];
+static int channelCount;
+static uint8_t frame[ADC_FRAME_BYTES];
+
+static bool adcAddChannel(int pin)
 {
-    if (val_type == ESP_ADC_CAL_VAL_EFUSE_TP)
+    adc_unit_t pinUnit;
+    adc_channel_t channel;
+
+    if (pin < 0 || channelCount >= ADC_MAX_CHANNELS)
     {
-        printf("Characterized using Two Point Value\n");
+        return false;
     }
-    else if (val_type == ESP_ADC_CAL_VAL_EFUSE_VREF)
+    if (adc_continuous_io_to_channel(pin, &pinUnit, &channel) != ESP_OK || pinUnit != unit)
     {
-        printf("Characterized using eFuse Vref\n");
+        DEBUG_PRINTW("GPIO%d is not an ADC1 pin", pin);
+        return false;
     }
-    else
+
+    channels[channelCount].pin = pin;
+    channels[channelCount].channel = channel;
+    channels[channelCount].voltage = 0.0f;
+    channelCount++;
+    return true;
+}
+
+static void adcCalibrationInit(void)
+{
+    esp_err_t ret = ESP_FAIL;
+
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+    adc_cali_curve_fitting_config_t cali = {
+        .unit_id = unit,
+        .atten = atten,
+        .bitwidth = SOC_ADC_DIGI_MAX_BITWIDTH,
+    };
+    ret = adc_cali_create_scheme_curve_fitting(&cali, &adcCali);
+#elif ADC_CALI_SCHEME_LINE_FITTING_SUPPORTED
+    adc_cali_line_fitting_config_t cali = {
+        .unit_id = unit,
+        .atten = atten,
+        .bitwidth = SOC_ADC_DIGI_MAX_BITWIDTH,
+    };
+    ret = adc_cali_create_scheme_line_fitting(&cali, &adcCali);
+#endif
+
+    adcCaliValid = (ret == ESP_OK);
+    if (!adcCaliValid)
+    {
+        DEBUG_PRINTW("No eFuse calibration, using raw scale");
+    }
+}
+
+static float adcRawToVoltage(uint32_t raw)
+{
+    int mv;
+
+    if (adcCaliValid && adc_cali_raw_to_voltage(adcCali, raw, &mv) == ESP_OK)
     {
-        printf("Characterized using Default Vref\n");
+        return mv / 1000.0f;
     }
+    // Uncalibrated: nominal full scale of the 12dB attenuation
+    return raw * 3.1f / ((1 << SOC_ADC_DIGI_MAX_BITWIDTH) - 1);
 }
 
 float analogReadVoltage(uint32_t pin)
 {
-    uint32_t adc_reading = 0;
-    for (int i = 0; i < NO_OF_SAMPLES; i++)
+    for (int i = 0; i < channelCount; i++)
     {
-        if (unit == ADC_UNIT_1)
+        if (channels[i].pin == pin)
         {
-            adc_reading += adc1_get_raw((adc1_channel_t)channel);
+            return channels[i].voltage;
         }
-        else
+    }
+    return 0.0f;
+}
+
+void adcTask(void *param)
+{
+    uint32_t sum[ADC_MAX_CHANNELS];
+    uint32_t count[ADC_MAX_CHANNELS];
+    uint32_t length;
+
+    while (1)
+    {
+        if (adc_continuous_read(adcHandle, frame, sizeof(frame), &length, ADC_MAX_DELAY) != ESP_OK)
         {
-            int raw;
-            adc2_get_raw((adc2_channel_t)channel, width, &raw);
-            adc_reading += raw;
+            continue;
+        }
+
+        memset(sum, 0, sizeof(sum));
+        memset(count, 0, sizeof(count));
+        for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= length; i += SOC_ADC_DIGI_RESULT_BYTES)
+        {
+            const adc_digi_output_data_t *p = (const adc_digi_output_data_t *)&frame[i];
+            for (int c = 0; c < channelCount; c++)
+            {
+                if (ADC_GET_CHANNEL(p) == channels[c].channel)
+                {
+                    sum[c] += ADC_GET_DATA(p);
+                    count[c]++;
+                    break;
+                }
+            }
         }
-    }
-    adc_reading /= NO_OF_SAMPLES;
-    // Convert adc_reading to voltage in mV
-    uint32_t voltage = esp_adc_cal_raw_to_voltage(adc_reading, adc_chars);
 
-    return voltage / 1000.0;
+        for (int c = 0; c < channelCount; c++)
+        {
+            if (count[c])
+            {
+                channels[c].voltage = adcRawToVoltage(sum[c] / count[c]);
+            }
+        }
+
+        pmBatteryUpdate();
+    }
 }
 
 void adcInit(void)
@@ -95,21 +198,61 @@ void adcInit(void)
         return;
     }
 
-    if (unit == ADC_UNIT_1)
+    adcAddChannel(CONFIG_ADC1_PIN);
+    adcAddChannel(CONFIG_ADC1_CURRENT_PIN);
+    if (channelCount == 0)
+    {
+        DEBUG_PRINTE("No ADC channel configured");
+        return;
+    }
+
+    adc_continuous_handle_cfg_t handleConfig = {
+        .max_store_buf_size = 4 * ADC_FRAME_BYTES,
+        .conv_frame_size = ADC_FRAME_BYTES,
+    };
+    ESP_ERROR_CHECK(adc_continuous_new_handle(&handleConfig, &adcHandle));
+
+    adc_digi_pattern_config_t pattern[ADC_MAX_CHANNELS] = {0};
+    for (int i = 0; i < channelCount; i++)
     {
-        adc1_config_width(width);
-        adc1_config_channel_atten(channel, atten);
+        pattern[i].atten = atten;
+        pattern[i].channel = channels[i].channel;
+        pattern[i].unit = unit;
+        pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
     }
-    else
+
+    adc_continuous_config_t config = {
+        .pattern_num = channelCount,
+        .adc_pattern = pattern,
+        .sample_freq_hz = ADC_SAMPLE_FREQ_HZ,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = ADC_OUTPUT_TYPE,
+    };
+    ESP_ERROR_CHECK(adc_continuous_config(adcHandle, &config));
+
+#if SOC_ADC_DIG_IIR_FILTER_SUPPORTED
+    // Hardware averaging on top of the per-frame mean
+    for (int i = 0; i < channelCount && i < SOC_ADC_DIGI_IIR_FILTER_NUM; i++)
     {
-        adc2_config_channel_atten((adc2_channel_t)channel, atten);
+        adc_iir_filter_handle_t filter;
+        adc_continuous_iir_filter_config_t filterConfig = {
+            .unit = unit,
+            .channel = channels[i].channel,
+            .coeff = ADC_DIGI_IIR_FILTER_COEFF_16,
+        };
+        if (adc_new_continuous_iir_filter(adcHandle, &filterConfig, &filter) == ESP_OK)
+        {
+            adc_continuous_iir_filter_enable(filter);
+        }
     }
+#endif
 
-    // Characterize ADC
-    adc_chars = calloc(1, sizeof(esp_adc_cal_characteristics_t));
-    esp_adc_cal_value_t val_type = esp_adc_cal_characterize(unit, atten, width, DEFAULT_VREF, adc_chars);
-    print_char_val_type(val_type);
+    adcCalibrationInit();
+    ESP_ERROR_CHECK(adc_continuous_start(adcHandle));
+    xTaskCreate(adcTask, ADC_TASK_NAME, ADC_TASK_STACKSIZE, NULL, ADC_TASK_PRI, NULL);
 
+    DEBUG_PRINTI("DMA sampling %d channel(s) at %d Hz, %d samples per frame",
+                 channelCount, ADC_SAMPLE_FREQ_HZ, ADC_FRAME_SAMPLES);
     isInit = true;
 }
 
@@ -26,8 +26,25 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 
+#include "soc/soc_caps.h"
+
 #include "config.h"
 
+/******** Sampling ********/
+
+// The ESP32 digital controller cannot run continuous conversions below
+// SOC_ADC_SAMPLE_FREQ_THRES_LOW (20kHz); later targets go down to ~600Hz.
+#define ADC_WANTED_SAMPLE_FREQ_HZ 5000
+#if SOC_ADC_SAMPLE_FREQ_THRES_LOW > ADC_WANTED_SAMPLE_FREQ_HZ
+#define ADC_SAMPLE_FREQ_HZ SOC_ADC_SAMPLE_FREQ_THRES_LOW
+#else
+#define ADC_SAMPLE_FREQ_HZ ADC_WANTED_SAMPLE_FREQ_HZ
+#endif
+
+// Rate at which averaged frames are handed to the power management
+#define ADC_BLOCK_RATE_HZ 200
+#define ADC_FRAME_SAMPLES (ADC_SAMPLE_FREQ_HZ / ADC_BLOCK_RATE_HZ)
+
 /******** Types ********/
 
 typedef struct __attribute__((packed)){
@@ -47,7 +64,8 @@ typedef struct {
 /*** Public interface ***/
 
 /**
- * Initialize analog to digital converter. Configures gyro and vref channels.
+ * Initialize analog to digital converter. Starts continuous DMA sampling of the
+ * battery voltage (and current sense, if configured) channels.
  */
 void adcInit(void);
 
@@ -78,10 +96,14 @@ void adcDmaStop(void);
 void adcInterruptHandler(void);
 
 /**
- * ADC task
+ * ADC task, averages each DMA frame and calls pmBatteryUpdate()
  */
 void adcTask(void *param);
 
+/**
+ * Latest frame-averaged voltage at an ADC pin in V (non-blocking).
+ * Returns 0 for pins that are not sampled.
+ */
 float analogReadVoltage(uint32_t pin);  //should in deck_analog.c
 
 #endif /* ADC_H_ */
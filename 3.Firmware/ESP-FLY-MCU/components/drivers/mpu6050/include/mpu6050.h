@@ -671,6 +671,7 @@ void mpu6050ResetSensors();
 
 // PWR_MGMT_1 register
 void mpu6050Reset();
+bool mpu6050GetDeviceReset();
 bool mpu6050GetSleepEnabled();
 void mpu6050SetSleepEnabled(bool enabled);
 bool mpu6050GetWakeCycleEnabled();
@@ -2865,6 +2865,21 @@ void mpu6050Reset()
 {
     i2cdevWriteBit(I2Cx, devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_DEVICE_RESET_BIT, 1);
 }
+/** Get device reset status.
+ * The DEVICE_RESET bit clears itself once the internal registers are back to
+ * their default values, so it can be polled instead of a fixed delay.
+ * @return True while the reset is in progress or the device does not answer
+ * @see MPU6050_RA_PWR_MGMT_1
+ * @see MPU6050_PWR1_DEVICE_RESET_BIT
+ */
+bool mpu6050GetDeviceReset()
+{
+    if (!i2cdevReadBit(I2Cx, devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_DEVICE_RESET_BIT, buffer))
+    {
+        return true;
+    }
+    return buffer[0];
+}
 /** Get sleep mode status.
  * Setting the SLEEP bit in the register puts the device into very low power
  * sleep mode. In this mode, only the serial interface and internal registers
@@ -5,10 +5,17 @@
 
 #define WIFI_RX_TX_PACKET_SIZE   (128)  // 128字节以支持当前协议最大负载
 
+#define WIFI_MAX_CLIENTS         (4)    // 客户端注册表容量 (单播遥测)
+#define WIFI_CLIENT_NONE         (0xFF) // 发送方未登记 (注册表已满或非IPv4)
+#define WIFI_CLIENT_NEW          (0x80) // 与客户端索引或运算: 该客户端刚刚登记
+#define WIFI_DEST_BROADCAST      (0x80) // 目标掩码: 广播 (仅用于发现)
+
 /* Structure used for in/out data via USB */
 typedef struct
 {
   uint8_t size;
+  uint8_t client; // RX: 发送方客户端索引 (可能带WIFI_CLIENT_NEW), TX: 未使用
+  uint8_t dest;   // TX: 目标客户端位掩码或WIFI_DEST_BROADCAST, RX: 未使用
   uint8_t data[WIFI_RX_TX_PACKET_SIZE];
 } UDPPacket;
 
@@ -19,6 +26,13 @@ typedef struct
  */
 void wifiInit(void);
 
+/**
+ * Bring up only the WiFi driver, the softAP netif and the radio channel,
+ * without the UDP socket and its RX/TX tasks (used by the ESP-NOW transport).
+ * wifiInit() calls it as its first step.
+ */
+void wifiRadioInit(void);
+
 /**
  * Test the WIFI status.
  *
@@ -41,6 +55,15 @@ bool wifiTest(void);
  */
 bool wifiGetDataBlocking(UDPPacket *in);
 
+/**
+ * Get data from rx queue with timeout.
+ * @param[out] in  Received packet
+ * @param[in] timeoutMs  Timeout in milliseconds
+ *
+ * @return true if a packet was received, false if timeout reached.
+ */
+bool wifiGetData(UDPPacket *in, uint32_t timeoutMs);
+
 /**
  * Sends raw data using a lock. Should be used from
  * exception functions and for debugging when a lot of data
@@ -52,4 +75,30 @@ bool wifiGetDataBlocking(UDPPacket *in);
  */
 bool wifiSendData(uint32_t size, uint8_t* data);
 
+/**
+ * Send data to a set of registered clients (unicast) or broadcast.
+ * @param[in] dest  Client bit mask, or WIFI_DEST_BROADCAST
+ * @param[in] size  Number of bytes to send
+ * @param[in] data  Pointer to data
+ *
+ * @return true if the packet was queued
+ */
+bool wifiSendDataTo(uint8_t dest, uint32_t size, uint8_t* data);
+
+/**
+ * Get the mask of registered clients. Any packet received from a client
+ * refreshes it; clients silent for more than 3 s are dropped here.
+ *
+ * @return Bit mask of active clients, 0 if none
+ */
+uint8_t wifiGetClientMask(void);
+
+/**
+ * Get the RSSI the softAP measures for a registered client's station.
+ * @param[in] client  Client index
+ *
+ * @return RSSI in dBm, 0 if unknown
+ */
+int8_t wifiGetClientRssi(uint8_t client);
+
 #endif
\ No newline at end of file
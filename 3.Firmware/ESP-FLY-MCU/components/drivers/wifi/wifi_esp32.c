@@ -4,9 +4,11 @@
 #include "config.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 
 #include "esp_system.h"
 #include "esp_wifi.h"
+#include "esp_netif_sta_list.h"
 #include "esp_event.h"
 #include "esp_netif.h"
 #include "lwip/err.h"
@@ -19,8 +21,9 @@
 #include "debug_cf.h"
 
 #define UDP_SERVER_PORT 2390      // 接收 APP 命令的端口
-#define UDP_BROADCAST_PORT 2399   // 广播飞行数据的目标端口
+#define UDP_BROADCAST_PORT 2399   // 客户端接收飞行数据的端口 (单播与广播共用)
 #define UDP_SERVER_BUFSIZE 128
+#define WIFI_CLIENT_TIMEOUT_MS 3000 // 客户端保活超时
 
 static struct sockaddr_in6 source_addr; // Large enough for both IPv4 or IPv6
 
@@ -49,8 +52,23 @@ static UDPPacket inPacket;
 static UDPPacket outPacket;
 
 static bool isInit = false;
+static bool isRadioInit = false;
 static bool isUDPInit = false;
 
+/**
+ * 客户端注册表: 由接收到的数据包源地址登记, 遥测按注册表单播
+ * 以IP区分客户端, 发往其UDP_BROADCAST_PORT端口, 与原广播接收方式兼容
+ */
+typedef struct
+{
+    bool active;
+    struct sockaddr_in addr;
+    TickType_t lastSeen;
+} WifiClient;
+
+static WifiClient clients[WIFI_MAX_CLIENTS];
+static SemaphoreHandle_t clientMutex;
+
 static esp_err_t udp_server_create(void *arg);
 
 static void wifi_event_handler(void *arg, esp_event_base_t event_base,
@@ -84,15 +102,153 @@ bool wifiGetDataBlocking(UDPPacket *in)
     return true;
 };
 
+bool wifiGetData(UDPPacket *in, uint32_t timeoutMs)
+{
+    return (xQueueReceive(udpDataRx, in, M2T(timeoutMs)) == pdTRUE);
+}
+
 bool wifiSendData(uint32_t size, uint8_t *data)
 {
-    static UDPPacket outStage;
+    // 有登记的客户端时单播给全部客户端, 否则广播
+    uint8_t dest = wifiGetClientMask();
+    return wifiSendDataTo(dest ? dest : WIFI_DEST_BROADCAST, size, data);
+};
+
+bool wifiSendDataTo(uint8_t dest, uint32_t size, uint8_t *data)
+{
+    UDPPacket outStage;
+    if (dest == 0 || size > WIFI_RX_TX_PACKET_SIZE)
+    {
+        return false;
+    }
     outStage.size = size;
+    outStage.dest = dest;
     memcpy(outStage.data, data, size);
     // 不阻塞发送，如果队列满则直接丢弃（避免影响飞控主循环）
     return (xQueueSend(udpDataTx, &outStage, 0) == pdTRUE);
 };
 
+/**
+ * 登记/刷新发送方, 返回客户端索引 (新登记时带WIFI_CLIENT_NEW)
+ */
+static uint8_t clientTouch(const struct sockaddr_in6 *from)
+{
+    if (from->sin6_family != AF_INET)
+    {
+        return WIFI_CLIENT_NONE;
+    }
+
+    const struct sockaddr_in *from4 = (const struct sockaddr_in *)from;
+    TickType_t now = xTaskGetTickCount();
+    uint8_t result = WIFI_CLIENT_NONE;
+    int freeSlot = -1;
+
+    xSemaphoreTake(clientMutex, portMAX_DELAY);
+    for (int i = 0; i < WIFI_MAX_CLIENTS; i++)
+    {
+        if (clients[i].active && now - clients[i].lastSeen > M2T(WIFI_CLIENT_TIMEOUT_MS))
+        {
+            clients[i].active = false;
+        }
+
+        if (clients[i].active && clients[i].addr.sin_addr.s_addr == from4->sin_addr.s_addr)
+        {
+            clients[i].lastSeen = now;
+            result = i;
+            break;
+        }
+
+        if (!clients[i].active && freeSlot < 0)
+        {
+            freeSlot = i;
+        }
+    }
+
+    if (result == WIFI_CLIENT_NONE && freeSlot >= 0)
+    {
+        clients[freeSlot].active = true;
+        clients[freeSlot].lastSeen = now;
+        clients[freeSlot].addr.sin_family = AF_INET;
+        clients[freeSlot].addr.sin_port = htons(UDP_BROADCAST_PORT);
+        clients[freeSlot].addr.sin_addr.s_addr = from4->sin_addr.s_addr;
+        result = freeSlot | WIFI_CLIENT_NEW;
+    }
+    xSemaphoreGive(clientMutex);
+
+    if (result & WIFI_CLIENT_NEW)
+    {
+        DEBUG_PRINT_LOCAL("Client %d registered: %s", freeSlot, inet_ntoa(from4->sin_addr));
+    }
+    return result;
+}
+
+uint8_t wifiGetClientMask(void)
+{
+    TickType_t now = xTaskGetTickCount();
+    uint8_t mask = 0;
+
+    xSemaphoreTake(clientMutex, portMAX_DELAY);
+    for (int i = 0; i < WIFI_MAX_CLIENTS; i++)
+    {
+        if (!clients[i].active)
+        {
+            continue;
+        }
+
+        if (now - clients[i].lastSeen > M2T(WIFI_CLIENT_TIMEOUT_MS))
+        {
+            clients[i].active = false;
+            DEBUG_PRINT_LOCAL("Client %d expired", i);
+            continue;
+        }
+        mask |= (1 << i);
+    }
+    xSemaphoreGive(clientMutex);
+
+    return mask;
+}
+
+int8_t wifiGetClientRssi(uint8_t client)
+{
+    if (client >= WIFI_MAX_CLIENTS)
+    {
+        return 0;
+    }
+
+    xSemaphoreTake(clientMutex, portMAX_DELAY);
+    bool active = clients[client].active;
+    uint32_t ip = clients[client].addr.sin_addr.s_addr;
+    xSemaphoreGive(clientMutex);
+
+    wifi_sta_list_t staList;
+    esp_netif_sta_list_t ipList;
+    if (!active ||
+        esp_wifi_ap_get_sta_list(&staList) != ESP_OK ||
+        esp_netif_get_sta_list(&staList, &ipList) != ESP_OK)
+    {
+        return 0;
+    }
+
+    // 按IP找到客户端所在的station, 再按MAC取softAP测得的RSSI
+    for (int i = 0; i < ipList.num; i++)
+    {
+        if (ipList.sta[i].ip.addr != ip)
+        {
+            continue;
+        }
+
+        for (int j = 0; j < staList.num; j++)
+        {
+            if (memcmp(staList.sta[j].mac, ipList.sta[i].mac, sizeof(staList.sta[j].mac)) == 0)
+            {
+                return staList.sta[j].rssi;
+            }
+        }
+    }
+
+    return 0;
+}
+
 static esp_err_t udp_server_create(void *arg)
 {
     if (isUDPInit)
@@ -171,11 +327,30 @@ static void udp_server_rx_task(void *pvParameters)
             // 仅接收原始数据并放入队列，由协议层处理
             memcpy(inPacket.data, rx_buffer, len);
             inPacket.size = len;
+            inPacket.client = clientTouch(&source_addr);
             xQueueSend(udpDataRx, &inPacket, M2T(2));
         }
     }
 }
 
+static void udpSendTo(const struct sockaddr_in *addr, int size)
+{
+    int err = sendto(sock, tx_buffer, size, 0, (const struct sockaddr *)addr, sizeof(*addr));
+    if (err < 0)
+    {
+        // errno 12 = ENOMEM (内存不足/缓冲区满)
+        if (errno == 12)
+        {
+            // UDP 发送缓冲区满，延时等待缓冲区释放
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+        else
+        {
+            DEBUG_PRINT_LOCAL("Error occurred during sending: errno %d", errno);
+        }
+    }
+}
+
 static void udp_server_tx_task(void *pvParameters)
 {
 
@@ -192,29 +367,39 @@ static void udp_server_tx_task(void *pvParameters)
             // 新协议的数据包已经包含校验和，直接发送
             memcpy(tx_buffer, outPacket.data, outPacket.size);
 
-            // 使用广播地址发送数据，所有客户端都能收到
-            int err = sendto(sock, tx_buffer, outPacket.size, 0, (struct sockaddr *)&broadcast_addr, sizeof(broadcast_addr));
-            if (err < 0)
+            if (outPacket.dest & WIFI_DEST_BROADCAST)
             {
-                // errno 12 = ENOMEM (内存不足/缓冲区满)
-                if (errno == 12)
+                // 无订阅客户端时广播，便于客户端发现飞机
+                udpSendTo(&broadcast_addr, outPacket.size);
+                continue;
+            }
+
+            // 单播给每个目标客户端 (链路层有重传, 速率不受限于最低基本速率)
+            for (int i = 0; i < WIFI_MAX_CLIENTS; i++)
+            {
+                if (!(outPacket.dest & (1 << i)))
                 {
-                    // UDP 发送缓冲区满，延时等待缓冲区释放
-                    vTaskDelay(pdMS_TO_TICKS(10));
+                    continue;
                 }
-                else
+
+                struct sockaddr_in addr;
+                xSemaphoreTake(clientMutex, portMAX_DELAY);
+                bool active = clients[i].active;
+                addr = clients[i].addr;
+                xSemaphoreGive(clientMutex);
+
+                if (active)
                 {
-                    DEBUG_PRINT_LOCAL("Error occurred during sending: errno %d", errno);
+                    udpSendTo(&addr, outPacket.size);
                 }
-                continue;
             }
         }
     }
 }
 
-void wifiInit(void)
+void wifiRadioInit(void)
 {
-    if (isInit)
+    if (isRadioInit)
     {
         return;
     }
@@ -268,6 +453,19 @@ void wifiInit(void)
     ESP_ERROR_CHECK(esp_netif_dhcps_start(ap_netif));
 
     DEBUG_PRINT_LOCAL("wifi_init_softap complete.SSID:%s password:%s", WIFI_SSID, WIFI_PWD);
+    isRadioInit = true;
+}
+
+void wifiInit(void)
+{
+    if (isInit)
+    {
+        return;
+    }
+
+    wifiRadioInit();
+
+    clientMutex = xSemaphoreCreateMutex();
 
     // This should probably be reduced to a CRTP packet size
     udpDataRx = xQueueCreate(5, sizeof(UDPPacket)); /* Buffer packets (max 64 bytes) */
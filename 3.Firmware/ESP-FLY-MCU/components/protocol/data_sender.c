@@ -4,31 +4,258 @@
 
 #include "data_sender.h"
 #include "packet_codec.h"
-#include "wifi_esp32.h"
-#include "stabilizer_types.h"
-#include "controller_pid.h"
-#include "motors.h"
+#include "transport.h"
+#include "state_snapshot.h"
 #include "pm_esplane.h"
 #include "stm32_legacy.h"
 #include "pid.h"
+#include "boot_timeline.h"
 
 #define DEBUG_MODULE "DATA_SEND"
 #include "debug_cf.h"
 
-// 引用 stabilizer.c 中的全局变量
-extern sensorData_t sensorData;
-extern state_t state;
-extern control_t control;
-
 static bool isInit = false;
 
+// ============================================================================
+// 客户端状态、协议版本协商与批量发送
+// ============================================================================
+
+#define PROTOCOL_V2_TIMEOUT M2T(3000) // 超过该时间未收到对端v2数据报则回退到v1
+#define HF_RATE_HZ 50                 // 高频数据任务频率
+
+/**
+ * 每个已登记客户端的发送状态 (索引与传输层客户端注册表一致)
+ */
+typedef struct
+{
+    TickType_t lastV2RxTick; // 最近一次收到该客户端v2数据报的时间
+    uint32_t txSeq;          // v2数据报序号 (每个客户端独立, 降速订阅不会被误判为丢包)
+    uint8_t hfDivider;       // 高频数据分频, 0/1=全速
+    int8_t bootReportLine;   // 下一行待发送的启动时间线, -1=已发送完毕
+} ClientState;
+
+static ClientState clientState[TRANSPORT_MAX_CLIENTS];
+static uint32_t v2ClientMask = 0; // 已协商v2的客户端
+
+/**
+ * 批量发送: v1下每帧单独发送, v2下多帧合并为一个数据报
+ */
+typedef struct
+{
+    uint8_t version;
+    uint8_t dest;   // 目标客户端掩码或TRANSPORT_DEST_BROADCAST
+    uint8_t client; // v2时的目标客户端索引
+    PacketDatagram_t dg;
+    uint8_t buffer[TRANSPORT_MTU];
+} TxBatch;
+
 /**
- * 发送PID参数响应包 (1Hz)
+ * 获取已协商v2的客户端, 超时未收到v2数据报的客户端回退到v1
+ */
+static uint8_t v2Clients(void)
+{
+    uint32_t mask = __atomic_load_n(&v2ClientMask, __ATOMIC_RELAXED);
+    TickType_t now = xTaskGetTickCount();
+
+    for (int i = 0; i < TRANSPORT_MAX_CLIENTS; i++)
+    {
+        if ((mask & (1 << i)) && now - clientState[i].lastV2RxTick > PROTOCOL_V2_TIMEOUT)
+        {
+            __atomic_fetch_and(&v2ClientMask, ~(1u << i), __ATOMIC_RELAXED);
+            mask &= ~(1u << i);
+            DEBUG_PRINT("Client %d protocol v2 timeout, fallback to v1\n", i);
+        }
+    }
+    return (uint8_t)mask;
+}
+
+static void txBatchBegin(TxBatch *batch, uint8_t dest, uint8_t version)
+{
+    batch->version = version;
+    batch->dest = dest;
+    batch->client = 0;
+    if (version >= PACKET_V2_VERSION)
+    {
+        while (!(dest & (1 << batch->client)))
+        {
+            batch->client++;
+        }
+    }
+    packet_datagramBegin(&batch->dg, batch->buffer, sizeof(batch->buffer));
+}
+
+static void txBatchFlush(TxBatch *batch)
+{
+    uint16_t seq = (uint16_t)__atomic_fetch_add(&clientState[batch->client].txSeq, 1, __ATOMIC_RELAXED);
+    uint16_t len = packet_datagramFinish(&batch->dg, seq, T2M(xTaskGetTickCount()));
+    if (len > 0)
+    {
+        transportSendTo(batch->dest, batch->buffer, len);
+    }
+    packet_datagramBegin(&batch->dg, batch->buffer, sizeof(batch->buffer));
+}
+
+static void txBatchAdd(TxBatch *batch, const uint8_t *frame, uint16_t len)
+{
+    if (len == 0)
+    {
+        return;
+    }
+
+    if (batch->version < PACKET_V2_VERSION)
+    {
+        transportSendTo(batch->dest, frame, len);
+        return;
+    }
+
+    uint16_t space;
+    uint8_t *tail = packet_datagramTail(&batch->dg, &space);
+    if (len > space)
+    {
+        // 放不下则先发出已合并的帧
+        txBatchFlush(batch);
+        tail = packet_datagramTail(&batch->dg, &space);
+    }
+
+    if (len <= space)
+    {
+        memcpy(tail, frame, len);
+        packet_datagramCommit(&batch->dg, len);
+    }
+}
+
+static void txBatchEnd(TxBatch *batch)
+{
+    if (batch->version >= PACKET_V2_VERSION)
+    {
+        txBatchFlush(batch);
+    }
+}
+
+/**
+ * 按各目标客户端的协议版本发送一组帧
+ * v1客户端(及广播)共用一份数据, v2客户端各自封装数据报
+ */
+static void sendFrames(uint8_t dest, const uint8_t *const frames[], const uint16_t lens[], uint8_t count)
+{
+    TxBatch batch;
+    uint8_t v2 = (dest & TRANSPORT_DEST_BROADCAST) ? 0 : (dest & v2Clients());
+    uint8_t v1 = dest & ~v2;
+
+    if (v1)
+    {
+        txBatchBegin(&batch, v1, 1);
+        for (uint8_t n = 0; n < count; n++)
+        {
+            txBatchAdd(&batch, frames[n], lens[n]);
+        }
+        txBatchEnd(&batch);
+    }
+
+    for (int i = 0; i < TRANSPORT_MAX_CLIENTS; i++)
+    {
+        if (!(v2 & (1 << i)))
+        {
+            continue;
+        }
+
+        txBatchBegin(&batch, 1 << i, PACKET_V2_VERSION);
+        for (uint8_t n = 0; n < count; n++)
+        {
+            txBatchAdd(&batch, frames[n], lens[n]);
+        }
+        txBatchEnd(&batch);
+    }
+}
+
+/**
+ * 计算本周期高频数据的目标客户端
+ */
+static uint8_t hfDestination(uint32_t tick)
+{
+    uint8_t active = transportGetClientMask();
+    if (active == 0)
+    {
+        // 无订阅客户端: 广播, 便于客户端发现飞机
+        return TRANSPORT_DEST_BROADCAST;
+    }
+
+    uint8_t dest = 0;
+    for (int i = 0; i < TRANSPORT_MAX_CLIENTS; i++)
+    {
+        uint8_t divider = clientState[i].hfDivider;
+        if ((active & (1 << i)) && (divider <= 1 || tick % divider == 0))
+        {
+            dest |= (1 << i);
+        }
+    }
+    return dest;
+}
+
+void dataSenderOnPeerDatagram(uint8_t client, uint8_t version)
+{
+    if (client >= TRANSPORT_MAX_CLIENTS || version < PACKET_V2_VERSION)
+    {
+        return;
+    }
+
+    clientState[client].lastV2RxTick = xTaskGetTickCount();
+    uint32_t prev = __atomic_fetch_or(&v2ClientMask, 1u << client, __ATOMIC_RELAXED);
+    if (!(prev & (1u << client)))
+    {
+        DEBUG_PRINT("Client %d protocol v2 negotiated\n", client);
+    }
+}
+
+uint8_t dataSenderGetProtocolVersion(uint8_t client)
+{
+    if (client < TRANSPORT_MAX_CLIENTS && (__atomic_load_n(&v2ClientMask, __ATOMIC_RELAXED) & (1u << client)))
+    {
+        return PACKET_V2_VERSION;
+    }
+    return 1;
+}
+
+void dataSenderResetClient(uint8_t client)
+{
+    if (client >= TRANSPORT_MAX_CLIENTS)
+    {
+        return;
+    }
+
+    __atomic_fetch_and(&v2ClientMask, ~(1u << client), __ATOMIC_RELAXED);
+    clientState[client].hfDivider = 1;
+    clientState[client].bootReportLine = 0;
+}
+
+void dataSenderSetClientRate(uint8_t client, uint8_t hfRateHz)
+{
+    if (client >= TRANSPORT_MAX_CLIENTS)
+    {
+        return;
+    }
+
+    uint8_t divider = 1;
+    if (hfRateHz > 0 && hfRateHz < HF_RATE_HZ)
+    {
+        divider = HF_RATE_HZ / hfRateHz;
+    }
+    clientState[client].hfDivider = divider;
+    DEBUG_PRINT("Client %d subscribed, HF rate %dHz\n", client, HF_RATE_HZ / divider);
+}
+
+void dataSenderSendFrame(uint8_t client, const uint8_t *frame, uint16_t len)
+{
+    uint8_t dest = (client < TRANSPORT_MAX_CLIENTS) ? (1 << client) : TRANSPORT_DEST_BROADCAST;
+    sendFrames(dest, &frame, &len, 1);
+}
+
+/**
+ * 构建PID参数响应包 (1Hz)
  * 一次性发送所有6组PID参数（姿态环和速度环）
  */
-static void sendPIDInfo(void)
+static uint16_t buildPIDInfo(uint8_t *sendBuffer, uint16_t bufferSize)
 {
-    static uint8_t sendBuffer[128];
 
     // 引用attitude_pid_controller.c中的全局PID对象
     extern PidObject pidRollRate;
@@ -66,12 +293,39 @@ static void sendPIDInfo(void)
     pid_data.yaw_rate_ki = pidYawRate.ki;
     pid_data.yaw_rate_kd = pidYawRate.kd;
 
-    // 创建并发送PID响应包
-    uint16_t packet_len = packet_createPIDResponse(sendBuffer, sizeof(sendBuffer), &pid_data);
+    // 创建PID响应包
+    return packet_createPIDResponse(sendBuffer, bufferSize, &pid_data);
+}
+
+/**
+ * 向新登记的客户端发送启动时间线 (控制台日志)
+ * 每个周期每个客户端只发一行, 避免占满发送队列; 启动未完成时等待后续条目
+ */
+static void sendBootReport(void)
+{
+    uint8_t active = transportGetClientMask();
+    char line[BOOT_LINE_MAX];
+    PacketFrame_t packet;
+    uint8_t buffer[PACKET_MAX_SIZE];
 
-    if (packet_len > 0)
+    for (int i = 0; i < TRANSPORT_MAX_CLIENTS; i++)
     {
-        wifiSendData(packet_len, sendBuffer);
+        if (clientState[i].bootReportLine < 0 || !(active & (1 << i)))
+            continue;
+
+        int len = bootTimelineFormat(clientState[i].bootReportLine, line, sizeof(line));
+        if (len == 0)
+        {
+            if (bootTimelineIsFinished())
+                clientState[i].bootReportLine = -1;
+            continue;
+        }
+
+        if (packet_pack(&packet, PKT_ID_CONSOLE_LOG, (const uint8_t *)line, len))
+        {
+            dataSenderSendFrame(i, buffer, packet_serialize(&packet, buffer, sizeof(buffer)));
+        }
+        clientState[i].bootReportLine++;
     }
 }
 
@@ -85,7 +339,10 @@ void dataSenderHighFreqTask(void *param)
     const TickType_t interval = M2T(20); // 50Hz 发送频率 (20ms周期)
 
     uint8_t sendBuffer[PACKET_MAX_SIZE];
+    const uint8_t *frame = sendBuffer;
     HighFreqDataPacket_t hf_data;
+    stateSnapshot_t snapshot;
+    uint32_t tick = 0;
 
     DEBUG_PRINT("High Frequency Data Transfer Task started\n");
 
@@ -96,44 +353,51 @@ void dataSenderHighFreqTask(void *param)
         if (!isInit)
             continue;
 
-        // 1. 采集姿态数据 (由姿态估计器计算)
-        hf_data.roll = state.attitude.roll;
-        hf_data.pitch = state.attitude.pitch;
-        hf_data.yaw = state.attitude.yaw;
-
-        // 2. 采集期望角速度 (第一级PID输出：角度环的输出)
-        controllerPidGetRateDesired(&hf_data.rollRateDesired,
-                                    &hf_data.pitchRateDesired,
-                                    &hf_data.yawRateDesired);
-
-        // 3. 采集控制输出 (第二级PID输出：角速度环的输出)
-        hf_data.rollControl = control.roll;
-        hf_data.pitchControl = control.pitch;
-        hf_data.yawControl = control.yaw;
-
-        // 4. 采集电机PWM输出 (0-65535)
-        hf_data.motor1 = (uint16_t)motorsGetRatio(0);
-        hf_data.motor2 = (uint16_t)motorsGetRatio(1);
-        hf_data.motor3 = (uint16_t)motorsGetRatio(2);
-        hf_data.motor4 = (uint16_t)motorsGetRatio(3);
-
-        // 5. 采集传感器原始数据 (1KHz采集到的陀螺仪和加速度计数据)
-        hf_data.gyroX = sensorData.gyro.x;
-        hf_data.gyroY = sensorData.gyro.y;
-        hf_data.gyroZ = sensorData.gyro.z;
-        hf_data.accX = sensorData.acc.x;
-        hf_data.accY = sensorData.acc.y;
-        hf_data.accZ = sensorData.acc.z;
-
-        // 6. 时间戳 (毫秒低16位)
-        hf_data.timestamp = (uint16_t)(xTaskGetTickCount() & 0xFFFF);
+        sendBootReport();
+
+        // 按各客户端订阅的速率分频, 本周期无目标则跳过
+        uint8_t dest = hfDestination(tick++);
+        if (dest == 0)
+            continue;
+
+        // 读取稳定器同一周期发布的快照, 各字段来自同一时刻
+        stateSnapshotRead(&snapshot);
+
+        // 1. 姿态数据 (由姿态估计器计算)
+        hf_data.roll = snapshot.state.attitude.roll;
+        hf_data.pitch = snapshot.state.attitude.pitch;
+        hf_data.yaw = snapshot.state.attitude.yaw;
+
+        // 2. 期望角速度 (第一级PID输出：角度环的输出)
+        hf_data.rollRateDesired = snapshot.rateDesired.roll;
+        hf_data.pitchRateDesired = snapshot.rateDesired.pitch;
+        hf_data.yawRateDesired = snapshot.rateDesired.yaw;
+
+        // 3. 控制输出 (第二级PID输出：角速度环的输出)
+        hf_data.rollControl = snapshot.control.roll;
+        hf_data.pitchControl = snapshot.control.pitch;
+        hf_data.yawControl = snapshot.control.yaw;
+
+        // 4. 电机PWM输出 (0-65535)
+        hf_data.motor1 = snapshot.motors[0];
+        hf_data.motor2 = snapshot.motors[1];
+        hf_data.motor3 = snapshot.motors[2];
+        hf_data.motor4 = snapshot.motors[3];
+
+        // 5. 传感器原始数据 (1KHz采集到的陀螺仪和加速度计数据)
+        hf_data.gyroX = snapshot.sensorData.gyro.x;
+        hf_data.gyroY = snapshot.sensorData.gyro.y;
+        hf_data.gyroZ = snapshot.sensorData.gyro.z;
+        hf_data.accX = snapshot.sensorData.acc.x;
+        hf_data.accY = snapshot.sensorData.acc.y;
+        hf_data.accZ = snapshot.sensorData.acc.z;
+
+        // 6. 时间戳 (快照发布时刻, 毫秒低16位)
+        hf_data.timestamp = (uint16_t)(snapshot.timestamp & 0xFFFF);
 
         // 7. 使用协议打包并发送
         uint16_t packet_len = packet_createHighFreqData(sendBuffer, sizeof(sendBuffer), &hf_data);
-        if (packet_len > 0)
-        {
-            wifiSendData(packet_len, sendBuffer);
-        }
+        sendFrames(dest, &frame, &packet_len, 1);
     }
 }
 
@@ -146,7 +410,10 @@ void dataSenderLowFreqTask(void *param)
     TickType_t lastWakeTime = xTaskGetTickCount();
     const TickType_t interval = M2T(1000); // 1Hz 发送频率 (1000ms周期)
 
-    uint8_t sendBuffer[PACKET_MAX_SIZE];
+    uint8_t pidBuffer[PACKET_MAX_SIZE];
+    uint8_t battBuffer[PACKET_MAX_SIZE];
+    const uint8_t *const frames[] = {pidBuffer, battBuffer};
+    uint16_t lens[2];
 
     DEBUG_PRINT("Low Frequency Data Transfer Task started\n");
 
@@ -157,20 +424,20 @@ void dataSenderLowFreqTask(void *param)
         if (!isInit)
             continue;
 
-        // 发送 PID 参数
-        sendPIDInfo();
+        // PID 参数
+        lens[0] = buildPIDInfo(pidBuffer, sizeof(pidBuffer));
 
-        // 发送电池状态
+        // 电池状态
         BatteryStatusPacket_t battery_data = {
             .voltage = pmGetBatteryVoltage(),
             .voltage_mv = (uint16_t)(pmGetBatteryVoltage() * 1000),
             .level = pmGetBatteryLevel(),
             .state = (uint8_t)pmGetState()};
-        uint16_t batt_len = packet_createBatteryStatus(sendBuffer, sizeof(sendBuffer), &battery_data);
-        if (batt_len > 0)
-        {
-            wifiSendData(batt_len, sendBuffer);
-        }
+        lens[1] = packet_createBatteryStatus(battBuffer, sizeof(battBuffer), &battery_data);
+
+        // 发送给全部客户端 (无客户端时广播), v2下两帧合并为一个数据报
+        uint8_t dest = transportGetClientMask();
+        sendFrames(dest ? dest : TRANSPORT_DEST_BROADCAST, frames, lens, 2);
     }
 }
 
@@ -0,0 +1,193 @@
+/**
+ * Transport POSIX - Linux UDP 传输后端 (仅主机构建)
+ *
+ * 用于在主机上运行协议层代码与基准测试: 本地回环, 或直接连接飞机.
+ * 与固件UDP后端不同, 客户端以IP+端口区分并回复到源端口, 便于同一主机上运行多个端点.
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "transport.h"
+#include "transport_posix.h"
+
+#define POSIX_CLIENT_TIMEOUT_MS 3000
+
+typedef struct
+{
+    bool active;
+    struct sockaddr_in addr;
+    uint64_t lastSeenMs;
+} PosixClient;
+
+static int sock = -1;
+static uint16_t localPort = 2399;
+static struct sockaddr_in peerAddr; // 无登记客户端时的发送目标 (代替广播)
+static PosixClient clients[TRANSPORT_MAX_CLIENTS];
+
+static uint64_t nowMs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+void transportPosixConfigure(uint16_t port, const char *peerHost, uint16_t peerPort)
+{
+    localPort = port;
+    memset(&peerAddr, 0, sizeof(peerAddr));
+    peerAddr.sin_family = AF_INET;
+    peerAddr.sin_port = htons(peerPort);
+    inet_pton(AF_INET, peerHost, &peerAddr.sin_addr);
+}
+
+static uint8_t clientTouch(const struct sockaddr_in *from)
+{
+    uint64_t now = nowMs();
+    int freeSlot = -1;
+
+    for (int i = 0; i < TRANSPORT_MAX_CLIENTS; i++)
+    {
+        if (clients[i].active && now - clients[i].lastSeenMs > POSIX_CLIENT_TIMEOUT_MS)
+        {
+            clients[i].active = false;
+        }
+
+        if (clients[i].active &&
+            clients[i].addr.sin_addr.s_addr == from->sin_addr.s_addr &&
+            clients[i].addr.sin_port == from->sin_port)
+        {
+            clients[i].lastSeenMs = now;
+            return i;
+        }
+
+        if (!clients[i].active && freeSlot < 0)
+        {
+            freeSlot = i;
+        }
+    }
+
+    if (freeSlot < 0)
+    {
+        return TRANSPORT_CLIENT_NONE;
+    }
+
+    clients[freeSlot].active = true;
+    clients[freeSlot].addr = *from;
+    clients[freeSlot].lastSeenMs = now;
+    return freeSlot | TRANSPORT_CLIENT_NEW;
+}
+
+static bool posixInit(void)
+{
+    struct sockaddr_in local = {
+        .sin_family = AF_INET,
+        .sin_port = htons(localPort),
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+    };
+    int reuse = 1;
+
+    sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0)
+    {
+        perror("socket");
+        return false;
+    }
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    if (bind(sock, (struct sockaddr *)&local, sizeof(local)) < 0)
+    {
+        perror("bind");
+        close(sock);
+        sock = -1;
+        return false;
+    }
+    return true;
+}
+
+static bool posixReceive(TransportPacket *in, uint32_t timeoutMs)
+{
+    struct pollfd pfd = {.fd = sock, .events = POLLIN};
+    int timeout = (timeoutMs == TRANSPORT_WAIT_FOREVER) ? -1 : (int)timeoutMs;
+
+    while (true)
+    {
+        if (poll(&pfd, 1, timeout) <= 0)
+        {
+            return false;
+        }
+
+        struct sockaddr_in from;
+        socklen_t fromLen = sizeof(from);
+        ssize_t len = recvfrom(sock, in->data, TRANSPORT_MTU, 0, (struct sockaddr *)&from, &fromLen);
+        if (len <= 0)
+        {
+            continue;
+        }
+
+        in->size = (uint8_t)len;
+        in->client = clientTouch(&from);
+        return true;
+    }
+}
+
+static bool posixSend(uint8_t dest, const uint8_t *data, uint32_t size)
+{
+    bool ok = true;
+
+    if (dest & TRANSPORT_DEST_BROADCAST)
+    {
+        return sendto(sock, data, size, 0, (struct sockaddr *)&peerAddr, sizeof(peerAddr)) == (ssize_t)size;
+    }
+
+    for (int i = 0; i < TRANSPORT_MAX_CLIENTS; i++)
+    {
+        if ((dest & (1 << i)) && clients[i].active)
+        {
+            ok &= sendto(sock, data, size, 0, (struct sockaddr *)&clients[i].addr,
+                         sizeof(clients[i].addr)) == (ssize_t)size;
+        }
+    }
+    return ok;
+}
+
+static uint8_t posixClientMask(void)
+{
+    uint64_t now = nowMs();
+    uint8_t mask = 0;
+
+    for (int i = 0; i < TRANSPORT_MAX_CLIENTS; i++)
+    {
+        if (clients[i].active && now - clients[i].lastSeenMs > POSIX_CLIENT_TIMEOUT_MS)
+        {
+            clients[i].active = false;
+        }
+        if (clients[i].active)
+        {
+            mask |= (1 << i);
+        }
+    }
+    return mask;
+}
+
+static int8_t posixClientRssi(uint8_t client)
+{
+    (void)client;
+    return 0;
+}
+
+const TransportOps transportPosix = {
+    .name = "posix-udp",
+    .init = posixInit,
+    .receive = posixReceive,
+    .send = posixSend,
+    .clientMask = posixClientMask,
+    .clientRssi = posixClientRssi,
+};
@@ -0,0 +1,26 @@
+/**
+ * Transport POSIX - Linux UDP 传输后端 (仅主机构建)
+ */
+
+#ifndef __TRANSPORT_POSIX_H__
+#define __TRANSPORT_POSIX_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 配置本地端口与对端地址, 需在transportInit(&transportPosix)之前调用
+ * @param port 本地监听端口
+ * @param peerHost 无登记客户端时的发送目标 (代替广播)
+ * @param peerPort 对端端口
+ */
+void transportPosixConfigure(uint16_t port, const char *peerHost, uint16_t peerPort);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __TRANSPORT_POSIX_H__
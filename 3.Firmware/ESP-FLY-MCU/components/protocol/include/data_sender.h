@@ -15,6 +15,42 @@
  */
 void dataSenderInit(void);
 
+/**
+ * 通知收到客户端数据报 (协议版本协商)
+ * 收到v2数据报后该客户端下行切换为v2, 持续未收到则回退到v1
+ * @param client 客户端索引
+ * @param version 数据报的协议版本
+ */
+void dataSenderOnPeerDatagram(uint8_t client, uint8_t version);
+
+/**
+ * 获取客户端当前下行协议版本
+ * @param client 客户端索引
+ * @return 1或2
+ */
+uint8_t dataSenderGetProtocolVersion(uint8_t client);
+
+/**
+ * 重置客户端发送状态 (客户端新登记时调用)
+ * @param client 客户端索引
+ */
+void dataSenderResetClient(uint8_t client);
+
+/**
+ * 设置客户端订阅的高频数据速率
+ * @param client 客户端索引
+ * @param hfRateHz 高频数据速率 (Hz), 0=默认50Hz
+ */
+void dataSenderSetClientRate(uint8_t client, uint8_t hfRateHz);
+
+/**
+ * 按客户端协议版本发送一个已编码的帧
+ * @param client 目标客户端索引, TRANSPORT_CLIENT_NONE时广播
+ * @param frame 完整v1帧
+ * @param len 帧长度
+ */
+void dataSenderSendFrame(uint8_t client, const uint8_t *frame, uint16_t len);
+
 /**
  * 高频数据传输任务 (50Hz)
  * 负责发送姿态、控制、电机和传感器数据
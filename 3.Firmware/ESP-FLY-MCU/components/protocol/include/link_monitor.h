@@ -0,0 +1,55 @@
+/**
+ * Link Monitor - 链路质量测量模块
+ *
+ * 响应上位机的PING请求 (回带双方时间戳与RSSI), 并按客户端统计请求丢失与上行到达抖动
+ */
+
+#ifndef __LINK_MONITOR_H__
+#define __LINK_MONITOR_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "packet_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 单个客户端的链路统计
+ */
+typedef struct
+{
+    PacketSeqStats_t seq;  // PING序号统计 (接收/丢失/乱序)
+    uint32_t jitterUs;     // 上行到达抖动 (RFC 3550平滑估计, 微秒)
+    int32_t lastTransitUs; // 上一个PING的传输时间差 (本地接收时间 - 上位机发送时间)
+    int8_t rssi;           // 最近一次测得的RSSI (dBm), 0=未知
+} LinkStats_t;
+
+/**
+ * 处理PING请求并回复PONG
+ * @param client 发送方客户端索引
+ * @param ping PING数据
+ * @param rxTimeUs 收到请求时的本地时间 (微秒)
+ */
+void linkMonitorHandlePing(uint8_t client, const PingPacket_t *ping, uint32_t rxTimeUs);
+
+/**
+ * 重置客户端链路统计 (客户端新登记时调用)
+ * @param client 客户端索引
+ */
+void linkMonitorResetClient(uint8_t client);
+
+/**
+ * 获取客户端链路统计
+ * @param client 客户端索引
+ * @param stats 输出的统计数据
+ * @return false=客户端索引无效
+ */
+bool linkMonitorGetStats(uint8_t client, LinkStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __LINK_MONITOR_H__
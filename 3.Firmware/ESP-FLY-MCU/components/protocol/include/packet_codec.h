@@ -3,6 +3,7 @@
  *
  * 替代CRTP协议，使用固定位宽的数据包格式
  * 数据包格式: PacketID(1) + Length(1) + Payload(0-120) + Checksum(1)
+ * v2数据报在此基础上增加序号、时间戳与CRC16, 并可在一个UDP数据报中携带多帧
  */
 
 #ifndef __PACKET_CODEC_H__
@@ -12,43 +13,17 @@
 #include <stdbool.h>
 #include <string.h>
 
+#include "packet_defs.h"
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
-    // ============================================================================
-    // 常量定义
-    // ============================================================================
-
-#define PACKET_MAX_PAYLOAD_SIZE 120 // 最大payload长度
-#define PACKET_HEADER_SIZE 2        // PacketID + Length
-#define PACKET_CHECKSUM_SIZE 1      // Checksum
-#define PACKET_MAX_SIZE (PACKET_HEADER_SIZE + PACKET_MAX_PAYLOAD_SIZE + PACKET_CHECKSUM_SIZE)
-
-    // ============================================================================
-    // 数据包类型定义 (PacketID)
-    // ============================================================================
-
-    // 上行数据包 (PC/APP → MCU)
-    typedef enum
-    {
-        PKT_ID_FLIGHT_CONTROL = 0x01, // 飞行控制命令
-        PKT_ID_PID_CONFIG = 0x02,     // PID参数配置
-        PKT_ID_MOTOR_TEST = 0x03,     // 电机测试
-    } PacketID_Uplink;
-
-    // 下行数据包 (MCU → PC/APP)
-    typedef enum
-    {
-        PKT_ID_HIGH_FREQ_DATA = 0x81, // 高频飞行数据 (50Hz)
-        PKT_ID_BATTERY_STATUS = 0x82, // 电池状态 (1Hz)
-        PKT_ID_PID_RESPONSE = 0x83,   // PID参数响应
-    } PacketID_Downlink;
-
     // ============================================================================
     // 数据包结构体定义
     // ============================================================================
+    // 数据包ID、各类型payload结构体及编解码函数由 packets.json 生成, 见 packet_defs.h
 
     /**
      * 通用数据包结构
@@ -61,112 +36,52 @@ extern "C"
         uint8_t checksum;                         // 校验和 (自动计算)
     } __attribute__((packed)) PacketFrame_t;
 
-    /**
-     * 飞行控制命令包 (0x01) - 14 bytes payload
-     */
-    typedef struct
-    {
-        float roll;      // 横滚角度 (度)
-        float pitch;     // 俯仰角度 (度)
-        float yaw;       // 偏航角度 (度，±180)
-        uint16_t thrust; // 推力值 (0-65535)
-    } __attribute__((packed)) FlightControlPacket_t;
+    // ============================================================================
+    // 协议v2 数据报
+    // ============================================================================
+    // 数据报格式: Magic(1) + Version(1) + Seq(2) + Timestamp(4) + 若干完整v1帧 + CRC16(2)
+    // 多字节字段均为小端序, CRC16-CCITT (0x1021, 初值0xFFFF) 覆盖CRC之前的全部字节
+    // Magic不与任何PacketID冲突, 接收端据首字节区分v1/v2; 收到对端v2数据报前一律使用v1
 
-    /**
-     * 高频飞行数据包 (0x81) - 64 bytes payload
-     */
-    typedef struct
-    {
-        // 姿态角 (12 bytes)
-        float roll;
-        float pitch;
-        float yaw;
-
-        // 期望角速度 (12 bytes)
-        float rollRateDesired;
-        float pitchRateDesired;
-        float yawRateDesired;
-
-        // 控制输出 (6 bytes)
-        int16_t rollControl;
-        int16_t pitchControl;
-        int16_t yawControl;
-
-        // 电机PWM (8 bytes)
-        uint16_t motor1;
-        uint16_t motor2;
-        uint16_t motor3;
-        uint16_t motor4;
-
-        // 陀螺仪数据 (12 bytes) - deg/s
-        float gyroX;
-        float gyroY;
-        float gyroZ;
-
-        // 加速度计数据 (12 bytes) - Gs
-        float accX;
-        float accY;
-        float accZ;
-
-        // 时间戳 (2 bytes)
-        uint16_t timestamp;
-    } __attribute__((packed)) HighFreqDataPacket_t;
+#define PACKET_V2_MAGIC 0xA5
+#define PACKET_V2_VERSION 2
+#define PACKET_V2_HEADER_SIZE 8 // Magic + Version + Seq + Timestamp
+#define PACKET_V2_CRC_SIZE 2    // CRC16
+#define PACKET_V2_OVERHEAD (PACKET_V2_HEADER_SIZE + PACKET_V2_CRC_SIZE)
 
     /**
-     * 电池状态包 (0x82) - 8 bytes payload
+     * v2数据报构建器 (帧直接编码进buffer, 结束时补写头部和CRC)
      */
     typedef struct
     {
-        float voltage;       // 电池电压 (V)
-        uint16_t voltage_mv; // 电池电压 (mV)
-        uint8_t level;       // 电量百分比 (0-100)
-        uint8_t state;       // 电池状态
-    } __attribute__((packed)) BatteryStatusPacket_t;
+        uint8_t *buffer;     // 输出缓冲区
+        uint16_t capacity;   // 缓冲区大小
+        uint16_t length;     // 已写入长度 (含预留的头部)
+        uint8_t frame_count; // 已写入的帧数
+    } PacketDatagram_t;
 
     /**
-     * PID参数配置包 (0x02) - 72 bytes payload
-     * 一次性发送所有6组PID参数（姿态环和速度环）
+     * v2数据报头部信息
      */
     typedef struct
     {
-        // 姿态环 PID参数
-        float roll_angle_kp; // Roll姿态环 - 比例系数
-        float roll_angle_ki; // Roll姿态环 - 积分系数
-        float roll_angle_kd; // Roll姿态环 - 微分系数
-
-        float pitch_angle_kp; // Pitch姿态环 - 比例系数
-        float pitch_angle_ki; // Pitch姿态环 - 积分系数
-        float pitch_angle_kd; // Pitch姿态环 - 微分系数
-
-        float yaw_angle_kp; // Yaw姿态环 - 比例系数
-        float yaw_angle_ki; // Yaw姿态环 - 积分系数
-        float yaw_angle_kd; // Yaw姿态环 - 微分系数
-
-        // 速度环 PID参数
-        float roll_rate_kp; // Roll速度环 - 比例系数
-        float roll_rate_ki; // Roll速度环 - 积分系数
-        float roll_rate_kd; // Roll速度环 - 微分系数
-
-        float pitch_rate_kp; // Pitch速度环 - 比例系数
-        float pitch_rate_ki; // Pitch速度环 - 积分系数
-        float pitch_rate_kd; // Pitch速度环 - 微分系数
-
-        float yaw_rate_kp; // Yaw速度环 - 比例系数
-        float yaw_rate_ki; // Yaw速度环 - 积分系数
-        float yaw_rate_kd; // Yaw速度环 - 微分系数
-    } __attribute__((packed)) PIDConfigPacket_t;
+        uint16_t seq;          // 发送序号
+        uint32_t timestamp;    // 发送端时间戳 (ms)
+        const uint8_t *frames; // 帧区起始地址
+        uint16_t frames_len;   // 帧区长度
+    } PacketDatagramInfo_t;
 
     /**
-     * 电机测试包 (0x03) - 9 bytes payload
+     * 序号统计 (丢包/乱序)
      */
     typedef struct
     {
-        uint16_t motor1_pwm; // 电机1 PWM占空比 (0-65535)
-        uint16_t motor2_pwm; // 电机2 PWM占空比 (0-65535)
-        uint16_t motor3_pwm; // 电机3 PWM占空比 (0-65535)
-        uint16_t motor4_pwm; // 电机4 PWM占空比 (0-65535)
-        uint8_t enable;      // 测试使能: 0=停止, 1=启用测试
-    } __attribute__((packed)) MotorTestPacket_t;
+        bool started;          // 是否已收到第一个数据报
+        uint16_t expected_seq; // 期望的下一个序号
+        uint32_t received;     // 已接收数据报数
+        uint32_t lost;         // 丢失数据报数
+        uint32_t reordered;    // 乱序(迟到)数据报数
+    } PacketSeqStats_t;
 
     // ============================================================================
     // 函数接口
@@ -271,6 +186,118 @@ extern "C"
      */
     bool packet_parseMotorTest(const PacketFrame_t *packet, MotorTestPacket_t *motor_test);
 
+    /**
+     * 解析订阅包
+     * @param packet 数据包结构
+     * @param subscribe 输出的订阅参数
+     * @return true=成功, false=失败
+     */
+    bool packet_parseSubscribe(const PacketFrame_t *packet, SubscribePacket_t *subscribe);
+
+    /**
+     * 解析链路测量请求包
+     * @param packet 数据包结构
+     * @param ping 输出的请求数据
+     * @return true=成功, false=失败
+     */
+    bool packet_parsePing(const PacketFrame_t *packet, PingPacket_t *ping);
+
+    /**
+     * 解析内核微基准测试请求包
+     * @param packet 数据包
+     * @param request 输出的请求数据
+     * @return true=成功, false=失败
+     */
+    bool packet_parseBenchRequest(const PacketFrame_t *packet, BenchRequestPacket_t *request);
+
+    /**
+     * 解析电机推力标定请求包
+     * @param packet 数据包
+     * @param request 输出的请求数据
+     * @return true=成功, false=失败
+     */
+    bool packet_parseMotorCharRequest(const PacketFrame_t *packet, MotorCharRequestPacket_t *request);
+
+    /**
+     * 解析系统辨识请求包
+     * @param packet 数据包
+     * @param request 输出的请求数据
+     * @return true=成功, false=失败
+     */
+    bool packet_parseSysidRequest(const PacketFrame_t *packet, SysidRequestPacket_t *request);
+
+    /**
+     * 计算CRC16-CCITT (查表法, 可分段累加)
+     * @param data 数据缓冲区
+     * @param len 数据长度
+     * @param crc 初值 (首段传0xFFFF, 后续传上一段的结果)
+     * @return CRC16
+     */
+    uint16_t packet_crc16(const uint8_t *data, uint16_t len, uint16_t crc);
+
+    /**
+     * 开始构建v2数据报 (预留头部空间)
+     * @param dg 数据报构建器
+     * @param buffer 输出缓冲区
+     * @param capacity 缓冲区大小
+     */
+    void packet_datagramBegin(PacketDatagram_t *dg, uint8_t *buffer, uint16_t capacity);
+
+    /**
+     * 获取数据报当前写入位置, 用于直接编码下一帧
+     * @param dg 数据报构建器
+     * @param space 输出: 可写入的字节数 (已扣除CRC)
+     * @return 写入位置
+     */
+    uint8_t *packet_datagramTail(const PacketDatagram_t *dg, uint16_t *space);
+
+    /**
+     * 确认在写入位置编码的一帧
+     * @param dg 数据报构建器
+     * @param frame_len 帧长度 (编码函数返回值, 0表示未写入)
+     * @return true=已追加, false=帧长度无效或超出剩余空间
+     */
+    bool packet_datagramCommit(PacketDatagram_t *dg, uint16_t frame_len);
+
+    /**
+     * 完成数据报: 写入头部并追加CRC
+     * @param dg 数据报构建器
+     * @param seq 发送序号
+     * @param timestamp 发送端时间戳 (ms)
+     * @return 数据报总长度 (0表示没有帧)
+     */
+    uint16_t packet_datagramFinish(PacketDatagram_t *dg, uint16_t seq, uint32_t timestamp);
+
+    /**
+     * 判断数据是否为v2数据报 (仅检查Magic和Version)
+     */
+    bool packet_isDatagramV2(const uint8_t *buffer, uint16_t len);
+
+    /**
+     * 校验并解析v2数据报头部
+     * @param buffer 输入缓冲区
+     * @param len 数据报长度
+     * @param info 输出的头部信息
+     * @return true=成功, false=格式或CRC错误
+     */
+    bool packet_parseDatagramV2(const uint8_t *buffer, uint16_t len, PacketDatagramInfo_t *info);
+
+    /**
+     * 从帧区取出下一帧
+     * @param cursor 帧区游标 (成功后前移)
+     * @param remaining 剩余字节数 (成功后扣减)
+     * @param frame 输出的数据包结构
+     * @return true=成功, false=帧区结束或帧格式错误
+     */
+    bool packet_nextFrame(const uint8_t **cursor, uint16_t *remaining, PacketFrame_t *frame);
+
+    /**
+     * 按接收序号更新丢包/乱序统计
+     * @param stats 统计数据
+     * @param seq 收到的序号
+     */
+    void packet_seqTrack(PacketSeqStats_t *stats, uint16_t seq);
+
 #ifdef __cplusplus
 }
 #endif
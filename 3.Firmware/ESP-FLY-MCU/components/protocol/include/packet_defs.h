@@ -0,0 +1,1453 @@
+/**
+ * Packet Definitions - 数据包定义
+ *
+ * 本文件由 tools/packet_codegen.py 根据 packets.json 自动生成，请勿手动修改
+ * 数据包格式: PacketID(1) + Length(1) + Payload(0-120) + Checksum(1)
+ */
+
+#ifndef __PACKET_DEFS_H__
+#define __PACKET_DEFS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // ============================================================================
+    // 常量定义
+    // ============================================================================
+
+#define PACKET_MAX_PAYLOAD_SIZE 120 // 最大payload长度
+#define PACKET_HEADER_SIZE 2        // PacketID + Length
+#define PACKET_CHECKSUM_SIZE 1      // Checksum
+#define PACKET_MAX_SIZE (PACKET_HEADER_SIZE + PACKET_MAX_PAYLOAD_SIZE + PACKET_CHECKSUM_SIZE)
+
+    // ============================================================================
+    // 数据包类型定义 (PacketID)
+    // ============================================================================
+
+    // 上行数据包 (PC/APP → MCU)
+    typedef enum
+    {
+        PKT_ID_FLIGHT_CONTROL = 0x01,     // 飞行控制命令
+        PKT_ID_PID_CONFIG = 0x02,         // PID参数配置 (一次性发送所有6组PID参数)
+        PKT_ID_MOTOR_TEST = 0x03,         // 电机测试
+        PKT_ID_HEARTBEAT = 0x10,          // 心跳包 (无payload)
+        PKT_ID_SUBSCRIBE = 0x11,          // 订阅遥测 (客户端以单播方式接收, 需心跳保活)
+        PKT_ID_PING = 0x12,               // 链路测量请求 (飞控原样回带时间戳)
+        PKT_ID_BENCH_REQUEST = 0x13,      // 内核微基准测试请求 (电机空闲时执行)
+        PKT_ID_MOTOR_CHAR_REQUEST = 0x14, // 电机推力标定请求 (须固定在测试台上, 电机空闲时执行)
+        PKT_ID_SYSID_REQUEST = 0x15,      // 角速度环系统辨识请求 (须固定在测试台上, 有油门时执行)
+    } PacketID_Uplink;
+
+    // 下行数据包 (MCU → PC/APP)
+    typedef enum
+    {
+        PKT_ID_HIGH_FREQ_DATA = 0x81,    // 高频飞行数据 (50Hz)
+        PKT_ID_BATTERY_STATUS = 0x82,    // 电池状态 (1Hz)
+        PKT_ID_PID_RESPONSE = 0x83,      // PID参数响应 (1Hz)
+        PKT_ID_CONSOLE_LOG = 0x84,       // 控制台日志 (UTF-8文本，变长)
+        PKT_ID_HEARTBEAT_RESP = 0x90,    // 心跳响应 (无payload)
+        PKT_ID_PONG = 0x91,              // 链路测量响应
+        PKT_ID_BENCH_RESULT = 0x92,      // 内核微基准测试结果 (每个内核一包)
+        PKT_ID_MOTOR_CHAR_RESULT = 0x93, // 电机推力标定结果 (每个标定点一包)
+        PKT_ID_SYSID_STATUS = 0x94,      // 系统辨识状态
+        PKT_ID_SYSID_SAMPLES = 0x95,     // 系统辨识原始记录 (每包8个样本)
+        PKT_ID_SYSID_FRF = 0x96,         // 系统辨识频率响应 (每个频点一包)
+    } PacketID_Downlink;
+
+    // ============================================================================
+    // Payload长度 (编译期常量)
+    // ============================================================================
+
+#define PKT_LEN_FLIGHT_CONTROL 14
+#define PKT_LEN_PID_CONFIG 72
+#define PKT_LEN_MOTOR_TEST 9
+#define PKT_LEN_HEARTBEAT 0
+#define PKT_LEN_SUBSCRIBE 1
+#define PKT_LEN_PING 6
+#define PKT_LEN_BENCH_REQUEST 2
+#define PKT_LEN_MOTOR_CHAR_REQUEST 1
+#define PKT_LEN_SYSID_REQUEST 16
+#define PKT_LEN_HIGH_FREQ_DATA 64
+#define PKT_LEN_BATTERY_STATUS 8
+#define PKT_LEN_PID_RESPONSE 72
+#define PKT_LEN_HEARTBEAT_RESP 0
+#define PKT_LEN_PONG 21
+#define PKT_LEN_BENCH_RESULT 66
+#define PKT_LEN_MOTOR_CHAR_RESULT 11
+#define PKT_LEN_SYSID_STATUS 8
+#define PKT_LEN_SYSID_SAMPLES 51
+#define PKT_LEN_SYSID_FRF 26
+
+#define PKT_FRAME_LEN_FLIGHT_CONTROL (PACKET_HEADER_SIZE + PKT_LEN_FLIGHT_CONTROL + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_PID_CONFIG (PACKET_HEADER_SIZE + PKT_LEN_PID_CONFIG + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_MOTOR_TEST (PACKET_HEADER_SIZE + PKT_LEN_MOTOR_TEST + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_HEARTBEAT (PACKET_HEADER_SIZE + PKT_LEN_HEARTBEAT + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_SUBSCRIBE (PACKET_HEADER_SIZE + PKT_LEN_SUBSCRIBE + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_PING (PACKET_HEADER_SIZE + PKT_LEN_PING + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_BENCH_REQUEST (PACKET_HEADER_SIZE + PKT_LEN_BENCH_REQUEST + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_MOTOR_CHAR_REQUEST (PACKET_HEADER_SIZE + PKT_LEN_MOTOR_CHAR_REQUEST + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_SYSID_REQUEST (PACKET_HEADER_SIZE + PKT_LEN_SYSID_REQUEST + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_HIGH_FREQ_DATA (PACKET_HEADER_SIZE + PKT_LEN_HIGH_FREQ_DATA + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_BATTERY_STATUS (PACKET_HEADER_SIZE + PKT_LEN_BATTERY_STATUS + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_PID_RESPONSE (PACKET_HEADER_SIZE + PKT_LEN_PID_RESPONSE + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_HEARTBEAT_RESP (PACKET_HEADER_SIZE + PKT_LEN_HEARTBEAT_RESP + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_PONG (PACKET_HEADER_SIZE + PKT_LEN_PONG + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_BENCH_RESULT (PACKET_HEADER_SIZE + PKT_LEN_BENCH_RESULT + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_MOTOR_CHAR_RESULT (PACKET_HEADER_SIZE + PKT_LEN_MOTOR_CHAR_RESULT + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_SYSID_STATUS (PACKET_HEADER_SIZE + PKT_LEN_SYSID_STATUS + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_SYSID_SAMPLES (PACKET_HEADER_SIZE + PKT_LEN_SYSID_SAMPLES + PACKET_CHECKSUM_SIZE)
+#define PKT_FRAME_LEN_SYSID_FRF (PACKET_HEADER_SIZE + PKT_LEN_SYSID_FRF + PACKET_CHECKSUM_SIZE)
+
+    // ============================================================================
+    // 数据包结构体定义
+    // ============================================================================
+
+    /**
+     * 飞行控制命令 (0x01) - 14 bytes payload
+     */
+    typedef struct
+    {
+        float roll;      // 横滚角度 (度)
+        float pitch;     // 俯仰角度 (度)
+        float yaw;       // 偏航角度 (度，±180)
+        uint16_t thrust; // 推力值 (0-65535)
+    } __attribute__((packed)) FlightControlPacket_t;
+
+    _Static_assert(sizeof(FlightControlPacket_t) == PKT_LEN_FLIGHT_CONTROL, "FlightControlPacket_t size mismatch");
+
+    /**
+     * PID参数配置 (一次性发送所有6组PID参数) (0x02) - 72 bytes payload
+     */
+    typedef struct
+    {
+        float roll_angle_kp;  // Roll姿态环 - 比例系数
+        float roll_angle_ki;  // Roll姿态环 - 积分系数
+        float roll_angle_kd;  // Roll姿态环 - 微分系数
+        float pitch_angle_kp; // Pitch姿态环 - 比例系数
+        float pitch_angle_ki; // Pitch姿态环 - 积分系数
+        float pitch_angle_kd; // Pitch姿态环 - 微分系数
+        float yaw_angle_kp;   // Yaw姿态环 - 比例系数
+        float yaw_angle_ki;   // Yaw姿态环 - 积分系数
+        float yaw_angle_kd;   // Yaw姿态环 - 微分系数
+        float roll_rate_kp;   // Roll速度环 - 比例系数
+        float roll_rate_ki;   // Roll速度环 - 积分系数
+        float roll_rate_kd;   // Roll速度环 - 微分系数
+        float pitch_rate_kp;  // Pitch速度环 - 比例系数
+        float pitch_rate_ki;  // Pitch速度环 - 积分系数
+        float pitch_rate_kd;  // Pitch速度环 - 微分系数
+        float yaw_rate_kp;    // Yaw速度环 - 比例系数
+        float yaw_rate_ki;    // Yaw速度环 - 积分系数
+        float yaw_rate_kd;    // Yaw速度环 - 微分系数
+    } __attribute__((packed)) PIDConfigPacket_t;
+
+    _Static_assert(sizeof(PIDConfigPacket_t) == PKT_LEN_PID_CONFIG, "PIDConfigPacket_t size mismatch");
+
+    /**
+     * 电机测试 (0x03) - 9 bytes payload
+     */
+    typedef struct
+    {
+        uint16_t motor1_pwm; // 电机1 PWM占空比 (0-65535)
+        uint16_t motor2_pwm; // 电机2 PWM占空比 (0-65535)
+        uint16_t motor3_pwm; // 电机3 PWM占空比 (0-65535)
+        uint16_t motor4_pwm; // 电机4 PWM占空比 (0-65535)
+        uint8_t enable;      // 测试使能: 0=停止, 1=启用测试
+    } __attribute__((packed)) MotorTestPacket_t;
+
+    _Static_assert(sizeof(MotorTestPacket_t) == PKT_LEN_MOTOR_TEST, "MotorTestPacket_t size mismatch");
+
+    /**
+     * 订阅遥测 (客户端以单播方式接收, 需心跳保活) (0x11) - 1 bytes payload
+     */
+    typedef struct
+    {
+        uint8_t hf_rate_hz; // 高频数据速率 (Hz), 0=默认50Hz
+    } __attribute__((packed)) SubscribePacket_t;
+
+    _Static_assert(sizeof(SubscribePacket_t) == PKT_LEN_SUBSCRIBE, "SubscribePacket_t size mismatch");
+
+    /**
+     * 链路测量请求 (飞控原样回带时间戳) (0x12) - 6 bytes payload
+     */
+    typedef struct
+    {
+        uint16_t seq;          // 请求序号
+        uint32_t host_time_us; // 上位机发送时间 (微秒低32位)
+    } __attribute__((packed)) PingPacket_t;
+
+    _Static_assert(sizeof(PingPacket_t) == PKT_LEN_PING, "PingPacket_t size mismatch");
+
+    /**
+     * 内核微基准测试请求 (电机空闲时执行) (0x13) - 2 bytes payload
+     */
+    typedef struct
+    {
+        uint16_t iterations; // 每个内核的调用次数, 0=默认1000
+    } __attribute__((packed)) BenchRequestPacket_t;
+
+    _Static_assert(sizeof(BenchRequestPacket_t) == PKT_LEN_BENCH_REQUEST, "BenchRequestPacket_t size mismatch");
+
+    /**
+     * 电机推力标定请求 (须固定在测试台上, 电机空闲时执行) (0x14) - 1 bytes payload
+     */
+    typedef struct
+    {
+        uint8_t action; // 0=查询当前查找表, 1=运行标定并保存, 2=清除标定恢复默认, 3=中止正在进行的标定
+    } __attribute__((packed)) MotorCharRequestPacket_t;
+
+    _Static_assert(sizeof(MotorCharRequestPacket_t) == PKT_LEN_MOTOR_CHAR_REQUEST, "MotorCharRequestPacket_t size mismatch");
+
+    /**
+     * 角速度环系统辨识请求 (须固定在测试台上, 有油门时执行) (0x15) - 16 bytes payload
+     */
+    typedef struct
+    {
+        uint8_t axis;         // 0=横滚, 1=俯仰, 2=偏航
+        uint8_t signal;       // 0=阶跃, 1=扫频, 255=中止当前辨识
+        uint16_t duration_ms; // 激励时长 (ms), 受记录缓冲限制
+        float amplitude;      // 激励幅值 (度/秒), 叠加在期望角速度上
+        float f_start;        // 扫频起始频率 (Hz)
+        float f_end;          // 扫频终止频率 (Hz)
+    } __attribute__((packed)) SysidRequestPacket_t;
+
+    _Static_assert(sizeof(SysidRequestPacket_t) == PKT_LEN_SYSID_REQUEST, "SysidRequestPacket_t size mismatch");
+
+    /**
+     * 高频飞行数据 (50Hz) (0x81) - 64 bytes payload
+     */
+    typedef struct
+    {
+        float roll;             // 姿态角 - 横滚 (度)
+        float pitch;            // 姿态角 - 俯仰 (度)
+        float yaw;              // 姿态角 - 偏航 (度)
+        float rollRateDesired;  // 期望角速度 - 横滚 (外环输出)
+        float pitchRateDesired; // 期望角速度 - 俯仰 (外环输出)
+        float yawRateDesired;   // 期望角速度 - 偏航 (外环输出)
+        int16_t rollControl;    // 控制输出 - 横滚 (内环输出)
+        int16_t pitchControl;   // 控制输出 - 俯仰 (内环输出)
+        int16_t yawControl;     // 控制输出 - 偏航 (内环输出)
+        uint16_t motor1;        // 电机1 PWM
+        uint16_t motor2;        // 电机2 PWM
+        uint16_t motor3;        // 电机3 PWM
+        uint16_t motor4;        // 电机4 PWM
+        float gyroX;            // 陀螺仪X (deg/s)
+        float gyroY;            // 陀螺仪Y (deg/s)
+        float gyroZ;            // 陀螺仪Z (deg/s)
+        float accX;             // 加速度X (Gs)
+        float accY;             // 加速度Y (Gs)
+        float accZ;             // 加速度Z (Gs)
+        uint16_t timestamp;     // 时间戳 (毫秒低16位)
+    } __attribute__((packed)) HighFreqDataPacket_t;
+
+    _Static_assert(sizeof(HighFreqDataPacket_t) == PKT_LEN_HIGH_FREQ_DATA, "HighFreqDataPacket_t size mismatch");
+
+    /**
+     * 电池状态 (1Hz) (0x82) - 8 bytes payload
+     */
+    typedef struct
+    {
+        float voltage;       // 电池电压 (V)
+        uint16_t voltage_mv; // 电池电压 (mV)
+        uint8_t level;       // 电量百分比 (0-100)
+        uint8_t state;       // 电池状态
+    } __attribute__((packed)) BatteryStatusPacket_t;
+
+    _Static_assert(sizeof(BatteryStatusPacket_t) == PKT_LEN_BATTERY_STATUS, "BatteryStatusPacket_t size mismatch");
+
+    /**
+     * 链路测量响应 (0x91) - 21 bytes payload
+     */
+    typedef struct
+    {
+        uint16_t seq;          // 请求序号 (原样回带)
+        uint32_t host_time_us; // 上位机发送时间 (原样回带)
+        uint32_t rx_time_us;   // 飞控收到请求的时间 (微秒低32位)
+        uint32_t tx_time_us;   // 飞控发出响应的时间 (微秒低32位)
+        int8_t rssi;           // 飞控侧测得该客户端的RSSI (dBm), 0=未知
+        uint16_t lost;         // 飞控统计的请求丢失数
+        uint32_t jitter_us;    // 飞控统计的上行到达抖动 (微秒)
+    } __attribute__((packed)) PongPacket_t;
+
+    _Static_assert(sizeof(PongPacket_t) == PKT_LEN_PONG, "PongPacket_t size mismatch");
+
+    /**
+     * 内核微基准测试结果 (每个内核一包) (0x92) - 66 bytes payload
+     */
+    typedef struct
+    {
+        uint8_t kernel;       // 内核序号
+        uint8_t kernel_count; // 本轮内核总数
+        uint16_t iterations;  // 调用次数
+        uint32_t cycles_min;  // 单次调用最少周期数 (已扣除计时开销)
+        uint32_t cycles_mean; // 单次调用平均周期数
+        uint32_t cycles_max;  // 单次调用最多周期数
+        uint16_t cpu_mhz;     // CPU主频 (MHz)
+        char name[16];        // 内核名称
+        char fw_version[32];  // 固件版本 (esp_app_desc)
+    } __attribute__((packed)) BenchResultPacket_t;
+
+    _Static_assert(sizeof(BenchResultPacket_t) == PKT_LEN_BENCH_RESULT, "BenchResultPacket_t size mismatch");
+
+    /**
+     * 电机推力标定结果 (每个标定点一包) (0x93) - 11 bytes payload
+     */
+    typedef struct
+    {
+        uint8_t status;     // 0=默认曲线, 1=已标定(NVS), 2=标定进行中, 3=请求被拒绝, 4=标定已中止
+        uint8_t step;       // 标定点序号
+        uint8_t step_count; // 标定点总数
+        uint16_t duty;      // 该点的PWM占空比 (0-65535)
+        uint16_t rest_mv;   // 标定开始时的空载电池电压 (mV)
+        uint16_t loaded_mv; // 该占空比下的带载电池电压 (mV)
+        uint16_t thrust;    // 推算的相对推力 (0-65535)
+    } __attribute__((packed)) MotorCharResultPacket_t;
+
+    _Static_assert(sizeof(MotorCharResultPacket_t) == PKT_LEN_MOTOR_CHAR_RESULT, "MotorCharResultPacket_t size mismatch");
+
+    /**
+     * 系统辨识状态 (0x94) - 8 bytes payload
+     */
+    typedef struct
+    {
+        uint8_t state;           // 0=完成, 1=激励中, 2=分析中, 3=请求被拒绝, 4=已中止
+        uint8_t axis;            // 辨识的轴
+        uint8_t signal;          // 激励信号类型
+        uint8_t reason;          // 拒绝/中止原因, 见sysid.h
+        uint16_t sample_rate_hz; // 记录采样率 (Hz)
+        uint16_t sample_count;   // 记录的样本数
+    } __attribute__((packed)) SysidStatusPacket_t;
+
+    _Static_assert(sizeof(SysidStatusPacket_t) == PKT_LEN_SYSID_STATUS, "SysidStatusPacket_t size mismatch");
+
+    /**
+     * 系统辨识原始记录 (每包8个样本) (0x95) - 51 bytes payload
+     */
+    typedef struct
+    {
+        uint16_t index;   // 首个样本序号
+        uint8_t count;    // 本包有效样本数
+        char samples[48]; // 样本块, 每样本3个int16(小端): 期望角速度与陀螺仪 (0.1度/秒), 内环输出
+    } __attribute__((packed)) SysidSamplesPacket_t;
+
+    _Static_assert(sizeof(SysidSamplesPacket_t) == PKT_LEN_SYSID_SAMPLES, "SysidSamplesPacket_t size mismatch");
+
+    /**
+     * 系统辨识频率响应 (每个频点一包) (0x96) - 26 bytes payload
+     */
+    typedef struct
+    {
+        uint8_t bin;        // 频点序号
+        uint8_t bin_count;  // 频点总数
+        float freq;         // 频率 (Hz)
+        float closed_gain;  // 闭环 期望角速度→陀螺仪 幅值
+        float closed_phase; // 闭环相位 (度)
+        float plant_gain;   // 对象 内环输出→陀螺仪 幅值 (度/秒/单位输出)
+        float plant_phase;  // 对象相位 (度)
+        float coherence;    // 相干函数 (0-1)
+    } __attribute__((packed)) SysidFrfPacket_t;
+
+    _Static_assert(sizeof(SysidFrfPacket_t) == PKT_LEN_SYSID_FRF, "SysidFrfPacket_t size mismatch");
+
+    // ============================================================================
+    // 字段编解码辅助函数 (小端序, 编码时同步累加校验和)
+    // ============================================================================
+
+    static inline uint8_t *packet_putU8(uint8_t *dst, uint8_t value, uint8_t *sum)
+    {
+        *dst = value;
+        *sum += value;
+        return dst + 1;
+    }
+
+    static inline uint8_t *packet_putI8(uint8_t *dst, int8_t value, uint8_t *sum)
+    {
+        return packet_putU8(dst, (uint8_t)value, sum);
+    }
+
+    static inline uint8_t *packet_putU16(uint8_t *dst, uint16_t value, uint8_t *sum)
+    {
+        dst = packet_putU8(dst, (uint8_t)value, sum);
+        return packet_putU8(dst, (uint8_t)(value >> 8), sum);
+    }
+
+    static inline uint8_t *packet_putI16(uint8_t *dst, int16_t value, uint8_t *sum)
+    {
+        return packet_putU16(dst, (uint16_t)value, sum);
+    }
+
+    static inline uint8_t *packet_putU32(uint8_t *dst, uint32_t value, uint8_t *sum)
+    {
+        dst = packet_putU16(dst, (uint16_t)value, sum);
+        return packet_putU16(dst, (uint16_t)(value >> 16), sum);
+    }
+
+    static inline uint8_t *packet_putI32(uint8_t *dst, int32_t value, uint8_t *sum)
+    {
+        return packet_putU32(dst, (uint32_t)value, sum);
+    }
+
+    static inline uint8_t *packet_putF32(uint8_t *dst, float value, uint8_t *sum)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return packet_putU32(dst, bits, sum);
+    }
+
+    static inline uint8_t packet_getU8(const uint8_t **src)
+    {
+        uint8_t value = (*src)[0];
+        *src += 1;
+        return value;
+    }
+
+    static inline int8_t packet_getI8(const uint8_t **src)
+    {
+        return (int8_t)packet_getU8(src);
+    }
+
+    static inline uint16_t packet_getU16(const uint8_t **src)
+    {
+        uint16_t value = (uint16_t)((*src)[0] | ((uint16_t)(*src)[1] << 8));
+        *src += 2;
+        return value;
+    }
+
+    static inline int16_t packet_getI16(const uint8_t **src)
+    {
+        return (int16_t)packet_getU16(src);
+    }
+
+    static inline uint32_t packet_getU32(const uint8_t **src)
+    {
+        uint32_t value = (uint32_t)(*src)[0] | ((uint32_t)(*src)[1] << 8) |
+                         ((uint32_t)(*src)[2] << 16) | ((uint32_t)(*src)[3] << 24);
+        *src += 4;
+        return value;
+    }
+
+    static inline int32_t packet_getI32(const uint8_t **src)
+    {
+        return (int32_t)packet_getU32(src);
+    }
+
+    static inline float packet_getF32(const uint8_t **src)
+    {
+        uint32_t bits = packet_getU32(src);
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    static inline uint8_t *packet_putChars(uint8_t *dst, const char *value, uint8_t len, uint8_t *sum)
+    {
+        for (uint8_t i = 0; i < len; i++)
+        {
+            dst = packet_putU8(dst, (uint8_t)value[i], sum);
+        }
+        return dst;
+    }
+
+    static inline void packet_getChars(const uint8_t **src, char *out, uint8_t len)
+    {
+        memcpy(out, *src, len);
+        *src += len;
+    }
+
+    // ============================================================================
+    // 编码函数 (单次遍历写入帧头/payload并同步计算校验和)
+    // ============================================================================
+
+    /**
+     * 编码数据包 0x01 - 飞行控制命令
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @param in 数据包内容
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodeFlightControl(uint8_t *buffer, uint16_t buffer_size, const FlightControlPacket_t *in)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_FLIGHT_CONTROL)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_FLIGHT_CONTROL, &sum);
+        p = packet_putU8(p, PKT_LEN_FLIGHT_CONTROL, &sum);
+        p = packet_putF32(p, in->roll, &sum);
+        p = packet_putF32(p, in->pitch, &sum);
+        p = packet_putF32(p, in->yaw, &sum);
+        p = packet_putU16(p, in->thrust, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_FLIGHT_CONTROL;
+    }
+
+    /**
+     * 编码数据包 0x02 - PID参数配置 (一次性发送所有6组PID参数)
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @param in 数据包内容
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodePIDConfig(uint8_t *buffer, uint16_t buffer_size, const PIDConfigPacket_t *in)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_PID_CONFIG)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_PID_CONFIG, &sum);
+        p = packet_putU8(p, PKT_LEN_PID_CONFIG, &sum);
+        p = packet_putF32(p, in->roll_angle_kp, &sum);
+        p = packet_putF32(p, in->roll_angle_ki, &sum);
+        p = packet_putF32(p, in->roll_angle_kd, &sum);
+        p = packet_putF32(p, in->pitch_angle_kp, &sum);
+        p = packet_putF32(p, in->pitch_angle_ki, &sum);
+        p = packet_putF32(p, in->pitch_angle_kd, &sum);
+        p = packet_putF32(p, in->yaw_angle_kp, &sum);
+        p = packet_putF32(p, in->yaw_angle_ki, &sum);
+        p = packet_putF32(p, in->yaw_angle_kd, &sum);
+        p = packet_putF32(p, in->roll_rate_kp, &sum);
+        p = packet_putF32(p, in->roll_rate_ki, &sum);
+        p = packet_putF32(p, in->roll_rate_kd, &sum);
+        p = packet_putF32(p, in->pitch_rate_kp, &sum);
+        p = packet_putF32(p, in->pitch_rate_ki, &sum);
+        p = packet_putF32(p, in->pitch_rate_kd, &sum);
+        p = packet_putF32(p, in->yaw_rate_kp, &sum);
+        p = packet_putF32(p, in->yaw_rate_ki, &sum);
+        p = packet_putF32(p, in->yaw_rate_kd, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_PID_CONFIG;
+    }
+
+    /**
+     * 编码数据包 0x03 - 电机测试
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @param in 数据包内容
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodeMotorTest(uint8_t *buffer, uint16_t buffer_size, const MotorTestPacket_t *in)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_MOTOR_TEST)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_MOTOR_TEST, &sum);
+        p = packet_putU8(p, PKT_LEN_MOTOR_TEST, &sum);
+        p = packet_putU16(p, in->motor1_pwm, &sum);
+        p = packet_putU16(p, in->motor2_pwm, &sum);
+        p = packet_putU16(p, in->motor3_pwm, &sum);
+        p = packet_putU16(p, in->motor4_pwm, &sum);
+        p = packet_putU8(p, in->enable, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_MOTOR_TEST;
+    }
+
+    /**
+     * 编码数据包 0x10 - 心跳包 (无payload)
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodeHeartbeat(uint8_t *buffer, uint16_t buffer_size)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_HEARTBEAT)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_HEARTBEAT, &sum);
+        p = packet_putU8(p, PKT_LEN_HEARTBEAT, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_HEARTBEAT;
+    }
+
+    /**
+     * 编码数据包 0x11 - 订阅遥测 (客户端以单播方式接收, 需心跳保活)
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @param in 数据包内容
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodeSubscribe(uint8_t *buffer, uint16_t buffer_size, const SubscribePacket_t *in)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_SUBSCRIBE)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_SUBSCRIBE, &sum);
+        p = packet_putU8(p, PKT_LEN_SUBSCRIBE, &sum);
+        p = packet_putU8(p, in->hf_rate_hz, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_SUBSCRIBE;
+    }
+
+    /**
+     * 编码数据包 0x12 - 链路测量请求 (飞控原样回带时间戳)
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @param in 数据包内容
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodePing(uint8_t *buffer, uint16_t buffer_size, const PingPacket_t *in)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_PING)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_PING, &sum);
+        p = packet_putU8(p, PKT_LEN_PING, &sum);
+        p = packet_putU16(p, in->seq, &sum);
+        p = packet_putU32(p, in->host_time_us, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_PING;
+    }
+
+    /**
+     * 编码数据包 0x13 - 内核微基准测试请求 (电机空闲时执行)
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @param in 数据包内容
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodeBenchRequest(uint8_t *buffer, uint16_t buffer_size, const BenchRequestPacket_t *in)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_BENCH_REQUEST)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_BENCH_REQUEST, &sum);
+        p = packet_putU8(p, PKT_LEN_BENCH_REQUEST, &sum);
+        p = packet_putU16(p, in->iterations, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_BENCH_REQUEST;
+    }
+
+    /**
+     * 编码数据包 0x14 - 电机推力标定请求 (须固定在测试台上, 电机空闲时执行)
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @param in 数据包内容
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodeMotorCharRequest(uint8_t *buffer, uint16_t buffer_size, const MotorCharRequestPacket_t *in)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_MOTOR_CHAR_REQUEST)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_MOTOR_CHAR_REQUEST, &sum);
+        p = packet_putU8(p, PKT_LEN_MOTOR_CHAR_REQUEST, &sum);
+        p = packet_putU8(p, in->action, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_MOTOR_CHAR_REQUEST;
+    }
+
+    /**
+     * 编码数据包 0x15 - 角速度环系统辨识请求 (须固定在测试台上, 有油门时执行)
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @param in 数据包内容
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodeSysidRequest(uint8_t *buffer, uint16_t buffer_size, const SysidRequestPacket_t *in)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_SYSID_REQUEST)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_SYSID_REQUEST, &sum);
+        p = packet_putU8(p, PKT_LEN_SYSID_REQUEST, &sum);
+        p = packet_putU8(p, in->axis, &sum);
+        p = packet_putU8(p, in->signal, &sum);
+        p = packet_putU16(p, in->duration_ms, &sum);
+        p = packet_putF32(p, in->amplitude, &sum);
+        p = packet_putF32(p, in->f_start, &sum);
+        p = packet_putF32(p, in->f_end, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_SYSID_REQUEST;
+    }
+
+    /**
+     * 编码数据包 0x81 - 高频飞行数据 (50Hz)
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @param in 数据包内容
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodeHighFreqData(uint8_t *buffer, uint16_t buffer_size, const HighFreqDataPacket_t *in)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_HIGH_FREQ_DATA)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_HIGH_FREQ_DATA, &sum);
+        p = packet_putU8(p, PKT_LEN_HIGH_FREQ_DATA, &sum);
+        p = packet_putF32(p, in->roll, &sum);
+        p = packet_putF32(p, in->pitch, &sum);
+        p = packet_putF32(p, in->yaw, &sum);
+        p = packet_putF32(p, in->rollRateDesired, &sum);
+        p = packet_putF32(p, in->pitchRateDesired, &sum);
+        p = packet_putF32(p, in->yawRateDesired, &sum);
+        p = packet_putI16(p, in->rollControl, &sum);
+        p = packet_putI16(p, in->pitchControl, &sum);
+        p = packet_putI16(p, in->yawControl, &sum);
+        p = packet_putU16(p, in->motor1, &sum);
+        p = packet_putU16(p, in->motor2, &sum);
+        p = packet_putU16(p, in->motor3, &sum);
+        p = packet_putU16(p, in->motor4, &sum);
+        p = packet_putF32(p, in->gyroX, &sum);
+        p = packet_putF32(p, in->gyroY, &sum);
+        p = packet_putF32(p, in->gyroZ, &sum);
+        p = packet_putF32(p, in->accX, &sum);
+        p = packet_putF32(p, in->accY, &sum);
+        p = packet_putF32(p, in->accZ, &sum);
+        p = packet_putU16(p, in->timestamp, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_HIGH_FREQ_DATA;
+    }
+
+    /**
+     * 编码数据包 0x82 - 电池状态 (1Hz)
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @param in 数据包内容
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodeBatteryStatus(uint8_t *buffer, uint16_t buffer_size, const BatteryStatusPacket_t *in)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_BATTERY_STATUS)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_BATTERY_STATUS, &sum);
+        p = packet_putU8(p, PKT_LEN_BATTERY_STATUS, &sum);
+        p = packet_putF32(p, in->voltage, &sum);
+        p = packet_putU16(p, in->voltage_mv, &sum);
+        p = packet_putU8(p, in->level, &sum);
+        p = packet_putU8(p, in->state, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_BATTERY_STATUS;
+    }
+
+    /**
+     * 编码数据包 0x83 - PID参数响应 (1Hz)
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @param in 数据包内容
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodePIDResponse(uint8_t *buffer, uint16_t buffer_size, const PIDConfigPacket_t *in)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_PID_RESPONSE)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_PID_RESPONSE, &sum);
+        p = packet_putU8(p, PKT_LEN_PID_RESPONSE, &sum);
+        p = packet_putF32(p, in->roll_angle_kp, &sum);
+        p = packet_putF32(p, in->roll_angle_ki, &sum);
+        p = packet_putF32(p, in->roll_angle_kd, &sum);
+        p = packet_putF32(p, in->pitch_angle_kp, &sum);
+        p = packet_putF32(p, in->pitch_angle_ki, &sum);
+        p = packet_putF32(p, in->pitch_angle_kd, &sum);
+        p = packet_putF32(p, in->yaw_angle_kp, &sum);
+        p = packet_putF32(p, in->yaw_angle_ki, &sum);
+        p = packet_putF32(p, in->yaw_angle_kd, &sum);
+        p = packet_putF32(p, in->roll_rate_kp, &sum);
+        p = packet_putF32(p, in->roll_rate_ki, &sum);
+        p = packet_putF32(p, in->roll_rate_kd, &sum);
+        p = packet_putF32(p, in->pitch_rate_kp, &sum);
+        p = packet_putF32(p, in->pitch_rate_ki, &sum);
+        p = packet_putF32(p, in->pitch_rate_kd, &sum);
+        p = packet_putF32(p, in->yaw_rate_kp, &sum);
+        p = packet_putF32(p, in->yaw_rate_ki, &sum);
+        p = packet_putF32(p, in->yaw_rate_kd, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_PID_RESPONSE;
+    }
+
+    /**
+     * 编码数据包 0x90 - 心跳响应 (无payload)
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodeHeartbeatResp(uint8_t *buffer, uint16_t buffer_size)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_HEARTBEAT_RESP)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_HEARTBEAT_RESP, &sum);
+        p = packet_putU8(p, PKT_LEN_HEARTBEAT_RESP, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_HEARTBEAT_RESP;
+    }
+
+    /**
+     * 编码数据包 0x91 - 链路测量响应
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @param in 数据包内容
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodePong(uint8_t *buffer, uint16_t buffer_size, const PongPacket_t *in)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_PONG)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_PONG, &sum);
+        p = packet_putU8(p, PKT_LEN_PONG, &sum);
+        p = packet_putU16(p, in->seq, &sum);
+        p = packet_putU32(p, in->host_time_us, &sum);
+        p = packet_putU32(p, in->rx_time_us, &sum);
+        p = packet_putU32(p, in->tx_time_us, &sum);
+        p = packet_putI8(p, in->rssi, &sum);
+        p = packet_putU16(p, in->lost, &sum);
+        p = packet_putU32(p, in->jitter_us, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_PONG;
+    }
+
+    /**
+     * 编码数据包 0x92 - 内核微基准测试结果 (每个内核一包)
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @param in 数据包内容
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodeBenchResult(uint8_t *buffer, uint16_t buffer_size, const BenchResultPacket_t *in)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_BENCH_RESULT)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_BENCH_RESULT, &sum);
+        p = packet_putU8(p, PKT_LEN_BENCH_RESULT, &sum);
+        p = packet_putU8(p, in->kernel, &sum);
+        p = packet_putU8(p, in->kernel_count, &sum);
+        p = packet_putU16(p, in->iterations, &sum);
+        p = packet_putU32(p, in->cycles_min, &sum);
+        p = packet_putU32(p, in->cycles_mean, &sum);
+        p = packet_putU32(p, in->cycles_max, &sum);
+        p = packet_putU16(p, in->cpu_mhz, &sum);
+        p = packet_putChars(p, in->name, 16, &sum);
+        p = packet_putChars(p, in->fw_version, 32, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_BENCH_RESULT;
+    }
+
+    /**
+     * 编码数据包 0x93 - 电机推力标定结果 (每个标定点一包)
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @param in 数据包内容
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodeMotorCharResult(uint8_t *buffer, uint16_t buffer_size, const MotorCharResultPacket_t *in)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_MOTOR_CHAR_RESULT)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_MOTOR_CHAR_RESULT, &sum);
+        p = packet_putU8(p, PKT_LEN_MOTOR_CHAR_RESULT, &sum);
+        p = packet_putU8(p, in->status, &sum);
+        p = packet_putU8(p, in->step, &sum);
+        p = packet_putU8(p, in->step_count, &sum);
+        p = packet_putU16(p, in->duty, &sum);
+        p = packet_putU16(p, in->rest_mv, &sum);
+        p = packet_putU16(p, in->loaded_mv, &sum);
+        p = packet_putU16(p, in->thrust, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_MOTOR_CHAR_RESULT;
+    }
+
+    /**
+     * 编码数据包 0x94 - 系统辨识状态
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @param in 数据包内容
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodeSysidStatus(uint8_t *buffer, uint16_t buffer_size, const SysidStatusPacket_t *in)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_SYSID_STATUS)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_SYSID_STATUS, &sum);
+        p = packet_putU8(p, PKT_LEN_SYSID_STATUS, &sum);
+        p = packet_putU8(p, in->state, &sum);
+        p = packet_putU8(p, in->axis, &sum);
+        p = packet_putU8(p, in->signal, &sum);
+        p = packet_putU8(p, in->reason, &sum);
+        p = packet_putU16(p, in->sample_rate_hz, &sum);
+        p = packet_putU16(p, in->sample_count, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_SYSID_STATUS;
+    }
+
+    /**
+     * 编码数据包 0x95 - 系统辨识原始记录 (每包8个样本)
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @param in 数据包内容
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodeSysidSamples(uint8_t *buffer, uint16_t buffer_size, const SysidSamplesPacket_t *in)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_SYSID_SAMPLES)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_SYSID_SAMPLES, &sum);
+        p = packet_putU8(p, PKT_LEN_SYSID_SAMPLES, &sum);
+        p = packet_putU16(p, in->index, &sum);
+        p = packet_putU8(p, in->count, &sum);
+        p = packet_putChars(p, in->samples, 48, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_SYSID_SAMPLES;
+    }
+
+    /**
+     * 编码数据包 0x96 - 系统辨识频率响应 (每个频点一包)
+     * @param buffer 输出缓冲区
+     * @param buffer_size 缓冲区大小
+     * @param in 数据包内容
+     * @return 数据包长度 (0表示缓冲区不足)
+     */
+    static inline uint16_t packet_encodeSysidFrf(uint8_t *buffer, uint16_t buffer_size, const SysidFrfPacket_t *in)
+    {
+        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_SYSID_FRF)
+        {
+            return 0;
+        }
+
+        uint8_t sum = 0;
+        uint8_t *p = packet_putU8(buffer, PKT_ID_SYSID_FRF, &sum);
+        p = packet_putU8(p, PKT_LEN_SYSID_FRF, &sum);
+        p = packet_putU8(p, in->bin, &sum);
+        p = packet_putU8(p, in->bin_count, &sum);
+        p = packet_putF32(p, in->freq, &sum);
+        p = packet_putF32(p, in->closed_gain, &sum);
+        p = packet_putF32(p, in->closed_phase, &sum);
+        p = packet_putF32(p, in->plant_gain, &sum);
+        p = packet_putF32(p, in->plant_phase, &sum);
+        p = packet_putF32(p, in->coherence, &sum);
+        *p = sum;
+
+        return PKT_FRAME_LEN_SYSID_FRF;
+    }
+
+    // ============================================================================
+    // 解码函数 (payload → 结构体)
+    // ============================================================================
+
+    /**
+     * 解码数据包 0x01 payload - 飞行控制命令
+     * @param payload payload数据 (不含帧头和校验和)
+     * @param length payload长度
+     * @param out 输出结构体
+     * @return true=成功, false=长度不匹配
+     */
+    static inline bool packet_decodeFlightControl(const uint8_t *payload, uint8_t length, FlightControlPacket_t *out)
+    {
+        if (payload == NULL || out == NULL || length != PKT_LEN_FLIGHT_CONTROL)
+        {
+            return false;
+        }
+
+        const uint8_t *p = payload;
+        out->roll = packet_getF32(&p);
+        out->pitch = packet_getF32(&p);
+        out->yaw = packet_getF32(&p);
+        out->thrust = packet_getU16(&p);
+
+        return true;
+    }
+
+    /**
+     * 解码数据包 0x02 payload - PID参数配置 (一次性发送所有6组PID参数)
+     * @param payload payload数据 (不含帧头和校验和)
+     * @param length payload长度
+     * @param out 输出结构体
+     * @return true=成功, false=长度不匹配
+     */
+    static inline bool packet_decodePIDConfig(const uint8_t *payload, uint8_t length, PIDConfigPacket_t *out)
+    {
+        if (payload == NULL || out == NULL || length != PKT_LEN_PID_CONFIG)
+        {
+            return false;
+        }
+
+        const uint8_t *p = payload;
+        out->roll_angle_kp = packet_getF32(&p);
+        out->roll_angle_ki = packet_getF32(&p);
+        out->roll_angle_kd = packet_getF32(&p);
+        out->pitch_angle_kp = packet_getF32(&p);
+        out->pitch_angle_ki = packet_getF32(&p);
+        out->pitch_angle_kd = packet_getF32(&p);
+        out->yaw_angle_kp = packet_getF32(&p);
+        out->yaw_angle_ki = packet_getF32(&p);
+        out->yaw_angle_kd = packet_getF32(&p);
+        out->roll_rate_kp = packet_getF32(&p);
+        out->roll_rate_ki = packet_getF32(&p);
+        out->roll_rate_kd = packet_getF32(&p);
+        out->pitch_rate_kp = packet_getF32(&p);
+        out->pitch_rate_ki = packet_getF32(&p);
+        out->pitch_rate_kd = packet_getF32(&p);
+        out->yaw_rate_kp = packet_getF32(&p);
+        out->yaw_rate_ki = packet_getF32(&p);
+        out->yaw_rate_kd = packet_getF32(&p);
+
+        return true;
+    }
+
+    /**
+     * 解码数据包 0x03 payload - 电机测试
+     * @param payload payload数据 (不含帧头和校验和)
+     * @param length payload长度
+     * @param out 输出结构体
+     * @return true=成功, false=长度不匹配
+     */
+    static inline bool packet_decodeMotorTest(const uint8_t *payload, uint8_t length, MotorTestPacket_t *out)
+    {
+        if (payload == NULL || out == NULL || length != PKT_LEN_MOTOR_TEST)
+        {
+            return false;
+        }
+
+        const uint8_t *p = payload;
+        out->motor1_pwm = packet_getU16(&p);
+        out->motor2_pwm = packet_getU16(&p);
+        out->motor3_pwm = packet_getU16(&p);
+        out->motor4_pwm = packet_getU16(&p);
+        out->enable = packet_getU8(&p);
+
+        return true;
+    }
+
+    /**
+     * 解码数据包 0x11 payload - 订阅遥测 (客户端以单播方式接收, 需心跳保活)
+     * @param payload payload数据 (不含帧头和校验和)
+     * @param length payload长度
+     * @param out 输出结构体
+     * @return true=成功, false=长度不匹配
+     */
+    static inline bool packet_decodeSubscribe(const uint8_t *payload, uint8_t length, SubscribePacket_t *out)
+    {
+        if (payload == NULL || out == NULL || length != PKT_LEN_SUBSCRIBE)
+        {
+            return false;
+        }
+
+        const uint8_t *p = payload;
+        out->hf_rate_hz = packet_getU8(&p);
+
+        return true;
+    }
+
+    /**
+     * 解码数据包 0x12 payload - 链路测量请求 (飞控原样回带时间戳)
+     * @param payload payload数据 (不含帧头和校验和)
+     * @param length payload长度
+     * @param out 输出结构体
+     * @return true=成功, false=长度不匹配
+     */
+    static inline bool packet_decodePing(const uint8_t *payload, uint8_t length, PingPacket_t *out)
+    {
+        if (payload == NULL || out == NULL || length != PKT_LEN_PING)
+        {
+            return false;
+        }
+
+        const uint8_t *p = payload;
+        out->seq = packet_getU16(&p);
+        out->host_time_us = packet_getU32(&p);
+
+        return true;
+    }
+
+    /**
+     * 解码数据包 0x13 payload - 内核微基准测试请求 (电机空闲时执行)
+     * @param payload payload数据 (不含帧头和校验和)
+     * @param length payload长度
+     * @param out 输出结构体
+     * @return true=成功, false=长度不匹配
+     */
+    static inline bool packet_decodeBenchRequest(const uint8_t *payload, uint8_t length, BenchRequestPacket_t *out)
+    {
+        if (payload == NULL || out == NULL || length != PKT_LEN_BENCH_REQUEST)
+        {
+            return false;
+        }
+
+        const uint8_t *p = payload;
+        out->iterations = packet_getU16(&p);
+
+        return true;
+    }
+
+    /**
+     * 解码数据包 0x14 payload - 电机推力标定请求 (须固定在测试台上, 电机空闲时执行)
+     * @param payload payload数据 (不含帧头和校验和)
+     * @param length payload长度
+     * @param out 输出结构体
+     * @return true=成功, false=长度不匹配
+     */
+    static inline bool packet_decodeMotorCharRequest(const uint8_t *payload, uint8_t length, MotorCharRequestPacket_t *out)
+    {
+        if (payload == NULL || out == NULL || length != PKT_LEN_MOTOR_CHAR_REQUEST)
+        {
+            return false;
+        }
+
+        const uint8_t *p = payload;
+        out->action = packet_getU8(&p);
+
+        return true;
+    }
+
+    /**
+     * 解码数据包 0x15 payload - 角速度环系统辨识请求 (须固定在测试台上, 有油门时执行)
+     * @param payload payload数据 (不含帧头和校验和)
+     * @param length payload长度
+     * @param out 输出结构体
+     * @return true=成功, false=长度不匹配
+     */
+    static inline bool packet_decodeSysidRequest(const uint8_t *payload, uint8_t length, SysidRequestPacket_t *out)
+    {
+        if (payload == NULL || out == NULL || length != PKT_LEN_SYSID_REQUEST)
+        {
+            return false;
+        }
+
+        const uint8_t *p = payload;
+        out->axis = packet_getU8(&p);
+        out->signal = packet_getU8(&p);
+        out->duration_ms = packet_getU16(&p);
+        out->amplitude = packet_getF32(&p);
+        out->f_start = packet_getF32(&p);
+        out->f_end = packet_getF32(&p);
+
+        return true;
+    }
+
+    /**
+     * 解码数据包 0x81 payload - 高频飞行数据 (50Hz)
+     * @param payload payload数据 (不含帧头和校验和)
+     * @param length payload长度
+     * @param out 输出结构体
+     * @return true=成功, false=长度不匹配
+     */
+    static inline bool packet_decodeHighFreqData(const uint8_t *payload, uint8_t length, HighFreqDataPacket_t *out)
+    {
+        if (payload == NULL || out == NULL || length != PKT_LEN_HIGH_FREQ_DATA)
+        {
+            return false;
+        }
+
+        const uint8_t *p = payload;
+        out->roll = packet_getF32(&p);
+        out->pitch = packet_getF32(&p);
+        out->yaw = packet_getF32(&p);
+        out->rollRateDesired = packet_getF32(&p);
+        out->pitchRateDesired = packet_getF32(&p);
+        out->yawRateDesired = packet_getF32(&p);
+        out->rollControl = packet_getI16(&p);
+        out->pitchControl = packet_getI16(&p);
+        out->yawControl = packet_getI16(&p);
+        out->motor1 = packet_getU16(&p);
+        out->motor2 = packet_getU16(&p);
+        out->motor3 = packet_getU16(&p);
+        out->motor4 = packet_getU16(&p);
+        out->gyroX = packet_getF32(&p);
+        out->gyroY = packet_getF32(&p);
+        out->gyroZ = packet_getF32(&p);
+        out->accX = packet_getF32(&p);
+        out->accY = packet_getF32(&p);
+        out->accZ = packet_getF32(&p);
+        out->timestamp = packet_getU16(&p);
+
+        return true;
+    }
+
+    /**
+     * 解码数据包 0x82 payload - 电池状态 (1Hz)
+     * @param payload payload数据 (不含帧头和校验和)
+     * @param length payload长度
+     * @param out 输出结构体
+     * @return true=成功, false=长度不匹配
+     */
+    static inline bool packet_decodeBatteryStatus(const uint8_t *payload, uint8_t length, BatteryStatusPacket_t *out)
+    {
+        if (payload == NULL || out == NULL || length != PKT_LEN_BATTERY_STATUS)
+        {
+            return false;
+        }
+
+        const uint8_t *p = payload;
+        out->voltage = packet_getF32(&p);
+        out->voltage_mv = packet_getU16(&p);
+        out->level = packet_getU8(&p);
+        out->state = packet_getU8(&p);
+
+        return true;
+    }
+
+    /**
+     * 解码数据包 0x83 payload - PID参数响应 (1Hz)
+     * @param payload payload数据 (不含帧头和校验和)
+     * @param length payload长度
+     * @param out 输出结构体
+     * @return true=成功, false=长度不匹配
+     */
+    static inline bool packet_decodePIDResponse(const uint8_t *payload, uint8_t length, PIDConfigPacket_t *out)
+    {
+        if (payload == NULL || out == NULL || length != PKT_LEN_PID_RESPONSE)
+        {
+            return false;
+        }
+
+        const uint8_t *p = payload;
+        out->roll_angle_kp = packet_getF32(&p);
+        out->roll_angle_ki = packet_getF32(&p);
+        out->roll_angle_kd = packet_getF32(&p);
+        out->pitch_angle_kp = packet_getF32(&p);
+        out->pitch_angle_ki = packet_getF32(&p);
+        out->pitch_angle_kd = packet_getF32(&p);
+        out->yaw_angle_kp = packet_getF32(&p);
+        out->yaw_angle_ki = packet_getF32(&p);
+        out->yaw_angle_kd = packet_getF32(&p);
+        out->roll_rate_kp = packet_getF32(&p);
+        out->roll_rate_ki = packet_getF32(&p);
+        out->roll_rate_kd = packet_getF32(&p);
+        out->pitch_rate_kp = packet_getF32(&p);
+        out->pitch_rate_ki = packet_getF32(&p);
+        out->pitch_rate_kd = packet_getF32(&p);
+        out->yaw_rate_kp = packet_getF32(&p);
+        out->yaw_rate_ki = packet_getF32(&p);
+        out->yaw_rate_kd = packet_getF32(&p);
+
+        return true;
+    }
+
+    /**
+     * 解码数据包 0x91 payload - 链路测量响应
+     * @param payload payload数据 (不含帧头和校验和)
+     * @param length payload长度
+     * @param out 输出结构体
+     * @return true=成功, false=长度不匹配
+     */
+    static inline bool packet_decodePong(const uint8_t *payload, uint8_t length, PongPacket_t *out)
+    {
+        if (payload == NULL || out == NULL || length != PKT_LEN_PONG)
+        {
+            return false;
+        }
+
+        const uint8_t *p = payload;
+        out->seq = packet_getU16(&p);
+        out->host_time_us = packet_getU32(&p);
+        out->rx_time_us = packet_getU32(&p);
+        out->tx_time_us = packet_getU32(&p);
+        out->rssi = packet_getI8(&p);
+        out->lost = packet_getU16(&p);
+        out->jitter_us = packet_getU32(&p);
+
+        return true;
+    }
+
+    /**
+     * 解码数据包 0x92 payload - 内核微基准测试结果 (每个内核一包)
+     * @param payload payload数据 (不含帧头和校验和)
+     * @param length payload长度
+     * @param out 输出结构体
+     * @return true=成功, false=长度不匹配
+     */
+    static inline bool packet_decodeBenchResult(const uint8_t *payload, uint8_t length, BenchResultPacket_t *out)
+    {
+        if (payload == NULL || out == NULL || length != PKT_LEN_BENCH_RESULT)
+        {
+            return false;
+        }
+
+        const uint8_t *p = payload;
+        out->kernel = packet_getU8(&p);
+        out->kernel_count = packet_getU8(&p);
+        out->iterations = packet_getU16(&p);
+        out->cycles_min = packet_getU32(&p);
+        out->cycles_mean = packet_getU32(&p);
+        out->cycles_max = packet_getU32(&p);
+        out->cpu_mhz = packet_getU16(&p);
+        packet_getChars(&p, out->name, 16);
+        packet_getChars(&p, out->fw_version, 32);
+
+        return true;
+    }
+
+    /**
+     * 解码数据包 0x93 payload - 电机推力标定结果 (每个标定点一包)
+     * @param payload payload数据 (不含帧头和校验和)
+     * @param length payload长度
+     * @param out 输出结构体
+     * @return true=成功, false=长度不匹配
+     */
+    static inline bool packet_decodeMotorCharResult(const uint8_t *payload, uint8_t length, MotorCharResultPacket_t *out)
+    {
+        if (payload == NULL || out == NULL || length != PKT_LEN_MOTOR_CHAR_RESULT)
+        {
+            return false;
+        }
+
+        const uint8_t *p = payload;
+        out->status = packet_getU8(&p);
+        out->step = packet_getU8(&p);
+        out->step_count = packet_getU8(&p);
+        out->duty = packet_getU16(&p);
+        out->rest_mv = packet_getU16(&p);
+        out->loaded_mv = packet_getU16(&p);
+        out->thrust = packet_getU16(&p);
+
+        return true;
+    }
+
+    /**
+     * 解码数据包 0x94 payload - 系统辨识状态
+     * @param payload payload数据 (不含帧头和校验和)
+     * @param length payload长度
+     * @param out 输出结构体
+     * @return true=成功, false=长度不匹配
+     */
+    static inline bool packet_decodeSysidStatus(const uint8_t *payload, uint8_t length, SysidStatusPacket_t *out)
+    {
+        if (payload == NULL || out == NULL || length != PKT_LEN_SYSID_STATUS)
+        {
+            return false;
+        }
+
+        const uint8_t *p = payload;
+        out->state = packet_getU8(&p);
+        out->axis = packet_getU8(&p);
+        out->signal = packet_getU8(&p);
+        out->reason = packet_getU8(&p);
+        out->sample_rate_hz = packet_getU16(&p);
+        out->sample_count = packet_getU16(&p);
+
+        return true;
+    }
+
+    /**
+     * 解码数据包 0x95 payload - 系统辨识原始记录 (每包8个样本)
+     * @param payload payload数据 (不含帧头和校验和)
+     * @param length payload长度
+     * @param out 输出结构体
+     * @return true=成功, false=长度不匹配
+     */
+    static inline bool packet_decodeSysidSamples(const uint8_t *payload, uint8_t length, SysidSamplesPacket_t *out)
+    {
+        if (payload == NULL || out == NULL || length != PKT_LEN_SYSID_SAMPLES)
+        {
+            return false;
+        }
+
+        const uint8_t *p = payload;
+        out->index = packet_getU16(&p);
+        out->count = packet_getU8(&p);
+        packet_getChars(&p, out->samples, 48);
+
+        return true;
+    }
+
+    /**
+     * 解码数据包 0x96 payload - 系统辨识频率响应 (每个频点一包)
+     * @param payload payload数据 (不含帧头和校验和)
+     * @param length payload长度
+     * @param out 输出结构体
+     * @return true=成功, false=长度不匹配
+     */
+    static inline bool packet_decodeSysidFrf(const uint8_t *payload, uint8_t length, SysidFrfPacket_t *out)
+    {
+        if (payload == NULL || out == NULL || length != PKT_LEN_SYSID_FRF)
+        {
+            return false;
+        }
+
+        const uint8_t *p = payload;
+        out->bin = packet_getU8(&p);
+        out->bin_count = packet_getU8(&p);
+        out->freq = packet_getF32(&p);
+        out->closed_gain = packet_getF32(&p);
+        out->closed_phase = packet_getF32(&p);
+        out->plant_gain = packet_getF32(&p);
+        out->plant_phase = packet_getF32(&p);
+        out->coherence = packet_getF32(&p);
+
+        return true;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __PACKET_DEFS_H__
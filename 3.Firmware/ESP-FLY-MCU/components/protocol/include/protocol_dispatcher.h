@@ -6,6 +6,7 @@
 #define __PROTOCOL_DISPATCHER_H__
 
 #include <stdbool.h>
+#include "packet_codec.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -21,6 +22,14 @@ void protocolDispatcherInit(void);
  */
 bool protocolDispatcherTest(void);
 
+/**
+ * 获取客户端v2上行数据报的接收统计 (丢包/乱序)
+ * @param client 客户端索引
+ * @param stats 输出的统计数据
+ * @return false=客户端索引无效
+ */
+bool protocolDispatcherGetRxStats(uint8_t client, PacketSeqStats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
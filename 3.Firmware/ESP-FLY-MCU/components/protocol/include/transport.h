@@ -0,0 +1,125 @@
+/**
+ * Transport - 传输层抽象
+ *
+ * 协议层通过本接口收发数据报, 不直接依赖具体链路:
+ * - transportUdp:      softAP + lwIP UDP (默认)
+ * - transportEspNow:   ESP-NOW 无连接链路, 单包开销更小
+ * - transportPosix:    Linux UDP (仅主机构建, 用于回环测试与基准测试)
+ *
+ * 所有后端共用同一套客户端语义: 收到数据即登记/刷新发送方, 超时注销;
+ * 有登记客户端时单播, 否则广播
+ */
+
+#ifndef __TRANSPORT_H__
+#define __TRANSPORT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRANSPORT_MTU (128)             // 单个数据报最大长度
+#define TRANSPORT_MAX_CLIENTS (4)       // 客户端注册表容量
+#define TRANSPORT_CLIENT_NONE (0xFF)    // 发送方未登记
+#define TRANSPORT_CLIENT_NEW (0x80)     // 与客户端索引或运算: 该客户端刚刚登记
+#define TRANSPORT_DEST_BROADCAST (0x80) // 目标掩码: 广播 (仅用于发现)
+#define TRANSPORT_WAIT_FOREVER (0xFFFFFFFFu)
+
+    /**
+     * 传输层数据报
+     */
+    typedef struct
+    {
+        uint8_t size;   // 数据长度
+        uint8_t client; // RX: 发送方客户端索引 (可能带TRANSPORT_CLIENT_NEW)
+        uint8_t data[TRANSPORT_MTU];
+    } TransportPacket;
+
+    /**
+     * 传输后端操作表
+     */
+    typedef struct
+    {
+        const char *name;
+
+        /** 初始化后端, 失败返回false */
+        bool (*init)(void);
+
+        /** 接收一个数据报, 超时返回false */
+        bool (*receive)(TransportPacket *in, uint32_t timeoutMs);
+
+        /** 发送到客户端掩码或TRANSPORT_DEST_BROADCAST, 不阻塞, 发送队列满返回false */
+        bool (*send)(uint8_t dest, const uint8_t *data, uint32_t size);
+
+        /** 当前登记的客户端掩码 (同时注销超时客户端) */
+        uint8_t (*clientMask)(void);
+
+        /** 客户端的RSSI (dBm), 0=未知 */
+        int8_t (*clientRssi)(uint8_t client);
+    } TransportOps;
+
+    extern const TransportOps transportUdp;
+    extern const TransportOps transportEspNow;
+    extern const TransportOps transportPosix;
+
+#if defined(CONFIG_TRANSPORT_ESPNOW)
+#define TRANSPORT_DEFAULT (&transportEspNow)
+#else
+#define TRANSPORT_DEFAULT (&transportUdp)
+#endif
+
+    /**
+     * 选择并初始化传输后端
+     * @param ops 后端操作表
+     */
+    void transportInit(const TransportOps *ops);
+
+    /**
+     * 测试传输层是否已初始化
+     */
+    bool transportTest(void);
+
+    /**
+     * 当前后端名称
+     */
+    const char *transportName(void);
+
+    /**
+     * 接收一个数据报
+     * @param in 输出的数据报
+     * @param timeoutMs 超时 (毫秒), TRANSPORT_WAIT_FOREVER=一直等待
+     * @return true=收到数据
+     */
+    bool transportReceive(TransportPacket *in, uint32_t timeoutMs);
+
+    /**
+     * 发送数据报
+     * @param dest 客户端掩码或TRANSPORT_DEST_BROADCAST
+     * @param data 数据
+     * @param size 数据长度 (不超过TRANSPORT_MTU)
+     * @return true=已进入发送队列
+     */
+    bool transportSendTo(uint8_t dest, const uint8_t *data, uint32_t size);
+
+    /**
+     * 发送给全部登记客户端, 无客户端时广播
+     */
+    bool transportSend(const uint8_t *data, uint32_t size);
+
+    /**
+     * 当前登记的客户端掩码
+     */
+    uint8_t transportGetClientMask(void);
+
+    /**
+     * 客户端的RSSI (dBm), 0=未知
+     */
+    int8_t transportGetClientRssi(uint8_t client);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __TRANSPORT_H__
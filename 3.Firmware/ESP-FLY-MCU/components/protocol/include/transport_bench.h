@@ -0,0 +1,69 @@
+/**
+ * Transport Bench - 传输层回环基准测试
+ *
+ * 发起端发送以TRANSPORT_BENCH_MAGIC开头的探测包, 反射端原样回送给发送方.
+ * 时延阶段逐包往返测量 (单向时延按RTT/2估算), 吞吐阶段以滑动窗口突发并统计回送的字节速率.
+ * 本模块只依赖transport.h, 固件与主机可共用.
+ */
+
+#ifndef __TRANSPORT_BENCH_H__
+#define __TRANSPORT_BENCH_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRANSPORT_BENCH_MAGIC (0xBE)    // 探测包首字节, 不与协议帧头0xAA和v2魔数0xA5冲突
+#define TRANSPORT_BENCH_HEADER_SIZE (8) // magic + phase + seq(u16) + t_us(u32)
+
+    /**
+     * 微秒时钟, 由调用方提供
+     */
+    typedef uint64_t (*TransportBenchClock)(void);
+
+    /**
+     * 基准测试结果
+     */
+    typedef struct
+    {
+        uint16_t pingSent;        // 时延阶段发送数
+        uint16_t pingReceived;    // 时延阶段收到的回送数
+        uint32_t latencyMinUs;    // 单向时延最小值 (RTT/2)
+        uint32_t latencyAvgUs;    // 单向时延平均值 (RTT/2)
+        uint32_t latencyMaxUs;    // 单向时延最大值 (RTT/2)
+        uint16_t burstSent;       // 吞吐阶段发送数
+        uint16_t burstReceived;   // 吞吐阶段收到的回送数
+        uint32_t throughputBps;   // 回送有效字节速率 (字节/秒)
+    } TransportBenchResult;
+
+    /**
+     * 判断数据报是否为基准测试探测包
+     */
+    bool transportBenchIsPacket(const uint8_t *data, uint32_t size);
+
+    /**
+     * 反射端: 将探测包原样回送给发送方
+     * @param in 收到的数据报 (client为发送方索引)
+     */
+    void transportBenchReflect(const TransportPacket *in);
+
+    /**
+     * 发起端: 运行时延与吞吐测试, 期间独占transportReceive
+     * @param dest 反射端的客户端掩码或TRANSPORT_DEST_BROADCAST
+     * @param count 每个阶段的探测包数量
+     * @param size 探测包长度 (TRANSPORT_BENCH_HEADER_SIZE ~ TRANSPORT_MTU)
+     * @param clock 微秒时钟
+     * @param result 输出结果
+     */
+    void transportBenchRun(uint8_t dest, uint16_t count, uint8_t size,
+                           TransportBenchClock clock, TransportBenchResult *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __TRANSPORT_BENCH_H__
@@ -0,0 +1,90 @@
+/**
+ * Link Monitor - 链路质量测量模块
+ */
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "link_monitor.h"
+#include "data_sender.h"
+#include "transport.h"
+#include "stm32_legacy.h"
+
+#define DEBUG_MODULE "LINK_MON"
+#include "debug_cf.h"
+
+static LinkStats_t linkStats[TRANSPORT_MAX_CLIENTS];
+static uint32_t jitterQ4[TRANSPORT_MAX_CLIENTS]; // 抖动估计 x16, 避免整数除法损失精度
+
+/**
+ * 更新上行到达抖动: J += (|D| - J) / 16 (RFC 3550)
+ */
+static void updateJitter(uint8_t client, int32_t transit)
+{
+    LinkStats_t *stats = &linkStats[client];
+
+    if (stats->seq.received > 1)
+    {
+        int32_t d = transit - stats->lastTransitUs;
+        uint32_t absD = (uint32_t)(d < 0 ? -d : d);
+        jitterQ4[client] += absD - ((jitterQ4[client] + 8) >> 4);
+        stats->jitterUs = jitterQ4[client] >> 4;
+    }
+    stats->lastTransitUs = transit;
+}
+
+void linkMonitorHandlePing(uint8_t client, const PingPacket_t *ping, uint32_t rxTimeUs)
+{
+    PongPacket_t pong = {
+        .seq = ping->seq,
+        .host_time_us = ping->host_time_us,
+        .rx_time_us = rxTimeUs,
+    };
+
+    if (client < TRANSPORT_MAX_CLIENTS)
+    {
+        LinkStats_t *stats = &linkStats[client];
+        uint32_t reordered = stats->seq.reordered;
+
+        packet_seqTrack(&stats->seq, ping->seq);
+
+        // 乱序到达的请求不参与抖动计算
+        if (stats->seq.reordered == reordered)
+        {
+            updateJitter(client, (int32_t)(rxTimeUs - ping->host_time_us));
+        }
+        stats->rssi = transportGetClientRssi(client);
+
+        pong.rssi = stats->rssi;
+        pong.lost = (uint16_t)(stats->seq.lost > UINT16_MAX ? UINT16_MAX : stats->seq.lost);
+        pong.jitter_us = stats->jitterUs;
+    }
+
+    uint8_t frame[PKT_FRAME_LEN_PONG];
+    pong.tx_time_us = (uint32_t)usecTimestamp();
+    uint16_t len = packet_encodePong(frame, sizeof(frame), &pong);
+    dataSenderSendFrame(client, frame, len);
+}
+
+void linkMonitorResetClient(uint8_t client)
+{
+    if (client >= TRANSPORT_MAX_CLIENTS)
+    {
+        return;
+    }
+
+    memset(&linkStats[client], 0, sizeof(linkStats[client]));
+    jitterQ4[client] = 0;
+}
+
+bool linkMonitorGetStats(uint8_t client, LinkStats_t *stats)
+{
+    if (client >= TRANSPORT_MAX_CLIENTS)
+    {
+        return false;
+    }
+
+    *stats = linkStats[client];
+    return true;
+}
@@ -63,21 +63,14 @@ bool packet_pack(PacketFrame_t *packet, uint8_t packet_id,
     packet->packet_id = packet_id;
     packet->length = payload_len;
 
-    if (payload_len > 0)
+    // 单次遍历: 拷贝payload的同时累加校验和 (PacketID + Length + Payload)
+    uint8_t checksum = packet_id + payload_len;
+    for (uint8_t i = 0; i < payload_len; i++)
     {
-        memcpy(packet->payload, payload, payload_len);
+        packet->payload[i] = payload[i];
+        checksum += payload[i];
     }
-
-    // 计算校验和 (PacketID + Length + Payload)
-    uint8_t temp_buffer[PACKET_MAX_SIZE];
-    temp_buffer[0] = packet->packet_id;
-    temp_buffer[1] = packet->length;
-    if (payload_len > 0)
-    {
-        memcpy(&temp_buffer[2], packet->payload, payload_len);
-    }
-
-    packet->checksum = packet_calculateChecksum(temp_buffer, 2 + payload_len);
+    packet->checksum = checksum;
 
     return true;
 }
@@ -123,41 +116,42 @@ bool packet_parse(const uint8_t *buffer, uint16_t buffer_len, PacketFrame_t *pac
     }
 
     // 最小长度检查: PacketID + Length + Checksum = 3
-    if (buffer_len < 3)
+    if (buffer_len < PACKET_HEADER_SIZE + PACKET_CHECKSUM_SIZE)
     {
         return false;
     }
 
-    // 验证校验和
-    if (!packet_verifyChecksum(buffer, buffer_len))
-    {
-        return false;
-    }
-
-    // 解析头部
-    packet->packet_id = buffer[0];
-    packet->length = buffer[1];
+    uint8_t length = buffer[1];
 
     // 长度验证
-    if (packet->length > PACKET_MAX_PAYLOAD_SIZE)
+    if (length > PACKET_MAX_PAYLOAD_SIZE)
     {
         return false;
     }
 
     // 验证缓冲区长度是否匹配
-    uint16_t expected_len = 2 + packet->length + 1;
-    if (buffer_len != expected_len)
+    if (buffer_len != PACKET_HEADER_SIZE + length + PACKET_CHECKSUM_SIZE)
     {
         return false;
     }
 
-    // 提取payload
-    if (packet->length > 0)
+    // 单次遍历: 提取payload的同时累加校验和
+    uint8_t checksum = buffer[0] + length;
+    for (uint8_t i = 0; i < length; i++)
     {
-        memcpy(packet->payload, &buffer[2], packet->length);
+        packet->payload[i] = buffer[PACKET_HEADER_SIZE + i];
+        checksum += packet->payload[i];
     }
 
-    packet->checksum = buffer[buffer_len - 1];
+    // 验证校验和
+    if (checksum != buffer[buffer_len - 1])
+    {
+        return false;
+    }
+
+    packet->packet_id = buffer[0];
+    packet->length = length;
+    packet->checksum = checksum;
 
     return true;
 }
@@ -177,14 +171,7 @@ uint16_t packet_createHighFreqData(uint8_t *buffer, uint16_t buffer_size,
         return 0;
     }
 
-    PacketFrame_t packet;
-    if (!packet_pack(&packet, PKT_ID_HIGH_FREQ_DATA,
-                     (const uint8_t *)hf_data, sizeof(HighFreqDataPacket_t)))
-    {
-        return 0;
-    }
-
-    return packet_serialize(&packet, buffer, buffer_size);
+    return packet_encodeHighFreqData(buffer, buffer_size, hf_data);
 }
 
 /**
@@ -198,14 +185,7 @@ uint16_t packet_createBatteryStatus(uint8_t *buffer, uint16_t buffer_size,
         return 0;
     }
 
-    PacketFrame_t packet;
-    if (!packet_pack(&packet, PKT_ID_BATTERY_STATUS,
-                     (const uint8_t *)battery, sizeof(BatteryStatusPacket_t)))
-    {
-        return 0;
-    }
-
-    return packet_serialize(&packet, buffer, buffer_size);
+    return packet_encodeBatteryStatus(buffer, buffer_size, battery);
 }
 
 /**
@@ -219,14 +199,7 @@ uint16_t packet_createPIDResponse(uint8_t *buffer, uint16_t buffer_size,
         return 0;
     }
 
-    PacketFrame_t packet;
-    if (!packet_pack(&packet, PKT_ID_PID_RESPONSE,
-                     (const uint8_t *)pid_config, sizeof(PIDConfigPacket_t)))
-    {
-        return 0;
-    }
-
-    return packet_serialize(&packet, buffer, buffer_size);
+    return packet_encodePIDResponse(buffer, buffer_size, pid_config);
 }
 
 // ============================================================================
@@ -248,13 +221,7 @@ bool packet_parseFlightControl(const PacketFrame_t *packet, FlightControlPacket_
         return false;
     }
 
-    if (packet->length != sizeof(FlightControlPacket_t))
-    {
-        return false;
-    }
-
-    memcpy(fc_packet, packet->payload, sizeof(FlightControlPacket_t));
-    return true;
+    return packet_decodeFlightControl(packet->payload, packet->length, fc_packet);
 }
 
 /**
@@ -272,35 +239,331 @@ bool packet_parsePIDConfig(const PacketFrame_t *packet, PIDConfigPacket_t *pid_c
         return false;
     }
 
-    if (packet->length != sizeof(PIDConfigPacket_t))
+    return packet_decodePIDConfig(packet->payload, packet->length, pid_config);
+}
+
+/**
+ * 解析电机测试包
+ */
+bool packet_parseMotorTest(const PacketFrame_t *packet, MotorTestPacket_t *motor_test)
+{
+    if (packet == NULL || motor_test == NULL)
+    {
+        return false;
+    }
+
+    if (packet->packet_id != PKT_ID_MOTOR_TEST)
+    {
+        return false;
+    }
+
+    return packet_decodeMotorTest(packet->payload, packet->length, motor_test);
+}
+
+/**
+ * 解析订阅包
+ */
+bool packet_parseSubscribe(const PacketFrame_t *packet, SubscribePacket_t *subscribe)
+{
+    if (packet == NULL || subscribe == NULL)
+    {
+        return false;
+    }
+
+    if (packet->packet_id != PKT_ID_SUBSCRIBE)
+    {
+        return false;
+    }
+
+    return packet_decodeSubscribe(packet->payload, packet->length, subscribe);
+}
+
+/**
+ * 解析链路测量请求包
+ */
+bool packet_parsePing(const PacketFrame_t *packet, PingPacket_t *ping)
+{
+    if (packet == NULL || ping == NULL)
+    {
+        return false;
+    }
+
+    if (packet->packet_id != PKT_ID_PING)
+    {
+        return false;
+    }
+
+    return packet_decodePing(packet->payload, packet->length, ping);
+}
+
+/**
+ * 解析内核微基准测试请求包
+ */
+bool packet_parseBenchRequest(const PacketFrame_t *packet, BenchRequestPacket_t *request)
+{
+    if (packet == NULL || request == NULL)
+    {
+        return false;
+    }
+
+    if (packet->packet_id != PKT_ID_BENCH_REQUEST)
+    {
+        return false;
+    }
+
+    return packet_decodeBenchRequest(packet->payload, packet->length, request);
+}
+
+/**
+ * 解析电机推力标定请求包
+ */
+bool packet_parseMotorCharRequest(const PacketFrame_t *packet, MotorCharRequestPacket_t *request)
+{
+    if (packet == NULL || request == NULL)
+    {
+        return false;
+    }
+
+    if (packet->packet_id != PKT_ID_MOTOR_CHAR_REQUEST)
     {
         return false;
     }
 
-    memcpy(pid_config, packet->payload, sizeof(PIDConfigPacket_t));
+    return packet_decodeMotorCharRequest(packet->payload, packet->length, request);
+}
+
+/**
+ * 解析系统辨识请求包
+ */
+bool packet_parseSysidRequest(const PacketFrame_t *packet, SysidRequestPacket_t *request)
+{
+    if (packet == NULL || request == NULL)
+    {
+        return false;
+    }
+
+    if (packet->packet_id != PKT_ID_SYSID_REQUEST)
+    {
+        return false;
+    }
+
+    return packet_decodeSysidRequest(packet->payload, packet->length, request);
+}
+
+// ============================================================================
+// 协议v2 数据报
+// ============================================================================
+
+// CRC16-CCITT 查表 (多项式0x1021)
+static const uint16_t crc16Table[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+};
+
+/**
+ * 计算CRC16-CCITT
+ */
+uint16_t packet_crc16(const uint8_t *data, uint16_t len, uint16_t crc)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        crc = (uint16_t)(crc << 8) ^ crc16Table[(uint8_t)(crc >> 8) ^ data[i]];
+    }
+    return crc;
+}
+
+/**
+ * 开始构建v2数据报
+ */
+void packet_datagramBegin(PacketDatagram_t *dg, uint8_t *buffer, uint16_t capacity)
+{
+    dg->buffer = buffer;
+    dg->capacity = capacity;
+    dg->length = PACKET_V2_HEADER_SIZE;
+    dg->frame_count = 0;
+}
+
+/**
+ * 获取数据报当前写入位置
+ */
+uint8_t *packet_datagramTail(const PacketDatagram_t *dg, uint16_t *space)
+{
+    if (dg->capacity < dg->length + PACKET_V2_CRC_SIZE)
+    {
+        *space = 0;
+    }
+    else
+    {
+        *space = dg->capacity - dg->length - PACKET_V2_CRC_SIZE;
+    }
+    return &dg->buffer[dg->length];
+}
+
+/**
+ * 确认在写入位置编码的一帧
+ */
+bool packet_datagramCommit(PacketDatagram_t *dg, uint16_t frame_len)
+{
+    uint16_t space;
+    packet_datagramTail(dg, &space);
+
+    if (frame_len == 0 || frame_len > space)
+    {
+        return false;
+    }
+
+    dg->length += frame_len;
+    dg->frame_count++;
     return true;
 }
 
 /**
- * 解析电机测试包
+ * 完成数据报: 写入头部并追加CRC
  */
-bool packet_parseMotorTest(const PacketFrame_t *packet, MotorTestPacket_t *motor_test)
+uint16_t packet_datagramFinish(PacketDatagram_t *dg, uint16_t seq, uint32_t timestamp)
 {
-    if (packet == NULL || motor_test == NULL)
+    if (dg->frame_count == 0)
+    {
+        return 0;
+    }
+
+    uint8_t *buffer = dg->buffer;
+    buffer[0] = PACKET_V2_MAGIC;
+    buffer[1] = PACKET_V2_VERSION;
+    buffer[2] = (uint8_t)seq;
+    buffer[3] = (uint8_t)(seq >> 8);
+    buffer[4] = (uint8_t)timestamp;
+    buffer[5] = (uint8_t)(timestamp >> 8);
+    buffer[6] = (uint8_t)(timestamp >> 16);
+    buffer[7] = (uint8_t)(timestamp >> 24);
+
+    uint16_t crc = packet_crc16(buffer, dg->length, 0xFFFF);
+    buffer[dg->length] = (uint8_t)crc;
+    buffer[dg->length + 1] = (uint8_t)(crc >> 8);
+
+    return dg->length + PACKET_V2_CRC_SIZE;
+}
+
+/**
+ * 判断数据是否为v2数据报
+ */
+bool packet_isDatagramV2(const uint8_t *buffer, uint16_t len)
+{
+    return buffer != NULL && len >= 2 &&
+           buffer[0] == PACKET_V2_MAGIC && buffer[1] == PACKET_V2_VERSION;
+}
+
+/**
+ * 校验并解析v2数据报头部
+ */
+bool packet_parseDatagramV2(const uint8_t *buffer, uint16_t len, PacketDatagramInfo_t *info)
+{
+    if (info == NULL || !packet_isDatagramV2(buffer, len))
     {
         return false;
     }
 
-    if (packet->packet_id != PKT_ID_MOTOR_TEST)
+    // 至少需要: 头部 + 一个空帧 + CRC
+    if (len < PACKET_V2_OVERHEAD + PACKET_HEADER_SIZE + PACKET_CHECKSUM_SIZE)
+    {
+        return false;
+    }
+
+    uint16_t body_len = len - PACKET_V2_CRC_SIZE;
+    uint16_t received = (uint16_t)(buffer[body_len] | (buffer[body_len + 1] << 8));
+    if (packet_crc16(buffer, body_len, 0xFFFF) != received)
     {
         return false;
     }
 
-    if (packet->length != sizeof(MotorTestPacket_t))
+    info->seq = (uint16_t)(buffer[2] | (buffer[3] << 8));
+    info->timestamp = (uint32_t)buffer[4] | ((uint32_t)buffer[5] << 8) |
+                      ((uint32_t)buffer[6] << 16) | ((uint32_t)buffer[7] << 24);
+    info->frames = &buffer[PACKET_V2_HEADER_SIZE];
+    info->frames_len = body_len - PACKET_V2_HEADER_SIZE;
+
+    return true;
+}
+
+/**
+ * 从帧区取出下一帧
+ */
+bool packet_nextFrame(const uint8_t **cursor, uint16_t *remaining, PacketFrame_t *frame)
+{
+    if (*remaining < PACKET_HEADER_SIZE + PACKET_CHECKSUM_SIZE)
+    {
+        return false;
+    }
+
+    uint16_t frame_len = PACKET_HEADER_SIZE + (*cursor)[1] + PACKET_CHECKSUM_SIZE;
+    if (frame_len > *remaining || !packet_parse(*cursor, frame_len, frame))
     {
         return false;
     }
 
-    memcpy(motor_test, packet->payload, sizeof(MotorTestPacket_t));
+    *cursor += frame_len;
+    *remaining -= frame_len;
     return true;
 }
+
+/**
+ * 按接收序号更新丢包/乱序统计
+ */
+void packet_seqTrack(PacketSeqStats_t *stats, uint16_t seq)
+{
+    stats->received++;
+
+    if (!stats->started)
+    {
+        stats->started = true;
+        stats->expected_seq = seq + 1;
+        return;
+    }
+
+    int16_t delta = (int16_t)(seq - stats->expected_seq);
+    if (delta >= 0)
+    {
+        // 跳过的序号先记为丢失
+        stats->lost += (uint16_t)delta;
+        stats->expected_seq = seq + 1;
+    }
+    else
+    {
+        // 迟到的数据报: 之前被记为丢失, 改记为乱序
+        stats->reordered++;
+        if (stats->lost > 0)
+        {
+            stats->lost--;
+        }
+    }
+}
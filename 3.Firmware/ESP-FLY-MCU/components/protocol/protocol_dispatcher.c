@@ -4,179 +4,344 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 
 #include "protocol_dispatcher.h"
 #include "packet_codec.h"
-#include "wifi_esp32.h"
+#include "transport.h"
+#include "transport_bench.h"
+#include "data_sender.h"
+#include "link_monitor.h"
 #include "command_receiver.h"
 #include "config_receiver.h"
 #include "motors.h"
 #include "power_distribution.h"
 #include "zero_calib.h"
+#include "kernel_bench.h"
+#include "motor_lut.h"
+#include "sysid.h"
+#include "worker.h"
+#include "stm32_legacy.h"
 
 #define DEBUG_MODULE "PROTO_DISP"
 #include "debug_cf.h"
 
 static bool isInit = false;
+static PacketSeqStats_t rxSeqStats[TRANSPORT_MAX_CLIENTS];
+static SemaphoreHandle_t rxStatsMutex; // 保护rxSeqStats, 接收任务写入时其他任务可能正在读取
+static PIDConfigPacket_t lastPidConfig; // 供日志任务打印, 不在接收任务中格式化输出
+static portMUX_TYPE lastPidConfigLock = portMUX_INITIALIZER_UNLOCKED; // 打印任务执行前可能又收到新的PID参数
 
-static void protocolDispatcherTask(void *param)
+static void pidConfigPrintJob(void *arg);
+WORKER_JOB_DEFINE(pidConfigPrintWork, pidConfigPrintJob, WORKER_PRIO_LOW, 0);
+
+/**
+ * @brief 打印最近一次收到的PID参数 (在worker中执行)
+ */
+static void pidConfigPrintJob(void *arg)
 {
-    UDPPacket udp_packet;
-    PacketFrame_t frame;
+    PIDConfigPacket_t snapshot;
 
-    DEBUG_PRINT("Protocol Dispatcher task started\n");
+    portENTER_CRITICAL(&lastPidConfigLock);
+    snapshot = lastPidConfig;
+    portEXIT_CRITICAL(&lastPidConfigLock);
 
-    while (1)
+    const PIDConfigPacket_t *cfg = &snapshot;
+
+    DEBUG_PRINT_LOCAL("[PID] Received all PID parameters");
+    DEBUG_PRINT_LOCAL("[PID] Roll Angle: Kp=%.3f, Ki=%.3f, Kd=%.3f",
+                      (double)cfg->roll_angle_kp, (double)cfg->roll_angle_ki, (double)cfg->roll_angle_kd);
+    DEBUG_PRINT_LOCAL("[PID] Pitch Angle: Kp=%.3f, Ki=%.3f, Kd=%.3f",
+                      (double)cfg->pitch_angle_kp, (double)cfg->pitch_angle_ki, (double)cfg->pitch_angle_kd);
+    DEBUG_PRINT_LOCAL("[PID] Yaw Angle: Kp=%.3f, Ki=%.3f, Kd=%.3f",
+                      (double)cfg->yaw_angle_kp, (double)cfg->yaw_angle_ki, (double)cfg->yaw_angle_kd);
+    DEBUG_PRINT_LOCAL("[PID] Roll Rate: Kp=%.3f, Ki=%.3f, Kd=%.3f",
+                      (double)cfg->roll_rate_kp, (double)cfg->roll_rate_ki, (double)cfg->roll_rate_kd);
+    DEBUG_PRINT_LOCAL("[PID] Pitch Rate: Kp=%.3f, Ki=%.3f, Kd=%.3f",
+                      (double)cfg->pitch_rate_kp, (double)cfg->pitch_rate_ki, (double)cfg->pitch_rate_kd);
+    DEBUG_PRINT_LOCAL("[PID] Yaw Rate: Kp=%.3f, Ki=%.3f, Kd=%.3f",
+                      (double)cfg->yaw_rate_kp, (double)cfg->yaw_rate_ki, (double)cfg->yaw_rate_kd);
+}
+
+static void dispatchFrame(const PacketFrame_t *frame, uint8_t client, uint32_t rxTimeUs)
+{
+    switch (frame->packet_id)
     {
-        if (!wifiGetDataBlocking(&udp_packet))
+    case PKT_ID_FLIGHT_CONTROL:
+    {
+        if (!zero_calib_is_done())
         {
-            vTaskDelay(1);
-            continue;
+            DEBUG_PRINT_LOCAL("[PROTO] Calibrating, flight control command ignored");
+            break;
         }
+        FlightControlPacket_t fc_packet;
+        if (packet_parseFlightControl(frame, &fc_packet))
+        {
+            DEBUG_PRINT_LOCAL("[CTRL] Roll=%.2f, Pitch=%.2f, Yaw=%.2f, Thrust=%u",
+                              (double)fc_packet.roll, (double)fc_packet.pitch,
+                              (double)fc_packet.yaw, fc_packet.thrust);
 
-        if (!packet_parse(udp_packet.data, udp_packet.size, &frame))
+            commandReceiverHandleFlightControl(&fc_packet);
+        }
+        break;
+    }
+
+    case PKT_ID_PID_CONFIG:
+    {
+        PIDConfigPacket_t pid_config;
+        if (packet_parsePIDConfig(frame, &pid_config))
         {
-            DEBUG_PRINT_LOCAL("[PROTO_RX] Parse failed, len=%u", udp_packet.size);
-            continue;
+            // 应用姿态环PID参数
+            PIDConfig pid_cfg;
+
+            // Roll 姿态环
+            pid_cfg.axis = 0;       // Roll
+            pid_cfg.isRateLoop = 0; // 姿态环
+            pid_cfg.kp = pid_config.roll_angle_kp;
+            pid_cfg.ki = pid_config.roll_angle_ki;
+            pid_cfg.kd = pid_config.roll_angle_kd;
+            configReceiverApplyPID(&pid_cfg);
+
+            // Pitch 姿态环
+            pid_cfg.axis = 1; // Pitch
+            pid_cfg.isRateLoop = 0;
+            pid_cfg.kp = pid_config.pitch_angle_kp;
+            pid_cfg.ki = pid_config.pitch_angle_ki;
+            pid_cfg.kd = pid_config.pitch_angle_kd;
+            configReceiverApplyPID(&pid_cfg);
+
+            // Yaw 姿态环
+            pid_cfg.axis = 2; // Yaw
+            pid_cfg.isRateLoop = 0;
+            pid_cfg.kp = pid_config.yaw_angle_kp;
+            pid_cfg.ki = pid_config.yaw_angle_ki;
+            pid_cfg.kd = pid_config.yaw_angle_kd;
+            configReceiverApplyPID(&pid_cfg);
+
+            // 应用速度环PID参数
+
+            // Roll 速度环
+            pid_cfg.axis = 0;       // Roll
+            pid_cfg.isRateLoop = 1; // 速度环
+            pid_cfg.kp = pid_config.roll_rate_kp;
+            pid_cfg.ki = pid_config.roll_rate_ki;
+            pid_cfg.kd = pid_config.roll_rate_kd;
+            configReceiverApplyPID(&pid_cfg);
+
+            // Pitch 速度环
+            pid_cfg.axis = 1; // Pitch
+            pid_cfg.isRateLoop = 1;
+            pid_cfg.kp = pid_config.pitch_rate_kp;
+            pid_cfg.ki = pid_config.pitch_rate_ki;
+            pid_cfg.kd = pid_config.pitch_rate_kd;
+            configReceiverApplyPID(&pid_cfg);
+
+            // Yaw 速度环
+            pid_cfg.axis = 2; // Yaw
+            pid_cfg.isRateLoop = 1;
+            pid_cfg.kp = pid_config.yaw_rate_kp;
+            pid_cfg.ki = pid_config.yaw_rate_ki;
+            pid_cfg.kd = pid_config.yaw_rate_kd;
+            configReceiverApplyPID(&pid_cfg);
+
+            portENTER_CRITICAL(&lastPidConfigLock);
+            lastPidConfig = pid_config;
+            portEXIT_CRITICAL(&lastPidConfigLock);
+            workerSubmit(&pidConfigPrintWork, NULL);
         }
+        break;
+    }
 
-        switch (frame.packet_id)
+    case PKT_ID_MOTOR_TEST:
+    {
+        if (!zero_calib_is_done())
         {
-        case PKT_ID_FLIGHT_CONTROL:
+            DEBUG_PRINT_LOCAL("[PROTO] Calibrating, motor test command ignored");
+            break;
+        }
+        MotorTestPacket_t motor_test;
+        if (packet_parseMotorTest(frame, &motor_test))
         {
-            if (!zero_calib_is_done())
+            DEBUG_PRINT_LOCAL("[MOTOR] Enable=%d, M1=%u, M2=%u, M3=%u, M4=%u",
+                              motor_test.enable, motor_test.motor1_pwm, motor_test.motor2_pwm,
+                              motor_test.motor3_pwm, motor_test.motor4_pwm);
+
+            // 根据使能标志判断是否进入测试模式
+            if (motor_test.enable == 0)
             {
-                DEBUG_PRINT_LOCAL("[PROTO] Calibrating, flight control command ignored");
-                break;
+                // 禁用测试模式 (同时中止正在进行的推力标定)
+                motorLutAbort();
+                powerDistributionSetMotorTestMode(false);
+                powerStop(); // 停止所有电机
+                DEBUG_PRINT_LOCAL("[MOTOR] Motor test mode disabled");
             }
-            FlightControlPacket_t fc_packet;
-            if (packet_parseFlightControl(&frame, &fc_packet))
+            else
             {
-                DEBUG_PRINT_LOCAL("[CTRL] Roll=%.2f, Pitch=%.2f, Yaw=%.2f, Thrust=%u",
-                                  (double)fc_packet.roll, (double)fc_packet.pitch,
-                                  (double)fc_packet.yaw, fc_packet.thrust);
+                // 启用电机测试模式，防止姿态控制覆盖电机设置
+                powerDistributionSetMotorTestMode(true);
 
-                commandReceiverHandleFlightControl(&fc_packet);
+                // 设置四个电机的PWM占空比
+                motorsSetRatio(0, motor_test.motor1_pwm);
+                motorsSetRatio(1, motor_test.motor2_pwm);
+                motorsSetRatio(2, motor_test.motor3_pwm);
+                motorsSetRatio(3, motor_test.motor4_pwm);
             }
+        }
+        break;
+    }
+
+    case PKT_ID_HEARTBEAT:
+    {
+        uint8_t resp[PKT_FRAME_LEN_HEARTBEAT_RESP];
+        uint16_t resp_len = packet_encodeHeartbeatResp(resp, sizeof(resp));
+        dataSenderSendFrame(client, resp, resp_len);
+        break;
+    }
+
+    case PKT_ID_PING:
+    {
+        PingPacket_t ping;
+        if (packet_parsePing(frame, &ping))
+        {
+            linkMonitorHandlePing(client, &ping, rxTimeUs);
+        }
+        break;
+    }
+
+    case PKT_ID_SUBSCRIBE:
+    {
+        SubscribePacket_t subscribe;
+        if (packet_parseSubscribe(frame, &subscribe))
+        {
+            dataSenderSetClientRate(client, subscribe.hf_rate_hz);
+        }
+        break;
+    }
+
+    case PKT_ID_BENCH_REQUEST:
+    {
+        BenchRequestPacket_t bench;
+        if (packet_parseBenchRequest(frame, &bench) && !kernelBenchRequest(client, bench.iterations))
+        {
+            DEBUG_PRINT_LOCAL("[BENCH] Kernel bench busy, request ignored");
+        }
+        break;
+    }
+
+    case PKT_ID_MOTOR_CHAR_REQUEST:
+    {
+        MotorCharRequestPacket_t motor_char;
+        if (packet_parseMotorCharRequest(frame, &motor_char) && !motorLutRequest(client, motor_char.action))
+        {
+            DEBUG_PRINT_LOCAL("[MOTOR] Characterization busy, request ignored");
+        }
+        break;
+    }
+
+    case PKT_ID_SYSID_REQUEST:
+    {
+        SysidRequestPacket_t sysid;
+        if (!packet_parseSysidRequest(frame, &sysid))
+        {
             break;
         }
 
-        case PKT_ID_PID_CONFIG:
+        if (sysid.signal == SYSID_SIGNAL_ABORT)
         {
-            PIDConfigPacket_t pid_config;
-            if (packet_parsePIDConfig(&frame, &pid_config))
-            {
-                DEBUG_PRINT_LOCAL("[PID] Received all PID parameters");
-
-                // 应用姿态环PID参数
-                PIDConfig pid_cfg;
-
-                // Roll 姿态环
-                pid_cfg.axis = 0;       // Roll
-                pid_cfg.isRateLoop = 0; // 姿态环
-                pid_cfg.kp = pid_config.roll_angle_kp;
-                pid_cfg.ki = pid_config.roll_angle_ki;
-                pid_cfg.kd = pid_config.roll_angle_kd;
-                configReceiverApplyPID(&pid_cfg);
-                DEBUG_PRINT_LOCAL("[PID] Roll Angle: Kp=%.3f, Ki=%.3f, Kd=%.3f",
-                                  (double)pid_cfg.kp, (double)pid_cfg.ki, (double)pid_cfg.kd);
-
-                // Pitch 姿态环
-                pid_cfg.axis = 1; // Pitch
-                pid_cfg.isRateLoop = 0;
-                pid_cfg.kp = pid_config.pitch_angle_kp;
-                pid_cfg.ki = pid_config.pitch_angle_ki;
-                pid_cfg.kd = pid_config.pitch_angle_kd;
-                configReceiverApplyPID(&pid_cfg);
-                DEBUG_PRINT_LOCAL("[PID] Pitch Angle: Kp=%.3f, Ki=%.3f, Kd=%.3f",
-                                  (double)pid_cfg.kp, (double)pid_cfg.ki, (double)pid_cfg.kd);
-
-                // Yaw 姿态环
-                pid_cfg.axis = 2; // Yaw
-                pid_cfg.isRateLoop = 0;
-                pid_cfg.kp = pid_config.yaw_angle_kp;
-                pid_cfg.ki = pid_config.yaw_angle_ki;
-                pid_cfg.kd = pid_config.yaw_angle_kd;
-                configReceiverApplyPID(&pid_cfg);
-                DEBUG_PRINT_LOCAL("[PID] Yaw Angle: Kp=%.3f, Ki=%.3f, Kd=%.3f",
-                                  (double)pid_cfg.kp, (double)pid_cfg.ki, (double)pid_cfg.kd);
-
-                // 应用速度环PID参数
-
-                // Roll 速度环
-                pid_cfg.axis = 0;       // Roll
-                pid_cfg.isRateLoop = 1; // 速度环
-                pid_cfg.kp = pid_config.roll_rate_kp;
-                pid_cfg.ki = pid_config.roll_rate_ki;
-                pid_cfg.kd = pid_config.roll_rate_kd;
-                configReceiverApplyPID(&pid_cfg);
-                DEBUG_PRINT_LOCAL("[PID] Roll Rate: Kp=%.3f, Ki=%.3f, Kd=%.3f",
-                                  (double)pid_cfg.kp, (double)pid_cfg.ki, (double)pid_cfg.kd);
-
-                // Pitch 速度环
-                pid_cfg.axis = 1; // Pitch
-                pid_cfg.isRateLoop = 1;
-                pid_cfg.kp = pid_config.pitch_rate_kp;
-                pid_cfg.ki = pid_config.pitch_rate_ki;
-                pid_cfg.kd = pid_config.pitch_rate_kd;
-                configReceiverApplyPID(&pid_cfg);
-                DEBUG_PRINT_LOCAL("[PID] Pitch Rate: Kp=%.3f, Ki=%.3f, Kd=%.3f",
-                                  (double)pid_cfg.kp, (double)pid_cfg.ki, (double)pid_cfg.kd);
-
-                // Yaw 速度环
-                pid_cfg.axis = 2; // Yaw
-                pid_cfg.isRateLoop = 1;
-                pid_cfg.kp = pid_config.yaw_rate_kp;
-                pid_cfg.ki = pid_config.yaw_rate_ki;
-                pid_cfg.kd = pid_config.yaw_rate_kd;
-                configReceiverApplyPID(&pid_cfg);
-                DEBUG_PRINT_LOCAL("[PID] Yaw Rate: Kp=%.3f, Ki=%.3f, Kd=%.3f",
-                                  (double)pid_cfg.kp, (double)pid_cfg.ki, (double)pid_cfg.kd);
-            }
+            sysidAbort();
             break;
         }
 
-        case PKT_ID_MOTOR_TEST:
+        SysidConfig cfg = {
+            .axis = sysid.axis,
+            .signal = sysid.signal,
+            .durationMs = sysid.duration_ms,
+            .amplitude = sysid.amplitude,
+            .fStart = sysid.f_start,
+            .fEnd = sysid.f_end,
+        };
+        if (!sysidRequest(client, &cfg))
         {
-            if (!zero_calib_is_done())
+            DEBUG_PRINT_LOCAL("[SYSID] Identification request rejected");
+        }
+        break;
+    }
+
+    default:
+        DEBUG_PRINT_LOCAL("[PROTO_RX] Unknown packet: 0x%02X", frame->packet_id);
+        break;
+    }
+}
+
+static void protocolDispatcherTask(void *param)
+{
+    TransportPacket rx_packet;
+    PacketFrame_t frame;
+    PacketDatagramInfo_t datagram;
+
+    DEBUG_PRINT("Protocol Dispatcher task started\n");
+
+    while (1)
+    {
+        if (!transportReceive(&rx_packet, TRANSPORT_WAIT_FOREVER))
+        {
+            vTaskDelay(1);
+            continue;
+        }
+
+        // 接收时间戳, 用于链路测量
+        uint32_t rxTimeUs = (uint32_t)usecTimestamp();
+
+        // 新登记的客户端从默认状态开始
+        uint8_t client = rx_packet.client;
+        if (client != TRANSPORT_CLIENT_NONE && (client & TRANSPORT_CLIENT_NEW))
+        {
+            client &= ~TRANSPORT_CLIENT_NEW;
+            dataSenderResetClient(client);
+            linkMonitorResetClient(client);
+            xSemaphoreTake(rxStatsMutex, portMAX_DELAY);
+            rxSeqStats[client] = (PacketSeqStats_t){0};
+            xSemaphoreGive(rxStatsMutex);
+        }
+
+        // 传输层基准测试探测包: 原样回送给发送方
+        if (transportBenchIsPacket(rx_packet.data, rx_packet.size))
+        {
+            transportBenchReflect(&rx_packet);
+            continue;
+        }
+
+        // v2数据报: 校验CRC后依次分发其中的各帧
+        if (packet_parseDatagramV2(rx_packet.data, rx_packet.size, &datagram))
+        {
+            if (client < TRANSPORT_MAX_CLIENTS)
             {
-                DEBUG_PRINT_LOCAL("[PROTO] Calibrating, motor test command ignored");
-                break;
+                xSemaphoreTake(rxStatsMutex, portMAX_DELAY);
+                packet_seqTrack(&rxSeqStats[client], datagram.seq);
+                xSemaphoreGive(rxStatsMutex);
             }
-            MotorTestPacket_t motor_test;
-            if (packet_parseMotorTest(&frame, &motor_test))
+            dataSenderOnPeerDatagram(client, PACKET_V2_VERSION);
+
+            const uint8_t *cursor = datagram.frames;
+            uint16_t remaining = datagram.frames_len;
+            while (remaining > 0 && packet_nextFrame(&cursor, &remaining, &frame))
             {
-                DEBUG_PRINT_LOCAL("[MOTOR] Enable=%d, M1=%u, M2=%u, M3=%u, M4=%u",
-                                  motor_test.enable, motor_test.motor1_pwm, motor_test.motor2_pwm,
-                                  motor_test.motor3_pwm, motor_test.motor4_pwm);
-
-                // 根据使能标志判断是否进入测试模式
-                if (motor_test.enable == 0)
-                {
-                    // 禁用测试模式
-                    powerDistributionSetMotorTestMode(false);
-                    powerStop(); // 停止所有电机
-                    DEBUG_PRINT_LOCAL("[MOTOR] Motor test mode disabled");
-                }
-                else
-                {
-                    // 启用电机测试模式，防止姿态控制覆盖电机设置
-                    powerDistributionSetMotorTestMode(true);
-
-                    // 设置四个电机的PWM占空比
-                    motorsSetRatio(0, motor_test.motor1_pwm);
-                    motorsSetRatio(1, motor_test.motor2_pwm);
-                    motorsSetRatio(2, motor_test.motor3_pwm);
-                    motorsSetRatio(3, motor_test.motor4_pwm);
-                }
+                dispatchFrame(&frame, client, rxTimeUs);
             }
-            break;
+            if (remaining > 0)
+            {
+                DEBUG_PRINT_LOCAL("[PROTO_RX] Bad frame in datagram seq=%u", datagram.seq);
+            }
+            continue;
         }
 
-        default:
-            DEBUG_PRINT_LOCAL("[PROTO_RX] Unknown packet: 0x%02X", frame.packet_id);
-            break;
+        if (!packet_parse(rx_packet.data, rx_packet.size, &frame))
+        {
+            DEBUG_PRINT_LOCAL("[PROTO_RX] Parse failed, len=%u", rx_packet.size);
+            continue;
         }
+
+        dispatchFrame(&frame, client, rxTimeUs);
     }
 }
 
@@ -189,6 +354,7 @@ void protocolDispatcherInit(void)
 
     configReceiverInit();
 
+    rxStatsMutex = xSemaphoreCreateMutex();
     xTaskCreate(protocolDispatcherTask, "PROTO_DISP", 4096, NULL, 3, NULL);
 
     isInit = true;
@@ -199,3 +365,16 @@ bool protocolDispatcherTest(void)
 {
     return isInit;
 }
+
+bool protocolDispatcherGetRxStats(uint8_t client, PacketSeqStats_t *stats)
+{
+    if (client >= TRANSPORT_MAX_CLIENTS || rxStatsMutex == NULL)
+    {
+        return false;
+    }
+
+    xSemaphoreTake(rxStatsMutex, portMAX_DELAY);
+    *stats = rxSeqStats[client];
+    xSemaphoreGive(rxStatsMutex);
+    return true;
+}
@@ -0,0 +1,801 @@
+#!/usr/bin/env python3
+"""
+packet_codegen - 数据包编解码代码生成器
+
+根据 packets.json 生成:
+- 固件: components/protocol/include/packet_defs.h
+  (数据包ID、packed结构体、编译期长度断言、单次遍历编码/解码函数)
+- 上位机: 5.Software/ESP-FLY-PC/services/packet_defs.py
+  (PacketType、预编译struct.Struct、编码/解码函数)
+
+用法:
+    python tools/packet_codegen.py             # 重新生成代码
+    python tools/packet_codegen.py --check     # 检查生成代码是否与packets.json一致
+    python tools/packet_codegen.py --selftest  # 往返一致性与吞吐量自测 (Python + 主机C编译器)
+"""
+
+import argparse
+import importlib.util
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import timeit
+
+PROTOCOL_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+REPO_DIR = os.path.normpath(os.path.join(PROTOCOL_DIR, "..", "..", "..", ".."))
+
+SCHEMA_PATH = os.path.join(PROTOCOL_DIR, "packets.json")
+C_OUTPUT_PATH = os.path.join(PROTOCOL_DIR, "include", "packet_defs.h")
+PY_OUTPUT_PATH = os.path.join(
+    REPO_DIR, "5.Software", "ESP-FLY-PC", "services", "packet_defs.py"
+)
+
+HEADER_SIZE = 2
+CHECKSUM_SIZE = 1
+
+# 字段类型: (C类型, struct格式符, 字节数, 编解码辅助函数后缀)
+FIELD_TYPES = {
+    "u8": ("uint8_t", "B", 1, "U8"),
+    "i8": ("int8_t", "b", 1, "I8"),
+    "u16": ("uint16_t", "H", 2, "U16"),
+    "i16": ("int16_t", "h", 2, "I16"),
+    "u32": ("uint32_t", "I", 4, "U32"),
+    "i32": ("int32_t", "i", 4, "I32"),
+    "f32": ("float", "f", 4, "F32"),
+    # 定长字符串 (不足补0, 不保证以'\0'结尾), C端为char数组, Python端为bytes
+    "c16": ("char", "16s", 16, "Chars"),
+    "c32": ("char", "32s", 32, "Chars"),
+    # 定长二进制块, 编码方式同上, 内容由收发双方约定
+    "c48": ("char", "48s", 48, "Chars"),
+}
+
+GENERATED_NOTE = "本文件由 tools/packet_codegen.py 根据 packets.json 自动生成，请勿手动修改"
+
+
+# ============================================================================
+# Schema加载
+# ============================================================================
+
+
+def load_schema(path=SCHEMA_PATH):
+    """加载并校验数据包定义"""
+    with open(path, "r", encoding="utf-8") as f:
+        schema = json.load(f)
+
+    max_payload = schema["max_payload"]
+    by_name = {}
+    ids = set()
+
+    for pkt in schema["packets"]:
+        pkt["id"] = int(pkt["id"], 0)
+        if pkt["id"] in ids:
+            raise ValueError(f"重复的数据包ID: 0x{pkt['id']:02X}")
+        ids.add(pkt["id"])
+
+        if "same_as" in pkt:
+            base = by_name[pkt["same_as"]]
+            pkt["c_type"] = base["c_type"]
+            pkt["fields"] = base["fields"]
+
+        pkt.setdefault("variable", False)
+        pkt.setdefault("fields", [])
+
+        size = 0
+        for field in pkt["fields"]:
+            if field["type"] not in FIELD_TYPES:
+                raise ValueError(f"{pkt['name']}.{field['c']}: 未知类型 {field['type']}")
+            size += FIELD_TYPES[field["type"]][2]
+        pkt["size"] = size
+
+        if size > max_payload:
+            raise ValueError(f"{pkt['name']}: payload {size} bytes 超过上限 {max_payload}")
+
+        by_name[pkt["name"]] = pkt
+
+    return schema
+
+
+def is_chars(field):
+    return FIELD_TYPES[field["type"]][3] == "Chars"
+
+
+def struct_format(fields):
+    """生成紧凑的struct格式串, 例如 <6f3h4H6fH"""
+    fmt = "<"
+    i = 0
+    while i < len(fields):
+        code = FIELD_TYPES[fields[i]["type"]][1]
+        n = 1
+        while (
+            len(code) == 1
+            and i + n < len(fields)
+            and FIELD_TYPES[fields[i + n]["type"]][1] == code
+        ):
+            n += 1
+        fmt += (str(n) if n > 1 else "") + code
+        i += n
+    return fmt
+
+
+def fixed_packets(schema):
+    return [p for p in schema["packets"] if not p["variable"]]
+
+
+def struct_packets(schema):
+    """拥有独立结构体定义的数据包 (排除same_as复用与无payload包)"""
+    return [
+        p
+        for p in schema["packets"]
+        if p["fields"] and "same_as" not in p and not p["variable"]
+    ]
+
+
+# ============================================================================
+# C代码生成
+# ============================================================================
+
+
+def _c_helpers():
+    return """    // ============================================================================
+    // 字段编解码辅助函数 (小端序, 编码时同步累加校验和)
+    // ============================================================================
+
+    static inline uint8_t *packet_putU8(uint8_t *dst, uint8_t value, uint8_t *sum)
+    {
+        *dst = value;
+        *sum += value;
+        return dst + 1;
+    }
+
+    static inline uint8_t *packet_putI8(uint8_t *dst, int8_t value, uint8_t *sum)
+    {
+        return packet_putU8(dst, (uint8_t)value, sum);
+    }
+
+    static inline uint8_t *packet_putU16(uint8_t *dst, uint16_t value, uint8_t *sum)
+    {
+        dst = packet_putU8(dst, (uint8_t)value, sum);
+        return packet_putU8(dst, (uint8_t)(value >> 8), sum);
+    }
+
+    static inline uint8_t *packet_putI16(uint8_t *dst, int16_t value, uint8_t *sum)
+    {
+        return packet_putU16(dst, (uint16_t)value, sum);
+    }
+
+    static inline uint8_t *packet_putU32(uint8_t *dst, uint32_t value, uint8_t *sum)
+    {
+        dst = packet_putU16(dst, (uint16_t)value, sum);
+        return packet_putU16(dst, (uint16_t)(value >> 16), sum);
+    }
+
+    static inline uint8_t *packet_putI32(uint8_t *dst, int32_t value, uint8_t *sum)
+    {
+        return packet_putU32(dst, (uint32_t)value, sum);
+    }
+
+    static inline uint8_t *packet_putF32(uint8_t *dst, float value, uint8_t *sum)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return packet_putU32(dst, bits, sum);
+    }
+
+    static inline uint8_t packet_getU8(const uint8_t **src)
+    {
+        uint8_t value = (*src)[0];
+        *src += 1;
+        return value;
+    }
+
+    static inline int8_t packet_getI8(const uint8_t **src)
+    {
+        return (int8_t)packet_getU8(src);
+    }
+
+    static inline uint16_t packet_getU16(const uint8_t **src)
+    {
+        uint16_t value = (uint16_t)((*src)[0] | ((uint16_t)(*src)[1] << 8));
+        *src += 2;
+        return value;
+    }
+
+    static inline int16_t packet_getI16(const uint8_t **src)
+    {
+        return (int16_t)packet_getU16(src);
+    }
+
+    static inline uint32_t packet_getU32(const uint8_t **src)
+    {
+        uint32_t value = (uint32_t)(*src)[0] | ((uint32_t)(*src)[1] << 8) |
+                         ((uint32_t)(*src)[2] << 16) | ((uint32_t)(*src)[3] << 24);
+        *src += 4;
+        return value;
+    }
+
+    static inline int32_t packet_getI32(const uint8_t **src)
+    {
+        return (int32_t)packet_getU32(src);
+    }
+
+    static inline float packet_getF32(const uint8_t **src)
+    {
+        uint32_t bits = packet_getU32(src);
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    static inline uint8_t *packet_putChars(uint8_t *dst, const char *value, uint8_t len, uint8_t *sum)
+    {
+        for (uint8_t i = 0; i < len; i++)
+        {
+            dst = packet_putU8(dst, (uint8_t)value[i], sum);
+        }
+        return dst;
+    }
+
+    static inline void packet_getChars(const uint8_t **src, char *out, uint8_t len)
+    {
+        memcpy(out, *src, len);
+        *src += len;
+    }
+"""
+
+
+def _c_section(title):
+    bar = "    // " + "=" * 76
+    return [bar, f"    // {title}", bar, ""]
+
+
+def generate_c(schema):
+    packets = schema["packets"]
+    out = []
+    w = out.append
+
+    w("/**")
+    w(" * Packet Definitions - 数据包定义")
+    w(" *")
+    w(f" * {GENERATED_NOTE}")
+    w(" * 数据包格式: PacketID(1) + Length(1) + Payload(0-120) + Checksum(1)")
+    w(" */")
+    w("")
+    w("#ifndef __PACKET_DEFS_H__")
+    w("#define __PACKET_DEFS_H__")
+    w("")
+    w("#include <stdint.h>")
+    w("#include <stdbool.h>")
+    w("#include <string.h>")
+    w("")
+    w("#ifdef __cplusplus")
+    w('extern "C"')
+    w("{")
+    w("#endif")
+    w("")
+
+    out.extend(_c_section("常量定义"))
+    w(f"#define PACKET_MAX_PAYLOAD_SIZE {schema['max_payload']} // 最大payload长度")
+    w(f"#define PACKET_HEADER_SIZE {HEADER_SIZE}        // PacketID + Length")
+    w(f"#define PACKET_CHECKSUM_SIZE {CHECKSUM_SIZE}      // Checksum")
+    w("#define PACKET_MAX_SIZE (PACKET_HEADER_SIZE + PACKET_MAX_PAYLOAD_SIZE + PACKET_CHECKSUM_SIZE)")
+    w("")
+
+    out.extend(_c_section("数据包类型定义 (PacketID)"))
+    for direction, title, enum_name in (
+        ("uplink", "上行数据包 (PC/APP → MCU)", "PacketID_Uplink"),
+        ("downlink", "下行数据包 (MCU → PC/APP)", "PacketID_Downlink"),
+    ):
+        w(f"    // {title}")
+        w("    typedef enum")
+        w("    {")
+        entries = [
+            (f"PKT_ID_{p['name']} = 0x{p['id']:02X},", p["comment"])
+            for p in packets
+            if p["dir"] == direction
+        ]
+        width = max(len(e[0]) for e in entries)
+        for decl, comment in entries:
+            w(f"        {decl.ljust(width)} // {comment}")
+        w(f"    }} {enum_name};")
+        w("")
+
+    out.extend(_c_section("Payload长度 (编译期常量)"))
+    for p in fixed_packets(schema):
+        w(f"#define PKT_LEN_{p['name']} {p['size']}")
+    w("")
+    for p in fixed_packets(schema):
+        w(
+            f"#define PKT_FRAME_LEN_{p['name']} "
+            f"(PACKET_HEADER_SIZE + PKT_LEN_{p['name']} + PACKET_CHECKSUM_SIZE)"
+        )
+    w("")
+
+    out.extend(_c_section("数据包结构体定义"))
+    for p in struct_packets(schema):
+        w("    /**")
+        w(f"     * {p['comment']} (0x{p['id']:02X}) - {p['size']} bytes payload")
+        w("     */")
+        w("    typedef struct")
+        w("    {")
+        decls = [
+            f"{FIELD_TYPES[f['type']][0]} {f['c']}[{FIELD_TYPES[f['type']][2]}];"
+            if is_chars(f)
+            else f"{FIELD_TYPES[f['type']][0]} {f['c']};"
+            for f in p["fields"]
+        ]
+        width = max(len(d) for d in decls)
+        for decl, f in zip(decls, p["fields"]):
+            w(f"        {decl.ljust(width)} // {f['comment']}")
+        w(f"    }} __attribute__((packed)) {p['c_type']};")
+        w("")
+        w(
+            f"    _Static_assert(sizeof({p['c_type']}) == PKT_LEN_{p['name']}, "
+            f'"{p["c_type"]} size mismatch");'
+        )
+        w("")
+
+    w(_c_helpers())
+
+    out.extend(_c_section("编码函数 (单次遍历写入帧头/payload并同步计算校验和)"))
+    for p in fixed_packets(schema):
+        name = p["name"]
+        w("    /**")
+        w(f"     * 编码数据包 0x{p['id']:02X} - {p['comment']}")
+        w("     * @param buffer 输出缓冲区")
+        w("     * @param buffer_size 缓冲区大小")
+        if p["fields"]:
+            w("     * @param in 数据包内容")
+        w("     * @return 数据包长度 (0表示缓冲区不足)")
+        w("     */")
+        params = "uint8_t *buffer, uint16_t buffer_size"
+        if p["fields"]:
+            params += f", const {p['c_type']} *in"
+        w(f"    static inline uint16_t packet_encode{p['c_func']}({params})")
+        w("    {")
+        w(f"        if (buffer == NULL || buffer_size < PKT_FRAME_LEN_{name})")
+        w("        {")
+        w("            return 0;")
+        w("        }")
+        w("")
+        w("        uint8_t sum = 0;")
+        w(f"        uint8_t *p = packet_putU8(buffer, PKT_ID_{name}, &sum);")
+        w(f"        p = packet_putU8(p, PKT_LEN_{name}, &sum);")
+        for f in p["fields"]:
+            suffix = FIELD_TYPES[f["type"]][3]
+            if is_chars(f):
+                size = FIELD_TYPES[f["type"]][2]
+                w(f"        p = packet_put{suffix}(p, in->{f['c']}, {size}, &sum);")
+            else:
+                w(f"        p = packet_put{suffix}(p, in->{f['c']}, &sum);")
+        w("        *p = sum;")
+        w("")
+        w(f"        return PKT_FRAME_LEN_{name};")
+        w("    }")
+        w("")
+
+    out.extend(_c_section("解码函数 (payload → 结构体)"))
+    for p in fixed_packets(schema):
+        if not p["fields"]:
+            continue
+        w("    /**")
+        w(f"     * 解码数据包 0x{p['id']:02X} payload - {p['comment']}")
+        w("     * @param payload payload数据 (不含帧头和校验和)")
+        w("     * @param length payload长度")
+        w("     * @param out 输出结构体")
+        w("     * @return true=成功, false=长度不匹配")
+        w("     */")
+        w(
+            f"    static inline bool packet_decode{p['c_func']}"
+            f"(const uint8_t *payload, uint8_t length, {p['c_type']} *out)"
+        )
+        w("    {")
+        w(f"        if (payload == NULL || out == NULL || length != PKT_LEN_{p['name']})")
+        w("        {")
+        w("            return false;")
+        w("        }")
+        w("")
+        w("        const uint8_t *p = payload;")
+        for f in p["fields"]:
+            suffix = FIELD_TYPES[f["type"]][3]
+            if is_chars(f):
+                size = FIELD_TYPES[f["type"]][2]
+                w(f"        packet_get{suffix}(&p, out->{f['c']}, {size});")
+            else:
+                w(f"        out->{f['c']} = packet_get{suffix}(&p);")
+        w("")
+        w("        return true;")
+        w("    }")
+        w("")
+
+    w("#ifdef __cplusplus")
+    w("}")
+    w("#endif")
+    w("")
+    w("#endif // __PACKET_DEFS_H__")
+    return "\n".join(out) + "\n"
+
+
+# ============================================================================
+# Python代码生成
+# ============================================================================
+
+
+def generate_py(schema):
+    packets = schema["packets"]
+    out = []
+    w = out.append
+
+    w('"""')
+    w("packet_defs - 数据包定义与预编译编解码器")
+    w("")
+    w("本文件由 3.Firmware/ESP-FLY-MCU/components/protocol/tools/packet_codegen.py")
+    w("根据 packets.json 自动生成，请勿手动修改")
+    w('"""')
+    w("")
+    w("import struct")
+    w("from enum import IntEnum")
+    w("from typing import Dict, Optional, Tuple")
+    w("")
+    w(f"MAX_PAYLOAD_SIZE = {schema['max_payload']}")
+    w(f"HEADER_SIZE = {HEADER_SIZE}")
+    w(f"CHECKSUM_SIZE = {CHECKSUM_SIZE}")
+    w("")
+    w("")
+    w("class PacketType(IntEnum):")
+    w('    """数据包类型ID"""')
+    w("")
+    w("    # 上行数据包 (PC → MCU)")
+    for p in packets:
+        if p["dir"] == "uplink":
+            w(f"    {p['name']} = 0x{p['id']:02X}  # {p['comment']}")
+    w("")
+    w("    # 下行数据包 (MCU → PC)")
+    for p in packets:
+        if p["dir"] == "downlink":
+            w(f"    {p['name']} = 0x{p['id']:02X}  # {p['comment']}")
+    w("")
+    w("")
+    w("# ========== Payload结构 (预编译) ==========")
+    w("")
+    for p in fixed_packets(schema):
+        if not p["fields"]:
+            continue
+        fmt = struct_format(p["fields"])
+        w(f"# {p['comment']} (0x{p['id']:02X}) - {p['size']} bytes")
+        w(f'{p["name"]}_STRUCT = struct.Struct("{fmt}")')
+        w(f'{p["name"]}_FRAME = struct.Struct("<BB{fmt[1:]}")')
+        w(f"{p['name']}_FIELDS = (")
+        for f in p["fields"]:
+            w(f'    "{f["py"]}",')
+        w(")")
+        w("")
+    w("PAYLOAD_LAYOUTS: Dict[int, Tuple[struct.Struct, Tuple[str, ...]]] = {")
+    for p in fixed_packets(schema):
+        if p["fields"]:
+            w(f"    PacketType.{p['name']}: ({p['name']}_STRUCT, {p['name']}_FIELDS),")
+    w("}")
+    w("")
+    w("PAYLOAD_SIZES: Dict[int, int] = {")
+    for p in fixed_packets(schema):
+        w(f"    PacketType.{p['name']}: {p['size']},")
+    w("}")
+    w("")
+    w("")
+    w("# ========== 帧编解码 ==========")
+    w("")
+    w("")
+    w("def checksum(data) -> int:")
+    w('    """Checksum = 所有字节累加 & 0xFF"""')
+    w("    return sum(data) & 0xFF")
+    w("")
+    w("")
+    w("def encode_frame(packet_id: int, payload: bytes) -> bytes:")
+    w('    """构建完整数据包: PacketID + Length + Payload + Checksum"""')
+    w("    if len(payload) > MAX_PAYLOAD_SIZE:")
+    w('        raise ValueError("payload too long")')
+    w("    frame = bytearray(HEADER_SIZE + len(payload) + CHECKSUM_SIZE)")
+    w("    frame[0] = packet_id")
+    w("    frame[1] = len(payload)")
+    w("    frame[HEADER_SIZE:-CHECKSUM_SIZE] = payload")
+    w("    frame[-1] = sum(frame) & 0xFF")
+    w("    return bytes(frame)")
+    w("")
+    w("")
+    w("def split_frame(raw_data: bytes) -> Optional[Tuple[int, bytes]]:")
+    w('    """')
+    w("    校验并拆分数据帧")
+    w("")
+    w("    Returns:")
+    w("        (packet_id, payload)，长度或校验和错误返回None")
+    w('    """')
+    w("    if len(raw_data) < HEADER_SIZE + CHECKSUM_SIZE:")
+    w("        return None")
+    w("    length = raw_data[1]")
+    w("    end = HEADER_SIZE + length")
+    w("    if len(raw_data) < end + CHECKSUM_SIZE:")
+    w("        return None")
+    w("    if sum(raw_data[:end]) & 0xFF != raw_data[end]:")
+    w("        return None")
+    w("    return raw_data[0], raw_data[HEADER_SIZE:end]")
+    w("")
+    w("")
+    w("def decode_payload(packet_id: int, payload: bytes) -> Optional[Dict[str, object]]:")
+    w('    """按数据包ID解码定长payload为字段字典，未知ID或长度不足返回None"""')
+    w("    layout = PAYLOAD_LAYOUTS.get(packet_id)")
+    w("    if layout is None:")
+    w("        return None")
+    w("    packer, fields = layout")
+    w("    if len(payload) < packer.size:")
+    w("        return None")
+    w("    return dict(zip(fields, packer.unpack_from(payload)))")
+    w("")
+    w("")
+    w("# ========== 数据包编码 ==========")
+    for p in packets:
+        w("")
+        w("")
+        name = p["name"]
+        if p["variable"]:
+            w(f"def encode_{p['py_func']}(payload: bytes) -> bytes:")
+            w(f'    """编码数据包 0x{p["id"]:02X} - {p["comment"]}"""')
+            w(f"    return encode_frame(PacketType.{name}, payload)")
+        elif not p["fields"]:
+            w(f"_{name}_BYTES = encode_frame(PacketType.{name}, b\"\")")
+            w("")
+            w("")
+            w(f"def encode_{p['py_func']}() -> bytes:")
+            w(f'    """编码数据包 0x{p["id"]:02X} - {p["comment"]}"""')
+            w(f"    return _{name}_BYTES")
+        else:
+            frame_struct = f"{name}_FRAME"
+            args = [f["py"] for f in p["fields"]]
+            signature = f"def encode_{p['py_func']}({', '.join(args)}) -> bytes:"
+            if len(signature) <= 88:
+                w(signature)
+            else:
+                w(f"def encode_{p['py_func']}(")
+                for a in args:
+                    w(f"    {a},")
+                w(") -> bytes:")
+            w(f'    """编码数据包 0x{p["id"]:02X} - {p["comment"]}"""')
+            w(f"    frame = bytearray({frame_struct}.size + CHECKSUM_SIZE)")
+            pack_args = ["frame", "0", f"PacketType.{name}", str(p["size"])] + args
+            call = f"    {frame_struct}.pack_into({', '.join(pack_args)})"
+            if len(call) <= 88:
+                w(call)
+            else:
+                w(f"    {frame_struct}.pack_into(")
+                for a in pack_args:
+                    w(f"        {a},")
+                w("    )")
+            w("    frame[-1] = sum(frame) & 0xFF")
+            w("    return bytes(frame)")
+    return "\n".join(out) + "\n"
+
+
+# ============================================================================
+# 自测: 往返一致性 + 吞吐量
+# ============================================================================
+
+
+def sample_values(fields):
+    """为每个字段生成确定性的测试值 (浮点取可精确表示的值)"""
+    values = []
+    for i, f in enumerate(fields):
+        t = f["type"]
+        if t == "f32":
+            values.append((i + 1) * 0.25 * (-1 if i % 2 else 1))
+        elif is_chars(f):
+            values.append(f"field{i}".encode().ljust(FIELD_TYPES[t][2], b"\0"))
+        elif t in ("u8", "i8"):
+            values.append((i * 37 + 1) % 100 * (-1 if t == "i8" and i % 2 else 1))
+        else:
+            values.append((i * 4099 + 7) % 30000 * (-1 if t[0] == "i" and i % 2 else 1))
+    return values
+
+
+def c_literal(field, value):
+    if is_chars(field):
+        return '"' + value.rstrip(b"\0").decode() + '"'
+    return f"{value!r}f" if field["type"] == "f32" else str(value)
+
+
+def load_py_module(path=PY_OUTPUT_PATH):
+    spec = importlib.util.spec_from_file_location("packet_defs", path)
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+def selftest_python(schema, module):
+    expected = {}
+    for p in fixed_packets(schema):
+        values = sample_values(p["fields"])
+        frame = getattr(module, f"encode_{p['py_func']}")(*values)
+
+        assert len(frame) == p["size"] + HEADER_SIZE + CHECKSUM_SIZE, p["name"]
+        packet_id, payload = module.split_frame(frame)
+        assert packet_id == p["id"], p["name"]
+        if p["fields"]:
+            decoded = module.decode_payload(packet_id, payload)
+            assert decoded == dict(zip((f["py"] for f in p["fields"]), values)), p["name"]
+        expected[p["name"]] = frame
+
+    log = module.encode_console_log("hello".encode())
+    assert module.split_frame(log) == (module.PacketType.CONSOLE_LOG, b"hello")
+
+    corrupted = bytearray(expected["HIGH_FREQ_DATA"])
+    corrupted[5] ^= 0xFF
+    assert module.split_frame(bytes(corrupted)) is None
+
+    print(f"[py] round-trip OK ({len(expected)} packet types)")
+
+    hf = next(p for p in schema["packets"] if p["name"] == "HIGH_FREQ_DATA")
+    values = sample_values(hf["fields"])
+    frame = expected["HIGH_FREQ_DATA"]
+    n = 50000
+    t_enc = timeit.timeit(lambda: module.encode_high_freq_data(*values), number=n)
+    t_dec = timeit.timeit(
+        lambda: module.decode_payload(*module.split_frame(frame)), number=n
+    )
+    print(
+        f"[py] HIGH_FREQ_DATA encode {t_enc / n * 1e6:.2f} us/pkt, "
+        f"split+decode {t_dec / n * 1e6:.2f} us/pkt"
+    )
+    return expected
+
+
+def selftest_c(schema, expected):
+    cc = shutil.which("cc") or shutil.which("gcc") or shutil.which("clang")
+    if cc is None:
+        print("[c] 未找到主机C编译器，跳过C自测")
+        return True
+
+    lines = [
+        "#include <stdio.h>",
+        "#include <time.h>",
+        '#include "packet_defs.h"',
+        "",
+        "static void dump(const char *name, const uint8_t *buf, uint16_t len)",
+        "{",
+        '    printf("%s ", name);',
+        "    for (uint16_t i = 0; i < len; i++)",
+        '        printf("%02x", buf[i]);',
+        '    printf("\\n");',
+        "}",
+        "",
+        "int main(void)",
+        "{",
+        "    uint8_t buf[PACKET_MAX_SIZE];",
+        "    uint16_t len;",
+        "    int failed = 0;",
+    ]
+    for p in fixed_packets(schema):
+        values = sample_values(p["fields"])
+        lines.append("    {")
+        if p["fields"]:
+            inits = ", ".join(
+                f".{f['c']} = {c_literal(f, v)}" for f, v in zip(p["fields"], values)
+            )
+            lines.append(f"        {p['c_type']} in = {{{inits}}}, out;")
+            lines.append(f"        len = packet_encode{p['c_func']}(buf, sizeof(buf), &in);")
+            lines.append(f'        dump("{p["name"]}", buf, len);')
+            lines.append(
+                f"        if (!packet_decode{p['c_func']}(&buf[PACKET_HEADER_SIZE], buf[1], &out) "
+                "|| memcmp(&in, &out, sizeof(in)) != 0)"
+            )
+            lines.append(f'            failed = 1, printf("decode mismatch: {p["name"]}\\n");')
+            lines.append(
+                f"        if (packet_encode{p['c_func']}(buf, PKT_FRAME_LEN_{p['name']} - 1, &in) != 0)"
+            )
+            lines.append(f'            failed = 1, printf("short buffer accepted: {p["name"]}\\n");')
+        else:
+            lines.append(f"        len = packet_encode{p['c_func']}(buf, sizeof(buf));")
+            lines.append(f'        dump("{p["name"]}", buf, len);')
+        lines.append("    }")
+
+    hf = next(p for p in schema["packets"] if p["name"] == "HIGH_FREQ_DATA")
+    inits = ", ".join(
+        f".{f['c']} = {c_literal(f, v)}"
+        for f, v in zip(hf["fields"], sample_values(hf["fields"]))
+    )
+    lines += [
+        "    {",
+        f"        HighFreqDataPacket_t in = {{{inits}}}, out;",
+        "        const long n = 2000000;",
+        "        volatile uint16_t sink = 0;",
+        "        struct timespec t0, t1;",
+        "        clock_gettime(CLOCK_MONOTONIC, &t0);",
+        "        for (long i = 0; i < n; i++)",
+        "        {",
+        "            in.timestamp = (uint16_t)i;",
+        "            sink += packet_encodeHighFreqData(buf, sizeof(buf), &in);",
+        "        }",
+        "        clock_gettime(CLOCK_MONOTONIC, &t1);",
+        "        double enc = ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / n;",
+        "        clock_gettime(CLOCK_MONOTONIC, &t0);",
+        "        for (long i = 0; i < n; i++)",
+        "        {",
+        "            buf[2] = (uint8_t)i;",
+        "            sink += packet_decodeHighFreqData(&buf[PACKET_HEADER_SIZE], buf[1], &out);",
+        "        }",
+        "        clock_gettime(CLOCK_MONOTONIC, &t1);",
+        "        double dec = ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / n;",
+        '        printf("# HIGH_FREQ_DATA encode %.1f ns/pkt, decode %.1f ns/pkt\\n", enc, dec);',
+        "    }",
+        "    return failed ? 1 : 0;",
+        "}",
+    ]
+
+    with tempfile.TemporaryDirectory() as tmp:
+        src = os.path.join(tmp, "packet_selftest.c")
+        exe = os.path.join(tmp, "packet_selftest")
+        with open(src, "w", encoding="utf-8") as f:
+            f.write("\n".join(lines) + "\n")
+        subprocess.run(
+            [cc, "-std=gnu11", "-O2", "-Wall", "-Wextra", "-Werror",
+             "-I", os.path.dirname(C_OUTPUT_PATH), src, "-o", exe],
+            check=True,
+        )
+        result = subprocess.run([exe], capture_output=True, text=True)
+
+    ok = result.returncode == 0
+    for line in result.stdout.splitlines():
+        if line.startswith("#"):
+            print("[c]" + line[1:])
+            continue
+        parts = line.split()
+        if len(parts) != 2 or parts[0] not in expected:
+            print("[c] " + line)
+            ok = False
+        elif bytes.fromhex(parts[1]) != expected[parts[0]]:
+            print(f"[c] {parts[0]} 与Python编码结果不一致")
+            ok = False
+    if ok:
+        print(f"[c] round-trip OK, C/Python 编码逐字节一致 ({len(expected)} packet types)")
+    return ok
+
+
+# ============================================================================
+# 入口
+# ============================================================================
+
+
+def main():
+    parser = argparse.ArgumentParser(description="ESP-FLY 数据包编解码代码生成器")
+    parser.add_argument("--check", action="store_true", help="检查生成代码是否最新")
+    parser.add_argument("--selftest", action="store_true", help="运行往返一致性与吞吐量自测")
+    args = parser.parse_args()
+
+    schema = load_schema()
+    outputs = {C_OUTPUT_PATH: generate_c(schema), PY_OUTPUT_PATH: generate_py(schema)}
+
+    if args.check:
+        stale = []
+        for path, content in outputs.items():
+            if not os.path.exists(path):
+                stale.append(path)
+                continue
+            with open(path, "r", encoding="utf-8") as f:
+                if f.read() != content:
+                    stale.append(path)
+        for path in stale:
+            print(f"过期: {os.path.relpath(path, REPO_DIR)}")
+        return 1 if stale else 0
+
+    if args.selftest:
+        expected = selftest_python(schema, load_py_module())
+        return 0 if selftest_c(schema, expected) else 1
+
+    for path, content in outputs.items():
+        with open(path, "w", encoding="utf-8", newline="\n") as f:
+            f.write(content)
+        print(f"生成: {os.path.relpath(path, REPO_DIR)}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,150 @@
+/**
+ * transport_bench_host - 主机端传输层基准测试
+ *
+ * 构建 (主机端工具工程的transport_bench目标, 见 host/CMakeLists.txt):
+ *   cmake -S host -B build-host && cmake --build build-host --target transport_bench
+ *
+ * 用法:
+ *   build-host/transport_bench                 本机回环: fork一个反射进程, 测量POSIX后端本身的开销
+ *   ./transport_bench --udp 192.168.43.42:2390 直连飞机: 绑定本地2399端口, 由飞控协议分发器反射
+ *   可选参数: --count N (默认200)  --size S (默认64字节)
+ *
+ * ESP-NOW后端需要另一块运行transportBenchRun()的ESP32作为发起端, 本工具不覆盖.
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "transport.h"
+#include "transport_bench.h"
+#include "transport_posix.h"
+
+#define LOOPBACK_HOST "127.0.0.1"
+#define LOOPBACK_BENCH_PORT 23990
+#define LOOPBACK_REFLECT_PORT 23991
+#define DRONE_LOCAL_PORT 2399
+
+static uint64_t monotonicUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void runReflector(void)
+{
+    TransportPacket pkt;
+
+    transportPosixConfigure(LOOPBACK_REFLECT_PORT, LOOPBACK_HOST, LOOPBACK_BENCH_PORT);
+    transportInit(&transportPosix);
+    if (!transportTest())
+    {
+        exit(1);
+    }
+
+    while (true)
+    {
+        if (transportReceive(&pkt, TRANSPORT_WAIT_FOREVER) && transportBenchIsPacket(pkt.data, pkt.size))
+        {
+            transportBenchReflect(&pkt);
+        }
+    }
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [--udp HOST:PORT] [--count N] [--size S]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    const char *target = NULL;
+    int count = 200;
+    int size = 64;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--udp") && i + 1 < argc)
+        {
+            target = argv[++i];
+        }
+        else if (!strcmp(argv[i], "--count") && i + 1 < argc)
+        {
+            count = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--size") && i + 1 < argc)
+        {
+            size = atoi(argv[++i]);
+        }
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (count <= 0 || count > 65535 || size < TRANSPORT_BENCH_HEADER_SIZE || size > TRANSPORT_MTU)
+    {
+        fprintf(stderr, "count must be 1..65535, size %d..%d\n", TRANSPORT_BENCH_HEADER_SIZE, TRANSPORT_MTU);
+        return 2;
+    }
+
+    pid_t reflector = -1;
+    char host[64] = LOOPBACK_HOST;
+    int port = LOOPBACK_REFLECT_PORT;
+
+    if (target)
+    {
+        const char *colon = strrchr(target, ':');
+        size_t hostLen = colon ? (size_t)(colon - target) : strlen(target);
+        if (hostLen >= sizeof(host))
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        memcpy(host, target, hostLen);
+        host[hostLen] = '\0';
+        port = colon ? atoi(colon + 1) : 2390;
+        transportPosixConfigure(DRONE_LOCAL_PORT, host, port);
+    }
+    else
+    {
+        reflector = fork();
+        if (reflector == 0)
+        {
+            runReflector();
+        }
+        usleep(100 * 1000);
+        transportPosixConfigure(LOOPBACK_BENCH_PORT, LOOPBACK_HOST, LOOPBACK_REFLECT_PORT);
+    }
+
+    transportInit(&transportPosix);
+    if (!transportTest())
+    {
+        fprintf(stderr, "transport init failed\n");
+        return 1;
+    }
+
+    // 反射端不会登记发起端以外的地址, 这里直接以对端地址为目标 (TRANSPORT_DEST_BROADCAST)
+    TransportBenchResult r;
+    transportBenchRun(TRANSPORT_DEST_BROADCAST, (uint16_t)count, (uint8_t)size, monotonicUs, &r);
+
+    if (reflector > 0)
+    {
+        kill(reflector, SIGTERM);
+        waitpid(reflector, NULL, 0);
+    }
+
+    printf("transport: %s  target: %s:%d  size: %d B\n", transportName(), host, port, size);
+    printf("latency (RTT/2): %u/%u received  min %u us  avg %u us  max %u us\n",
+           r.pingReceived, r.pingSent, r.latencyMinUs, r.latencyAvgUs, r.latencyMaxUs);
+    printf("echo throughput: %u/%u received  %.1f kB/s\n",
+           r.burstReceived, r.burstSent, r.throughputBps / 1000.0);
+
+    return r.pingReceived > 0 ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+/**
+ * Transport - 传输层抽象
+ *
+ * 本文件不依赖FreeRTOS/ESP-IDF, 主机构建可直接编译
+ */
+
+#include <stddef.h>
+#include "transport.h"
+
+static const TransportOps *ops = NULL;
+static bool isInit = false;
+
+void transportInit(const TransportOps *transport)
+{
+    if (isInit)
+    {
+        return;
+    }
+
+    ops = transport;
+    isInit = ops->init();
+}
+
+bool transportTest(void)
+{
+    return isInit;
+}
+
+const char *transportName(void)
+{
+    return ops ? ops->name : "none";
+}
+
+bool transportReceive(TransportPacket *in, uint32_t timeoutMs)
+{
+    if (!isInit)
+    {
+        return false;
+    }
+    return ops->receive(in, timeoutMs);
+}
+
+bool transportSendTo(uint8_t dest, const uint8_t *data, uint32_t size)
+{
+    if (!isInit || dest == 0 || size > TRANSPORT_MTU)
+    {
+        return false;
+    }
+    return ops->send(dest, data, size);
+}
+
+bool transportSend(const uint8_t *data, uint32_t size)
+{
+    uint8_t dest = transportGetClientMask();
+    return transportSendTo(dest ? dest : TRANSPORT_DEST_BROADCAST, data, size);
+}
+
+uint8_t transportGetClientMask(void)
+{
+    return isInit ? ops->clientMask() : 0;
+}
+
+int8_t transportGetClientRssi(uint8_t client)
+{
+    if (!isInit || client >= TRANSPORT_MAX_CLIENTS)
+    {
+        return 0;
+    }
+    return ops->clientRssi(client);
+}
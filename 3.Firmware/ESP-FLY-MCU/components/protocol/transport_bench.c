@@ -0,0 +1,171 @@
+/**
+ * Transport Bench - 传输层回环基准测试
+ *
+ * 本文件不依赖FreeRTOS/ESP-IDF, 主机构建可直接编译
+ */
+
+#include <string.h>
+#include "transport_bench.h"
+
+#define BENCH_PHASE_PING 1
+#define BENCH_PHASE_BURST 2
+
+#define BENCH_PING_TIMEOUT_MS 200  // 时延阶段单包等待时间
+#define BENCH_DRAIN_TIMEOUT_MS 300 // 吞吐阶段最后一包后的等待时间
+#define BENCH_BURST_WINDOW 16      // 吞吐阶段最大在途包数
+
+// ==================== 探测包编解码 ====================
+
+static void benchEncode(uint8_t *buf, uint8_t size, uint8_t phase, uint16_t seq, uint32_t timeUs)
+{
+    memset(buf, 0, size);
+    buf[0] = TRANSPORT_BENCH_MAGIC;
+    buf[1] = phase;
+    buf[2] = seq & 0xFF;
+    buf[3] = seq >> 8;
+    buf[4] = timeUs & 0xFF;
+    buf[5] = (timeUs >> 8) & 0xFF;
+    buf[6] = (timeUs >> 16) & 0xFF;
+    buf[7] = timeUs >> 24;
+}
+
+static bool benchDecode(const TransportPacket *pkt, uint8_t *phase, uint16_t *seq, uint32_t *timeUs)
+{
+    if (!transportBenchIsPacket(pkt->data, pkt->size))
+    {
+        return false;
+    }
+
+    *phase = pkt->data[1];
+    *seq = pkt->data[2] | (pkt->data[3] << 8);
+    *timeUs = (uint32_t)pkt->data[4] | ((uint32_t)pkt->data[5] << 8) |
+              ((uint32_t)pkt->data[6] << 16) | ((uint32_t)pkt->data[7] << 24);
+    return true;
+}
+
+// ==================== 公共接口 ====================
+
+bool transportBenchIsPacket(const uint8_t *data, uint32_t size)
+{
+    return size >= TRANSPORT_BENCH_HEADER_SIZE && data[0] == TRANSPORT_BENCH_MAGIC;
+}
+
+void transportBenchReflect(const TransportPacket *in)
+{
+    uint8_t client = in->client & ~TRANSPORT_CLIENT_NEW;
+
+    if (client < TRANSPORT_MAX_CLIENTS)
+    {
+        transportSendTo(1 << client, in->data, in->size);
+    }
+}
+
+void transportBenchRun(uint8_t dest, uint16_t count, uint8_t size,
+                       TransportBenchClock clock, TransportBenchResult *result)
+{
+    uint8_t buf[TRANSPORT_MTU];
+    TransportPacket pkt;
+    uint8_t phase;
+    uint16_t seq;
+    uint32_t sentUs;
+    uint64_t latencySum = 0;
+
+    if (size < TRANSPORT_BENCH_HEADER_SIZE)
+    {
+        size = TRANSPORT_BENCH_HEADER_SIZE;
+    }
+    else if (size > TRANSPORT_MTU)
+    {
+        size = TRANSPORT_MTU;
+    }
+
+    memset(result, 0, sizeof(*result));
+    result->latencyMinUs = UINT32_MAX;
+
+    // 时延阶段: 逐包往返, 丢弃过期回送
+    for (uint16_t i = 0; i < count; i++)
+    {
+        benchEncode(buf, size, BENCH_PHASE_PING, i, (uint32_t)clock());
+        if (!transportSendTo(dest, buf, size))
+        {
+            continue;
+        }
+        result->pingSent++;
+
+        uint64_t deadline = clock() + BENCH_PING_TIMEOUT_MS * 1000ULL;
+        while (clock() < deadline)
+        {
+            if (!transportReceive(&pkt, BENCH_PING_TIMEOUT_MS))
+            {
+                break;
+            }
+            if (benchDecode(&pkt, &phase, &seq, &sentUs) && phase == BENCH_PHASE_PING && seq == i)
+            {
+                uint32_t oneWayUs = ((uint32_t)clock() - sentUs) / 2;
+                latencySum += oneWayUs;
+                result->pingReceived++;
+                if (oneWayUs < result->latencyMinUs)
+                    result->latencyMinUs = oneWayUs;
+                if (oneWayUs > result->latencyMaxUs)
+                    result->latencyMaxUs = oneWayUs;
+                break;
+            }
+        }
+    }
+
+    if (result->pingReceived > 0)
+    {
+        result->latencyAvgUs = (uint32_t)(latencySum / result->pingReceived);
+    }
+    else
+    {
+        result->latencyMinUs = 0;
+    }
+
+    // 吞吐阶段: 滑动窗口突发, 在途包数不超过BENCH_BURST_WINDOW, 避免UDP无流控导致的缓冲溢出;
+    // 窗口满且等待超时则视为在途包全部丢失
+    uint64_t startUs = clock();
+    uint64_t lastRxUs = startUs;
+    uint16_t abandoned = 0;
+
+    while (result->burstSent < count)
+    {
+        uint16_t inFlight = result->burstSent - result->burstReceived - abandoned;
+
+        if (inFlight < BENCH_BURST_WINDOW)
+        {
+            benchEncode(buf, size, BENCH_PHASE_BURST, result->burstSent, (uint32_t)clock());
+            if (transportSendTo(dest, buf, size))
+            {
+                result->burstSent++;
+                continue;
+            }
+        }
+
+        if (!transportReceive(&pkt, BENCH_PING_TIMEOUT_MS))
+        {
+            abandoned += inFlight;
+        }
+        else if (benchDecode(&pkt, &phase, &seq, &sentUs) && phase == BENCH_PHASE_BURST)
+        {
+            result->burstReceived++;
+            lastRxUs = clock();
+        }
+    }
+
+    while (result->burstReceived + abandoned < result->burstSent &&
+           transportReceive(&pkt, BENCH_DRAIN_TIMEOUT_MS))
+    {
+        if (benchDecode(&pkt, &phase, &seq, &sentUs) && phase == BENCH_PHASE_BURST)
+        {
+            result->burstReceived++;
+            lastRxUs = clock();
+        }
+    }
+
+    if (lastRxUs > startUs)
+    {
+        result->throughputBps = (uint32_t)((uint64_t)result->burstReceived * size * 1000000ULL /
+                                           (lastRxUs - startUs));
+    }
+}
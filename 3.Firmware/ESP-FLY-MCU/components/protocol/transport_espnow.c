@@ -0,0 +1,237 @@
+/**
+ * Transport ESP-NOW - ESP-NOW 无连接传输后端
+ *
+ * 与softAP共用信道 (复用wifiRadioInit完成射频初始化, 不创建UDP套接字与收发任务), 无需关联和IP协议栈,
+ * 单包开销比UDP小, 适合命令链路. 地面端需要一块运行ESP-NOW的ESP32作为桥接.
+ * 客户端以MAC地址登记, 语义与UDP后端一致.
+ */
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include "esp_now.h"
+#include "esp_mac.h"
+#include "esp_wifi.h"
+
+#include "transport.h"
+#include "wifi_esp32.h"
+#include "stm32_legacy.h"
+
+#define DEBUG_MODULE "ESPNOW"
+#include "debug_cf.h"
+
+#define ESPNOW_CLIENT_TIMEOUT M2T(3000) // 客户端保活超时
+#define ESPNOW_RX_QUEUE_LEN 5
+
+typedef struct
+{
+    bool active;
+    uint8_t mac[ESP_NOW_ETH_ALEN];
+    TickType_t lastSeen;
+    int8_t rssi;
+} EspNowClient;
+
+static const uint8_t broadcastMac[ESP_NOW_ETH_ALEN] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+static EspNowClient clients[TRANSPORT_MAX_CLIENTS];
+static SemaphoreHandle_t clientMutex;
+static xQueueHandle rxQueue;
+
+static void addPeer(const uint8_t *mac)
+{
+    esp_now_peer_info_t peer = {
+        .channel = 0, // 使用当前信道
+        .ifidx = WIFI_IF_AP,
+        .encrypt = false,
+    };
+    memcpy(peer.peer_addr, mac, ESP_NOW_ETH_ALEN);
+
+    if (!esp_now_is_peer_exist(mac))
+    {
+        esp_now_add_peer(&peer);
+    }
+}
+
+/**
+ * 登记/刷新发送方 (在WiFi任务中调用), 返回客户端索引 (新登记时带TRANSPORT_CLIENT_NEW)
+ * 回调中不调用esp_now_add_peer/del_peer: 对端在首次发送时添加, 超时客户端由espnowClientMask注销
+ */
+static uint8_t clientTouch(const uint8_t *mac, int8_t rssi)
+{
+    TickType_t now = xTaskGetTickCount();
+    uint8_t result = TRANSPORT_CLIENT_NONE;
+    int freeSlot = -1;
+
+    xSemaphoreTake(clientMutex, portMAX_DELAY);
+    for (int i = 0; i < TRANSPORT_MAX_CLIENTS; i++)
+    {
+        if (clients[i].active && memcmp(clients[i].mac, mac, ESP_NOW_ETH_ALEN) == 0)
+        {
+            clients[i].lastSeen = now;
+            clients[i].rssi = rssi;
+            result = i;
+            break;
+        }
+
+        if (!clients[i].active && freeSlot < 0)
+        {
+            freeSlot = i;
+        }
+    }
+
+    if (result == TRANSPORT_CLIENT_NONE && freeSlot >= 0)
+    {
+        clients[freeSlot].active = true;
+        clients[freeSlot].lastSeen = now;
+        clients[freeSlot].rssi = rssi;
+        memcpy(clients[freeSlot].mac, mac, ESP_NOW_ETH_ALEN);
+        result = freeSlot | TRANSPORT_CLIENT_NEW;
+    }
+    xSemaphoreGive(clientMutex);
+
+    if (result & TRANSPORT_CLIENT_NEW)
+    {
+        DEBUG_PRINT_LOCAL("Client %d registered: " MACSTR, freeSlot, MAC2STR(mac));
+    }
+    return result;
+}
+
+static void espnowRecvCb(const esp_now_recv_info_t *info, const uint8_t *data, int len)
+{
+    TransportPacket packet;
+
+    if (len <= 0 || len > TRANSPORT_MTU)
+    {
+        return;
+    }
+
+    packet.size = len;
+    packet.client = clientTouch(info->src_addr, info->rx_ctrl ? info->rx_ctrl->rssi : 0);
+    memcpy(packet.data, data, len);
+
+    // WiFi任务中不阻塞, 队列满则丢弃
+    xQueueSend(rxQueue, &packet, 0);
+}
+
+static bool espnowInit(void)
+{
+    // 复用softAP的射频与信道初始化 (只有WiFi驱动与netif, 不启动UDP收发任务)
+    wifiRadioInit();
+
+    clientMutex = xSemaphoreCreateMutex();
+    rxQueue = xQueueCreate(ESPNOW_RX_QUEUE_LEN, sizeof(TransportPacket));
+
+    if (esp_now_init() != ESP_OK)
+    {
+        DEBUG_PRINT_LOCAL("esp_now_init failed");
+        return false;
+    }
+    esp_now_register_recv_cb(espnowRecvCb);
+    addPeer(broadcastMac);
+
+    DEBUG_PRINT_LOCAL("ESP-NOW transport ready");
+    return true;
+}
+
+static bool espnowReceive(TransportPacket *in, uint32_t timeoutMs)
+{
+    TickType_t ticks = (timeoutMs == TRANSPORT_WAIT_FOREVER) ? portMAX_DELAY : M2T(timeoutMs);
+    return (xQueueReceive(rxQueue, in, ticks) == pdTRUE);
+}
+
+static bool espnowSend(uint8_t dest, const uint8_t *data, uint32_t size)
+{
+    bool ok = true;
+
+    if (dest & TRANSPORT_DEST_BROADCAST)
+    {
+        return (esp_now_send(broadcastMac, data, size) == ESP_OK);
+    }
+
+    for (int i = 0; i < TRANSPORT_MAX_CLIENTS; i++)
+    {
+        if (!(dest & (1 << i)))
+        {
+            continue;
+        }
+
+        uint8_t mac[ESP_NOW_ETH_ALEN];
+        xSemaphoreTake(clientMutex, portMAX_DELAY);
+        bool active = clients[i].active;
+        memcpy(mac, clients[i].mac, ESP_NOW_ETH_ALEN);
+        xSemaphoreGive(clientMutex);
+
+        if (!active)
+        {
+            continue;
+        }
+
+        // ESP_ERR_ESPNOW_NO_MEM: 发送队列满, 直接丢弃
+        addPeer(mac);
+        if (esp_now_send(mac, data, size) != ESP_OK)
+        {
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+static uint8_t espnowClientMask(void)
+{
+    TickType_t now = xTaskGetTickCount();
+    uint8_t mask = 0;
+    uint8_t expired = 0;
+    uint8_t expiredMac[TRANSPORT_MAX_CLIENTS][ESP_NOW_ETH_ALEN];
+
+    xSemaphoreTake(clientMutex, portMAX_DELAY);
+    for (int i = 0; i < TRANSPORT_MAX_CLIENTS; i++)
+    {
+        if (!clients[i].active)
+        {
+            continue;
+        }
+
+        if (now - clients[i].lastSeen > ESPNOW_CLIENT_TIMEOUT)
+        {
+            clients[i].active = false;
+            memcpy(expiredMac[i], clients[i].mac, ESP_NOW_ETH_ALEN);
+            expired |= (1 << i);
+            continue;
+        }
+        mask |= (1 << i);
+    }
+    xSemaphoreGive(clientMutex);
+
+    // esp_now_del_peer会与WiFi任务同步, 不在clientMutex中调用 (接收回调也要取该锁);
+    // 期间同一MAC重新登记时, 下次发送前addPeer会重新添加对端
+    for (int i = 0; i < TRANSPORT_MAX_CLIENTS; i++)
+    {
+        if (expired & (1 << i))
+        {
+            esp_now_del_peer(expiredMac[i]);
+            DEBUG_PRINT_LOCAL("Client %d expired", i);
+        }
+    }
+
+    return mask;
+}
+
+static int8_t espnowClientRssi(uint8_t client)
+{
+    xSemaphoreTake(clientMutex, portMAX_DELAY);
+    int8_t rssi = clients[client].active ? clients[client].rssi : 0;
+    xSemaphoreGive(clientMutex);
+    return rssi;
+}
+
+const TransportOps transportEspNow = {
+    .name = "espnow",
+    .init = espnowInit,
+    .receive = espnowReceive,
+    .send = espnowSend,
+    .clientMask = espnowClientMask,
+    .clientRssi = espnowClientRssi,
+};
@@ -0,0 +1,52 @@
+/**
+ * Transport UDP - softAP + lwIP UDP 传输后端
+ *
+ * 包装wifi_esp32驱动 (客户端注册表、单播/广播发送由驱动实现)
+ */
+
+#include <string.h>
+
+#include "transport.h"
+#include "wifi_esp32.h"
+
+_Static_assert(WIFI_RX_TX_PACKET_SIZE == TRANSPORT_MTU, "transport MTU mismatch");
+_Static_assert(WIFI_MAX_CLIENTS == TRANSPORT_MAX_CLIENTS, "client table size mismatch");
+_Static_assert(WIFI_CLIENT_NONE == TRANSPORT_CLIENT_NONE, "client flag mismatch");
+_Static_assert(WIFI_CLIENT_NEW == TRANSPORT_CLIENT_NEW, "client flag mismatch");
+_Static_assert(WIFI_DEST_BROADCAST == TRANSPORT_DEST_BROADCAST, "dest flag mismatch");
+
+static bool udpInit(void)
+{
+    wifiInit();
+    return wifiTest();
+}
+
+static bool udpReceive(TransportPacket *in, uint32_t timeoutMs)
+{
+    UDPPacket packet;
+    bool received = (timeoutMs == TRANSPORT_WAIT_FOREVER) ? wifiGetDataBlocking(&packet)
+                                                          : wifiGetData(&packet, timeoutMs);
+    if (!received)
+    {
+        return false;
+    }
+
+    in->size = packet.size;
+    in->client = packet.client;
+    memcpy(in->data, packet.data, packet.size);
+    return true;
+}
+
+static bool udpSend(uint8_t dest, const uint8_t *data, uint32_t size)
+{
+    return wifiSendDataTo(dest, size, (uint8_t *)data);
+}
+
+const TransportOps transportUdp = {
+    .name = "udp",
+    .init = udpInit,
+    .receive = udpReceive,
+    .send = udpSend,
+    .clientMask = wifiGetClientMask,
+    .clientRssi = wifiGetClientRssi,
+};
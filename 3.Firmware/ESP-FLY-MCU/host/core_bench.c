@@ -0,0 +1,1045 @@
+/**
+ * core_bench - 固件核心代码的主机端微基准与黄金输出比对
+ *
+ * 直接链接固件中未经修改的 filter.c / pid.c / sensfusion6.c / packet_codec.c 与 math3d.h,
+ * 在PC上测量滤波链、PID组、四元数更新与协议编解码的耗时, 并用确定性输入生成输出样本,
+ * 与 golden/core_bench.golden 比对, 以便在上机之前验证对这些文件的优化.
+ *
+ * 构建 (在 3.Firmware/ESP-FLY-MCU 目录下):
+ *   cmake -S host -B build-host && cmake --build build-host
+ *
+ * 用法:
+ *   ./core_bench                      运行全部基准 (ns/op 与吞吐量)
+ *   ./core_bench --filter packet      只运行名称包含 packet 的基准
+ *   ./core_bench --check [FILE]       与黄金输出比对, 不一致时返回1
+ *   ./core_bench --update [FILE]      重新生成黄金输出 (有意修改算法行为后使用)
+ *   可选参数: --min-time MS (每轮最短测量时间, 默认50)  --tolerance REL (默认1e-4)
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "filter.h"
+#include "math3d.h"
+#include "packet_codec.h"
+#include "pid.h"
+#include "sensfusion6.h"
+#include "state_snapshot.h"
+
+#ifndef CORE_BENCH_GOLDEN
+#define CORE_BENCH_GOLDEN "golden/core_bench.golden"
+#endif
+
+#define BENCH_REPEATS 5      // 每个基准重复测量的轮数, 取最快一轮
+#define INPUT_TABLE_SIZE 1024 // 预生成的输入样本数 (2的幂)
+#define GOLDEN_MAX_SAMPLES 4096
+#define GOLDEN_NAME_MAX 32
+
+#define IMU_RATE_HZ 1000.0f
+#define IMU_DT (1.0f / IMU_RATE_HZ)
+#define ATTITUDE_DT (1.0f / 500.0f)
+
+// ============================================================================
+// 确定性输入
+// ============================================================================
+
+typedef struct
+{
+    float gyro[3]; // deg/s
+    float acc[3];  // Gs
+    float angle[3];
+} ImuSample;
+
+static ImuSample inputs[INPUT_TABLE_SIZE];
+static uint32_t lcgState;
+
+static uint32_t lcgNext(void)
+{
+    lcgState = lcgState * 1664525u + 1013904223u;
+    return lcgState;
+}
+
+// [-1, 1) 均匀分布
+static float lcgUniform(void)
+{
+    return (float)(lcgNext() >> 8) / (float)(1u << 23) - 1.0f;
+}
+
+/**
+ * 合成的IMU数据: 缓慢的姿态摆动 + 电机振动 + 噪声, 与真实飞行数据的频谱大致相当
+ */
+static void makeImuSample(uint32_t i, ImuSample *s)
+{
+    float t = i * IMU_DT;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        float slow = 20.0f * sinf(2.0f * (float)M_PI * (0.7f + 0.3f * axis) * t);
+        float vib = 8.0f * sinf(2.0f * (float)M_PI * (180.0f + 15.0f * axis) * t);
+        s->gyro[axis] = slow + vib + 2.0f * lcgUniform();
+        s->angle[axis] = 10.0f * sinf(2.0f * (float)M_PI * 0.25f * t + axis);
+    }
+    s->acc[0] = 0.05f * sinf(2.0f * (float)M_PI * 0.5f * t) + 0.02f * lcgUniform();
+    s->acc[1] = -0.04f * cosf(2.0f * (float)M_PI * 0.4f * t) + 0.02f * lcgUniform();
+    s->acc[2] = 1.0f + 0.03f * lcgUniform();
+}
+
+static void initInputs(void)
+{
+    lcgState = 12345;
+    for (uint32_t i = 0; i < INPUT_TABLE_SIZE; i++)
+    {
+        makeImuSample(i, &inputs[i]);
+    }
+}
+
+static const ImuSample *input(uint32_t i)
+{
+    return &inputs[i & (INPUT_TABLE_SIZE - 1)];
+}
+
+// sensfusion6.c 的估计器状态为全局变量, 各用例开始前复位
+extern float qw, qx, qy, qz;
+extern float integralFBx, integralFBy, integralFBz;
+
+static void resetFusion(void)
+{
+    qw = 1.0f;
+    qx = qy = qz = 0.0f;
+    integralFBx = integralFBy = integralFBz = 0.0f;
+}
+
+static void fillHighFreq(uint32_t i, HighFreqDataPacket_t *hf)
+{
+    const ImuSample *s = input(i);
+    hf->roll = s->angle[0];
+    hf->pitch = s->angle[1];
+    hf->yaw = s->angle[2];
+    hf->rollRateDesired = s->gyro[0];
+    hf->pitchRateDesired = s->gyro[1];
+    hf->yawRateDesired = s->gyro[2];
+    hf->rollControl = (int16_t)(s->gyro[0] * 100);
+    hf->pitchControl = (int16_t)(s->gyro[1] * 100);
+    hf->yawControl = (int16_t)(s->gyro[2] * 100);
+    hf->motor1 = (uint16_t)(i * 7);
+    hf->motor2 = (uint16_t)(i * 11);
+    hf->motor3 = (uint16_t)(i * 13);
+    hf->motor4 = (uint16_t)(i * 17);
+    hf->gyroX = s->gyro[0];
+    hf->gyroY = s->gyro[1];
+    hf->gyroZ = s->gyro[2];
+    hf->accX = s->acc[0];
+    hf->accY = s->acc[1];
+    hf->accZ = s->acc[2];
+    hf->timestamp = (uint16_t)i;
+}
+
+// ============================================================================
+// 被测对象: 滤波链 / PID组
+// ============================================================================
+
+// 陀螺仪与加速度计各3轴的二阶低通 (与传感器驱动相同的采样率与截止频率)
+typedef struct
+{
+    lpf2pData lpf[6];
+    Butterworth2LowPass bw[6];
+} FilterChain;
+
+static void filterChainInit(FilterChain *fc)
+{
+    for (int i = 0; i < 6; i++)
+    {
+        lpf2pInit(&fc->lpf[i], IMU_RATE_HZ, i < 3 ? 80.0f : 30.0f);
+        init_butterworth_2_low_pass(&fc->bw[i], 1.0f / (2.0f * (float)M_PI * 40.0f), IMU_DT, 0.0f);
+    }
+}
+
+// 姿态环 + 角速度环, 各3轴, 与 attitude_pid_controller.c 的串级结构相同
+typedef struct
+{
+    PidObject angle[3];
+    PidObject rate[3];
+    float out[3];
+} PidBank;
+
+static void pidBankInit(PidBank *bank)
+{
+    for (int axis = 0; axis < 3; axis++)
+    {
+        pidInit(&bank->angle[axis], 0, 6.0f, 3.0f, 0.0f, ATTITUDE_DT, 500.0f, 0.0f, false);
+        pidSetIntegralLimit(&bank->angle[axis], 20.0f);
+        pidInit(&bank->rate[axis], 0, 250.0f, 500.0f, 2.5f, ATTITUDE_DT, 500.0f, 30.0f, true);
+        pidSetIntegralLimit(&bank->rate[axis], 33.3f);
+    }
+}
+
+static void pidBankUpdate(PidBank *bank, const ImuSample *s)
+{
+    for (int axis = 0; axis < 3; axis++)
+    {
+        pidSetDesired(&bank->angle[axis], 0.5f * s->angle[axis]);
+        float rateDesired = pidUpdate(&bank->angle[axis], s->angle[axis], true);
+        pidSetDesired(&bank->rate[axis], rateDesired);
+        bank->out[axis] = pidUpdate(&bank->rate[axis], s->gyro[axis], true);
+    }
+}
+
+// ============================================================================
+// 黄金输出
+// ============================================================================
+
+typedef struct
+{
+    char name[GOLDEN_NAME_MAX];
+    int index;
+    bool exact; // 整数样本 (哈希/长度) 精确比较, 浮点样本按容差比较
+    double value;
+} GoldenSample;
+
+typedef struct
+{
+    GoldenSample *samples;
+    int count;
+    const char *name; // 当前用例
+} GoldenSet;
+
+static void goldenAdd(GoldenSet *set, int index, bool exact, double value)
+{
+    if (set->count >= GOLDEN_MAX_SAMPLES)
+    {
+        fprintf(stderr, "too many golden samples\n");
+        exit(2);
+    }
+    GoldenSample *s = &set->samples[set->count++];
+    snprintf(s->name, sizeof(s->name), "%s", set->name);
+    s->index = index;
+    s->exact = exact;
+    s->value = value;
+}
+
+static void goldenFloat(GoldenSet *set, int index, float value)
+{
+    goldenAdd(set, index, false, value);
+}
+
+static void goldenU32(GoldenSet *set, int index, uint32_t value)
+{
+    goldenAdd(set, index, true, value);
+}
+
+static uint32_t fnv1a(uint32_t hash, const uint8_t *data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static void goldenFilterChain(GoldenSet *set)
+{
+    FilterChain fc;
+    filterChainInit(&fc);
+
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        const ImuSample *s = input(i);
+        for (int ch = 0; ch < 6; ch++)
+        {
+            float x = ch < 3 ? s->gyro[ch] : s->acc[ch - 3];
+            float y = lpf2pApply(&fc.lpf[ch], x);
+            float z = update_butterworth_2_low_pass(&fc.bw[ch], x);
+            if (i % 100 == 99)
+            {
+                goldenFloat(set, i * 12 + ch * 2, y);
+                goldenFloat(set, i * 12 + ch * 2 + 1, z);
+            }
+        }
+    }
+}
+
+static void goldenPidBank(GoldenSet *set)
+{
+    PidBank bank;
+    pidBankInit(&bank);
+
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        pidBankUpdate(&bank, input(i));
+        if (i % 100 == 99)
+        {
+            for (int axis = 0; axis < 3; axis++)
+            {
+                goldenFloat(set, i * 6 + axis * 2, bank.out[axis]);
+                goldenFloat(set, i * 6 + axis * 2 + 1, bank.rate[axis].integ);
+            }
+        }
+    }
+}
+
+static void goldenSensfusion(GoldenSet *set)
+{
+    resetFusion();
+
+    for (uint32_t i = 0; i < 5000; i++)
+    {
+        const ImuSample *s = input(i);
+        sensfusion6UpdateQ(s->gyro[0], s->gyro[1], s->gyro[2], s->acc[0], s->acc[1], s->acc[2], IMU_DT);
+        if (i % 250 == 249)
+        {
+            float q[4], rpy[3];
+            sensfusion6GetQuaternion(&q[0], &q[1], &q[2], &q[3]);
+            sensfusion6GetEulerRPY(&rpy[0], &rpy[1], &rpy[2]);
+            for (int k = 0; k < 4; k++)
+            {
+                goldenFloat(set, i * 8 + k, q[k]);
+            }
+            for (int k = 0; k < 3; k++)
+            {
+                goldenFloat(set, i * 8 + 4 + k, rpy[k]);
+            }
+            goldenFloat(set, i * 8 + 7,
+                        sensfusion6GetAccZWithoutGravity(s->acc[0], s->acc[1], s->acc[2]));
+        }
+    }
+    resetFusion();
+}
+
+// 拆分形式: 每个样本预测, 每4个样本 (250Hz) 校正一次, 与估计器的默认配置一致
+#define FUSION_CORRECT_DIV 4
+
+static void goldenSensfusionSplit(GoldenSet *set)
+{
+    resetFusion();
+
+    for (uint32_t i = 0; i < 5000; i++)
+    {
+        const ImuSample *s = input(i);
+        sensfusion6Predict(s->gyro[0], s->gyro[1], s->gyro[2], IMU_DT);
+        if (i % FUSION_CORRECT_DIV == FUSION_CORRECT_DIV - 1)
+        {
+            sensfusion6Correct(s->acc[0], s->acc[1], s->acc[2], IMU_DT * FUSION_CORRECT_DIV);
+        }
+        if (i % 250 == 249)
+        {
+            float q[4], rpy[3];
+            sensfusion6GetQuaternion(&q[0], &q[1], &q[2], &q[3]);
+            sensfusion6GetEulerRPY(&rpy[0], &rpy[1], &rpy[2]);
+            for (int k = 0; k < 4; k++)
+            {
+                goldenFloat(set, i * 7 + k, q[k]);
+            }
+            for (int k = 0; k < 3; k++)
+            {
+                goldenFloat(set, i * 7 + 4 + k, rpy[k]);
+            }
+        }
+    }
+    resetFusion();
+}
+
+static void goldenMath3d(GoldenSet *set)
+{
+    struct quat q = qeye();
+
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        const ImuSample *s = input(i);
+        struct vec omega = vscl(radians(1.0f), vloadf(s->gyro));
+        struct quat dq = qaxisangle(vnormalize(omega), vmag(omega) * IMU_DT);
+        q = qnormalize(qqmul(q, dq));
+
+        if (i % 50 == 49)
+        {
+            struct vec rpy = quat2rpy(q);
+            struct quat back = rpy2quat(rpy);
+            struct vec g = qvrot(qinv(q), mkvec(0.0f, 0.0f, 1.0f));
+            struct vec m = mvmul(quat2rotmat(q), vloadf(s->acc));
+            struct quat mid = qslerp(qeye(), q, 0.5f);
+            float values[] = {
+                q.x, q.y, q.z, q.w,
+                rpy.x, rpy.y, rpy.z,
+                qanglebetween(q, back),
+                g.x, g.y, g.z,
+                m.x, m.y, m.z,
+                mid.x, mid.w,
+            };
+            for (int k = 0; k < (int)(sizeof(values) / sizeof(values[0])); k++)
+            {
+                goldenFloat(set, i * 16 + k, values[k]);
+            }
+        }
+    }
+}
+
+static void goldenPacket(GoldenSet *set)
+{
+    uint8_t frame[PKT_FRAME_LEN_HIGH_FREQ_DATA];
+    uint8_t datagram[PACKET_MAX_SIZE * 2];
+    PacketFrame_t parsed;
+    HighFreqDataPacket_t hf, decoded;
+    uint32_t frameHash = 2166136261u;
+    uint32_t decodeHash = 2166136261u;
+    uint32_t datagramHash = 2166136261u;
+    uint32_t failures = 0;
+
+    for (uint32_t i = 0; i < 500; i++)
+    {
+        fillHighFreq(i, &hf);
+        uint16_t len = packet_encodeHighFreqData(frame, sizeof(frame), &hf);
+        frameHash = fnv1a(frameHash, frame, len);
+
+        if (!packet_parse(frame, len, &parsed) ||
+            !packet_decodeHighFreqData(parsed.payload, parsed.length, &decoded))
+        {
+            failures++;
+            continue;
+        }
+        decodeHash = fnv1a(decodeHash, (const uint8_t *)&decoded, sizeof(decoded));
+
+        // 每4帧打包一个v2数据报
+        if (i % 4 == 3)
+        {
+            PacketDatagram_t dg;
+            uint16_t space;
+            packet_datagramBegin(&dg, datagram, sizeof(datagram));
+            for (int k = 0; k < 4; k++)
+            {
+                uint8_t *tail = packet_datagramTail(&dg, &space);
+                fillHighFreq(i - 3 + k, &hf);
+                packet_datagramCommit(&dg, packet_encodeHighFreqData(tail, space, &hf));
+            }
+            uint16_t dlen = packet_datagramFinish(&dg, (uint16_t)i, i * 20);
+            datagramHash = fnv1a(datagramHash, datagram, dlen);
+
+            PacketDatagramInfo_t info;
+            if (!packet_parseDatagramV2(datagram, dlen, &info))
+            {
+                failures++;
+            }
+        }
+    }
+
+    goldenU32(set, 0, frameHash);
+    goldenU32(set, 1, decodeHash);
+    goldenU32(set, 2, datagramHash);
+    goldenU32(set, 3, packet_crc16(datagram, 64, 0xFFFF));
+    goldenU32(set, 4, failures);
+}
+
+typedef struct
+{
+    const char *name;
+    void (*run)(GoldenSet *set);
+} GoldenCase;
+
+static const GoldenCase goldenCases[] = {
+    {"filter.chain", goldenFilterChain},
+    {"pid.bank", goldenPidBank},
+    {"sensfusion6", goldenSensfusion},
+    {"sensfusion6.split", goldenSensfusionSplit},
+    {"math3d.quat", goldenMath3d},
+    {"packet.highfreq", goldenPacket},
+};
+
+#define GOLDEN_CASE_COUNT ((int)(sizeof(goldenCases) / sizeof(goldenCases[0])))
+
+static void goldenCollect(GoldenSet *set)
+{
+    for (int i = 0; i < GOLDEN_CASE_COUNT; i++)
+    {
+        initInputs();
+        set->name = goldenCases[i].name;
+        goldenCases[i].run(set);
+    }
+}
+
+static int goldenWrite(const char *path)
+{
+    GoldenSet set = {.samples = calloc(GOLDEN_MAX_SAMPLES, sizeof(GoldenSample))};
+    goldenCollect(&set);
+
+    FILE *f = fopen(path, "w");
+    if (f == NULL)
+    {
+        perror(path);
+        return 2;
+    }
+    fprintf(f, "# core_bench golden outputs, regenerate with: core_bench --update\n");
+    for (int i = 0; i < set.count; i++)
+    {
+        const GoldenSample *s = &set.samples[i];
+        if (s->exact)
+        {
+            fprintf(f, "%s %d 0x%08lx\n", s->name, s->index, (unsigned long)s->value);
+        }
+        else
+        {
+            fprintf(f, "%s %d %.9g\n", s->name, s->index, s->value);
+        }
+    }
+    fclose(f);
+    printf("wrote %d samples to %s\n", set.count, path);
+    free(set.samples);
+    return 0;
+}
+
+static int goldenLoad(const char *path, GoldenSet *set)
+{
+    char line[128];
+    FILE *f = fopen(path, "r");
+    if (f == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), f))
+    {
+        char name[GOLDEN_NAME_MAX], value[32];
+        int index;
+        if (line[0] == '#' || sscanf(line, "%31s %d %31s", name, &index, value) != 3)
+        {
+            continue;
+        }
+        set->name = name;
+        if (!strncmp(value, "0x", 2))
+        {
+            goldenAdd(set, index, true, (double)strtoul(value, NULL, 16));
+        }
+        else
+        {
+            goldenAdd(set, index, false, strtod(value, NULL));
+        }
+    }
+    fclose(f);
+    return set->count;
+}
+
+static int goldenCheck(const char *path, double tolerance)
+{
+    GoldenSet expected = {.samples = calloc(GOLDEN_MAX_SAMPLES, sizeof(GoldenSample))};
+    GoldenSet actual = {.samples = calloc(GOLDEN_MAX_SAMPLES, sizeof(GoldenSample))};
+    int mismatches = 0;
+
+    if (goldenLoad(path, &expected) < 0)
+    {
+        return 2;
+    }
+    goldenCollect(&actual);
+
+    if (expected.count != actual.count)
+    {
+        printf("sample count differs: golden %d, actual %d\n", expected.count, actual.count);
+        mismatches++;
+    }
+
+    int n = expected.count < actual.count ? expected.count : actual.count;
+    for (int i = 0; i < n; i++)
+    {
+        const GoldenSample *e = &expected.samples[i];
+        const GoldenSample *a = &actual.samples[i];
+        bool same;
+
+        if (strcmp(e->name, a->name) || e->index != a->index)
+        {
+            printf("layout differs at #%d: golden %s[%d], actual %s[%d]\n", i, e->name, e->index, a->name, a->index);
+            mismatches++;
+            break;
+        }
+        if (e->exact)
+        {
+            same = e->value == a->value;
+        }
+        else
+        {
+            same = fabs(a->value - e->value) <= tolerance * fmax(1.0, fabs(e->value));
+        }
+        if (!same)
+        {
+            if (mismatches < 20)
+            {
+                printf("%-16s [%5d] golden %.9g, actual %.9g\n", e->name, e->index, e->value, a->value);
+            }
+            mismatches++;
+        }
+    }
+
+    printf("%s: %d samples, %d mismatches (tolerance %g)\n", mismatches ? "FAIL" : "OK", n, mismatches, tolerance);
+    free(expected.samples);
+    free(actual.samples);
+    return mismatches ? 1 : 0;
+}
+
+// ============================================================================
+// 微基准
+// ============================================================================
+
+static volatile float sinkF;
+static volatile uint32_t sinkU;
+
+// 阻止编译器把循环内的内存写入合并或外提 (内联的编码函数)
+#define BENCH_CLOBBER() __asm__ volatile("" ::: "memory")
+
+#define BENCH_TABLE_SIZE 64
+
+static struct quat benchQuatTable[BENCH_TABLE_SIZE];
+static HighFreqDataPacket_t benchHfTable[BENCH_TABLE_SIZE];
+
+static FilterChain benchFilter;
+static PidBank benchPid;
+static struct quat benchQuat;
+static uint8_t benchFrame[PKT_FRAME_LEN_HIGH_FREQ_DATA];
+static uint8_t benchDatagram[PACKET_MAX_SIZE * 2];
+static uint16_t benchDatagramLen;
+
+static void setupFilter(void)
+{
+    filterChainInit(&benchFilter);
+}
+
+static void benchLpf2p(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const ImuSample *s = input(i);
+        float acc = 0;
+        for (int ch = 0; ch < 3; ch++)
+        {
+            acc += lpf2pApply(&benchFilter.lpf[ch], s->gyro[ch]);
+            acc += lpf2pApply(&benchFilter.lpf[ch + 3], s->acc[ch]);
+        }
+        sinkF = acc;
+    }
+}
+
+static void benchButterworth(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const ImuSample *s = input(i);
+        float acc = 0;
+        for (int ch = 0; ch < 3; ch++)
+        {
+            acc += update_butterworth_2_low_pass(&benchFilter.bw[ch], s->gyro[ch]);
+            acc += update_butterworth_2_low_pass(&benchFilter.bw[ch + 3], s->acc[ch]);
+        }
+        sinkF = acc;
+    }
+}
+
+static void setupPid(void)
+{
+    pidBankInit(&benchPid);
+}
+
+static void benchPidBank(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        pidBankUpdate(&benchPid, input(i));
+        sinkF = benchPid.out[0];
+    }
+}
+
+static void benchFusionUpdate(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const ImuSample *s = input(i);
+        sensfusion6UpdateQ(s->gyro[0], s->gyro[1], s->gyro[2], s->acc[0], s->acc[1], s->acc[2], IMU_DT);
+    }
+    sinkF = qw;
+}
+
+static void benchFusionPredict(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const ImuSample *s = input(i);
+        sensfusion6Predict(s->gyro[0], s->gyro[1], s->gyro[2], IMU_DT);
+    }
+    sinkF = qw;
+}
+
+static void benchFusionCorrect(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const ImuSample *s = input(i);
+        sensfusion6Correct(s->acc[0], s->acc[1], s->acc[2], IMU_DT * FUSION_CORRECT_DIV);
+    }
+    sinkF = qw;
+}
+
+// 估计器每个1kHz周期的平均开销: 旧版每4个样本一次完整更新, 拆分版每个样本预测+输出
+static void benchEstimatorLegacy(uint32_t n)
+{
+    float r, p, y;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const ImuSample *s = input(i);
+        if (i % FUSION_CORRECT_DIV == 0)
+        {
+            sensfusion6UpdateQ(s->gyro[0], s->gyro[1], s->gyro[2], s->acc[0], s->acc[1], s->acc[2],
+                               IMU_DT * FUSION_CORRECT_DIV);
+            sensfusion6GetEulerRPY(&r, &p, &y);
+            sinkF = r + p + y;
+        }
+    }
+}
+
+static void benchEstimatorSplit(uint32_t n)
+{
+    float r, p, y;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const ImuSample *s = input(i);
+        sensfusion6Predict(s->gyro[0], s->gyro[1], s->gyro[2], IMU_DT);
+        if (i % FUSION_CORRECT_DIV == 0)
+        {
+            sensfusion6Correct(s->acc[0], s->acc[1], s->acc[2], IMU_DT * FUSION_CORRECT_DIV);
+        }
+        sensfusion6GetEulerRPY(&r, &p, &y);
+        sinkF = r + p + y;
+    }
+}
+
+static void benchFusionEuler(uint32_t n)
+{
+    float r, p, y;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        sensfusion6GetEulerRPY(&r, &p, &y);
+        sinkF = r + p + y;
+    }
+}
+
+static void setupQuat(void)
+{
+    benchQuat = qeye();
+}
+
+static void benchQuatIntegrate(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const ImuSample *s = input(i);
+        struct quat dq = quatvw(vscl(0.5f * radians(1.0f) * IMU_DT, vloadf(s->gyro)), 1.0f);
+        benchQuat = qnormalize(qqmul(benchQuat, dq));
+    }
+    sinkF = benchQuat.w;
+}
+
+static void setupQuatTable(void)
+{
+    for (uint32_t i = 0; i < BENCH_TABLE_SIZE; i++)
+    {
+        benchQuatTable[i] = rpy2quat(vscl(radians(1.0f), vloadf(input(i * 7)->angle)));
+    }
+}
+
+static void benchQuatRotate(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        struct vec v = qvrot(benchQuatTable[i & (BENCH_TABLE_SIZE - 1)], vloadf(input(i)->acc));
+        sinkF = v.z;
+    }
+}
+
+static void benchQuatRotmat(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        struct vec v = mvmul(quat2rotmat(benchQuatTable[i & (BENCH_TABLE_SIZE - 1)]), vloadf(input(i)->acc));
+        sinkF = v.z;
+    }
+}
+
+static void benchQuatRpy(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        struct vec rpy = vscl(radians(1.0f), vloadf(input(i)->angle));
+        struct vec back = quat2rpy(rpy2quat(rpy));
+        sinkF = back.x;
+    }
+}
+
+static void setupHfTable(void)
+{
+    for (uint32_t i = 0; i < BENCH_TABLE_SIZE; i++)
+    {
+        fillHighFreq(i, &benchHfTable[i]);
+    }
+}
+
+static void benchEncodeHighFreq(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        sinkU = packet_encodeHighFreqData(benchFrame, sizeof(benchFrame), &benchHfTable[i & (BENCH_TABLE_SIZE - 1)]);
+        BENCH_CLOBBER();
+    }
+}
+
+static void setupFrame(void)
+{
+    HighFreqDataPacket_t hf;
+    fillHighFreq(1, &hf);
+    packet_encodeHighFreqData(benchFrame, sizeof(benchFrame), &hf);
+}
+
+static void benchDecodeHighFreq(uint32_t n)
+{
+    PacketFrame_t frame;
+    HighFreqDataPacket_t hf;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        if (packet_parse(benchFrame, sizeof(benchFrame), &frame) &&
+            packet_decodeHighFreqData(frame.payload, frame.length, &hf))
+        {
+            sinkF = hf.roll;
+        }
+    }
+}
+
+static void benchDatagramBuild(uint32_t n)
+{
+    HighFreqDataPacket_t hf;
+    PacketDatagram_t dg;
+    uint16_t space;
+    fillHighFreq(1, &hf);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        packet_datagramBegin(&dg, benchDatagram, sizeof(benchDatagram));
+        for (int k = 0; k < 4; k++)
+        {
+            uint8_t *tail = packet_datagramTail(&dg, &space);
+            packet_datagramCommit(&dg, packet_encodeHighFreqData(tail, space, &hf));
+        }
+        benchDatagramLen = packet_datagramFinish(&dg, (uint16_t)i, i);
+    }
+    sinkU = benchDatagramLen;
+}
+
+static void setupDatagram(void)
+{
+    benchDatagramBuild(1);
+}
+
+static void benchDatagramParse(uint32_t n)
+{
+    PacketDatagramInfo_t info;
+    PacketFrame_t frame;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        if (packet_parseDatagramV2(benchDatagram, benchDatagramLen, &info))
+        {
+            const uint8_t *cursor = info.frames;
+            uint16_t remaining = info.frames_len;
+            while (remaining > 0 && packet_nextFrame(&cursor, &remaining, &frame))
+            {
+                sinkU = frame.packet_id;
+            }
+        }
+    }
+}
+
+// 稳定器每周期发布一次快照, 遥测任务按50Hz读取
+static stateSnapshot_t benchSnapshot;
+
+static void setupSnapshot(void)
+{
+    memset(&benchSnapshot, 0, sizeof(benchSnapshot));
+    benchSnapshot.state.attitude.roll = 1.0f;
+    benchSnapshot.sensorData.gyro.x = 2.0f;
+    stateSnapshotBegin();
+    stateSnapshotCommit();
+}
+
+static void benchSnapshotPublish(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        stateSnapshot_t *snapshot = stateSnapshotBegin();
+        snapshot->tick = i + 1;
+        snapshot->timestamp = i;
+        snapshot->sensorData = benchSnapshot.sensorData;
+        snapshot->state = benchSnapshot.state;
+        snapshot->setpoint = benchSnapshot.setpoint;
+        snapshot->control = benchSnapshot.control;
+        snapshot->rateDesired = benchSnapshot.rateDesired;
+        memcpy(snapshot->motors, benchSnapshot.motors, sizeof(snapshot->motors));
+        stateSnapshotCommit();
+        BENCH_CLOBBER();
+    }
+}
+
+static void benchSnapshotRead(uint32_t n)
+{
+    stateSnapshot_t snapshot;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        sinkU = stateSnapshotRead(&snapshot);
+        BENCH_CLOBBER();
+    }
+}
+
+typedef struct
+{
+    const char *name;
+    const char *item;   // 吞吐量单位
+    uint32_t bytes;     // 每次操作处理的字节数, 0=不统计带宽
+    void (*setup)(void); // 可为NULL
+    void (*run)(uint32_t n);
+} Bench;
+
+static const Bench benches[] = {
+    {"filter.lpf2p x6", "samples", 0, setupFilter, benchLpf2p},
+    {"filter.butterworth2 x6", "samples", 0, setupFilter, benchButterworth},
+    {"pid.bank (3 axis cascade)", "updates", 0, setupPid, benchPidBank},
+    {"sensfusion6.UpdateQ", "updates", 0, resetFusion, benchFusionUpdate},
+    {"sensfusion6.GetEulerRPY", "calls", 0, NULL, benchFusionEuler},
+    {"sensfusion6.Predict", "updates", 0, resetFusion, benchFusionPredict},
+    {"sensfusion6.Correct", "updates", 0, resetFusion, benchFusionCorrect},
+    {"estimator 250Hz update (per ms)", "ticks", 0, resetFusion, benchEstimatorLegacy},
+    {"estimator 1kHz predict (per ms)", "ticks", 0, resetFusion, benchEstimatorSplit},
+    {"math3d.qqmul+qnormalize", "updates", 0, setupQuat, benchQuatIntegrate},
+    {"math3d.qvrot", "rotations", 0, setupQuatTable, benchQuatRotate},
+    {"math3d.quat2rotmat+mvmul", "rotations", 0, setupQuatTable, benchQuatRotmat},
+    {"math3d.rpy2quat+quat2rpy", "conversions", 0, NULL, benchQuatRpy},
+    {"packet.encode HIGH_FREQ", "frames", PKT_FRAME_LEN_HIGH_FREQ_DATA, setupHfTable, benchEncodeHighFreq},
+    {"packet.parse+decode HIGH_FREQ", "frames", PKT_FRAME_LEN_HIGH_FREQ_DATA, setupFrame, benchDecodeHighFreq},
+    {"packet.datagram build x4", "datagrams", PACKET_V2_HEADER_SIZE + 4 * PKT_FRAME_LEN_HIGH_FREQ_DATA + 2,
+     NULL, benchDatagramBuild},
+    {"packet.datagram parse x4", "datagrams", PACKET_V2_HEADER_SIZE + 4 * PKT_FRAME_LEN_HIGH_FREQ_DATA + 2,
+     setupDatagram, benchDatagramParse},
+    {"state_snapshot publish", "ticks", sizeof(stateSnapshot_t), setupSnapshot, benchSnapshotPublish},
+    {"state_snapshot read", "reads", sizeof(stateSnapshot_t), setupSnapshot, benchSnapshotRead},
+};
+
+#define BENCH_COUNT ((int)(sizeof(benches) / sizeof(benches[0])))
+
+static uint64_t monotonicNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static double timeRun(const Bench *b, uint32_t n)
+{
+    if (b->setup)
+    {
+        b->setup();
+    }
+    uint64_t start = monotonicNs();
+    b->run(n);
+    return (double)(monotonicNs() - start);
+}
+
+static void runBench(const Bench *b, double minTimeNs)
+{
+    // 找到单轮耗时不少于minTimeNs的迭代次数
+    uint32_t n = 64;
+    double elapsed = timeRun(b, n);
+    while (elapsed < minTimeNs && n < (1u << 30))
+    {
+        double scale = elapsed > 0 ? 1.2 * minTimeNs / elapsed : 10.0;
+        n = (uint32_t)fmin((double)n * fmax(scale, 2.0), (double)(1u << 30));
+        elapsed = timeRun(b, n);
+    }
+
+    double best = elapsed;
+    for (int r = 1; r < BENCH_REPEATS; r++)
+    {
+        double t = timeRun(b, n);
+        if (t < best)
+        {
+            best = t;
+        }
+    }
+
+    double nsPerOp = best / n;
+    printf("%-32s %9.1f ns/op %10.2f M%s/s", b->name, nsPerOp, 1e3 / nsPerOp, b->item);
+    if (b->bytes)
+    {
+        printf(" %8.1f MB/s", b->bytes * 1e3 / nsPerOp);
+    }
+    printf("\n");
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--filter NAME] [--min-time MS] [--check [FILE]] [--update [FILE]] [--tolerance REL]\n",
+            prog);
+}
+
+int main(int argc, char **argv)
+{
+    const char *filter = NULL;
+    const char *goldenPath = CORE_BENCH_GOLDEN;
+    double minTimeMs = 50;
+    double tolerance = 1e-4;
+    enum
+    {
+        MODE_BENCH,
+        MODE_CHECK,
+        MODE_UPDATE,
+    } mode = MODE_BENCH;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--filter") && i + 1 < argc)
+        {
+            filter = argv[++i];
+        }
+        else if (!strcmp(argv[i], "--min-time") && i + 1 < argc)
+        {
+            minTimeMs = atof(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--tolerance") && i + 1 < argc)
+        {
+            tolerance = atof(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--check") || !strcmp(argv[i], "--update"))
+        {
+            mode = !strcmp(argv[i], "--check") ? MODE_CHECK : MODE_UPDATE;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+            {
+                goldenPath = argv[++i];
+            }
+        }
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (mode == MODE_CHECK)
+    {
+        return goldenCheck(goldenPath, tolerance);
+    }
+    if (mode == MODE_UPDATE)
+    {
+        return goldenWrite(goldenPath);
+    }
+
+    initInputs();
+    for (int i = 0; i < BENCH_COUNT; i++)
+    {
+        if (filter == NULL || strstr(benches[i].name, filter))
+        {
+            runBench(&benches[i], minTimeMs * 1e6);
+        }
+    }
+    return 0;
+}
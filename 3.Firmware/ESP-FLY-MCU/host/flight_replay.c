@@ -0,0 +1,685 @@
+/**
+ * flight_replay - 飞行记录回放, 用于姿态估计与控制器的回归比对
+ *
+ * 把记录的IMU数据与飞控命令按1kHz节拍送入未经修改的 estimatorComplementary /
+ * controllerPid / attitude_pid_controller / command_receiver 代码 (主机编译),
+ * 以远快于实时的速度重算姿态、期望角速度与控制输出, 并与记录中的值逐点比对.
+ *
+ * 构建见 CMakeLists.txt (与 core_bench 同一工程).
+ *
+ * 用法:
+ *   ./flight_replay flight.csv                 回放并打印各信号的偏差统计
+ *   ./flight_replay flight.csv --out diff.csv  同时输出逐点的回放值与记录值
+ *   可选参数:
+ *     --offsets auto|calibrate|PITCH,ROLL  角度零点: auto=按记录反推 (默认),
+ *                                          calibrate=从记录开头运行自动零点校准, 或直接给定 (度)
+ *     --att-tol DEG   --rate-tol DEG_S   --ctl-tol COUNTS   判定偏离的阈值 (默认 1 / 10 / 500)
+ *
+ * 记录格式为带表头的CSV, 列顺序不限, 空字段表示沿用上一行的值:
+ *   时间:     t_ms (单调递增) 或 timestamp_ms (遥测中的16位毫秒计数, 自动展开)
+ *   IMU输入:  gyro_x gyro_y gyro_z (deg/s)  acc_x acc_y acc_z (Gs)        必需
+ *   命令输入: cmd_roll cmd_pitch cmd_yaw cmd_thrust (FLIGHT_CONTROL包)  缺省时油门为0
+ *   比对对象: roll pitch yaw  roll_rate_desired pitch_rate_desired yaw_rate_desired
+ *             roll_control_output pitch_control_output yaw_control_output  均可选
+ * 列名与上位机遥测字段 (HIGH_FREQ_DATA) 一致. 回放在两行之间保持上一行的输入,
+ * 因此记录的遥测速率越高 (订阅包可提高到250Hz), 回放越接近实机.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "FreeRTOS.h"
+#include "attitude_controller.h"
+#include "command_receiver.h"
+#include "commander.h"
+#include "controller_pid.h"
+#include "estimator_complementary.h"
+#include "sensors.h"
+#include "stabilizer_types.h"
+#include "zero_calib.h"
+
+#define LINE_MAX_LEN 4096
+#define MAX_COLUMNS 64
+
+// ============================================================================
+// 主机替身: 时钟 / 传感器 / commander
+// ============================================================================
+
+TickType_t hostTickCount = 0;
+
+static sensorData_t replaySensors;
+static setpoint_t replaySetpoint;
+
+void sensorsAcquire(sensorData_t *sensors, const uint32_t tick)
+{
+    (void)tick;
+    *sensors = replaySensors;
+}
+
+void commanderSetSetpoint(setpoint_t *setpoint, int priority)
+{
+    (void)priority;
+    replaySetpoint = *setpoint;
+    replaySetpoint.timestamp = hostTickCount;
+}
+
+// ============================================================================
+// 记录加载
+// ============================================================================
+
+enum
+{
+    SIG_ROLL,
+    SIG_PITCH,
+    SIG_YAW,
+    SIG_ROLL_RATE,
+    SIG_PITCH_RATE,
+    SIG_YAW_RATE,
+    SIG_ROLL_CTL,
+    SIG_PITCH_CTL,
+    SIG_YAW_CTL,
+    SIG_COUNT,
+};
+
+static const char *signalNames[SIG_COUNT] = {
+    "roll",
+    "pitch",
+    "yaw",
+    "roll_rate_desired",
+    "pitch_rate_desired",
+    "yaw_rate_desired",
+    "roll_control_output",
+    "pitch_control_output",
+    "yaw_control_output",
+};
+
+enum
+{
+    IN_GYRO_X,
+    IN_GYRO_Y,
+    IN_GYRO_Z,
+    IN_ACC_X,
+    IN_ACC_Y,
+    IN_ACC_Z,
+    IN_CMD_ROLL,
+    IN_CMD_PITCH,
+    IN_CMD_YAW,
+    IN_CMD_THRUST,
+    IN_COUNT,
+};
+
+static const char *inputNames[IN_COUNT] = {
+    "gyro_x", "gyro_y", "gyro_z", "acc_x", "acc_y", "acc_z",
+    "cmd_roll", "cmd_pitch", "cmd_yaw", "cmd_thrust",
+};
+
+typedef struct
+{
+    uint32_t tMs;
+    float in[IN_COUNT];
+    float rec[SIG_COUNT]; // NAN = 该行没有记录
+} LogRow;
+
+typedef struct
+{
+    LogRow *rows;
+    int count;
+    bool hasSignal[SIG_COUNT];
+} FlightLog;
+
+static int findColumn(char **names, int count, const char *name)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (!strcmp(names[i], name))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int splitCsv(char *line, char **fields, int max)
+{
+    int n = 0;
+    char *p = line;
+    while (n < max)
+    {
+        fields[n++] = p;
+        char *comma = strchr(p, ',');
+        if (comma == NULL)
+        {
+            break;
+        }
+        *comma = '\0';
+        p = comma + 1;
+    }
+    // 去掉行尾换行与空白
+    char *last = fields[n - 1];
+    last[strcspn(last, "\r\n")] = '\0';
+    for (int i = 0; i < n; i++)
+    {
+        while (*fields[i] == ' ')
+        {
+            fields[i]++;
+        }
+    }
+    return n;
+}
+
+static bool parseField(char **fields, int count, int col, float *value)
+{
+    if (col < 0 || col >= count || fields[col][0] == '\0')
+    {
+        return false;
+    }
+    char *end;
+    float v = strtof(fields[col], &end);
+    if (end == fields[col])
+    {
+        return false;
+    }
+    *value = v;
+    return true;
+}
+
+static bool loadLog(const char *path, FlightLog *log)
+{
+    char line[LINE_MAX_LEN];
+    char header[LINE_MAX_LEN];
+    char *names[MAX_COLUMNS];
+    char *fields[MAX_COLUMNS];
+    int capacity = 4096;
+
+    FILE *f = fopen(path, "r");
+    if (f == NULL)
+    {
+        perror(path);
+        return false;
+    }
+
+    if (!fgets(header, sizeof(header), f))
+    {
+        fprintf(stderr, "%s: empty file\n", path);
+        fclose(f);
+        return false;
+    }
+    int columns = splitCsv(header, names, MAX_COLUMNS);
+
+    int colTime = findColumn(names, columns, "t_ms");
+    bool wrapped = false;
+    if (colTime < 0)
+    {
+        colTime = findColumn(names, columns, "timestamp_ms");
+        wrapped = true;
+    }
+    int colIn[IN_COUNT], colSig[SIG_COUNT];
+    for (int i = 0; i < IN_COUNT; i++)
+    {
+        colIn[i] = findColumn(names, columns, inputNames[i]);
+    }
+    for (int i = 0; i < SIG_COUNT; i++)
+    {
+        colSig[i] = findColumn(names, columns, signalNames[i]);
+        log->hasSignal[i] = colSig[i] >= 0;
+    }
+    if (colTime < 0 || colIn[IN_GYRO_X] < 0 || colIn[IN_GYRO_Y] < 0 || colIn[IN_GYRO_Z] < 0 ||
+        colIn[IN_ACC_X] < 0 || colIn[IN_ACC_Y] < 0 || colIn[IN_ACC_Z] < 0)
+    {
+        fprintf(stderr, "%s: need t_ms (or timestamp_ms), gyro_x/y/z and acc_x/y/z columns\n", path);
+        fclose(f);
+        return false;
+    }
+
+    log->rows = malloc(capacity * sizeof(LogRow));
+    log->count = 0;
+
+    float in[IN_COUNT] = {0};
+    uint32_t lastRaw = 0, wraps = 0;
+    int lineNo = 1;
+
+    while (fgets(line, sizeof(line), f))
+    {
+        lineNo++;
+        int n = splitCsv(line, fields, MAX_COLUMNS);
+        float t;
+        if (!parseField(fields, n, colTime, &t))
+        {
+            continue;
+        }
+
+        uint32_t tMs = (uint32_t)t;
+        if (wrapped)
+        {
+            // 遥测时间戳为毫秒计数的低16位
+            uint32_t raw = tMs & 0xFFFF;
+            if (log->count > 0 && raw < lastRaw)
+            {
+                wraps++;
+            }
+            lastRaw = raw;
+            tMs = raw + (wraps << 16);
+        }
+        if (log->count > 0 && tMs < log->rows[log->count - 1].tMs)
+        {
+            fprintf(stderr, "%s:%d: time goes backwards, row skipped\n", path, lineNo);
+            continue;
+        }
+
+        if (log->count == capacity)
+        {
+            capacity *= 2;
+            log->rows = realloc(log->rows, capacity * sizeof(LogRow));
+        }
+        LogRow *row = &log->rows[log->count++];
+        row->tMs = tMs;
+        for (int i = 0; i < IN_COUNT; i++)
+        {
+            parseField(fields, n, colIn[i], &in[i]);
+            row->in[i] = in[i];
+        }
+        for (int i = 0; i < SIG_COUNT; i++)
+        {
+            row->rec[i] = NAN;
+            parseField(fields, n, colSig[i], &row->rec[i]);
+        }
+    }
+    fclose(f);
+
+    if (log->count == 0)
+    {
+        fprintf(stderr, "%s: no data rows\n", path);
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// 回放
+// ============================================================================
+
+typedef struct
+{
+    double sumSq;
+    double maxAbs;
+    uint32_t maxAtMs;
+    int64_t firstOverMs; // -1 = 未超出阈值
+    int count;
+} SignalStats;
+
+typedef struct
+{
+    float tolerance[SIG_COUNT];
+    float pitchOffset;
+    float rollOffset;
+    bool runCalibration;
+    FILE *out;
+} ReplayConfig;
+
+typedef struct
+{
+    SignalStats stats[SIG_COUNT];
+    double biasSum[2]; // 回放值-记录值 (pitch, roll), 用于反推零点
+    int biasCount;
+    uint64_t ticks;
+} ReplayResult;
+
+static void seedZeroCalib(float pitch, float roll)
+{
+    // 以恒定角度喂满校准窗口: 方差为0, 零点即为给定值
+    zero_calib_reset();
+    for (int i = 0; i < CALIB_WINDOW_SIZE && !zero_calib_is_done(); i++)
+    {
+        hostTickCount += CALIB_SAMPLE_INTERVAL_MS;
+        zero_calib_update(pitch, roll);
+    }
+}
+
+static float wrapDegrees(float angle)
+{
+    while (angle > 180.0f)
+    {
+        angle -= 360.0f;
+    }
+    while (angle < -180.0f)
+    {
+        angle += 360.0f;
+    }
+    return angle;
+}
+
+static void compareRow(const LogRow *row, const float replay[SIG_COUNT], const ReplayConfig *cfg,
+                       ReplayResult *result)
+{
+    for (int i = 0; i < SIG_COUNT; i++)
+    {
+        if (isnan(row->rec[i]))
+        {
+            continue;
+        }
+        float diff = replay[i] - row->rec[i];
+        if (i == SIG_YAW)
+        {
+            diff = wrapDegrees(diff);
+        }
+        SignalStats *s = &result->stats[i];
+        s->sumSq += (double)diff * diff;
+        s->count++;
+        if (fabsf(diff) > s->maxAbs)
+        {
+            s->maxAbs = fabsf(diff);
+            s->maxAtMs = row->tMs;
+        }
+        if (s->firstOverMs < 0 && fabsf(diff) > cfg->tolerance[i])
+        {
+            s->firstOverMs = row->tMs;
+        }
+    }
+
+    if (!isnan(row->rec[SIG_PITCH]) && !isnan(row->rec[SIG_ROLL]))
+    {
+        result->biasSum[0] += replay[SIG_PITCH] - row->rec[SIG_PITCH];
+        result->biasSum[1] += replay[SIG_ROLL] - row->rec[SIG_ROLL];
+        result->biasCount++;
+    }
+
+    if (cfg->out)
+    {
+        fprintf(cfg->out, "%lu", (unsigned long)row->tMs);
+        for (int i = 0; i < SIG_COUNT; i++)
+        {
+            fprintf(cfg->out, ",%.4f,%.4f", replay[i], row->rec[i]);
+        }
+        fprintf(cfg->out, "\n");
+    }
+}
+
+static void replay(const FlightLog *log, const ReplayConfig *cfg, ReplayResult *result)
+{
+    state_t state = {0};
+    control_t control = {0};
+    sensorData_t sensorData = {0};
+    FlightControlPacket_t fc = {0};
+    bool fcValid = false;
+
+    memset(result, 0, sizeof(*result));
+    for (int i = 0; i < SIG_COUNT; i++)
+    {
+        result->stats[i].firstOverMs = -1;
+    }
+
+    estimatorComplementaryInit();
+    controllerPidInit();
+    commandReceiverInit();
+    memset(&replaySetpoint, 0, sizeof(replaySetpoint));
+
+    hostTickCount = 0;
+    if (!cfg->runCalibration)
+    {
+        seedZeroCalib(cfg->pitchOffset, cfg->rollOffset);
+    }
+
+    if (cfg->out)
+    {
+        fprintf(cfg->out, "t_ms");
+        for (int i = 0; i < SIG_COUNT; i++)
+        {
+            fprintf(cfg->out, ",replay_%s,rec_%s", signalNames[i], signalNames[i]);
+        }
+        fprintf(cfg->out, "\n");
+    }
+
+    // 与稳定器循环相同: tick从1开始, 每毫秒依次执行估计器与控制器
+    uint32_t tick = 1;
+    int next = 0;
+    const LogRow *row = NULL;
+    uint32_t start = log->rows[0].tMs;
+    uint32_t end = log->rows[log->count - 1].tMs;
+
+    for (uint32_t now = start; now <= end; now++, tick++)
+    {
+        hostTickCount = now + CALIB_WINDOW_SIZE * CALIB_SAMPLE_INTERVAL_MS;
+
+        const LogRow *arrived = NULL;
+        while (next < log->count && log->rows[next].tMs <= now)
+        {
+            arrived = row = &log->rows[next++];
+        }
+
+        if (arrived)
+        {
+            replaySensors.gyro.x = row->in[IN_GYRO_X];
+            replaySensors.gyro.y = row->in[IN_GYRO_Y];
+            replaySensors.gyro.z = row->in[IN_GYRO_Z];
+            replaySensors.acc.x = row->in[IN_ACC_X];
+            replaySensors.acc.y = row->in[IN_ACC_Y];
+            replaySensors.acc.z = row->in[IN_ACC_Z];
+
+            FlightControlPacket_t cmd = {
+                .roll = row->in[IN_CMD_ROLL],
+                .pitch = row->in[IN_CMD_PITCH],
+                .yaw = row->in[IN_CMD_YAW],
+                .thrust = (uint16_t)fmaxf(0.0f, fminf(row->in[IN_CMD_THRUST], 65535.0f)),
+            };
+            if (!fcValid || memcmp(&cmd, &fc, sizeof(fc)))
+            {
+                fc = cmd;
+                fcValid = true;
+                commandReceiverHandleFlightControl(&fc);
+            }
+        }
+
+        estimatorComplementary(&state, &sensorData, &control, tick);
+        setpoint_t setpoint = replaySetpoint;
+        controllerPid(&control, &setpoint, &sensorData, &state, tick);
+        result->ticks++;
+
+        if (arrived)
+        {
+            float replayed[SIG_COUNT];
+            replayed[SIG_ROLL] = state.attitude.roll;
+            replayed[SIG_PITCH] = state.attitude.pitch;
+            replayed[SIG_YAW] = state.attitude.yaw;
+            controllerPidGetRateDesired(&replayed[SIG_ROLL_RATE], &replayed[SIG_PITCH_RATE], &replayed[SIG_YAW_RATE]);
+            replayed[SIG_ROLL_CTL] = control.roll;
+            replayed[SIG_PITCH_CTL] = control.pitch;
+            replayed[SIG_YAW_CTL] = control.yaw;
+            compareRow(arrived, replayed, cfg, result);
+        }
+    }
+}
+
+/**
+ * 以零点为0回放一遍 (在子进程中, 以免污染各模块的静态状态), 反推记录时的零点偏移
+ */
+static bool estimateOffsets(const FlightLog *log, const ReplayConfig *cfg, float *pitch, float *roll)
+{
+    int fds[2];
+    float offsets[2] = {0.0f, 0.0f};
+
+    if (pipe(fds) != 0)
+    {
+        return false;
+    }
+
+    pid_t child = fork();
+    if (child == 0)
+    {
+        ReplayConfig probe = *cfg;
+        ReplayResult result;
+        probe.pitchOffset = probe.rollOffset = 0.0f;
+        probe.out = NULL;
+        replay(log, &probe, &result);
+        if (result.biasCount > 0)
+        {
+            offsets[0] = result.biasSum[0] / result.biasCount;
+            offsets[1] = result.biasSum[1] / result.biasCount;
+        }
+        ssize_t written = write(fds[1], offsets, sizeof(offsets));
+        _exit(written == sizeof(offsets) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    ssize_t got = read(fds[0], offsets, sizeof(offsets));
+    close(fds[0]);
+    waitpid(child, NULL, 0);
+    if (got != sizeof(offsets))
+    {
+        return false;
+    }
+
+    *pitch = offsets[0];
+    *roll = offsets[1];
+    return true;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s LOG.csv [--out FILE] [--offsets auto|calibrate|PITCH,ROLL]\n"
+            "       [--att-tol DEG] [--rate-tol DEG_S] [--ctl-tol COUNTS]\n",
+            prog);
+}
+
+int main(int argc, char **argv)
+{
+    const char *logPath = NULL;
+    const char *outPath = NULL;
+    const char *offsets = "auto";
+    float attTol = 1.0f, rateTol = 10.0f, ctlTol = 500.0f;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--out") && i + 1 < argc)
+        {
+            outPath = argv[++i];
+        }
+        else if (!strcmp(argv[i], "--offsets") && i + 1 < argc)
+        {
+            offsets = argv[++i];
+        }
+        else if (!strcmp(argv[i], "--att-tol") && i + 1 < argc)
+        {
+            attTol = atof(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--rate-tol") && i + 1 < argc)
+        {
+            rateTol = atof(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--ctl-tol") && i + 1 < argc)
+        {
+            ctlTol = atof(argv[++i]);
+        }
+        else if (argv[i][0] != '-' && logPath == NULL)
+        {
+            logPath = argv[i];
+        }
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (logPath == NULL)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    FlightLog log;
+    if (!loadLog(logPath, &log))
+    {
+        return 2;
+    }
+
+    ReplayConfig cfg = {0};
+    for (int i = 0; i < SIG_COUNT; i++)
+    {
+        cfg.tolerance[i] = i <= SIG_YAW ? attTol : (i <= SIG_YAW_RATE ? rateTol : ctlTol);
+    }
+
+    if (!strcmp(offsets, "calibrate"))
+    {
+        cfg.runCalibration = true;
+    }
+    else if (!strcmp(offsets, "auto"))
+    {
+        if (!estimateOffsets(&log, &cfg, &cfg.pitchOffset, &cfg.rollOffset))
+        {
+            fprintf(stderr, "offset estimation failed, using 0,0\n");
+        }
+    }
+    else if (sscanf(offsets, "%f,%f", &cfg.pitchOffset, &cfg.rollOffset) != 2)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    if (outPath)
+    {
+        cfg.out = fopen(outPath, "w");
+        if (cfg.out == NULL)
+        {
+            perror(outPath);
+            return 2;
+        }
+    }
+
+    struct timespec t0, t1;
+    ReplayResult result;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    replay(&log, &cfg, &result);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (cfg.out)
+    {
+        fclose(cfg.out);
+    }
+
+    double wallMs = (t1.tv_sec - t0.tv_sec) * 1e3 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+    printf("%s: %d rows, %.1f s of flight replayed in %.1f ms (%.0fx real time)\n", logPath, log.count,
+           result.ticks / 1000.0, wallMs, wallMs > 0 ? result.ticks / wallMs : 0.0);
+    if (cfg.runCalibration)
+    {
+        printf("zero offsets: %s (pitch %.3f, roll %.3f)\n",
+               zero_calib_is_done() ? "calibrated from log" : "calibration did not finish",
+               zero_calib_get_pitch_offset(), zero_calib_get_roll_offset());
+    }
+    else
+    {
+        printf("zero offsets: pitch %.3f, roll %.3f (%s)\n", cfg.pitchOffset, cfg.rollOffset, offsets);
+    }
+
+    printf("%-22s %8s %10s %10s %10s %12s\n", "signal", "samples", "rms", "max", "max@ms", "diverged@ms");
+    int diverged = 0;
+    for (int i = 0; i < SIG_COUNT; i++)
+    {
+        const SignalStats *s = &result.stats[i];
+        if (!log.hasSignal[i] || s->count == 0)
+        {
+            continue;
+        }
+        printf("%-22s %8d %10.3f %10.3f %10lu ", signalNames[i], s->count, sqrt(s->sumSq / s->count), s->maxAbs,
+               (unsigned long)s->maxAtMs);
+        if (s->firstOverMs >= 0)
+        {
+            printf("%12lld\n", (long long)s->firstOverMs);
+            diverged++;
+        }
+        else
+        {
+            printf("%12s\n", "-");
+        }
+    }
+
+    printf("%s: %d of %d signals exceed tolerance (att %.2f deg, rate %.1f deg/s, ctl %.0f)\n",
+           diverged ? "DIVERGED" : "OK", diverged, SIG_COUNT, attTol, rateTol, ctlTol);
+    free(log.rows);
+    return diverged ? 1 : 0;
+}
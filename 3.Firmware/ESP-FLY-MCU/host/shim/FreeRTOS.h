@@ -0,0 +1,24 @@
+/**
+ * 主机端FreeRTOS替身: 只提供被回放的固件源文件用到的类型与宏.
+ * 时钟由回放工具驱动 (hostTickCount), 1 tick = 1 ms, 与固件的configTICK_RATE_HZ一致.
+ */
+#ifndef HOST_SHIM_FREERTOS_H
+#define HOST_SHIM_FREERTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define configTICK_RATE_HZ 1000
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+extern TickType_t hostTickCount;
+
+#endif // HOST_SHIM_FREERTOS_H
@@ -0,0 +1,20 @@
+/**
+ * 主机端日志替身: 固件日志默认丢弃, 定义HOST_SHIM_LOG时输出到stderr
+ */
+#ifndef HOST_SHIM_ESP_LOG_H
+#define HOST_SHIM_ESP_LOG_H
+
+#include <stdio.h>
+
+#ifdef HOST_SHIM_LOG
+#define ESP_LOG_LEVEL_LOCAL(level, tag, fmt, ...) fprintf(stderr, "[%s] " fmt "\n", tag, ##__VA_ARGS__)
+#else
+#define ESP_LOG_LEVEL_LOCAL(level, tag, fmt, ...) \
+    do                                            \
+    {                                             \
+        if (0)                                    \
+            fprintf(stderr, fmt, ##__VA_ARGS__);  \
+    } while (0)
+#endif
+
+#endif // HOST_SHIM_ESP_LOG_H
@@ -0,0 +1,11 @@
+#ifndef HOST_SHIM_TASK_H
+#define HOST_SHIM_TASK_H
+
+#include "FreeRTOS.h"
+
+static inline TickType_t xTaskGetTickCount(void)
+{
+    return hostTickCount;
+}
+
+#endif // HOST_SHIM_TASK_H
@@ -30,6 +30,7 @@
 #include "stm32_legacy.h"
 #include "platform.h"
 #include "system.h"
+#include "boot_timeline.h"
 #include "status_led.h"
 #define DEBUG_MODULE "APP_MAIN"
 #include "debug_cf.h"
@@ -40,6 +41,7 @@ void app_main()
     * Initialize the platform and Launch the system task
     * app_main will initialize and start everything
     */
+    bootTimelineMark("app_main");
 
     /* Initialize Status LED and set to booting state */
     if (statusLedInit()) {
@@ -63,6 +65,7 @@ void app_main()
     }
 
     /*launch the system task */
+    bootTimelineMark("platform ready");
     systemLaunch();
 
 }
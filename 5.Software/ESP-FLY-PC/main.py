@@ -3,6 +3,7 @@ ESP-FLY-PC 主入口文件
 MVVM架构 - 连接ViewModels和Views的数据绑定
 """
 
+import os
 import sys
 from PyQt6.QtWidgets import QApplication
 from PyQt6.QtCore import Qt
@@ -19,6 +20,8 @@ except ImportError:
 from services.network_service import NetworkService
 from services.protocol_service import ProtocolService
 from services.config_service import ConfigService
+from services.telemetry_decoder import TelemetryDecoder
+from common.resource_path import get_config_path
 
 # ViewModels
 from viewmodels.drone_view_model import DroneViewModel
@@ -26,6 +29,12 @@ from viewmodels.flight_control_view_model import FlightControlViewModel
 from viewmodels.connection_view_model import ConnectionViewModel
 from viewmodels.pid_config_view_model import PidConfigViewModel
 from viewmodels.motor_test_view_model import MotorTestViewModel
+from viewmodels.link_health_view_model import LinkHealthViewModel
+from viewmodels.sysid_view_model import SysidViewModel
+from viewmodels.recording_view_model import RecordingViewModel
+from viewmodels.spectrum_view_model import SpectrumViewModel
+from viewmodels.step_response_view_model import StepResponseViewModel
+from viewmodels.fleet_view_model import FleetViewModel
 
 # Views
 from views.main_view import MainView
@@ -45,21 +54,32 @@ class Application:
     def __init__(self):
         # ========== 创建Services ==========
         self.config_service = ConfigService()
-        self.protocol_service = ProtocolService()
+        protocol_version = self.config_service.get_int("protocol", "version", 2)
+        # 各ViewModel用它构建命令，发往某架无人机前由该会话的链路重新封装
+        self.protocol_service = ProtocolService(preferred_version=protocol_version)
+        drone_ip = self.config_service.get_string("network", "drone_ip", "192.168.43.42")
         self.network_service = NetworkService(
-            drone_ip=self.config_service.get_string(
-                "network", "drone_ip", "192.168.43.42"
-            ),
+            drone_ip=drone_ip,
             port=self.config_service.get_int("network", "port", 2390),
             config_service=self.config_service,
         )
 
+        # 每架无人机一个会话: 链路状态（v2协商、序号统计）和解码器各自独立，共用一个接收线程
+        drone_ips = self.config_service.get_string("network", "drone_ips", drone_ip)
+        for ip in [ip.strip() for ip in drone_ips.split(",") if ip.strip()]:
+            protocol = ProtocolService(preferred_version=protocol_version)
+            self.network_service.add_drone(ip, protocol, TelemetryDecoder(protocol))
+
         # ========== 创建ViewModels ==========
         self.drone_vm = DroneViewModel(
             protocol_service=self.protocol_service,
             config_service=self.config_service,
         )
-        self.connection_vm = ConnectionViewModel(self.network_service)
+        self.connection_vm = ConnectionViewModel(
+            self.network_service,
+            self.protocol_service,
+            telemetry_rate=self.config_service.get_int("protocol", "telemetry_rate", 0),
+        )
         self.flight_control_vm = FlightControlViewModel(
             self.network_service, self.protocol_service
         )
@@ -69,6 +89,26 @@ class Application:
         self.motor_test_vm = MotorTestViewModel(
             self.network_service, self.protocol_service
         )
+        self.link_health_vm = LinkHealthViewModel(
+            self.network_service,
+            self.protocol_service,
+            ping_interval_ms=self.config_service.get_int(
+                "protocol", "ping_interval_ms", 200
+            ),
+        )
+        self.sysid_vm = SysidViewModel(self.network_service, self.protocol_service)
+        self.recording_vm = RecordingViewModel(
+            self.network_service,
+            self.protocol_service,
+            directory=self.config_service.get_string(
+                "recording",
+                "directory",
+                os.path.join(os.path.dirname(get_config_path()), "recordings"),
+            ),
+        )
+        self.spectrum_vm = SpectrumViewModel()
+        self.step_response_vm = StepResponseViewModel()
+        self.fleet_vm = FleetViewModel(self.network_service)
 
         # ========== 创建MainView ==========
         self.main_view = MainView()
@@ -80,10 +120,18 @@ class Application:
         self._setup_flight_control_vm_bindings()
         self._setup_pid_config_vm_bindings()
         self._setup_motor_test_vm_bindings()
+        self._setup_link_health_vm_bindings()
+        self._setup_sysid_vm_bindings()
+        self._setup_recording_vm_bindings()
+        self._setup_spectrum_vm_bindings()
+        self._setup_step_response_vm_bindings()
+        self._setup_fleet_vm_bindings()
 
     def _setup_service_bindings(self):
         """建立Service层绑定"""
-        # NetworkService → DroneViewModel（数据接收）
+        # NetworkService → DroneViewModel（当前无人机的数据接收）
+        # 接收线程按会话分批解码，GUI线程每批只处理一次
+        self.network_service.batch_received.connect(self.drone_vm.on_telemetry_batch)
         self.network_service.data_received.connect(self.drone_vm.on_data_received)
 
         # NetworkService统计 → ConnectionViewModel
@@ -100,6 +148,9 @@ class Application:
         self.drone_vm.high_freq_data_changed.connect(
             self.main_view.waveform_view.update_waveform_data
         )
+        self.drone_vm.high_freq_block_changed.connect(
+            self.main_view.waveform_view.update_waveform_block
+        )
 
         # ========== 电池数据 → 状态视图 ==========
         self.drone_vm.battery_voltage_changed.connect(
@@ -136,6 +187,12 @@ class Application:
         self.main_view.disconnect_requested.connect(
             self.connection_vm.disconnect_command
         )
+        self.main_view.terminal_view.bench_requested.connect(
+            self.connection_vm.kernel_bench_command
+        )
+        self.main_view.terminal_view.motor_char_requested.connect(
+            self.connection_vm.motor_char_command
+        )
 
         # ========== ViewModel → View（状态更新）==========
         self.connection_vm.is_connected_changed.connect(
@@ -189,6 +246,9 @@ class Application:
         self.flight_control_vm.target_pitch_changed.connect(control_view.update_pitch)
         self.flight_control_vm.target_yaw_changed.connect(control_view.update_yaw)
         self.flight_control_vm.thrust_changed.connect(control_view.update_thrust)
+        self.flight_control_vm.send_stats_changed.connect(
+            self.main_view.status_view.update_command_stats
+        )
 
         # 在连接断开时停止发送
         self.connection_vm.is_connected_changed.connect(
@@ -238,6 +298,166 @@ class Application:
         self.motor_test_vm.motor3_pwm_changed.connect(motor_view.update_motor3_pwm)
         self.motor_test_vm.motor4_pwm_changed.connect(motor_view.update_motor4_pwm)
 
+    def _setup_link_health_vm_bindings(self):
+        """建立LinkHealthViewModel绑定"""
+        link_view = self.main_view.link_health_view
+
+        # DroneViewModel（PONG）→ LinkHealthViewModel
+        self.drone_vm.pong_received.connect(self.link_health_vm.on_pong_received)
+
+        # ========== ViewModel → View（状态更新）==========
+        self.link_health_vm.link_stats_changed.connect(link_view.update_link_stats)
+        self.connection_vm.signal_strength_changed.connect(
+            link_view.update_signal_strength
+        )
+
+    def _setup_sysid_vm_bindings(self):
+        """建立SysidViewModel绑定"""
+        sysid_view = self.main_view.pid_view.sysid_view
+
+        # ========== View → ViewModel（用户操作）==========
+        sysid_view.start_requested.connect(self.sysid_vm.start_command)
+        sysid_view.abort_requested.connect(self.sysid_vm.abort_command)
+        sysid_view.apply_requested.connect(self.sysid_vm.apply_suggestion_command)
+
+        # DroneViewModel（辨识数据包）→ SysidViewModel
+        self.drone_vm.sysid_packet_received.connect(self.sysid_vm.on_sysid_packet)
+
+        # 增益建议 → PidConfigViewModel（更新角速度环参数，需点击"发送到飞控"生效）
+        self.sysid_vm.rate_gains_suggested.connect(
+            self.pid_config_vm.set_rate_pi_command
+        )
+
+        # ========== ViewModel → View（状态更新）==========
+        self.sysid_vm.status_changed.connect(sysid_view.update_status)
+        self.sysid_vm.running_changed.connect(sysid_view.update_running)
+        self.sysid_vm.frequency_response_changed.connect(
+            sysid_view.update_frequency_response
+        )
+        self.sysid_vm.time_response_changed.connect(sysid_view.update_time_response)
+        self.sysid_vm.result_changed.connect(sysid_view.update_result)
+
+    def _setup_recording_vm_bindings(self):
+        """建立RecordingViewModel绑定"""
+        recording_view = self.main_view.recording_view
+        recording_view.set_directory(self.recording_vm.directory)
+
+        # ========== View → ViewModel（用户操作）==========
+        recording_view.start_recording_requested.connect(
+            self.recording_vm.start_recording_command
+        )
+        recording_view.stop_recording_requested.connect(
+            self.recording_vm.stop_recording_command
+        )
+        recording_view.open_requested.connect(self.recording_vm.open_replay_command)
+        recording_view.close_requested.connect(self.recording_vm.close_replay_command)
+        recording_view.play_requested.connect(self.recording_vm.play_command)
+        recording_view.pause_requested.connect(self.recording_vm.pause_command)
+        recording_view.speed_changed.connect(self.recording_vm.set_speed_command)
+        recording_view.seek_requested.connect(self.recording_vm.seek_command)
+
+        # 回放数据与实时数据走同一条路径
+        self.recording_vm.replay_batch.connect(self.drone_vm.on_telemetry_batch)
+        self.recording_vm.waveform_reset.connect(
+            self.main_view.waveform_view.reset_waveforms
+        )
+
+        # ========== ViewModel → View（状态更新）==========
+        self.recording_vm.recording_changed.connect(recording_view.update_recording)
+        self.recording_vm.recording_stats_changed.connect(
+            recording_view.update_recording_stats
+        )
+        self.recording_vm.replay_opened.connect(recording_view.update_replay_opened)
+        self.recording_vm.replay_playing_changed.connect(recording_view.update_playing)
+        self.recording_vm.replay_position_changed.connect(recording_view.update_position)
+        self.recording_vm.error_occurred.connect(self.main_view.show_error_message)
+
+    def _setup_spectrum_vm_bindings(self):
+        """建立SpectrumViewModel绑定"""
+        spectrum_view = self.main_view.spectrum_view
+
+        # ========== View → ViewModel（用户操作）==========
+        spectrum_view.selection_changed.connect(self.spectrum_vm.select_command)
+        spectrum_view.clear_requested.connect(self.spectrum_vm.reset_command)
+
+        # DroneViewModel（实时/回放高频数据）→ SpectrumViewModel
+        self.drone_vm.high_freq_block_changed.connect(self.spectrum_vm.on_high_freq_block)
+
+        # 连接成功、清空波形、回放跳转后重新开始
+        self.connection_vm.is_connected_changed.connect(
+            lambda connected: self.spectrum_vm.reset_command() if connected else None
+        )
+        self.main_view.waveform_view.clear_requested.connect(self.spectrum_vm.reset_command)
+        self.recording_vm.waveform_reset.connect(lambda _: self.spectrum_vm.reset_command())
+
+        # ========== ViewModel → View（状态更新）==========
+        self.spectrum_vm.spectrum_changed.connect(spectrum_view.update_spectrum)
+        self.spectrum_vm.spectrogram_changed.connect(spectrum_view.update_spectrogram)
+
+    def _setup_step_response_vm_bindings(self):
+        """建立StepResponseViewModel绑定"""
+        step_view = self.main_view.pid_view.step_response_view
+
+        # ========== View → ViewModel（用户操作）==========
+        step_view.set_baseline_requested.connect(self.step_response_vm.set_baseline_command)
+        step_view.clear_requested.connect(self.step_response_vm.clear_command)
+
+        # DroneViewModel（实时/回放高频数据）→ StepResponseViewModel
+        self.drone_vm.high_freq_block_changed.connect(self.step_response_vm.on_high_freq_block)
+
+        # 发送PID参数成功后，之前的结果转为基线
+        def on_config_sent(success: bool):
+            if not success:
+                return
+            gains = {}
+            for axis in ("roll", "pitch", "yaw"):
+                config = self.pid_config_vm.get_axis_config("rate", axis)
+                gains[axis] = (config.kp, config.ki, config.kd)
+            self.step_response_vm.gains_changed_command(gains)
+
+        self.pid_config_vm.config_sent.connect(on_config_sent)
+
+        # 连接成功、回放跳转后重新开始
+        self.connection_vm.is_connected_changed.connect(
+            lambda connected: self.step_response_vm.clear_command() if connected else None
+        )
+        self.recording_vm.waveform_reset.connect(lambda _: self.step_response_vm.clear_command())
+
+        # ========== ViewModel → View（状态更新）==========
+        self.step_response_vm.result_changed.connect(step_view.update_result)
+
+    def _setup_fleet_vm_bindings(self):
+        """建立FleetViewModel绑定"""
+        fleet_view = self.main_view.fleet_view
+
+        # ========== View → ViewModel（用户操作）==========
+        def select_drone(ip: str):
+            if ip == self.network_service.drone_ip:
+                return
+            # 先停止对上一架的控制循环、电机测试和辨识激励，再切换
+            self.flight_control_vm.disable_control_command()
+            if self.motor_test_vm.is_sending:
+                self.motor_test_vm.reset_command()
+            self.sysid_vm.abort_command()
+            self.fleet_vm.select_drone_command(ip)
+
+        fleet_view.drone_selected.connect(select_drone)
+        fleet_view.channel_changed.connect(self.fleet_vm.select_channel_command)
+        fleet_view.clear_requested.connect(self.fleet_vm.clear_command)
+
+        # 切换后当前无人机的波形和分析重新开始（链路测量和记录由各自的ViewModel处理）
+        def on_active_drone_changed(ip: str):
+            self.main_view.waveform_view.clear_all_waveforms()
+            self.spectrum_vm.reset_command()
+            self.step_response_vm.clear_command()
+            self.main_view.terminal_view.append_info(f"当前无人机: {ip}")
+
+        self.network_service.active_drone_changed.connect(on_active_drone_changed)
+
+        # ========== ViewModel → View（状态更新）==========
+        self.fleet_vm.fleet_changed.connect(fleet_view.update_fleet)
+        self.fleet_vm.overlay_changed.connect(fleet_view.update_overlay)
+
     def run(self):
         """运行应用程序"""
         self.main_view.show()
@@ -245,15 +465,19 @@ class Application:
         # 显示启动信息
         self.main_view.terminal_view.append_info("ESP-FLY-PC v2.0 启动")
         self.main_view.terminal_view.append_info("MVVM架构版本")
-        self.main_view.terminal_view.append_info(
-            f"目标设备: {self.network_service._drone_ip}:{self.network_service._port}"
-        )
+        for session in self.network_service.sessions:
+            self.main_view.terminal_view.append_info(
+                f"目标设备: {session.ip}:{self.network_service.port}"
+            )
 
     def cleanup(self):
         """清理资源"""
         # 停止控制发送
         self.flight_control_vm.disable_control_command()
 
+        # 结束记录（写入索引）
+        self.recording_vm.stop_recording_command()
+
         # 断开连接
         if self.connection_vm.is_connected:
             self.connection_vm.disconnect_command()
@@ -8,6 +8,7 @@ from .flight_control_model import FlightControlModel
 from .pid_config_model import PidConfigModel, PidAxisConfig
 from .connection_state_model import ConnectionStateModel
 from .motor_test_model import MotorTestModel
+from .link_health_model import LinkHealthModel
 
 __all__ = [
     'DroneStateModel',
@@ -16,4 +17,5 @@ __all__ = [
     'PidAxisConfig',
     'ConnectionStateModel',
     'MotorTestModel',
+    'LinkHealthModel',
 ]
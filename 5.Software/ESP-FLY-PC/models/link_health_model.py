@@ -0,0 +1,44 @@
+"""
+LinkHealthModel - 链路质量模型
+存储PING/PONG测得的往返时延、抖动、丢包和RSSI
+"""
+
+from dataclasses import dataclass
+
+
+@dataclass
+class LinkHealthModel:
+    """
+    链路质量模型
+
+    上位机侧: 往返时延(RTT)、RTT抖动、PONG丢失率
+    飞控侧: 飞控测得的RSSI、PING丢失数、上行到达抖动、处理耗时
+    """
+
+    # 往返时延（毫秒）
+    rtt_last_ms: float = 0.0
+    rtt_min_ms: float = 0.0
+    rtt_avg_ms: float = 0.0
+    rtt_max_ms: float = 0.0
+
+    # RTT抖动（毫秒，RFC 3550平滑估计）
+    jitter_ms: float = 0.0
+
+    # 丢包（统计窗口内）
+    sent: int = 0
+    received: int = 0
+    loss_percent: float = 0.0
+
+    # 飞控侧统计
+    drone_rssi: int = 0
+    uplink_lost: int = 0
+    uplink_jitter_ms: float = 0.0
+    drone_processing_us: int = 0
+
+    def to_dict(self) -> dict:
+        """转换为字典（用于信号传递）"""
+        return dict(self.__dict__)
+
+    def reset(self):
+        """重置所有状态"""
+        self.__init__()
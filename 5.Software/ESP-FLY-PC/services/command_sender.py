@@ -0,0 +1,191 @@
+"""
+CommandSender - 周期命令发送器
+独立线程按绝对截止时刻发送最新命令（先粗睡眠，再自旋到截止时刻），并统计实际发送间隔的抖动
+"""
+
+import threading
+import time
+from typing import Any, Callable, Dict, Optional
+
+import numpy as np
+
+STATS_WINDOW = 500  # 统计最近N次发送（50Hz约10秒）
+MIN_SPIN_MARGIN = 0.0002  # 自旋余量下限（秒）
+SPIN_GAIN = 2.0  # 自旋余量 = 睡眠超时的滑动平均 × SPIN_GAIN
+
+
+class CommandSender:
+    """
+    周期命令发送器
+
+    调度：
+    - 第k次发送的截止时刻为 t0 + k·period（perf_counter绝对时刻），单次延迟不会累积到后续周期
+    - time.sleep睡到截止时刻前一段余量，剩余时间自旋（每轮sleep(0)让出GIL，不阻塞GUI线程）；
+      余量按观测到的睡眠超时自适应，系统定时器粗糙时自动加大
+    - 错过整个周期时跳到下一个未来的截止时刻，不补发，计入missed
+
+    最新命令槽：
+    - set_command()整体替换一个不可变对象（如元组）的引用，Python中引用赋值是原子的，
+      UI线程写、发送线程每个周期读一次，无需加锁；中间的更新被最新值覆盖
+
+    统计：
+    - 发送线程把每次发送与上一次的间隔、相对截止时刻的延迟写入预分配数组，
+      get_stats()在其他线程复制最近STATS_WINDOW次计算
+    """
+
+    def __init__(
+        self,
+        rate_hz: float,
+        build: Callable[[Any], bytes],
+        send: Callable[[bytes], bool],
+        on_sent: Optional[Callable[[bool], None]] = None,
+    ):
+        """
+        Args:
+            rate_hz: 发送频率
+            build: 命令 → 数据包（在发送线程中调用）
+            send: 发送数据包，返回是否成功（在发送线程中调用）
+            on_sent: 每次发送后的回调（在发送线程中调用）
+        """
+        self._period_ns = int(round(1e9 / rate_hz))
+        self._build = build
+        self._send = send
+        self._on_sent = on_sent
+
+        self._command = None
+        self._running = False
+        self._thread: Optional[threading.Thread] = None
+
+        # 自适应自旋余量（秒）
+        self._oversleep = 0.0
+        self._spin_margin = MIN_SPIN_MARGIN
+
+        # 统计（发送线程写）
+        self._intervals_ns = np.zeros(STATS_WINDOW, dtype=np.int64)
+        self._late_ns = np.zeros(STATS_WINDOW, dtype=np.int64)
+        self._interval_count = 0
+        self._sent = 0
+        self._missed = 0
+
+    @property
+    def is_running(self) -> bool:
+        return self._running
+
+    @property
+    def period_ms(self) -> float:
+        return self._period_ns / 1e6
+
+    def set_command(self, command):
+        """写入最新命令（不可变对象，任意线程调用）"""
+        self._command = command
+
+    def start(self):
+        """启动发送线程（立即发送第一次）"""
+        if self._running:
+            return
+        self._running = True
+        self._thread = threading.Thread(target=self._run, daemon=True)
+        self._thread.start()
+
+    def stop(self):
+        """停止发送线程（最多等待一个周期）"""
+        self._running = False
+        if self._thread and self._thread.is_alive() and self._thread is not threading.current_thread():
+            self._thread.join(timeout=1.0)
+        self._thread = None
+
+    def reset_stats(self):
+        """清空统计（发送线程停止时调用）"""
+        self._interval_count = 0
+        self._sent = 0
+        self._missed = 0
+
+    def get_stats(self) -> Dict[str, float]:
+        """
+        最近STATS_WINDOW次发送的统计
+
+        Returns:
+            dict: period_ms, sent, missed, spin_margin_ms；有间隔数据时还有
+                  rate_hz, interval_mean_ms, jitter_ms（间隔标准差）, interval_min_ms,
+                  interval_max_ms, deviation_p99_ms（|间隔-周期|的99分位）,
+                  late_mean_ms, late_max_ms（发送时刻相对截止时刻）
+        """
+        stats = {
+            "period_ms": self.period_ms,
+            "sent": self._sent,
+            "missed": self._missed,
+            "spin_margin_ms": self._spin_margin * 1e3,
+        }
+        n = min(self._interval_count, STATS_WINDOW)
+        if n == 0:
+            return stats
+
+        # 与发送线程并发读取：最多有一个元素是刚写入的新值，不影响统计
+        intervals = self._intervals_ns[:n].astype(np.float64) / 1e6
+        late = self._late_ns[: min(self._sent, STATS_WINDOW)].astype(np.float64) / 1e6
+        stats.update(
+            {
+                "rate_hz": float(1000.0 / intervals.mean()),
+                "interval_mean_ms": float(intervals.mean()),
+                "jitter_ms": float(intervals.std()),
+                "interval_min_ms": float(intervals.min()),
+                "interval_max_ms": float(intervals.max()),
+                "deviation_p99_ms": float(np.percentile(np.abs(intervals - self.period_ms), 99)),
+                "late_mean_ms": float(late.mean()),
+                "late_max_ms": float(late.max()),
+            }
+        )
+        return stats
+
+    # ========== 发送线程 ==========
+
+    def _run(self):
+        period = self._period_ns
+        deadline = time.perf_counter_ns()
+        last_send = None
+
+        while self._running:
+            self._wait_until(deadline)
+            if not self._running:
+                break
+
+            now = time.perf_counter_ns()
+            success = self._send(self._build(self._command))
+
+            slot = self._sent % STATS_WINDOW
+            self._late_ns[slot] = now - deadline
+            if last_send is not None:
+                self._intervals_ns[self._interval_count % STATS_WINDOW] = now - last_send
+                self._interval_count += 1
+            last_send = now
+            self._sent += 1
+
+            if self._on_sent is not None:
+                self._on_sent(success)
+
+            # 下一个截止时刻；错过整个周期时跳过，不补发
+            deadline += period
+            behind = time.perf_counter_ns() - deadline
+            if behind >= period:
+                skipped = behind // period
+                deadline += skipped * period
+                self._missed += skipped
+
+    def _wait_until(self, deadline_ns: int):
+        """粗睡眠到截止时刻前spin_margin，再自旋到截止时刻"""
+        coarse = (deadline_ns - time.perf_counter_ns()) / 1e9 - self._spin_margin
+        if coarse > 0:
+            start = time.perf_counter_ns()
+            time.sleep(coarse)
+            oversleep = max((time.perf_counter_ns() - start) / 1e9 - coarse, 0.0)
+            if oversleep > self._spin_margin:
+                # 睡过了截止时刻: 立即加大余量
+                self._oversleep = max(self._oversleep, oversleep)
+            else:
+                self._oversleep += (oversleep - self._oversleep) / 8
+            self._spin_margin = min(
+                max(SPIN_GAIN * self._oversleep, MIN_SPIN_MARGIN), self._period_ns / 2e9
+            )
+
+        while self._running and time.perf_counter_ns() < deadline_ns:
+            time.sleep(0)
@@ -0,0 +1,89 @@
+"""
+DroneSession - 单架无人机的会话
+NetworkService按数据报源地址把遥测分到各会话，每个会话有独立的解码管线、统计和命令发送
+"""
+
+from typing import Callable, List, Optional, Tuple
+from PyQt6.QtCore import QObject, pyqtSignal
+
+
+class DroneSession(QObject):
+    """
+    单架无人机的会话
+
+    职责：
+    - 保存该无人机的地址、链路状态（ProtocolService: v2协商、下行序号统计）和批量解码器
+    - 保存该无人机的收发统计
+    - 攒批状态只在NetworkService的接收线程中访问（一个接收线程服务所有会话）
+    - 命令发送：经NetworkService共用的socket发往该无人机，发送前按本链路协商的版本重新封装
+
+    信号：
+    - data_received: 未设置解码器时，每个数据报一次
+    - batch_received: 设置了解码器时，每个批次一次解码结果
+    - stats_updated: 统计信息更新时发射
+    """
+
+    data_received = pyqtSignal(bytes)
+    batch_received = pyqtSignal(object)
+    stats_updated = pyqtSignal(int, int)  # sent_count, recv_count
+
+    def __init__(self, ip: str, network_service, protocol_service=None, telemetry_decoder=None):
+        """
+        Args:
+            ip: 无人机IP（数据报源地址，也是命令目标地址）
+            network_service: 所属的NetworkService
+            protocol_service: 本链路的ProtocolService，None时命令原样发送
+            telemetry_decoder: 本链路的TelemetryDecoder（应使用同一个protocol_service），
+                None时逐个发射data_received
+        """
+        super().__init__()
+        self._ip = ip
+        self._network_service = network_service
+        self._protocol_service = protocol_service
+        self._telemetry_decoder = telemetry_decoder
+
+        # 批量解码函数: 参数为 [(数据报, 接收时刻us)]，返回值由batch_received发射
+        self.decode: Optional[Callable[[List[Tuple[bytes, int]]], object]] = (
+            telemetry_decoder.decode if telemetry_decoder is not None else None
+        )
+
+        # 接收线程中的攒批状态
+        self.pending: List[Tuple[bytes, int]] = []
+        self.deadline = 0.0
+
+        # 统计
+        self.sent_packets = 0
+        self.recv_packets = 0
+        self.last_recv_time = 0.0
+
+    @property
+    def ip(self) -> str:
+        return self._ip
+
+    @property
+    def protocol_service(self):
+        return self._protocol_service
+
+    @property
+    def telemetry_decoder(self):
+        return self._telemetry_decoder
+
+    def frame_out(self, data: bytes) -> bytes:
+        """按本链路的发送版本输出数据包（命令由其他ProtocolService构建时重新封装）"""
+        if self._protocol_service is None:
+            return data
+        return self._protocol_service.frame_for_link(data)
+
+    def send_packet(self, data: bytes) -> bool:
+        """
+        向该无人机发送数据包
+
+        Returns:
+            bool: 是否发送成功
+        """
+        return self._network_service.send_packet(data, self)
+
+    def reset_stats(self):
+        """重置统计信息"""
+        self.sent_packets = 0
+        self.recv_packets = 0
@@ -0,0 +1,273 @@
+"""
+flight_analysis - 飞行记录统计
+对整份遥测记录做向量化统计：遥测间隔直方图、各轴角速度跟踪误差、电机饱和时间、电池压降
+"""
+
+from typing import Dict, List, Optional
+
+import numpy as np
+
+from . import packet_defs
+from .packet_defs import PacketType
+from .telemetry_recorder import TelemetryLog
+
+MOTOR_MAX = 65535  # 电机PWM上限（power_distribution中limitUint16饱和）
+MOTOR_FIELDS = ("motor1_pwm", "motor2_pwm", "motor3_pwm", "motor4_pwm")
+
+# 角速度环输入与陀螺仪的对应关系（controller_pid.c: gyro.x, -gyro.y, gyro.z）
+RATE_AXES = (
+    ("roll", "roll_rate_desired", "gyro_x", 1.0),
+    ("pitch", "pitch_rate_desired", "gyro_y", -1.0),
+    ("yaw", "yaw_rate_desired", "gyro_z", 1.0),
+)
+
+HISTOGRAM_MAX_MS = 100  # 间隔直方图上限，更长的间隔计入最后一格
+GAP_RATIO = 1.5  # 间隔超过标称间隔的该倍数视为丢帧
+ARMED_THROTTLE = 0.05  # 平均电机输出超过该比例视为带载（电池压降统计）
+
+
+def unwrap_timestamps(timestamp_ms: np.ndarray) -> np.ndarray:
+    """把uint16毫秒时间戳展开为从0开始的连续时间（ms，int64）"""
+    steps = np.diff(timestamp_ms.astype(np.int64)) & 0xFFFF
+    return np.concatenate(([0], np.cumsum(steps)))
+
+
+def interval_histogram(timestamp_ms: np.ndarray) -> Dict:
+    """
+    飞控时间戳间隔统计（反映飞控发送节拍与链路丢帧）
+
+    Returns:
+        dict: nominal_ms（间隔中位数）, rate_hz, histogram（间隔ms → 次数，
+              最后一格含更长间隔）, gaps（超过GAP_RATIO倍标称间隔的次数）,
+              missing（按总时长与标称间隔估计的丢帧数，不受发送抖动影响）, max_gap_ms
+    """
+    if len(timestamp_ms) < 2:
+        return {"nominal_ms": None, "rate_hz": None, "histogram": {}, "gaps": 0,
+                "missing": 0, "max_gap_ms": None}
+
+    dt = np.diff(timestamp_ms.astype(np.int64)) & 0xFFFF
+    counts = np.bincount(np.minimum(dt, HISTOGRAM_MAX_MS), minlength=HISTOGRAM_MAX_MS + 1)
+    nominal = max(float(np.median(dt)), 1.0)
+    gaps = dt > nominal * GAP_RATIO
+    return {
+        "nominal_ms": nominal,
+        "rate_hz": 1000.0 * len(dt) / max(int(dt.sum()), 1),
+        "histogram": {int(ms): int(n) for ms, n in enumerate(counts) if n},
+        "gaps": int(gaps.sum()),
+        "missing": max(int(round(dt.sum() / nominal)) - len(dt), 0),
+        "max_gap_ms": int(dt.max()),
+    }
+
+
+def armed_mask(high_freq: np.ndarray) -> np.ndarray:
+    """任一电机输出非零的行"""
+    mask = np.zeros(len(high_freq), dtype=bool)
+    for name in MOTOR_FIELDS:
+        mask |= high_freq[name] > 0
+    return mask
+
+
+def tracking_error(high_freq: np.ndarray, mask: np.ndarray) -> Dict[str, Dict[str, float]]:
+    """
+    各轴角速度跟踪误差（期望角速度 - 陀螺仪，只统计mask选中的行）
+
+    Returns:
+        dict: 轴名 → mean（偏置）, rms, p95（|误差|的95%分位）, max（°/s）
+    """
+    result = {}
+    for axis, desired, gyro, sign in RATE_AXES:
+        error = (high_freq[desired][mask] - sign * high_freq[gyro][mask]).astype(np.float64)
+        if error.size == 0:
+            result[axis] = None
+            continue
+        magnitude = np.abs(error)
+        result[axis] = {
+            "mean": float(error.mean()),
+            "rms": float(np.sqrt(np.mean(error * error))),
+            "p95": float(np.percentile(magnitude, 95)),
+            "max": float(magnitude.max()),
+        }
+    return result
+
+
+def motor_saturation(high_freq: np.ndarray, dt_s: np.ndarray, mask: np.ndarray) -> Dict:
+    """
+    电机饱和时间（只统计mask选中的行，每行按到下一行的间隔计时）
+
+    Returns:
+        dict: 电机名 → high_s（输出达到上限）, low_s（带载时输出为0）, high_pct, low_pct；
+              any_high_s: 任一电机达到上限的总时间
+    """
+    armed_time = float(dt_s[mask].sum())
+    result = {"armed_s": armed_time}
+    any_high = np.zeros(len(high_freq), dtype=bool)
+    for name in MOTOR_FIELDS:
+        values = high_freq[name]
+        high = mask & (values >= MOTOR_MAX)
+        low = mask & (values == 0)
+        any_high |= high
+        high_s, low_s = float(dt_s[high].sum()), float(dt_s[low].sum())
+        result[name] = {
+            "high_s": high_s,
+            "low_s": low_s,
+            "high_pct": 100.0 * high_s / armed_time if armed_time else 0.0,
+            "low_pct": 100.0 * low_s / armed_time if armed_time else 0.0,
+        }
+    result["any_high_s"] = float(dt_s[any_high].sum())
+    return result
+
+
+def battery_sag(
+    battery_t_us: np.ndarray,
+    voltage: np.ndarray,
+    t_us: np.ndarray,
+    high_freq: np.ndarray,
+) -> Optional[Dict[str, float]]:
+    """
+    电池压降（电池状态1Hz，按最接近的高频数据行取当时的平均电机输出）
+
+    Returns:
+        dict: start_v, end_v, rest_v（空载电压最大值）, min_loaded_v, sag_v（两者之差），
+              sag_per_full_throttle_v（电压对平均油门线性拟合的斜率，反映电池内阻），
+              None表示没有电池数据
+    """
+    if len(voltage) == 0:
+        return None
+
+    throttle = np.zeros(len(voltage))
+    if len(t_us):
+        rows = np.clip(np.searchsorted(t_us, battery_t_us), 0, len(t_us) - 1)
+        motors = np.stack([high_freq[name][rows] for name in MOTOR_FIELDS]).astype(np.float64)
+        throttle = motors.mean(axis=0) / MOTOR_MAX
+
+    loaded = throttle > ARMED_THROTTLE
+    rest = voltage[~loaded]
+    result = {
+        "start_v": float(voltage[0]),
+        "end_v": float(voltage[-1]),
+        "rest_v": float(rest.max()) if rest.size else None,
+        "min_loaded_v": float(voltage[loaded].min()) if loaded.any() else None,
+        "sag_v": None,
+        "sag_per_full_throttle_v": None,
+    }
+    if result["rest_v"] is not None and result["min_loaded_v"] is not None:
+        result["sag_v"] = result["rest_v"] - result["min_loaded_v"]
+    if np.ptp(throttle) > ARMED_THROTTLE:
+        slope = np.polyfit(throttle, voltage, 1)[0]
+        result["sag_per_full_throttle_v"] = float(-slope)
+    return result
+
+
+def analyze(
+    t_us: np.ndarray,
+    high_freq: np.ndarray,
+    battery_t_us: np.ndarray,
+    voltage: np.ndarray,
+) -> Dict:
+    """
+    统计一段遥测
+
+    Args:
+        t_us: 每行高频数据的上位机接收时刻（us）
+        high_freq: HIGH_FREQ_DTYPE结构化数组
+        battery_t_us, voltage: 电池状态的接收时刻与电压
+
+    Returns:
+        dict: duration_s, frames, intervals, armed_s, tracking, saturation, battery
+    """
+    time_ms = unwrap_timestamps(high_freq["timestamp_ms"]) if len(high_freq) else np.zeros(0)
+    dt_s = np.diff(time_ms, append=time_ms[-1:]) / 1000.0 if len(time_ms) else np.zeros(0)
+    intervals = interval_histogram(high_freq["timestamp_ms"])
+    # 超过标称间隔的丢帧期间不计时（按标称间隔计）
+    if intervals["nominal_ms"]:
+        dt_s = np.minimum(dt_s, intervals["nominal_ms"] * GAP_RATIO / 1000.0)
+
+    mask = armed_mask(high_freq)
+    saturation = motor_saturation(high_freq, dt_s, mask)
+    return {
+        "duration_s": float(t_us[-1] - t_us[0]) / 1e6 if len(t_us) else 0.0,
+        "frames": int(len(high_freq)),
+        "intervals": intervals,
+        "armed_s": saturation.pop("armed_s"),
+        "tracking": tracking_error(high_freq, mask),
+        "saturation": saturation,
+        "battery": battery_sag(battery_t_us, voltage, t_us, high_freq),
+    }
+
+
+def analyze_log(log: TelemetryLog) -> Dict:
+    """统计整份记录文件"""
+    t_us, high_freq = log.read_rows(0, log.record_count)
+
+    battery_t: List[int] = []
+    voltage: List[float] = []
+    for event_t, packet_id, payload in log.events(0, log.duration_us + 1):
+        if packet_id == PacketType.BATTERY_STATUS:
+            data = packet_defs.decode_payload(packet_id, payload)
+            if data:
+                battery_t.append(event_t)
+                voltage.append(data["voltage"])
+
+    return analyze(
+        t_us,
+        high_freq,
+        np.array(battery_t, dtype=np.int64),
+        np.array(voltage, dtype=np.float64),
+    )
+
+
+def format_summary(summary: Dict) -> str:
+    """把analyze()的结果格式化为文本"""
+    lines = [
+        f"时长 {summary['duration_s']:.1f} s, 高频数据 {summary['frames']} 帧, "
+        f"带载 {summary['armed_s']:.1f} s"
+    ]
+
+    intervals = summary["intervals"]
+    if intervals["nominal_ms"]:
+        lines.append(
+            f"遥测间隔: 标称 {intervals['nominal_ms']:.0f} ms ({intervals['rate_hz']:.1f} Hz), "
+            f"断档 {intervals['gaps']} 次, 估计丢帧 {intervals['missing']}, "
+            f"最长 {intervals['max_gap_ms']} ms"
+        )
+        total = sum(intervals["histogram"].values())
+        peak = max(intervals["histogram"].values())
+        for ms, count in sorted(intervals["histogram"].items()):
+            if count * 1000 < total:  # 不足0.1%的间隔不显示
+                continue
+            label = f">={ms}" if ms == HISTOGRAM_MAX_MS else f"{ms}"
+            bar = "#" * max(1, round(40 * count / peak))
+            lines.append(f"  {label:>5} ms {count:>8} {bar}")
+
+    lines.append("角速度跟踪误差 (期望 - 陀螺仪, °/s):")
+    for axis, stats in summary["tracking"].items():
+        if stats is None:
+            lines.append(f"  {axis:<5} 无带载数据")
+        else:
+            lines.append(
+                f"  {axis:<5} 偏置 {stats['mean']:7.2f}  RMS {stats['rms']:7.2f}  "
+                f"P95 {stats['p95']:7.2f}  最大 {stats['max']:7.2f}"
+            )
+
+    saturation = summary["saturation"]
+    lines.append(f"电机饱和 (任一电机达到上限 {saturation['any_high_s']:.2f} s):")
+    for i, name in enumerate(MOTOR_FIELDS, 1):
+        stats = saturation[name]
+        lines.append(
+            f"  M{i} 上限 {stats['high_s']:6.2f} s ({stats['high_pct']:4.1f}%)  "
+            f"零输出 {stats['low_s']:6.2f} s ({stats['low_pct']:4.1f}%)"
+        )
+
+    battery = summary["battery"]
+    if battery is None:
+        lines.append("电池: 无数据")
+    else:
+        def volts(value):
+            return "--" if value is None else f"{value:.2f} V"
+
+        lines.append(
+            f"电池: 开始 {volts(battery['start_v'])}, 结束 {volts(battery['end_v'])}, "
+            f"空载 {volts(battery['rest_v'])}, 带载最低 {volts(battery['min_loaded_v'])}, "
+            f"压降 {volts(battery['sag_v'])}, 满油门压降 {volts(battery['sag_per_full_throttle_v'])}"
+        )
+    return "\n".join(lines)
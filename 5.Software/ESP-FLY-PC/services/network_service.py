@@ -1,14 +1,16 @@
 """
 NetworkService - 网络通信服务
-负责UDP通信的连接、发送、接收
+负责UDP通信的连接、发送、接收，按源地址把遥测分到各无人机会话
 """
 
 import socket
 import threading
 import time
-from typing import Optional, Callable
+from typing import Dict, Optional, Callable, List, Tuple
 from PyQt6.QtCore import QObject, pyqtSignal
 
+from .drone_session import DroneSession
+
 
 class NetworkService(QObject):
     """
@@ -18,22 +20,32 @@ class NetworkService(QObject):
     - UDP Socket管理
     - 数据包发送
     - 数据包接收（独立线程）
+    - 批量解码（设置了批量解码器时在接收线程中执行）
     - 连接状态管理
+    - 多机会话: 一个socket和一个接收线程，按数据报源地址分到各DroneSession，
+      每个会话独立攒批解码；未登记地址的数据报丢弃
+    
+    单机接口（send_packet、data_received、batch_received、stats_updated、
+    sent_packets、recv_packets）作用于当前会话，各ViewModel只与当前无人机交互
     
     信号：
-    - data_received: 接收到数据时发射
+    - data_received: 当前会话接收到数据时发射（未设置批量解码器时，每个数据报一次）
+    - batch_received: 当前会话设置了批量解码器时，每个批次发射一次解码结果
     - connected: 连接成功时发射
     - disconnected: 断开连接时发射
     - error_occurred: 发生错误时发射
-    - stats_updated: 统计信息更新时发射
+    - stats_updated: 当前会话统计信息更新时发射
+    - active_drone_changed: 切换当前无人机后发射（IP）
     """
     
     # 信号定义
     data_received = pyqtSignal(bytes)
+    batch_received = pyqtSignal(object)
     connected = pyqtSignal()
     disconnected = pyqtSignal()
     error_occurred = pyqtSignal(str)
     stats_updated = pyqtSignal(int, int)  # sent_count, recv_count
+    active_drone_changed = pyqtSignal(str)
     
     # 默认配置
     DEFAULT_DRONE_IP = "192.168.43.42"
@@ -42,6 +54,7 @@ class NetworkService(QObject):
     DEFAULT_PORT = 2390         # 保留兼容性
     BUFFER_SIZE = 128
     RECV_TIMEOUT = 0.1  # 接收超时（秒）
+    BATCH_INTERVAL = 0.02  # 批量模式下攒批时长（秒），与波形刷新同量级
     
     def __init__(self, drone_ip: str = None, port: int = None, config_service=None):
         super().__init__()
@@ -73,12 +86,13 @@ class NetworkService(QObject):
         # 线程
         self._recv_thread: Optional[threading.Thread] = None
         
-        # 统计
-        self._sent_packets = 0
-        self._recv_packets = 0
+        # 会话: IP → DroneSession（按登记顺序），接收线程只读
+        self._sessions: Dict[str, DroneSession] = {}
+        self._active_session: Optional[DroneSession] = None
+        
+        # 统计（收发包数按会话统计）
         self._send_errors = 0
         self._recv_errors = 0
-        self._last_recv_time = 0.0
     
     @property
     def is_connected(self) -> bool:
@@ -90,7 +104,9 @@ class NetworkService(QObject):
     
     @property
     def drone_ip(self) -> str:
-        return self._drone_ip
+        """当前无人机IP"""
+        session = self._active_session
+        return session.ip if session is not None else self._drone_ip
     
     @property
     def port(self) -> int:
@@ -98,15 +114,83 @@ class NetworkService(QObject):
     
     @property
     def sent_packets(self) -> int:
-        return self._sent_packets
+        session = self._active_session
+        return session.sent_packets if session is not None else 0
     
     @property
     def recv_packets(self) -> int:
-        return self._recv_packets
+        session = self._active_session
+        return session.recv_packets if session is not None else 0
     
     @property
     def last_recv_time(self) -> float:
-        return self._last_recv_time
+        session = self._active_session
+        return session.last_recv_time if session is not None else 0.0
+    
+    @property
+    def sessions(self) -> List[DroneSession]:
+        """全部会话（按登记顺序）"""
+        return list(self._sessions.values())
+    
+    @property
+    def active_session(self) -> Optional[DroneSession]:
+        """当前会话"""
+        return self._active_session
+    
+    def session(self, ip: str) -> Optional[DroneSession]:
+        """按IP查找会话"""
+        return self._sessions.get(ip)
+    
+    def add_drone(self, ip: str, protocol_service=None, telemetry_decoder=None) -> DroneSession:
+        """
+        登记一架无人机（连接前调用），第一架为当前无人机
+        
+        Args:
+            ip: 无人机IP
+            protocol_service: 该链路的ProtocolService（v2协商和序号统计按链路独立）
+            telemetry_decoder: 该链路的TelemetryDecoder，None时逐个发射data_received
+        
+        Returns:
+            DroneSession: 新会话（IP已登记时返回已有会话）
+        """
+        session = self._sessions.get(ip)
+        if session is not None:
+            return session
+        
+        session = DroneSession(ip, self, protocol_service, telemetry_decoder)
+        # 整体替换字典，接收线程读到的总是完整的映射
+        self._sessions = {**self._sessions, ip: session}
+        if self._active_session is None:
+            self._active_session = session
+        return session
+    
+    def set_active_drone(self, ip: str) -> bool:
+        """
+        切换当前无人机（单机接口随之切换），其他会话继续接收
+        
+        Returns:
+            bool: 是否切换
+        """
+        session = self._sessions.get(ip)
+        if session is None or session is self._active_session:
+            return False
+        
+        self._active_session = session
+        self.active_drone_changed.emit(ip)
+        self.stats_updated.emit(session.sent_packets, session.recv_packets)
+        return True
+    
+    def set_batch_decoder(self, decoder: Optional[Callable[[List[Tuple[bytes, int]]], object]]):
+        """
+        设置默认无人机（drone_ip）的批量解码器（单机使用，连接前调用）
+        
+        设置后接收线程每BATCH_INTERVAL把收到的数据报交给decoder解码，
+        通过batch_received发射结果，不再逐个发射data_received
+        
+        Args:
+            decoder: 解码函数，None恢复逐个发射data_received
+        """
+        self.add_drone(self._drone_ip).decode = decoder
     
     def connect(self) -> bool:
         """
@@ -118,6 +202,10 @@ class NetworkService(QObject):
         if self._is_connected:
             return True
         
+        # 未登记无人机时使用默认无人机
+        if not self._sessions:
+            self.add_drone(self._drone_ip)
+        
         try:
             # 创建UDP Socket
             self._socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
@@ -129,15 +217,16 @@ class NetworkService(QObject):
             # 获取本机IP
             self._local_ip = self._get_local_ip()
             
-            # 绑定本地端口用于接收广播数据
-            if self._local_ip:
+            # 绑定本地端口用于接收广播数据（多机时无人机可能在不同网卡上，绑定全部地址）
+            if self._local_ip and len(self._sessions) == 1:
                 bind_addr = (self._local_ip, self._local_port)
             else:
                 bind_addr = ("", self._local_port)
             
             self._socket.bind(bind_addr)
             print(f"[NetworkService] 绑定到本地端口 {self._local_port} 接收数据")
-            print(f"[NetworkService] 将发送命令到设备 {self._drone_ip}:{self._device_port}")
+            for ip in self._sessions:
+                print(f"[NetworkService] 将发送命令到设备 {ip}:{self._device_port}")
             
             # 启动接收线程
             self._is_running = True
@@ -146,7 +235,8 @@ class NetworkService(QObject):
             
             # 标记为已连接
             self._is_connected = True
-            self._last_recv_time = 0.0
+            for session in self._sessions.values():
+                session.last_recv_time = 0.0
             
             # 等待网络栈准备就绪
             time.sleep(0.3)
@@ -178,29 +268,35 @@ class NetworkService(QObject):
             self._socket = None
         
         self._is_connected = False
-        self._last_recv_time = 0.0
+        for session in self._sessions.values():
+            session.pending = []
+            session.last_recv_time = 0.0
         
         self.disconnected.emit()
     
-    def send_packet(self, data: bytes) -> bool:
+    def send_packet(self, data: bytes, session: Optional[DroneSession] = None) -> bool:
         """
         发送数据包
         
         Args:
             data: 要发送的字节数据
+            session: 目标会话，None为当前无人机
             
         Returns:
             bool: 是否发送成功
         """
-        if not self._is_connected or not self._socket:
+        session = session or self._active_session
+        if not self._is_connected or not self._socket or session is None:
             return False
         
         try:
-            sent_bytes = self._socket.sendto(data, (self._drone_ip, self._device_port))
+            sent_bytes = self._socket.sendto(
+                session.frame_out(data), (session.ip, self._device_port)
+            )
             if sent_bytes > 0:
-                self._sent_packets += 1
+                session.sent_packets += 1
                 # 发射统计更新信号
-                self.stats_updated.emit(self._sent_packets, self._recv_packets)
+                self._emit_stats(session)
                 return True
             else:
                 self._send_errors += 1
@@ -211,14 +307,22 @@ class NetworkService(QObject):
             return False
     
     def _receive_loop(self):
-        """接收循环（在独立线程中运行）"""
+        """接收循环（在独立线程中运行，服务所有会话）"""
         while self._is_running:
             try:
+                # 有未发出的批次时只等到最早的攒批截止时刻
+                deadlines = [x.deadline for x in self._sessions.values() if x.pending]
+                if deadlines:
+                    self._socket.settimeout(max(min(deadlines) - time.monotonic(), 0.001))
+                else:
+                    self._socket.settimeout(self.RECV_TIMEOUT)
+                
                 data, addr = self._socket.recvfrom(self.BUFFER_SIZE)
                 
                 if data:
-                    # 只接收来自目标设备IP的数据包
-                    if addr[0] != self._drone_ip:
+                    # 按源地址分到会话，只接收已登记的无人机的数据包
+                    session = self._sessions.get(addr[0])
+                    if session is None:
                         continue
                     
                     # 打印原始数据包（如果配置启用）
@@ -226,23 +330,56 @@ class NetworkService(QObject):
                         debug_config = self._config_service.get_debug_config()
                         if debug_config.get('print_rx_raw_packets', False):
                             hex_str = ' '.join(f'{b:02x}' for b in data)
-                            print(f'[RAW] len={len(data)}: {hex_str}')
+                            print(f'[RAW] {addr[0]} len={len(data)}: {hex_str}')
                     
-                    self._last_recv_time = time.time()
-                    self._recv_packets += 1
+                    session.last_recv_time = time.time()
+                    session.recv_packets += 1
                     
-                    # 发射数据接收信号
-                    self.data_received.emit(data)
-                    # 发射统计更新信号
-                    self.stats_updated.emit(self._sent_packets, self._recv_packets)
+                    if session.decode is None:
+                        # 发射数据接收信号
+                        session.data_received.emit(data)
+                        if session is self._active_session:
+                            self.data_received.emit(data)
+                        # 发射统计更新信号
+                        self._emit_stats(session)
+                    else:
+                        if not session.pending:
+                            session.deadline = time.monotonic() + self.BATCH_INTERVAL
+                        session.pending.append((data, time.perf_counter_ns() // 1000))
                     
             except socket.timeout:
-                continue
+                pass
             except Exception as e:
                 if self._is_running:
                     self._recv_errors += 1
                     self.error_occurred.emit(f"接收错误: {e}")
                 break
+            
+            # 攒批到期: 在接收线程中用各会话自己的解码器解码，整批发射一次
+            now = time.monotonic()
+            for session in self._sessions.values():
+                if session.pending and now >= session.deadline:
+                    self._flush_batch(session)
+    
+    def _flush_batch(self, session: DroneSession):
+        """解码并发射一个会话的批次（接收线程）"""
+        pending, session.pending = session.pending, []
+        try:
+            batch = session.decode(pending)
+        except Exception as e:
+            self._recv_errors += 1
+            self.error_occurred.emit(f"解码错误: {e}")
+            return
+        
+        session.batch_received.emit(batch)
+        if session is self._active_session:
+            self.batch_received.emit(batch)
+        self._emit_stats(session)
+    
+    def _emit_stats(self, session: DroneSession):
+        session.stats_updated.emit(session.sent_packets, session.recv_packets)
+        if session is self._active_session:
+            self.stats_updated.emit(session.sent_packets, session.recv_packets)
     
     def _get_local_ip(self) -> str:
         """获取192.168.43.x网段的本机IP"""
@@ -274,17 +411,17 @@ class NetworkService(QObject):
     def get_stats(self) -> dict:
         """获取统计信息"""
         return {
-            'sent_packets': self._sent_packets,
-            'recv_packets': self._recv_packets,
+            'sent_packets': self.sent_packets,
+            'recv_packets': self.recv_packets,
             'send_errors': self._send_errors,
             'recv_errors': self._recv_errors,
-            'last_recv_time': self._last_recv_time,
+            'last_recv_time': self.last_recv_time,
         }
     
     def reset_stats(self):
         """重置统计信息"""
-        self._sent_packets = 0
-        self._recv_packets = 0
+        for session in self._sessions.values():
+            session.reset_stats()
         self._send_errors = 0
         self._recv_errors = 0
     
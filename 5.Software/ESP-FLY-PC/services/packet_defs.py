@@ -0,0 +1,805 @@
+"""
+packet_defs - 数据包定义与预编译编解码器
+
+本文件由 3.Firmware/ESP-FLY-MCU/components/protocol/tools/packet_codegen.py
+根据 packets.json 自动生成，请勿手动修改
+"""
+
+import struct
+from enum import IntEnum
+from typing import Dict, Optional, Tuple
+
+MAX_PAYLOAD_SIZE = 120
+HEADER_SIZE = 2
+CHECKSUM_SIZE = 1
+
+
+class PacketType(IntEnum):
+    """数据包类型ID"""
+
+    # 上行数据包 (PC → MCU)
+    FLIGHT_CONTROL = 0x01  # 飞行控制命令
+    PID_CONFIG = 0x02  # PID参数配置 (一次性发送所有6组PID参数)
+    MOTOR_TEST = 0x03  # 电机测试
+    HEARTBEAT = 0x10  # 心跳包 (无payload)
+    SUBSCRIBE = 0x11  # 订阅遥测 (客户端以单播方式接收, 需心跳保活)
+    PING = 0x12  # 链路测量请求 (飞控原样回带时间戳)
+    BENCH_REQUEST = 0x13  # 内核微基准测试请求 (电机空闲时执行)
+    MOTOR_CHAR_REQUEST = 0x14  # 电机推力标定请求 (须固定在测试台上, 电机空闲时执行)
+    SYSID_REQUEST = 0x15  # 角速度环系统辨识请求 (须固定在测试台上, 有油门时执行)
+
+    # 下行数据包 (MCU → PC)
+    HIGH_FREQ_DATA = 0x81  # 高频飞行数据 (50Hz)
+    BATTERY_STATUS = 0x82  # 电池状态 (1Hz)
+    PID_RESPONSE = 0x83  # PID参数响应 (1Hz)
+    CONSOLE_LOG = 0x84  # 控制台日志 (UTF-8文本，变长)
+    HEARTBEAT_RESP = 0x90  # 心跳响应 (无payload)
+    PONG = 0x91  # 链路测量响应
+    BENCH_RESULT = 0x92  # 内核微基准测试结果 (每个内核一包)
+    MOTOR_CHAR_RESULT = 0x93  # 电机推力标定结果 (每个标定点一包)
+    SYSID_STATUS = 0x94  # 系统辨识状态
+    SYSID_SAMPLES = 0x95  # 系统辨识原始记录 (每包8个样本)
+    SYSID_FRF = 0x96  # 系统辨识频率响应 (每个频点一包)
+
+
+# ========== Payload结构 (预编译) ==========
+
+# 飞行控制命令 (0x01) - 14 bytes
+FLIGHT_CONTROL_STRUCT = struct.Struct("<3fH")
+FLIGHT_CONTROL_FRAME = struct.Struct("<BB3fH")
+FLIGHT_CONTROL_FIELDS = (
+    "roll",
+    "pitch",
+    "yaw",
+    "thrust",
+)
+
+# PID参数配置 (一次性发送所有6组PID参数) (0x02) - 72 bytes
+PID_CONFIG_STRUCT = struct.Struct("<18f")
+PID_CONFIG_FRAME = struct.Struct("<BB18f")
+PID_CONFIG_FIELDS = (
+    "angle_roll_kp",
+    "angle_roll_ki",
+    "angle_roll_kd",
+    "angle_pitch_kp",
+    "angle_pitch_ki",
+    "angle_pitch_kd",
+    "angle_yaw_kp",
+    "angle_yaw_ki",
+    "angle_yaw_kd",
+    "rate_roll_kp",
+    "rate_roll_ki",
+    "rate_roll_kd",
+    "rate_pitch_kp",
+    "rate_pitch_ki",
+    "rate_pitch_kd",
+    "rate_yaw_kp",
+    "rate_yaw_ki",
+    "rate_yaw_kd",
+)
+
+# 电机测试 (0x03) - 9 bytes
+MOTOR_TEST_STRUCT = struct.Struct("<4HB")
+MOTOR_TEST_FRAME = struct.Struct("<BB4HB")
+MOTOR_TEST_FIELDS = (
+    "motor1_pwm",
+    "motor2_pwm",
+    "motor3_pwm",
+    "motor4_pwm",
+    "enable",
+)
+
+# 订阅遥测 (客户端以单播方式接收, 需心跳保活) (0x11) - 1 bytes
+SUBSCRIBE_STRUCT = struct.Struct("<B")
+SUBSCRIBE_FRAME = struct.Struct("<BBB")
+SUBSCRIBE_FIELDS = (
+    "hf_rate_hz",
+)
+
+# 链路测量请求 (飞控原样回带时间戳) (0x12) - 6 bytes
+PING_STRUCT = struct.Struct("<HI")
+PING_FRAME = struct.Struct("<BBHI")
+PING_FIELDS = (
+    "seq",
+    "host_time_us",
+)
+
+# 内核微基准测试请求 (电机空闲时执行) (0x13) - 2 bytes
+BENCH_REQUEST_STRUCT = struct.Struct("<H")
+BENCH_REQUEST_FRAME = struct.Struct("<BBH")
+BENCH_REQUEST_FIELDS = (
+    "iterations",
+)
+
+# 电机推力标定请求 (须固定在测试台上, 电机空闲时执行) (0x14) - 1 bytes
+MOTOR_CHAR_REQUEST_STRUCT = struct.Struct("<B")
+MOTOR_CHAR_REQUEST_FRAME = struct.Struct("<BBB")
+MOTOR_CHAR_REQUEST_FIELDS = (
+    "action",
+)
+
+# 角速度环系统辨识请求 (须固定在测试台上, 有油门时执行) (0x15) - 16 bytes
+SYSID_REQUEST_STRUCT = struct.Struct("<2BH3f")
+SYSID_REQUEST_FRAME = struct.Struct("<BB2BH3f")
+SYSID_REQUEST_FIELDS = (
+    "axis",
+    "signal",
+    "duration_ms",
+    "amplitude",
+    "f_start",
+    "f_end",
+)
+
+# 高频飞行数据 (50Hz) (0x81) - 64 bytes
+HIGH_FREQ_DATA_STRUCT = struct.Struct("<6f3h4H6fH")
+HIGH_FREQ_DATA_FRAME = struct.Struct("<BB6f3h4H6fH")
+HIGH_FREQ_DATA_FIELDS = (
+    "roll",
+    "pitch",
+    "yaw",
+    "roll_rate_desired",
+    "pitch_rate_desired",
+    "yaw_rate_desired",
+    "roll_control_output",
+    "pitch_control_output",
+    "yaw_control_output",
+    "motor1_pwm",
+    "motor2_pwm",
+    "motor3_pwm",
+    "motor4_pwm",
+    "gyro_x",
+    "gyro_y",
+    "gyro_z",
+    "acc_x",
+    "acc_y",
+    "acc_z",
+    "timestamp_ms",
+)
+
+# 电池状态 (1Hz) (0x82) - 8 bytes
+BATTERY_STATUS_STRUCT = struct.Struct("<fH2B")
+BATTERY_STATUS_FRAME = struct.Struct("<BBfH2B")
+BATTERY_STATUS_FIELDS = (
+    "voltage",
+    "voltage_mv",
+    "percentage",
+    "state",
+)
+
+# PID参数响应 (1Hz) (0x83) - 72 bytes
+PID_RESPONSE_STRUCT = struct.Struct("<18f")
+PID_RESPONSE_FRAME = struct.Struct("<BB18f")
+PID_RESPONSE_FIELDS = (
+    "angle_roll_kp",
+    "angle_roll_ki",
+    "angle_roll_kd",
+    "angle_pitch_kp",
+    "angle_pitch_ki",
+    "angle_pitch_kd",
+    "angle_yaw_kp",
+    "angle_yaw_ki",
+    "angle_yaw_kd",
+    "rate_roll_kp",
+    "rate_roll_ki",
+    "rate_roll_kd",
+    "rate_pitch_kp",
+    "rate_pitch_ki",
+    "rate_pitch_kd",
+    "rate_yaw_kp",
+    "rate_yaw_ki",
+    "rate_yaw_kd",
+)
+
+# 链路测量响应 (0x91) - 21 bytes
+PONG_STRUCT = struct.Struct("<H3IbHI")
+PONG_FRAME = struct.Struct("<BBH3IbHI")
+PONG_FIELDS = (
+    "seq",
+    "host_time_us",
+    "rx_time_us",
+    "tx_time_us",
+    "rssi",
+    "uplink_lost",
+    "uplink_jitter_us",
+)
+
+# 内核微基准测试结果 (每个内核一包) (0x92) - 66 bytes
+BENCH_RESULT_STRUCT = struct.Struct("<2BH3IH16s32s")
+BENCH_RESULT_FRAME = struct.Struct("<BB2BH3IH16s32s")
+BENCH_RESULT_FIELDS = (
+    "kernel",
+    "kernel_count",
+    "iterations",
+    "cycles_min",
+    "cycles_mean",
+    "cycles_max",
+    "cpu_mhz",
+    "name",
+    "fw_version",
+)
+
+# 电机推力标定结果 (每个标定点一包) (0x93) - 11 bytes
+MOTOR_CHAR_RESULT_STRUCT = struct.Struct("<3B4H")
+MOTOR_CHAR_RESULT_FRAME = struct.Struct("<BB3B4H")
+MOTOR_CHAR_RESULT_FIELDS = (
+    "status",
+    "step",
+    "step_count",
+    "duty",
+    "rest_mv",
+    "loaded_mv",
+    "thrust",
+)
+
+# 系统辨识状态 (0x94) - 8 bytes
+SYSID_STATUS_STRUCT = struct.Struct("<4B2H")
+SYSID_STATUS_FRAME = struct.Struct("<BB4B2H")
+SYSID_STATUS_FIELDS = (
+    "state",
+    "axis",
+    "signal",
+    "reason",
+    "sample_rate_hz",
+    "sample_count",
+)
+
+# 系统辨识原始记录 (每包8个样本) (0x95) - 51 bytes
+SYSID_SAMPLES_STRUCT = struct.Struct("<HB48s")
+SYSID_SAMPLES_FRAME = struct.Struct("<BBHB48s")
+SYSID_SAMPLES_FIELDS = (
+    "index",
+    "count",
+    "samples",
+)
+
+# 系统辨识频率响应 (每个频点一包) (0x96) - 26 bytes
+SYSID_FRF_STRUCT = struct.Struct("<2B6f")
+SYSID_FRF_FRAME = struct.Struct("<BB2B6f")
+SYSID_FRF_FIELDS = (
+    "bin",
+    "bin_count",
+    "freq",
+    "closed_gain",
+    "closed_phase",
+    "plant_gain",
+    "plant_phase",
+    "coherence",
+)
+
+PAYLOAD_LAYOUTS: Dict[int, Tuple[struct.Struct, Tuple[str, ...]]] = {
+    PacketType.FLIGHT_CONTROL: (FLIGHT_CONTROL_STRUCT, FLIGHT_CONTROL_FIELDS),
+    PacketType.PID_CONFIG: (PID_CONFIG_STRUCT, PID_CONFIG_FIELDS),
+    PacketType.MOTOR_TEST: (MOTOR_TEST_STRUCT, MOTOR_TEST_FIELDS),
+    PacketType.SUBSCRIBE: (SUBSCRIBE_STRUCT, SUBSCRIBE_FIELDS),
+    PacketType.PING: (PING_STRUCT, PING_FIELDS),
+    PacketType.BENCH_REQUEST: (BENCH_REQUEST_STRUCT, BENCH_REQUEST_FIELDS),
+    PacketType.MOTOR_CHAR_REQUEST: (MOTOR_CHAR_REQUEST_STRUCT, MOTOR_CHAR_REQUEST_FIELDS),
+    PacketType.SYSID_REQUEST: (SYSID_REQUEST_STRUCT, SYSID_REQUEST_FIELDS),
+    PacketType.HIGH_FREQ_DATA: (HIGH_FREQ_DATA_STRUCT, HIGH_FREQ_DATA_FIELDS),
+    PacketType.BATTERY_STATUS: (BATTERY_STATUS_STRUCT, BATTERY_STATUS_FIELDS),
+    PacketType.PID_RESPONSE: (PID_RESPONSE_STRUCT, PID_RESPONSE_FIELDS),
+    PacketType.PONG: (PONG_STRUCT, PONG_FIELDS),
+    PacketType.BENCH_RESULT: (BENCH_RESULT_STRUCT, BENCH_RESULT_FIELDS),
+    PacketType.MOTOR_CHAR_RESULT: (MOTOR_CHAR_RESULT_STRUCT, MOTOR_CHAR_RESULT_FIELDS),
+    PacketType.SYSID_STATUS: (SYSID_STATUS_STRUCT, SYSID_STATUS_FIELDS),
+    PacketType.SYSID_SAMPLES: (SYSID_SAMPLES_STRUCT, SYSID_SAMPLES_FIELDS),
+    PacketType.SYSID_FRF: (SYSID_FRF_STRUCT, SYSID_FRF_FIELDS),
+}
+
+PAYLOAD_SIZES: Dict[int, int] = {
+    PacketType.FLIGHT_CONTROL: 14,
+    PacketType.PID_CONFIG: 72,
+    PacketType.MOTOR_TEST: 9,
+    PacketType.HEARTBEAT: 0,
+    PacketType.SUBSCRIBE: 1,
+    PacketType.PING: 6,
+    PacketType.BENCH_REQUEST: 2,
+    PacketType.MOTOR_CHAR_REQUEST: 1,
+    PacketType.SYSID_REQUEST: 16,
+    PacketType.HIGH_FREQ_DATA: 64,
+    PacketType.BATTERY_STATUS: 8,
+    PacketType.PID_RESPONSE: 72,
+    PacketType.HEARTBEAT_RESP: 0,
+    PacketType.PONG: 21,
+    PacketType.BENCH_RESULT: 66,
+    PacketType.MOTOR_CHAR_RESULT: 11,
+    PacketType.SYSID_STATUS: 8,
+    PacketType.SYSID_SAMPLES: 51,
+    PacketType.SYSID_FRF: 26,
+}
+
+
+# ========== 帧编解码 ==========
+
+
+def checksum(data) -> int:
+    """Checksum = 所有字节累加 & 0xFF"""
+    return sum(data) & 0xFF
+
+
+def encode_frame(packet_id: int, payload: bytes) -> bytes:
+    """构建完整数据包: PacketID + Length + Payload + Checksum"""
+    if len(payload) > MAX_PAYLOAD_SIZE:
+        raise ValueError("payload too long")
+    frame = bytearray(HEADER_SIZE + len(payload) + CHECKSUM_SIZE)
+    frame[0] = packet_id
+    frame[1] = len(payload)
+    frame[HEADER_SIZE:-CHECKSUM_SIZE] = payload
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
+
+
+def split_frame(raw_data: bytes) -> Optional[Tuple[int, bytes]]:
+    """
+    校验并拆分数据帧
+
+    Returns:
+        (packet_id, payload)，长度或校验和错误返回None
+    """
+    if len(raw_data) < HEADER_SIZE + CHECKSUM_SIZE:
+        return None
+    length = raw_data[1]
+    end = HEADER_SIZE + length
+    if len(raw_data) < end + CHECKSUM_SIZE:
+        return None
+    if sum(raw_data[:end]) & 0xFF != raw_data[end]:
+        return None
+    return raw_data[0], raw_data[HEADER_SIZE:end]
+
+
+def decode_payload(packet_id: int, payload: bytes) -> Optional[Dict[str, object]]:
+    """按数据包ID解码定长payload为字段字典，未知ID或长度不足返回None"""
+    layout = PAYLOAD_LAYOUTS.get(packet_id)
+    if layout is None:
+        return None
+    packer, fields = layout
+    if len(payload) < packer.size:
+        return None
+    return dict(zip(fields, packer.unpack_from(payload)))
+
+
+# ========== 数据包编码 ==========
+
+
+def encode_flight_control(roll, pitch, yaw, thrust) -> bytes:
+    """编码数据包 0x01 - 飞行控制命令"""
+    frame = bytearray(FLIGHT_CONTROL_FRAME.size + CHECKSUM_SIZE)
+    FLIGHT_CONTROL_FRAME.pack_into(
+        frame,
+        0,
+        PacketType.FLIGHT_CONTROL,
+        14,
+        roll,
+        pitch,
+        yaw,
+        thrust,
+    )
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
+
+
+def encode_pid_config(
+    angle_roll_kp,
+    angle_roll_ki,
+    angle_roll_kd,
+    angle_pitch_kp,
+    angle_pitch_ki,
+    angle_pitch_kd,
+    angle_yaw_kp,
+    angle_yaw_ki,
+    angle_yaw_kd,
+    rate_roll_kp,
+    rate_roll_ki,
+    rate_roll_kd,
+    rate_pitch_kp,
+    rate_pitch_ki,
+    rate_pitch_kd,
+    rate_yaw_kp,
+    rate_yaw_ki,
+    rate_yaw_kd,
+) -> bytes:
+    """编码数据包 0x02 - PID参数配置 (一次性发送所有6组PID参数)"""
+    frame = bytearray(PID_CONFIG_FRAME.size + CHECKSUM_SIZE)
+    PID_CONFIG_FRAME.pack_into(
+        frame,
+        0,
+        PacketType.PID_CONFIG,
+        72,
+        angle_roll_kp,
+        angle_roll_ki,
+        angle_roll_kd,
+        angle_pitch_kp,
+        angle_pitch_ki,
+        angle_pitch_kd,
+        angle_yaw_kp,
+        angle_yaw_ki,
+        angle_yaw_kd,
+        rate_roll_kp,
+        rate_roll_ki,
+        rate_roll_kd,
+        rate_pitch_kp,
+        rate_pitch_ki,
+        rate_pitch_kd,
+        rate_yaw_kp,
+        rate_yaw_ki,
+        rate_yaw_kd,
+    )
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
+
+
+def encode_motor_test(motor1_pwm, motor2_pwm, motor3_pwm, motor4_pwm, enable) -> bytes:
+    """编码数据包 0x03 - 电机测试"""
+    frame = bytearray(MOTOR_TEST_FRAME.size + CHECKSUM_SIZE)
+    MOTOR_TEST_FRAME.pack_into(
+        frame,
+        0,
+        PacketType.MOTOR_TEST,
+        9,
+        motor1_pwm,
+        motor2_pwm,
+        motor3_pwm,
+        motor4_pwm,
+        enable,
+    )
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
+
+
+_HEARTBEAT_BYTES = encode_frame(PacketType.HEARTBEAT, b"")
+
+
+def encode_heartbeat() -> bytes:
+    """编码数据包 0x10 - 心跳包 (无payload)"""
+    return _HEARTBEAT_BYTES
+
+
+def encode_subscribe(hf_rate_hz) -> bytes:
+    """编码数据包 0x11 - 订阅遥测 (客户端以单播方式接收, 需心跳保活)"""
+    frame = bytearray(SUBSCRIBE_FRAME.size + CHECKSUM_SIZE)
+    SUBSCRIBE_FRAME.pack_into(frame, 0, PacketType.SUBSCRIBE, 1, hf_rate_hz)
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
+
+
+def encode_ping(seq, host_time_us) -> bytes:
+    """编码数据包 0x12 - 链路测量请求 (飞控原样回带时间戳)"""
+    frame = bytearray(PING_FRAME.size + CHECKSUM_SIZE)
+    PING_FRAME.pack_into(frame, 0, PacketType.PING, 6, seq, host_time_us)
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
+
+
+def encode_bench_request(iterations) -> bytes:
+    """编码数据包 0x13 - 内核微基准测试请求 (电机空闲时执行)"""
+    frame = bytearray(BENCH_REQUEST_FRAME.size + CHECKSUM_SIZE)
+    BENCH_REQUEST_FRAME.pack_into(frame, 0, PacketType.BENCH_REQUEST, 2, iterations)
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
+
+
+def encode_motor_char_request(action) -> bytes:
+    """编码数据包 0x14 - 电机推力标定请求 (须固定在测试台上, 电机空闲时执行)"""
+    frame = bytearray(MOTOR_CHAR_REQUEST_FRAME.size + CHECKSUM_SIZE)
+    MOTOR_CHAR_REQUEST_FRAME.pack_into(
+        frame,
+        0,
+        PacketType.MOTOR_CHAR_REQUEST,
+        1,
+        action,
+    )
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
+
+
+def encode_sysid_request(axis, signal, duration_ms, amplitude, f_start, f_end) -> bytes:
+    """编码数据包 0x15 - 角速度环系统辨识请求 (须固定在测试台上, 有油门时执行)"""
+    frame = bytearray(SYSID_REQUEST_FRAME.size + CHECKSUM_SIZE)
+    SYSID_REQUEST_FRAME.pack_into(
+        frame,
+        0,
+        PacketType.SYSID_REQUEST,
+        16,
+        axis,
+        signal,
+        duration_ms,
+        amplitude,
+        f_start,
+        f_end,
+    )
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
+
+
+def encode_high_freq_data(
+    roll,
+    pitch,
+    yaw,
+    roll_rate_desired,
+    pitch_rate_desired,
+    yaw_rate_desired,
+    roll_control_output,
+    pitch_control_output,
+    yaw_control_output,
+    motor1_pwm,
+    motor2_pwm,
+    motor3_pwm,
+    motor4_pwm,
+    gyro_x,
+    gyro_y,
+    gyro_z,
+    acc_x,
+    acc_y,
+    acc_z,
+    timestamp_ms,
+) -> bytes:
+    """编码数据包 0x81 - 高频飞行数据 (50Hz)"""
+    frame = bytearray(HIGH_FREQ_DATA_FRAME.size + CHECKSUM_SIZE)
+    HIGH_FREQ_DATA_FRAME.pack_into(
+        frame,
+        0,
+        PacketType.HIGH_FREQ_DATA,
+        64,
+        roll,
+        pitch,
+        yaw,
+        roll_rate_desired,
+        pitch_rate_desired,
+        yaw_rate_desired,
+        roll_control_output,
+        pitch_control_output,
+        yaw_control_output,
+        motor1_pwm,
+        motor2_pwm,
+        motor3_pwm,
+        motor4_pwm,
+        gyro_x,
+        gyro_y,
+        gyro_z,
+        acc_x,
+        acc_y,
+        acc_z,
+        timestamp_ms,
+    )
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
+
+
+def encode_battery_status(voltage, voltage_mv, percentage, state) -> bytes:
+    """编码数据包 0x82 - 电池状态 (1Hz)"""
+    frame = bytearray(BATTERY_STATUS_FRAME.size + CHECKSUM_SIZE)
+    BATTERY_STATUS_FRAME.pack_into(
+        frame,
+        0,
+        PacketType.BATTERY_STATUS,
+        8,
+        voltage,
+        voltage_mv,
+        percentage,
+        state,
+    )
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
+
+
+def encode_pid_response(
+    angle_roll_kp,
+    angle_roll_ki,
+    angle_roll_kd,
+    angle_pitch_kp,
+    angle_pitch_ki,
+    angle_pitch_kd,
+    angle_yaw_kp,
+    angle_yaw_ki,
+    angle_yaw_kd,
+    rate_roll_kp,
+    rate_roll_ki,
+    rate_roll_kd,
+    rate_pitch_kp,
+    rate_pitch_ki,
+    rate_pitch_kd,
+    rate_yaw_kp,
+    rate_yaw_ki,
+    rate_yaw_kd,
+) -> bytes:
+    """编码数据包 0x83 - PID参数响应 (1Hz)"""
+    frame = bytearray(PID_RESPONSE_FRAME.size + CHECKSUM_SIZE)
+    PID_RESPONSE_FRAME.pack_into(
+        frame,
+        0,
+        PacketType.PID_RESPONSE,
+        72,
+        angle_roll_kp,
+        angle_roll_ki,
+        angle_roll_kd,
+        angle_pitch_kp,
+        angle_pitch_ki,
+        angle_pitch_kd,
+        angle_yaw_kp,
+        angle_yaw_ki,
+        angle_yaw_kd,
+        rate_roll_kp,
+        rate_roll_ki,
+        rate_roll_kd,
+        rate_pitch_kp,
+        rate_pitch_ki,
+        rate_pitch_kd,
+        rate_yaw_kp,
+        rate_yaw_ki,
+        rate_yaw_kd,
+    )
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
+
+
+def encode_console_log(payload: bytes) -> bytes:
+    """编码数据包 0x84 - 控制台日志 (UTF-8文本，变长)"""
+    return encode_frame(PacketType.CONSOLE_LOG, payload)
+
+
+_HEARTBEAT_RESP_BYTES = encode_frame(PacketType.HEARTBEAT_RESP, b"")
+
+
+def encode_heartbeat_resp() -> bytes:
+    """编码数据包 0x90 - 心跳响应 (无payload)"""
+    return _HEARTBEAT_RESP_BYTES
+
+
+def encode_pong(
+    seq,
+    host_time_us,
+    rx_time_us,
+    tx_time_us,
+    rssi,
+    uplink_lost,
+    uplink_jitter_us,
+) -> bytes:
+    """编码数据包 0x91 - 链路测量响应"""
+    frame = bytearray(PONG_FRAME.size + CHECKSUM_SIZE)
+    PONG_FRAME.pack_into(
+        frame,
+        0,
+        PacketType.PONG,
+        21,
+        seq,
+        host_time_us,
+        rx_time_us,
+        tx_time_us,
+        rssi,
+        uplink_lost,
+        uplink_jitter_us,
+    )
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
+
+
+def encode_bench_result(
+    kernel,
+    kernel_count,
+    iterations,
+    cycles_min,
+    cycles_mean,
+    cycles_max,
+    cpu_mhz,
+    name,
+    fw_version,
+) -> bytes:
+    """编码数据包 0x92 - 内核微基准测试结果 (每个内核一包)"""
+    frame = bytearray(BENCH_RESULT_FRAME.size + CHECKSUM_SIZE)
+    BENCH_RESULT_FRAME.pack_into(
+        frame,
+        0,
+        PacketType.BENCH_RESULT,
+        66,
+        kernel,
+        kernel_count,
+        iterations,
+        cycles_min,
+        cycles_mean,
+        cycles_max,
+        cpu_mhz,
+        name,
+        fw_version,
+    )
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
+
+
+def encode_motor_char_result(
+    status,
+    step,
+    step_count,
+    duty,
+    rest_mv,
+    loaded_mv,
+    thrust,
+) -> bytes:
+    """编码数据包 0x93 - 电机推力标定结果 (每个标定点一包)"""
+    frame = bytearray(MOTOR_CHAR_RESULT_FRAME.size + CHECKSUM_SIZE)
+    MOTOR_CHAR_RESULT_FRAME.pack_into(
+        frame,
+        0,
+        PacketType.MOTOR_CHAR_RESULT,
+        11,
+        status,
+        step,
+        step_count,
+        duty,
+        rest_mv,
+        loaded_mv,
+        thrust,
+    )
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
+
+
+def encode_sysid_status(
+    state,
+    axis,
+    signal,
+    reason,
+    sample_rate_hz,
+    sample_count,
+) -> bytes:
+    """编码数据包 0x94 - 系统辨识状态"""
+    frame = bytearray(SYSID_STATUS_FRAME.size + CHECKSUM_SIZE)
+    SYSID_STATUS_FRAME.pack_into(
+        frame,
+        0,
+        PacketType.SYSID_STATUS,
+        8,
+        state,
+        axis,
+        signal,
+        reason,
+        sample_rate_hz,
+        sample_count,
+    )
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
+
+
+def encode_sysid_samples(index, count, samples) -> bytes:
+    """编码数据包 0x95 - 系统辨识原始记录 (每包8个样本)"""
+    frame = bytearray(SYSID_SAMPLES_FRAME.size + CHECKSUM_SIZE)
+    SYSID_SAMPLES_FRAME.pack_into(
+        frame,
+        0,
+        PacketType.SYSID_SAMPLES,
+        51,
+        index,
+        count,
+        samples,
+    )
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
+
+
+def encode_sysid_frf(
+    bin,
+    bin_count,
+    freq,
+    closed_gain,
+    closed_phase,
+    plant_gain,
+    plant_phase,
+    coherence,
+) -> bytes:
+    """编码数据包 0x96 - 系统辨识频率响应 (每个频点一包)"""
+    frame = bytearray(SYSID_FRF_FRAME.size + CHECKSUM_SIZE)
+    SYSID_FRF_FRAME.pack_into(
+        frame,
+        0,
+        PacketType.SYSID_FRF,
+        26,
+        bin,
+        bin_count,
+        freq,
+        closed_gain,
+        closed_phase,
+        plant_gain,
+        plant_phase,
+        coherence,
+    )
+    frame[-1] = sum(frame) & 0xFF
+    return bytes(frame)
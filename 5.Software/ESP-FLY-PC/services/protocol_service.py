@@ -3,24 +3,14 @@ ProtocolService - 协议服务
 负责数据包的解析和构建
 """
 
+import binascii
+import itertools
 import struct
-from typing import Optional, Dict, Any
-from enum import IntEnum
+from typing import Optional, Dict, Any, List, Iterable, Tuple
 from dataclasses import dataclass
 
-
-class PacketType(IntEnum):
-    """数据包类型ID"""
-
-    # 上行数据包 (PC → MCU)
-    FLIGHT_CONTROL = 0x01  # 飞行控制命令
-    PID_CONFIG = 0x02  # PID参数配置
-    MOTOR_TEST = 0x03  # 电机测试
-
-    # 下行数据包 (MCU → PC)
-    HIGH_FREQ_DATA = 0x81  # 高频飞行数据 (50Hz)
-    BATTERY_STATUS = 0x82  # 电池状态 (1Hz)
-    PID_RESPONSE = 0x83  # PID参数响应 (1Hz)
+from . import packet_defs
+from .packet_defs import PacketType
 
 
 @dataclass
@@ -42,12 +32,185 @@ class ProtocolService:
     - 解析接收到的数据包
     - 构建要发送的数据包
     - 校验和计算和验证
+    - 协议v2数据报封装（序号 + 时间戳 + CRC16，可合并多帧）
+
+    v2数据报格式（小端）:
+        Magic(0xA5) + Version(2) + Seq(u16) + Timestamp(u32, ms) + 若干v1帧 + CRC16
+    CRC16为CRC-16/CCITT-FALSE（多项式0x1021，初值0xFFFF），覆盖CRC之前的全部字节。
+    上位机发出v2心跳后，收到飞控的任意v2数据报即把下行切换为v2；
+    飞控同样在收到v2数据报后才切换，仅支持v1的APP不受影响。
     """
 
-    MAX_PAYLOAD_SIZE = 120
+    MAX_PAYLOAD_SIZE = packet_defs.MAX_PAYLOAD_SIZE
+
+    V2_MAGIC = 0xA5
+    V2_VERSION = 2
+    V2_HEADER = struct.Struct("<BBHI")
+    V2_CRC_SIZE = 2
+    V2_MAX_DATAGRAM = 124  # 飞控接收端单个UDP数据报上限（上行，超出的数据报被飞控丢弃）
+
+    def __init__(self, preferred_version: int = 2):
+        self._preferred_version = preferred_version
+        self._tx_seq = itertools.count()
+        self._tx_version = 1
+        self.reset_link()
+
+    # ========== 协议v2 ==========
+
+    @property
+    def tx_version(self) -> int:
+        """当前发送使用的协议版本"""
+        return self._tx_version
+
+    def reset_link(self):
+        """重置链路状态（断开连接时调用），回到v1"""
+        self._tx_version = 1
+        self._rx_expected_seq = None
+        self._rx_datagrams = 0
+        self._rx_lost = 0
+        self._rx_reordered = 0
+        self._rx_crc_errors = 0
+
+    def get_link_stats(self) -> Dict[str, int]:
+        """获取v2下行数据报统计（接收/丢失/乱序/CRC错误）"""
+        return {
+            "version": self._tx_version,
+            "received": self._rx_datagrams,
+            "lost": self._rx_lost,
+            "reordered": self._rx_reordered,
+            "crc_errors": self._rx_crc_errors,
+        }
+
+    def wrap_v2(self, frames: Iterable[bytes], timestamp_ms: int = 0) -> bytes:
+        """
+        将若干v1帧封装为一个v2数据报
+
+        Args:
+            frames: 完整v1帧列表
+            timestamp_ms: 发送时间戳（毫秒）
+
+        Returns:
+            bytes: v2数据报
+
+        Raises:
+            ValueError: 数据报超过V2_MAX_DATAGRAM（不消耗序号）
+        """
+        payload = b"".join(frames)
+        size = self.V2_HEADER.size + len(payload) + self.V2_CRC_SIZE
+        if size > self.V2_MAX_DATAGRAM:
+            raise ValueError(f"v2 datagram too long: {size} > {self.V2_MAX_DATAGRAM}")
+        seq = next(self._tx_seq) & 0xFFFF
+        body = self.V2_HEADER.pack(
+            self.V2_MAGIC, self.V2_VERSION, seq, timestamp_ms & 0xFFFFFFFF
+        ) + payload
+        crc = binascii.crc_hqx(body, 0xFFFF)
+        return body + struct.pack("<H", crc)
+
+    def parse_datagram(self, raw_data: bytes) -> List[ParsedPacket]:
+        """
+        解析一个UDP数据报（自动识别v1单帧或v2多帧）
+
+        Args:
+            raw_data: 原始字节数据
+
+        Returns:
+            List[ParsedPacket]: 数据报中解析成功的数据包
+        """
+        packets = []
+        for packet_id, payload in self.split_datagram(raw_data):
+            packet = self.decode_frame(packet_id, payload)
+            if packet is not None:
+                packets.append(packet)
+        return packets
+
+    def split_datagram(self, raw_data: bytes) -> List[Tuple[int, bytes]]:
+        """
+        校验并拆分一个UDP数据报（v2时检查CRC并统计序号），不解码payload
+
+        Args:
+            raw_data: 原始字节数据
 
-    def __init__(self):
-        pass
+        Returns:
+            List[Tuple[int, bytes]]: 校验和正确的帧 (packet_id, payload)
+        """
+        if not self._is_v2(raw_data):
+            frame = packet_defs.split_frame(raw_data)
+            return [frame] if frame is not None else []
+
+        body = raw_data[: -self.V2_CRC_SIZE]
+        (crc,) = struct.unpack_from("<H", raw_data, len(body))
+        if binascii.crc_hqx(body, 0xFFFF) != crc:
+            self._rx_crc_errors += 1
+            return []
+
+        _, _, seq, _ = self.V2_HEADER.unpack_from(body)
+        self._track_seq(seq)
+
+        # 对端支持v2，发送也切换为v2
+        if self._preferred_version >= self.V2_VERSION:
+            self._tx_version = self.V2_VERSION
+
+        frames = []
+        offset = self.V2_HEADER.size
+        while offset + packet_defs.HEADER_SIZE <= len(body):
+            frame_len = (
+                packet_defs.HEADER_SIZE + body[offset + 1] + packet_defs.CHECKSUM_SIZE
+            )
+            frame = packet_defs.split_frame(body[offset : offset + frame_len])
+            if frame is not None:
+                frames.append(frame)
+            offset += frame_len
+        return frames
+
+    def _is_v2(self, raw_data: bytes) -> bool:
+        return (
+            len(raw_data) >= self.V2_HEADER.size + self.V2_CRC_SIZE
+            and raw_data[0] == self.V2_MAGIC
+            and raw_data[1] == self.V2_VERSION
+        )
+
+    def _track_seq(self, seq: int):
+        """按序号统计丢包与乱序"""
+        self._rx_datagrams += 1
+        if self._rx_expected_seq is None:
+            self._rx_expected_seq = (seq + 1) & 0xFFFF
+            return
+
+        delta = (seq - self._rx_expected_seq) & 0xFFFF
+        if delta < 0x8000:
+            # 跳过的序号先记为丢失
+            self._rx_lost += delta
+            self._rx_expected_seq = (seq + 1) & 0xFFFF
+        else:
+            # 迟到的数据报: 之前被记为丢失, 改记为乱序
+            self._rx_reordered += 1
+            if self._rx_lost > 0:
+                self._rx_lost -= 1
+
+    def fits_v2(self, frames_len: int) -> bool:
+        """总长frames_len字节的帧封装为v2后是否不超过V2_MAX_DATAGRAM"""
+        return self.V2_HEADER.size + frames_len + self.V2_CRC_SIZE <= self.V2_MAX_DATAGRAM
+
+    def _frame_out(self, frame: bytes) -> bytes:
+        """
+        按当前发送版本输出帧（v2时封装为数据报）
+
+        封装后超过V2_MAX_DATAGRAM的长帧按v1单帧发送，飞控按魔数逐个识别数据报版本
+        """
+        if self._tx_version >= self.V2_VERSION and self.fits_v2(len(frame)):
+            return self.wrap_v2([frame])
+        return frame
+
+    def frame_for_link(self, data: bytes) -> bytes:
+        """
+        按本链路的发送版本输出其他ProtocolService构建的数据包
+
+        多机时命令由共用的ProtocolService构建，发往某架无人机前由该链路重新封装：
+        v1单帧在已协商v2时封装为v2数据报（使用本链路的序号），v2数据报原样发送
+        """
+        if self._is_v2(data):
+            return data
+        return self._frame_out(data)
 
     # ========== 数据包解析 ==========
 
@@ -61,24 +224,22 @@ class ProtocolService:
         Returns:
             ParsedPacket: 解析后的数据包，失败返回None
         """
-        if len(raw_data) < 3:
+        frame = packet_defs.split_frame(raw_data)
+        if frame is None:
             return None
+        return self.decode_frame(*frame)
 
-        packet_id = raw_data[0]
-        length = raw_data[1]
-
-        if len(raw_data) < 2 + length + 1:
-            return None
-
-        payload = raw_data[2 : 2 + length]
-        checksum = raw_data[2 + length]
+    def decode_frame(self, packet_id: int, payload: bytes) -> Optional[ParsedPacket]:
+        """
+        按类型解码已校验的帧
 
-        # 验证校验和
-        calculated_checksum = self._calculate_checksum(packet_id, length, payload)
-        if calculated_checksum != checksum:
-            return None
+        Args:
+            packet_id: 数据包ID
+            payload: 有效载荷
 
-        # 根据类型解析
+        Returns:
+            ParsedPacket: 解析后的数据包，未知类型或长度不足返回None
+        """
         if packet_id == PacketType.HIGH_FREQ_DATA:
             return self._parse_high_freq_data(payload)
         elif packet_id == PacketType.BATTERY_STATUS:
@@ -89,6 +250,18 @@ class ProtocolService:
             return self._parse_console_log(payload)
         elif packet_id == PacketType.HEARTBEAT_RESP:
             return ParsedPacket(PacketType.HEARTBEAT_RESP, {})
+        elif packet_id == PacketType.PONG:
+            return self._parse_pong(payload)
+        elif packet_id == PacketType.BENCH_RESULT:
+            return self._parse_bench_result(payload)
+        elif packet_id == PacketType.MOTOR_CHAR_RESULT:
+            return self._parse_motor_char_result(payload)
+        elif packet_id in (
+            PacketType.SYSID_STATUS,
+            PacketType.SYSID_SAMPLES,
+            PacketType.SYSID_FRF,
+        ):
+            return self._parse_sysid(packet_id, payload)
 
         return None
 
@@ -106,47 +279,11 @@ class ProtocolService:
         - 时间戳: timestamp (1 x uint16 = 2 bytes)
         总计: 64 bytes
         """
-        if len(payload) < 64:
+        data = packet_defs.decode_payload(PacketType.HIGH_FREQ_DATA, payload)
+        if data is None:
             return None
 
-        try:
-            # 解析数据
-            data = struct.unpack("<6f3h4H6fH", payload[:64])
-
-            return ParsedPacket(
-                PacketType.HIGH_FREQ_DATA,
-                {
-                    # 姿态角
-                    "roll": data[0],
-                    "pitch": data[1],
-                    "yaw": data[2],
-                    # 期望角速度（外环输出）
-                    "roll_rate_desired": data[3],
-                    "pitch_rate_desired": data[4],
-                    "yaw_rate_desired": data[5],
-                    # 控制量（内环输出）
-                    "roll_control_output": data[6],
-                    "pitch_control_output": data[7],
-                    "yaw_control_output": data[8],
-                    # 电机PWM
-                    "motor1_pwm": data[9],
-                    "motor2_pwm": data[10],
-                    "motor3_pwm": data[11],
-                    "motor4_pwm": data[12],
-                    # 陀螺仪
-                    "gyro_x": data[13],
-                    "gyro_y": data[14],
-                    "gyro_z": data[15],
-                    # 加速度
-                    "acc_x": data[16],
-                    "acc_y": data[17],
-                    "acc_z": data[18],
-                    # 时间戳
-                    "timestamp_ms": data[19],
-                },
-            )
-        except struct.error:
-            return None
+        return ParsedPacket(PacketType.HIGH_FREQ_DATA, data)
 
     def _parse_battery_status(self, payload: bytes) -> Optional[ParsedPacket]:
         """
@@ -158,26 +295,14 @@ class ProtocolService:
         - level: uint8 (1 byte)
         - state: uint8 (1 byte)
         """
-        if len(payload) < 8:
+        data = packet_defs.decode_payload(PacketType.BATTERY_STATUS, payload)
+        if data is None:
             return None
 
-        try:
-            voltage, voltage_mv, level, state = struct.unpack("<fHBB", payload[:8])
-
-            state_names = {0: "正常", 1: "充电中", 2: "已充满", 3: "低电量", 4: "关机"}
-
-            return ParsedPacket(
-                PacketType.BATTERY_STATUS,
-                {
-                    "voltage": voltage,
-                    "voltage_mv": voltage_mv,
-                    "percentage": level,
-                    "state": state,
-                    "state_name": state_names.get(state, "未知"),
-                },
-            )
-        except struct.error:
-            return None
+        state_names = {0: "正常", 1: "充电中", 2: "已充满", 3: "低电量", 4: "关机"}
+        data["state_name"] = state_names.get(data["state"], "未知")
+
+        return ParsedPacket(PacketType.BATTERY_STATUS, data)
 
     def _parse_pid_response(self, payload: bytes) -> Optional[ParsedPacket]:
         """
@@ -188,40 +313,93 @@ class ProtocolService:
         - 角速度环PID: roll(kp,ki,kd), pitch(kp,ki,kd), yaw(kp,ki,kd) (9 x float = 36 bytes)
         总计: 72 bytes
         """
-        if len(payload) < 72:
+        data = packet_defs.decode_payload(PacketType.PID_RESPONSE, payload)
+        if data is None:
             return None
 
-        try:
-            data = struct.unpack("<18f", payload[:72])
-
-            return ParsedPacket(
-                PacketType.PID_RESPONSE,
-                {
-                    # 角度环（外环）
-                    "angle_roll_kp": data[0],
-                    "angle_roll_ki": data[1],
-                    "angle_roll_kd": data[2],
-                    "angle_pitch_kp": data[3],
-                    "angle_pitch_ki": data[4],
-                    "angle_pitch_kd": data[5],
-                    "angle_yaw_kp": data[6],
-                    "angle_yaw_ki": data[7],
-                    "angle_yaw_kd": data[8],
-                    # 角速度环（内环）
-                    "rate_roll_kp": data[9],
-                    "rate_roll_ki": data[10],
-                    "rate_roll_kd": data[11],
-                    "rate_pitch_kp": data[12],
-                    "rate_pitch_ki": data[13],
-                    "rate_pitch_kd": data[14],
-                    "rate_yaw_kp": data[15],
-                    "rate_yaw_ki": data[16],
-                    "rate_yaw_kd": data[17],
-                },
-            )
-        except struct.error:
+        return ParsedPacket(PacketType.PID_RESPONSE, data)
+
+    def _parse_pong(self, payload: bytes) -> Optional[ParsedPacket]:
+        """
+        解析链路测量响应
+
+        Payload结构（21 bytes）:
+        - seq, host_time_us: 原样回带的请求序号和上位机发送时间
+        - rx_time_us, tx_time_us: 飞控收到请求/发出响应的时间（微秒）
+        - rssi: 飞控侧测得的RSSI（dBm）
+        - uplink_lost, uplink_jitter_us: 飞控统计的请求丢失数和上行抖动
+        """
+        data = packet_defs.decode_payload(PacketType.PONG, payload)
+        if data is None:
+            return None
+
+        return ParsedPacket(PacketType.PONG, data)
+
+    def _parse_bench_result(self, payload: bytes) -> Optional[ParsedPacket]:
+        """
+        解析内核微基准测试结果（每个内核一包）
+
+        Payload结构（66 bytes）:
+        - kernel, kernel_count: 内核序号和本轮内核总数
+        - iterations: 调用次数
+        - cycles_min, cycles_mean, cycles_max: 单次调用周期数（已扣除计时开销）
+        - cpu_mhz: CPU主频
+        - name, fw_version: 内核名称和固件版本（定长, 补0）
+        """
+        data = packet_defs.decode_payload(PacketType.BENCH_RESULT, payload)
+        if data is None:
+            return None
+
+        for key in ("name", "fw_version"):
+            data[key] = data[key].split(b"\x00", 1)[0].decode("utf-8", errors="ignore")
+        mhz = data["cpu_mhz"] or 1
+        data["mean_us"] = data["cycles_mean"] / mhz
+
+        return ParsedPacket(PacketType.BENCH_RESULT, data)
+
+    def _parse_motor_char_result(self, payload: bytes) -> Optional[ParsedPacket]:
+        """
+        解析电机推力标定结果（每个标定点一包）
+
+        Payload结构（11 bytes）:
+        - status: 0=理想曲线 1=NVS标定 2=标定中 3=被拒绝/中止
+        - step, step_count: 标定点序号和总数
+        - duty: 该点PWM占空比 (0-65535)
+        - rest_mv, loaded_mv: 静止和带载电池电压 (mV)
+        - thrust: 推算的相对推力 (0-65535)
+        """
+        data = packet_defs.decode_payload(PacketType.MOTOR_CHAR_RESULT, payload)
+        if data is None:
             return None
 
+        data["duty_pct"] = data["duty"] * 100.0 / 65535
+        data["thrust_pct"] = data["thrust"] * 100.0 / 65535
+
+        return ParsedPacket(PacketType.MOTOR_CHAR_RESULT, data)
+
+    def _parse_sysid(self, packet_id: int, payload: bytes) -> Optional[ParsedPacket]:
+        """
+        解析系统辨识数据包
+
+        - SYSID_STATUS: state（0=完成 1=激励中 2=分析中 3=被拒绝 4=已中止）、reason、
+          sample_rate_hz、sample_count
+        - SYSID_FRF: 每个频点一包，闭环/对象的幅值和相位（度）及相干值
+        - SYSID_SAMPLES: 每包8个样本，samples解包为
+          [(期望角速度 度/秒, 陀螺仪 度/秒, 内环输出), ...]
+        """
+        data = packet_defs.decode_payload(packet_id, payload)
+        if data is None:
+            return None
+
+        if packet_id == PacketType.SYSID_SAMPLES:
+            block = data["samples"][: data["count"] * 6]
+            data["samples"] = [
+                (rate / 10.0, gyro / 10.0, output)
+                for rate, gyro, output in struct.iter_unpack("<3h", block)
+            ]
+
+        return ParsedPacket(packet_id, data)
+
     def _parse_console_log(self, payload: bytes) -> Optional[ParsedPacket]:
         """解析控制台日志"""
         try:
@@ -247,9 +425,9 @@ class ProtocolService:
         Returns:
             bytes: 完整数据包
         """
-        packet_id = PacketType.FLIGHT_CONTROL
-        payload = struct.pack("<3fH", roll, pitch, yaw, thrust)
-        return self._build_packet(packet_id, payload)
+        return self._frame_out(
+            packet_defs.encode_flight_control(roll, pitch, yaw, thrust)
+        )
 
     def build_pid_config_packet(
         self,
@@ -281,29 +459,28 @@ class ProtocolService:
         Returns:
             bytes: 完整数据包（72 bytes payload）
         """
-        packet_id = PacketType.PID_CONFIG
-        payload = struct.pack(
-            "<18f",
-            angle_roll_kp,
-            angle_roll_ki,
-            angle_roll_kd,
-            angle_pitch_kp,
-            angle_pitch_ki,
-            angle_pitch_kd,
-            angle_yaw_kp,
-            angle_yaw_ki,
-            angle_yaw_kd,
-            rate_roll_kp,
-            rate_roll_ki,
-            rate_roll_kd,
-            rate_pitch_kp,
-            rate_pitch_ki,
-            rate_pitch_kd,
-            rate_yaw_kp,
-            rate_yaw_ki,
-            rate_yaw_kd,
+        return self._frame_out(
+            packet_defs.encode_pid_config(
+                angle_roll_kp,
+                angle_roll_ki,
+                angle_roll_kd,
+                angle_pitch_kp,
+                angle_pitch_ki,
+                angle_pitch_kd,
+                angle_yaw_kp,
+                angle_yaw_ki,
+                angle_yaw_kd,
+                rate_roll_kp,
+                rate_roll_ki,
+                rate_roll_kd,
+                rate_pitch_kp,
+                rate_pitch_ki,
+                rate_pitch_kd,
+                rate_yaw_kp,
+                rate_yaw_ki,
+                rate_yaw_kd,
+            )
         )
-        return self._build_packet(packet_id, payload)
 
     def build_motor_test_packet(
         self, m1_pwm: int, m2_pwm: int, m3_pwm: int, m4_pwm: int, enable: bool
@@ -321,15 +498,119 @@ class ProtocolService:
         Returns:
             bytes: 完整数据包
         """
-        packet_id = PacketType.MOTOR_TEST
-        payload = struct.pack(
-            "<HHHHB", m1_pwm, m2_pwm, m3_pwm, m4_pwm, 1 if enable else 0
+        return self._frame_out(
+            packet_defs.encode_motor_test(
+                m1_pwm, m2_pwm, m3_pwm, m4_pwm, 1 if enable else 0
+            )
         )
-        return self._build_packet(packet_id, payload)
 
     def build_heartbeat_packet(self) -> bytes:
-        """构建心跳包（0x10）"""
-        return self._build_packet(PacketType.HEARTBEAT, b"")
+        """
+        构建心跳包（0x10）
+
+        首选v2时心跳始终以v2数据报发送，用于向飞控发起v2协商
+        """
+        frame = packet_defs.encode_heartbeat()
+        if self._preferred_version >= self.V2_VERSION and self.fits_v2(len(frame)):
+            return self.wrap_v2([frame])
+        return frame
+
+    def build_subscribe_packet(self, hf_rate_hz: int = 0) -> bytes:
+        """
+        构建订阅包（0x11）
+
+        飞控以单播方式向已订阅的客户端发送遥测，需配合心跳保活
+
+        Args:
+            hf_rate_hz: 高频数据速率（Hz），0=默认50Hz
+
+        Returns:
+            bytes: 完整数据包
+        """
+        return self._frame_out(
+            packet_defs.encode_subscribe(max(0, min(int(hf_rate_hz), 255)))
+        )
+
+    def build_ping_packet(self, seq: int, host_time_us: int) -> bytes:
+        """
+        构建链路测量请求包（0x12）
+
+        Args:
+            seq: 请求序号（低16位）
+            host_time_us: 上位机发送时间（微秒，低32位）
+
+        Returns:
+            bytes: 完整数据包
+        """
+        return self._frame_out(
+            packet_defs.encode_ping(seq & 0xFFFF, host_time_us & 0xFFFFFFFF)
+        )
+
+    def build_bench_request_packet(self, iterations: int = 0) -> bytes:
+        """
+        构建内核微基准测试请求包（0x13）
+
+        飞控在电机停转时执行测试，结果以BENCH_RESULT包逐个返回
+
+        Args:
+            iterations: 每个内核的调用次数，0=默认1000
+
+        Returns:
+            bytes: 完整数据包
+        """
+        return self._frame_out(
+            packet_defs.encode_bench_request(max(0, min(int(iterations), 0xFFFF)))
+        )
+
+    def build_motor_char_request_packet(self, action: int = 0) -> bytes:
+        """
+        构建电机推力标定请求包（0x14）
+
+        标定结果（或当前曲线）以MOTOR_CHAR_RESULT包逐点返回
+
+        Args:
+            action: 0=查询当前曲线, 1=运行标定并保存, 2=清除标定, 3=中止标定
+
+        Returns:
+            bytes: 完整数据包
+        """
+        return self._frame_out(packet_defs.encode_motor_char_request(int(action) & 0xFF))
+
+    def build_sysid_request_packet(
+        self,
+        axis: int,
+        signal: int,
+        duration_ms: int = 4000,
+        amplitude: float = 0.0,
+        f_start: float = 0.0,
+        f_end: float = 0.0,
+    ) -> bytes:
+        """
+        构建系统辨识请求包（0x15）
+
+        飞控在期望角速度上叠加激励并记录响应，进度以SYSID_STATUS包返回，
+        随后依次返回SYSID_FRF（仅扫频）和SYSID_SAMPLES
+
+        Args:
+            axis: 0=Roll, 1=Pitch, 2=Yaw
+            signal: 0=阶跃, 1=扫频, 255=中止
+            duration_ms: 激励时长
+            amplitude: 激励幅值（度/秒）
+            f_start, f_end: 扫频频率范围（Hz）
+
+        Returns:
+            bytes: 完整数据包
+        """
+        return self._frame_out(
+            packet_defs.encode_sysid_request(
+                int(axis) & 0xFF,
+                int(signal) & 0xFF,
+                max(0, min(int(duration_ms), 0xFFFF)),
+                float(amplitude),
+                float(f_start),
+                float(f_end),
+            )
+        )
 
     # ========== 辅助方法 ==========
 
@@ -344,9 +625,7 @@ class ProtocolService:
         Returns:
             bytes: PacketID + Length + Payload + Checksum
         """
-        length = len(payload)
-        checksum = self._calculate_checksum(packet_id, length, payload)
-        return bytes([packet_id, length]) + payload + bytes([checksum])
+        return packet_defs.encode_frame(packet_id, payload)
 
     def _calculate_checksum(self, packet_id: int, length: int, payload: bytes) -> int:
         """
@@ -0,0 +1,276 @@
+"""
+ColumnRingBuffer - 列式环形缓冲区
+一组同时采样的信号共用一块预分配的numpy数组，批量追加，按列返回零拷贝视图
+
+EnvelopeRingBuffer - 带最小/最大值金字塔的环形缓冲区
+追加样本时逐级合并块的最小/最大值，按可见范围和像素数取包络，缩放不需要遍历原始数据
+"""
+
+from typing import Sequence
+
+import numpy as np
+
+
+class ColumnRingBuffer:
+    """
+    列式环形缓冲区
+
+    存储为 (列数, 2×容量) 的float64数组，每行写入两次（位置i与i+容量），
+    因此最近的size个样本在每一列中始终是一段连续内存，
+    view()直接返回切片，不需要拼接或复制。
+
+    Args:
+        capacity: 最大样本数
+        columns: 列名（例如 ["t", "roll", "pitch", "yaw"]）
+    """
+
+    def __init__(self, capacity: int, columns: Sequence[str]):
+        self._capacity = int(capacity)
+        self._columns = {name: i for i, name in enumerate(columns)}
+        self._data = np.zeros((len(self._columns), 2 * self._capacity), dtype=np.float64)
+        self._head = 0  # 下一个样本的写入位置（0..capacity-1）
+        self._size = 0
+
+    @property
+    def capacity(self) -> int:
+        return self._capacity
+
+    @property
+    def columns(self) -> list:
+        return list(self._columns)
+
+    def __len__(self) -> int:
+        return self._size
+
+    def index(self, name: str) -> int:
+        """列名对应的列号"""
+        return self._columns[name]
+
+    def append(self, row: Sequence[float]):
+        """追加一个样本（按列顺序）"""
+        self._data[:, self._head] = row
+        self._data[:, self._head + self._capacity] = row
+        self._head = (self._head + 1) % self._capacity
+        self._size = min(self._size + 1, self._capacity)
+
+    def extend(self, rows: np.ndarray):
+        """
+        批量追加样本
+
+        Args:
+            rows: 形状为 (N, 列数) 的数组，超过容量时只保留最后capacity行
+        """
+        rows = np.asarray(rows, dtype=np.float64)
+        n = rows.shape[0]
+        if n == 0:
+            return
+        if n > self._capacity:
+            rows = rows[-self._capacity :]
+            n = self._capacity
+
+        # 最多分两段写入（跨越缓冲区末尾时回绕），每段同时写两份
+        cols = rows.T
+        first = min(n, self._capacity - self._head)
+        for start, src in ((self._head, cols[:, :first]), (0, cols[:, first:])):
+            count = src.shape[1]
+            if count:
+                self._data[:, start : start + count] = src
+                self._data[:, start + self._capacity : start + self._capacity + count] = src
+
+        self._head = (self._head + n) % self._capacity
+        self._size = min(self._size + n, self._capacity)
+
+    def view(self, name: str) -> np.ndarray:
+        """
+        某一列最近的size个样本（按时间顺序），返回内部数组的只读切片
+
+        下次写入后视图内容可能改变，需要长期保存时由调用方复制
+        """
+        end = self._head + self._capacity
+        column = self._data[self._columns[name], end - self._size : end]
+        column.flags.writeable = False
+        return column
+
+    def view_all(self) -> np.ndarray:
+        """所有列最近的size个样本，形状为 (列数, size) 的只读切片"""
+        end = self._head + self._capacity
+        block = self._data[:, end - self._size : end]
+        block.flags.writeable = False
+        return block
+
+    def last(self, name: str) -> float:
+        """某一列最新的样本"""
+        if self._size == 0:
+            raise IndexError("ring buffer is empty")
+        return float(self._data[self._columns[name], self._head + self._capacity - 1])
+
+    def clear(self):
+        """清空（不释放内存）"""
+        self._head = 0
+        self._size = 0
+
+
+class EnvelopeRingBuffer(ColumnRingBuffer):
+    """
+    带最小/最大值金字塔的列式环形缓冲区
+
+    第k级的每个块覆盖 factor^k 个连续样本，记录块内每列的最小/最大值
+    （NaN不参与比较），每级本身也是环形缓冲区。新样本攒够merge_batch个
+    或调用envelope()时才合并新凑满的块，逐样本追加时不做numpy小数组运算。
+
+    第0列必须是单调递增的时间，envelope()按时间范围取数据：
+    范围内样本不多于max_points时直接返回原始数据的切片，
+    否则选择块数不超过max_points/2的最细一级，每个块输出(最小, 最大)两个点，
+    保留降采样时会被跳过的尖峰。
+
+    Args:
+        capacity: 最大样本数
+        columns: 列名，第0列为时间
+        factor: 相邻两级的块大小之比
+        merge_batch: 攒够多少个新样本合并一次（必须小于capacity）
+    """
+
+    def __init__(self, capacity: int, columns: Sequence[str], factor: int = 4, merge_batch: int = 256):
+        super().__init__(capacity, columns)
+        self._factor = int(factor)
+        self._merge_batch = min(int(merge_batch), self._capacity // 2)
+        self._total = 0  # 自上次clear()以来追加的样本总数（绝对序号）
+        self._merged = 0  # 已合并到金字塔的样本数
+
+        # 每级: (块大小, 最小值缓冲区, 最大值缓冲区)
+        self._levels = []
+        block = self._factor
+        while block < self._capacity:
+            count = self._capacity // block + 2
+            self._levels.append(
+                (block, ColumnRingBuffer(count, columns), ColumnRingBuffer(count, columns))
+            )
+            block *= self._factor
+
+    def append(self, row: Sequence[float]):
+        super().append(row)
+        self._total += 1
+        if self._total - self._merged >= self._merge_batch:
+            self._update_levels()
+
+    def extend(self, rows: np.ndarray):
+        n = len(rows)
+        if n == 0:
+            return
+        super().extend(rows)
+        self._total += n
+        self._update_levels()
+
+    def clear(self):
+        super().clear()
+        self._total = 0
+        self._merged = 0
+        for _, mins, maxs in self._levels:
+            mins.clear()
+            maxs.clear()
+
+    def _update_levels(self):
+        """把新凑满的块逐级合并到金字塔"""
+        old_total, self._merged = self._merged, self._total
+        factor = self._factor
+        lower_min = lower_max = self.view_all()
+        lower_count = self._total  # 下一级已完成的单元总数（第0级为样本）
+
+        for block, mins, maxs in self._levels:
+            before, now = old_total // block, self._total // block
+            if now == before:
+                break
+
+            # 下一级中仍保留的第一个单元的绝对序号
+            available = lower_count - lower_min.shape[1]
+            if before * factor < available:
+                # 一次追加超过容量，旧块已无法合并：从保留的数据中第一个完整的块重新开始，
+                # 之前不足一块的样本由envelope()从原始数据补上
+                before = -(-available // factor)
+                mins.clear()
+                maxs.clear()
+
+            if now > before:
+                start = before * factor - available
+                end = now * factor - available
+                shape = (lower_min.shape[0], now - before, factor)
+                mins.extend(np.fmin.reduce(lower_min[:, start:end].reshape(shape), axis=2).T)
+                maxs.extend(np.fmax.reduce(lower_max[:, start:end].reshape(shape), axis=2).T)
+
+            lower_min, lower_max = mins.view_all(), maxs.view_all()
+            lower_count = now
+
+    def envelope(self, name: str, x0: float, x1: float, max_points: int):
+        """
+        取时间范围 [x0, x1] 内某一列的显示数据
+
+        Args:
+            name: 列名
+            x0, x1: 时间范围（两端各多取一个点，保证曲线连到视图边缘）
+            max_points: 最大输出点数（一般为绘图区宽度的像素数的2倍）
+
+        Returns:
+            tuple: (时间数组, 数值数组)
+        """
+        if self._merged != self._total:
+            self._update_levels()
+
+        times = self.view_all()[0]
+        values = self.view(name)
+        n = len(times)
+        i0 = max(int(np.searchsorted(times, x0, side="left")) - 1, 0)
+        i1 = min(int(np.searchsorted(times, x1, side="right")) + 1, n)
+        if i1 - i0 <= max_points:
+            return times[i0:i1], values[i0:i1]
+
+        # 块数不超过max_points/2的最细一级（没有合适的级别时取最粗一级）
+        span = i1 - i0
+        level = self._levels[-1]
+        for candidate in self._levels:
+            if 2 * span <= candidate[0] * max_points:
+                level = candidate
+                break
+        block, mins, maxs = level
+
+        # 样本的绝对序号 → 块号
+        base = self._total - n
+        a0, a1 = base + i0, base + i1
+        completed = self._total // block
+        j0 = max(a0 // block, completed - len(mins))
+        j1 = max(min(-(-a1 // block), completed), j0)
+        offset = completed - len(mins)
+
+        column = self.index(name)
+        block_min = mins.view_all()[:, j0 - offset : j1 - offset]
+        block_max = maxs.view_all()[column, j0 - offset : j1 - offset]
+        # 跨越淘汰边界的块，时间不早于最早保留的样本
+        block_t = np.maximum(block_min[0], times[0])
+        block_min = block_min[column]
+
+        # 跨越淘汰边界的块包含已淘汰的样本，其最小/最大值只从保留的原始数据计算
+        if j1 > j0 and j0 * block < base:
+            cross = (j0 + 1) * block - base
+            block_min = block_min.copy()
+            block_max = block_max.copy()
+            block_min[0] = np.fmin.reduce(values[:cross])
+            block_max[0] = np.fmax.reduce(values[:cross])
+
+        # 一次追加超过容量后，该级保留的第一个块之前的样本不属于任何块，直接从原始数据计算
+        head = min(offset * block - base, i1)
+        if head > i0:
+            block_t = np.insert(block_t, 0, times[i0])
+            block_min = np.insert(block_min, 0, np.fmin.reduce(values[i0:head]))
+            block_max = np.insert(block_max, 0, np.fmax.reduce(values[i0:head]))
+
+        # 最后一个未凑满的块直接从原始数据计算
+        tail = max(completed * block, a0) - base
+        if tail < i1:
+            block_t = np.append(block_t, times[tail])
+            block_min = np.append(block_min, np.fmin.reduce(values[tail:i1]))
+            block_max = np.append(block_max, np.fmax.reduce(values[tail:i1]))
+
+        x = np.repeat(block_t, 2)
+        y = np.empty(x.size, dtype=np.float64)
+        y[0::2] = block_min
+        y[1::2] = block_max
+        return x, y
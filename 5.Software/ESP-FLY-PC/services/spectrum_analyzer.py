@@ -0,0 +1,250 @@
+"""
+SpectrumAnalyzer - 陀螺仪频谱分析
+在遥测环形缓冲区上增量计算滚动Welch功率谱密度和油门-频率谱图
+
+新数据每凑满半个分段就计算一段（Hann窗、50%重叠），每段只做一次rfft，
+不重复计算已处理的数据，高采样率下也不会阻塞界面
+"""
+
+from typing import Dict, Optional, Tuple
+
+import numpy as np
+
+from .ring_buffer import ColumnRingBuffer
+
+MOTOR_MAX = 65535.0  # 电机PWM上限（throttle按四个电机平均输出/上限计算）
+
+# 角速度环输入与陀螺仪的对应关系（controller_pid.c: gyro.x, -gyro.y, gyro.z）
+AXES = (
+    ("roll", "roll_rate_desired", "gyro_x", 1.0, "roll_control"),
+    ("pitch", "pitch_rate_desired", "gyro_y", -1.0, "pitch_control"),
+    ("yaw", "yaw_rate_desired", "gyro_z", 1.0, "yaw_control"),
+)
+
+# 分析的信号：陀螺仪、D项（跟踪误差的微分，未乘Kd）、角速度PID输出
+SIGNALS = ("gyro", "dterm", "control")
+CHANNELS = tuple(f"{signal}_{axis[0]}" for signal in SIGNALS for axis in AXES)
+
+SEGMENT_SECONDS = 0.5  # 分段时长（按采样率取2的幂点数）
+MIN_SEGMENT = 32
+MAX_SEGMENT = 1024
+AVERAGE_SEGMENTS = 16  # 滚动PSD平均的分段数
+THROTTLE_BINS = 20  # 谱图油门分档数
+RATE_HISTORY = 64  # 估计采样率使用的最近时间戳间隔数
+MAX_STRETCH = 1.05  # 分段实际时长超过标称时长的该倍数（丢帧过多）时跳过该段
+
+
+class SpectrumAnalyzer:
+    """
+    陀螺仪频谱分析器（非线程安全，在GUI线程中使用）
+
+    - extend(block): 追加一批高频数据（WAVEFORM_DTYPE结构化数组）
+    - psd(): 最近AVERAGE_SEGMENTS段的平均功率谱密度（各通道）
+    - spectrogram(channel): 自reset()以来按油门分档的平均功率谱密度
+
+    采样率由飞控时间戳间隔的中位数确定，变化时（重新订阅）自动重新开始。
+    功率谱密度单位为 (信号单位)²/Hz，单边谱。
+    """
+
+    def __init__(self):
+        self._buffer = ColumnRingBuffer(4 * MAX_SEGMENT, ("t_ms", "throttle") + CHANNELS)
+        self._channel_rows = slice(2, 2 + len(CHANNELS))
+        self.reset()
+
+    # ========== Properties ==========
+
+    @property
+    def sample_rate(self) -> Optional[float]:
+        return self._fs
+
+    @property
+    def segment_length(self) -> int:
+        return self._nperseg
+
+    @property
+    def segments(self) -> int:
+        """已计算的分段数（自reset()以来）"""
+        return self._segments
+
+    @property
+    def skipped(self) -> int:
+        """因丢帧跳过的分段数"""
+        return self._skipped
+
+    @property
+    def freqs(self) -> np.ndarray:
+        return self._freqs
+
+    # ========== Public Methods ==========
+
+    def reset(self):
+        """清空所有数据（采样率重新估计）"""
+        self._buffer.clear()
+        self._fs = None
+        self._nominal_ms = None
+        self._nperseg = 0
+        self._freqs = np.zeros(0)
+        self._window = None
+        self._scale = 1.0
+
+        self._last_t = None  # 上一帧的展开时间（ms）
+        self._dt_history = np.zeros(0, dtype=np.int64)
+        self._total = 0  # 追加到缓冲区的样本总数
+        self._next = 0  # 下一分段的起始样本序号
+        self._segments = 0
+        self._skipped = 0
+
+        self._recent = None  # (AVERAGE_SEGMENTS, 通道, 频点) 最近分段的PSD
+        self._recent_sum = None
+        self._recent_count = 0
+        self._bin_sum = None  # (通道, 油门档, 频点)
+        self._bin_count = np.zeros(THROTTLE_BINS, dtype=np.int64)
+
+    def extend(self, block: np.ndarray) -> int:
+        """
+        追加一批高频数据并计算新凑满的分段
+
+        Args:
+            block: WAVEFORM_DTYPE结构化数组（timestamp为uint16毫秒）
+
+        Returns:
+            int: 本次新计算的分段数
+        """
+        if len(block) == 0:
+            return 0
+
+        # 展开uint16时间戳（与上一批最后一帧相接）
+        raw = block["timestamp"].astype(np.int64)
+        first = self._last_t is None
+        previous = int(raw[0]) if first else self._last_t
+        steps = np.diff(raw, prepend=previous & 0xFFFF) & 0xFFFF
+        t_ms = previous + np.cumsum(steps)
+        self._last_t = int(t_ms[-1])
+
+        if not self._update_rate(steps[1:] if first else steps):
+            return 0
+
+        rows = np.empty((len(block), 2 + len(CHANNELS)), dtype=np.float64)
+        rows[:, 0] = t_ms
+        rows[:, 1] = (
+            block["motor1"].astype(np.float64)
+            + block["motor2"]
+            + block["motor3"]
+            + block["motor4"]
+        ) / (4 * MOTOR_MAX)
+        axes = len(AXES)
+        for i, (_, desired, gyro, sign, control) in enumerate(AXES):
+            rows[:, 2 + i] = block[gyro]
+            # D项按跟踪误差计算，在分段内做微分（见_process_segment）
+            rows[:, 2 + axes + i] = block[desired] - sign * block[gyro]
+            rows[:, 2 + 2 * axes + i] = block[control]
+        self._buffer.extend(rows)
+        self._total += len(block)
+
+        # 缓冲区已覆盖未处理的数据时跳到仍在缓冲区中的位置
+        oldest = self._total - len(self._buffer)
+        if self._next < oldest:
+            self._next = oldest
+
+        count = 0
+        hop = self._nperseg // 2
+        while self._total - self._next >= self._nperseg:
+            start = len(self._buffer) - (self._total - self._next)
+            segment = self._buffer.view_all()[:, start : start + self._nperseg]
+            if self._process_segment(segment):
+                count += 1
+            self._next += hop
+        return count
+
+    def psd(self) -> Optional[Dict[str, np.ndarray]]:
+        """最近AVERAGE_SEGMENTS段的平均PSD，通道名 → 数组；尚无分段时返回None"""
+        if not self._recent_count:
+            return None
+        mean = self._recent_sum / self._recent_count
+        return {name: mean[i] for i, name in enumerate(CHANNELS)}
+
+    def spectrogram(self, channel: str) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        按油门分档的平均PSD
+
+        Returns:
+            (matrix, counts): matrix形状为 (THROTTLE_BINS, 频点)，
+            没有数据的油门档为NaN；counts为每档的分段数
+        """
+        if self._bin_sum is None:
+            return np.full((THROTTLE_BINS, 0), np.nan), self._bin_count.copy()
+        with np.errstate(invalid="ignore", divide="ignore"):
+            matrix = self._bin_sum[CHANNELS.index(channel)] / self._bin_count[:, None]
+        matrix[self._bin_count == 0] = np.nan
+        return matrix, self._bin_count.copy()
+
+    # ========== Private Methods ==========
+
+    def _update_rate(self, dt_ms: np.ndarray) -> bool:
+        """
+        按最近RATE_HISTORY个时间戳间隔的中位数确定采样率和分段长度，
+        采样率变化超过25%时（重新订阅）重新开始
+
+        Returns:
+            bool: 采样率是否已确定
+        """
+        self._dt_history = np.concatenate((self._dt_history, dt_ms))[-RATE_HISTORY:]
+        if len(self._dt_history) < RATE_HISTORY // 4:
+            return False
+
+        nominal = max(float(np.median(self._dt_history)), 1.0)
+        if self._nominal_ms is not None and abs(nominal - self._nominal_ms) <= 0.25 * self._nominal_ms:
+            return True
+
+        last_t, history = self._last_t, self._dt_history
+        self.reset()
+        self._last_t, self._dt_history = last_t, history
+        self._nominal_ms = nominal
+        self._fs = 1000.0 / nominal
+        target = self._fs * SEGMENT_SECONDS
+        self._nperseg = int(np.clip(2 ** int(np.ceil(np.log2(max(target, 1)))), MIN_SEGMENT, MAX_SEGMENT))
+        self._freqs = np.fft.rfftfreq(self._nperseg, 1.0 / self._fs)
+        self._window = np.hanning(self._nperseg)
+        # 单边PSD: 2|X|²/(fs·Σw²)（直流与奈奎斯特频点不加倍）
+        self._scale = np.full(len(self._freqs), 2.0 / (self._fs * np.sum(self._window**2)))
+        self._scale[0] /= 2.0
+        if self._nperseg % 2 == 0:
+            self._scale[-1] /= 2.0
+        return True
+
+    def _process_segment(self, segment: np.ndarray) -> bool:
+        """计算一段的PSD，累加到滚动平均和油门谱图；丢帧过多时跳过"""
+        span = segment[0, -1] - segment[0, 0]
+        if span > (self._nperseg - 1) * self._nominal_ms * MAX_STRETCH:
+            self._skipped += 1
+            return False
+
+        data = np.array(segment[self._channel_rows])
+        axes = len(AXES)
+        errors = data[axes : 2 * axes]
+        # 与pid.c相同的后向差分 (error - prevError) / dt
+        data[axes : 2 * axes] = np.diff(errors, axis=1, prepend=errors[:, :1]) * self._fs
+        data -= data.mean(axis=1, keepdims=True)
+        spectrum = np.fft.rfft(data * self._window, axis=1)
+        psd = (spectrum.real**2 + spectrum.imag**2) * self._scale
+
+        if self._recent is None:
+            shape = (len(CHANNELS), len(self._freqs))
+            self._recent = np.zeros((AVERAGE_SEGMENTS,) + shape)
+            self._recent_sum = np.zeros(shape)
+            self._bin_sum = np.zeros((len(CHANNELS), THROTTLE_BINS, len(self._freqs)))
+
+        slot = self._segments % AVERAGE_SEGMENTS
+        self._recent_sum += psd - self._recent[slot]
+        self._recent[slot] = psd
+        if slot == AVERAGE_SEGMENTS - 1:
+            self._recent_sum = self._recent.sum(axis=0)  # 定期重新求和，避免累计误差
+        self._recent_count = min(self._recent_count + 1, AVERAGE_SEGMENTS)
+
+        throttle = float(segment[1].mean())
+        index = min(int(throttle * THROTTLE_BINS), THROTTLE_BINS - 1)
+        self._bin_sum[:, index] += psd
+        self._bin_count[index] += 1
+
+        self._segments += 1
+        return True
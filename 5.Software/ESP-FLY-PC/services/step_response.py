@@ -0,0 +1,160 @@
+"""
+step_response - 从飞行遥测估计角速度环阶跃响应
+把期望角速度和陀螺仪切成重叠窗口，整批做维纳反卷积得到各窗口的脉冲响应，
+积分为阶跃响应后取平均，再计算延迟、上升时间、超调和调节时间
+"""
+
+from typing import Dict, Optional
+
+import numpy as np
+from numpy.lib.stride_tricks import sliding_window_view
+
+from .flight_analysis import RATE_AXES, unwrap_timestamps
+
+WINDOW_SECONDS = 2.0  # 反卷积窗口时长
+WINDOW_HOP = 0.25  # 相邻窗口的间隔（窗口时长的比例，即75%重叠）
+RESPONSE_SECONDS = 0.5  # 输出的阶跃响应时长
+MIN_SETPOINT_DPS = 20.0  # 期望角速度最大值低于此值的窗口（没有操纵）不参与估计
+NOISE_RATIO = 0.01  # 维纳正则项：输入功率谱均值的该比例（相当于信噪比100）
+STEADY_RANGE = (0.5, 2.0)  # 窗口稳态值不在此范围内（拟合失败）时丢弃
+STEADY_START = 0.6  # 稳态值取响应后40%的平均
+SETTLING_BAND = 0.05  # 调节时间的误差带（±5%）
+
+
+def estimate_step_response(setpoint: np.ndarray, gyro: np.ndarray, sample_rate_hz: float) -> Dict:
+    """
+    维纳反卷积估计阶跃响应
+
+    每个窗口: H = Y·X* / (|X|² + λ)，λ = NOISE_RATIO·mean(|X|²)，
+    脉冲响应h = irfft(H)，阶跃响应为h的累加。所有窗口一次rfft/irfft完成。
+
+    Args:
+        setpoint: 等间隔采样的期望角速度（度/秒）
+        gyro: 同时刻的陀螺仪角速度（度/秒，与期望角速度同号）
+        sample_rate_hz: 采样率
+
+    Returns:
+        dict: t（秒）, response（平均阶跃响应，稳态理想为1）, windows（窗口总数）,
+              used（参与平均的窗口数）；数据不足时response为None
+    """
+    n = int(round(WINDOW_SECONDS * sample_rate_hz))
+    length = min(int(round(RESPONSE_SECONDS * sample_rate_hz)), n)
+    t = np.arange(length) / sample_rate_hz
+    result = {"t": t, "response": None, "windows": 0, "used": 0}
+    if len(setpoint) < n or length < 4:
+        return result
+
+    hop = max(int(n * WINDOW_HOP), 1)
+    x = sliding_window_view(np.asarray(setpoint, dtype=np.float64), n)[::hop]
+    y = sliding_window_view(np.asarray(gyro, dtype=np.float64), n)[::hop]
+    result["windows"] = len(x)
+
+    active = np.abs(x).max(axis=1) >= MIN_SETPOINT_DPS
+    x, y = x[active], y[active]
+    if len(x) == 0:
+        return result
+
+    # Hann窗减小截断影响，补零到2n避免循环卷积混叠
+    window = np.hanning(n)
+    X = np.fft.rfft(x * window, 2 * n, axis=1)
+    Y = np.fft.rfft(y * window, 2 * n, axis=1)
+    power = X.real**2 + X.imag**2
+    H = Y * np.conj(X) / (power + NOISE_RATIO * power.mean(axis=1, keepdims=True))
+    steps = np.cumsum(np.fft.irfft(H, 2 * n, axis=1)[:, :length], axis=1)
+
+    steady = steps[:, int(length * STEADY_START) :].mean(axis=1)
+    good = (steady >= STEADY_RANGE[0]) & (steady <= STEADY_RANGE[1])
+    if good.any():
+        result["response"] = steps[good].mean(axis=0)
+        result["used"] = int(good.sum())
+    return result
+
+
+def step_metrics(t: np.ndarray, response: Optional[np.ndarray]) -> Dict[str, Optional[float]]:
+    """
+    阶跃响应指标（与sysid_analysis.analyze_step的定义相同，按稳态值归一化）
+
+    Returns:
+        dict: steady（稳态值）, delay_ms（到10%）, rise_ms（10%→90%）, overshoot_pct,
+              settling_ms（最后一次离开±SETTLING_BAND误差带的时刻）, peak_ms
+    """
+    result = {
+        "steady": None,
+        "delay_ms": None,
+        "rise_ms": None,
+        "overshoot_pct": None,
+        "settling_ms": None,
+        "peak_ms": None,
+    }
+    if response is None or len(response) < 4:
+        return result
+
+    final = float(response[int(len(response) * STEADY_START) :].mean())
+    if final <= 0:
+        return result
+    normalized = response / final
+    dt_ms = float(t[1] - t[0]) * 1000.0
+
+    def first_crossing(level: float) -> Optional[float]:
+        idx = np.nonzero(normalized >= level)[0]
+        if idx.size == 0:
+            return None
+        i = idx[0]
+        if i == 0:
+            return 0.0
+        frac = (level - normalized[i - 1]) / (normalized[i] - normalized[i - 1])
+        return float((i - 1 + frac) * dt_ms)
+
+    t10, t90 = first_crossing(0.1), first_crossing(0.9)
+    outside = np.nonzero(np.abs(normalized - 1.0) > SETTLING_BAND)[0]
+    peak = int(np.argmax(normalized))
+
+    result["steady"] = final
+    result["delay_ms"] = t10
+    result["rise_ms"] = t90 - t10 if t10 is not None and t90 is not None else None
+    result["overshoot_pct"] = float(max(0.0, (normalized[peak] - 1.0) * 100.0))
+    result["peak_ms"] = peak * dt_ms
+    result["settling_ms"] = (outside[-1] + 1) * dt_ms if outside.size else 0.0
+    return result
+
+
+def analyze_axes(timestamp_ms: np.ndarray, setpoints: Dict[str, np.ndarray], gyros: Dict[str, np.ndarray]) -> Dict:
+    """
+    按飞控时间戳重采样到等间隔后，分析三个轴的阶跃响应
+
+    Args:
+        timestamp_ms: 飞控时间戳（uint16毫秒，可回绕）
+        setpoints: 轴名 → 期望角速度
+        gyros: 轴名 → 陀螺仪角速度（已按角速度环的符号对齐）
+
+    Returns:
+        dict: sample_rate_hz, duration_s, axes{轴名: {t, response, windows, used, 各项指标}}
+    """
+    result = {"sample_rate_hz": None, "duration_s": 0.0, "axes": {}}
+    if len(timestamp_ms) < 2:
+        return result
+
+    time_ms = unwrap_timestamps(timestamp_ms)
+    dt = np.diff(time_ms)
+    nominal = max(float(np.median(dt)), 1.0)
+    fs = 1000.0 / nominal
+    grid = np.arange(time_ms[0], time_ms[-1] + nominal / 2, nominal)
+    result["sample_rate_hz"] = fs
+    result["duration_s"] = float(time_ms[-1] - time_ms[0]) / 1000.0
+
+    for axis in setpoints:
+        setpoint = np.interp(grid, time_ms, setpoints[axis])
+        gyro = np.interp(grid, time_ms, gyros[axis])
+        estimate = estimate_step_response(setpoint, gyro, fs)
+        estimate.update(step_metrics(estimate["t"], estimate["response"]))
+        result["axes"][axis] = estimate
+    return result
+
+
+def analyze_high_freq(high_freq: np.ndarray) -> Dict:
+    """分析HIGH_FREQ_DTYPE结构化数组中三个轴的阶跃响应（见analyze_axes）"""
+    return analyze_axes(
+        high_freq["timestamp_ms"],
+        {axis: high_freq[desired] for axis, desired, _, _ in RATE_AXES},
+        {axis: sign * high_freq[gyro].astype(np.float64) for axis, _, gyro, sign in RATE_AXES},
+    )
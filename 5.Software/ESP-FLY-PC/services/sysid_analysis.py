@@ -0,0 +1,156 @@
+"""
+sysid_analysis - 角速度环系统辨识结果分析
+根据飞控上报的频率响应与原始记录估计带宽、延迟和对象增益，并给出角速度环PI增益建议
+"""
+
+import math
+from typing import Dict, List, Optional
+
+import numpy as np
+
+# 对象模型: P(s) = K·e^(-sτ) / s
+# 陀螺仪角速度对内环输出积分（K: 度/秒² 每单位输出），电机/电调/滤波的滞后合并为等效延迟τ
+
+MIN_COHERENCE = 0.6  # 参与拟合的频点的最小相干值
+TARGET_PHASE_MARGIN_DEG = 45.0  # 增益建议的目标相位裕度
+PI_ZERO_RATIO = 5.0  # PI零点 = 穿越频率 / 该比值
+
+
+def analyze_frequency_response(bins: List[dict]) -> Dict[str, float]:
+    """
+    分析扫频得到的频率响应
+
+    Args:
+        bins: SYSID_FRF包的字典列表（freq, closed_gain, closed_phase,
+              plant_gain, plant_phase, coherence）
+
+    Returns:
+        dict: bandwidth_hz（闭环-3dB带宽，None表示测量范围内未跌落），
+              delay_ms（对象等效延迟），plant_k（对象增益K），coherent_bins
+    """
+    bins = sorted(bins, key=lambda b: b["freq"])
+    freq = np.array([b["freq"] for b in bins], dtype=np.float64)
+    closed = np.array([b["closed_gain"] for b in bins], dtype=np.float64)
+    plant_gain = np.array([b["plant_gain"] for b in bins], dtype=np.float64)
+    plant_phase = np.radians([b["plant_phase"] for b in bins])
+    coherence = np.array([b["coherence"] for b in bins], dtype=np.float64)
+
+    good = coherence >= MIN_COHERENCE
+    result = {
+        "bandwidth_hz": None,
+        "delay_ms": None,
+        "plant_k": None,
+        "coherent_bins": int(good.sum()),
+    }
+    if result["coherent_bins"] < 3:
+        return result
+
+    # 闭环带宽: |T|首次低于-3dB处（相邻频点间线性插值）
+    f, g = freq[good], closed[good]
+    below = np.nonzero(g < 1.0 / math.sqrt(2.0))[0]
+    if below.size and below[0] > 0:
+        i = below[0]
+        t = (g[i - 1] - 1.0 / math.sqrt(2.0)) / (g[i - 1] - g[i])
+        result["bandwidth_hz"] = float(f[i - 1] + t * (f[i] - f[i - 1]))
+    elif below.size:
+        result["bandwidth_hz"] = float(f[0])
+
+    # 对象增益: 积分环节下 |P|·ω ≈ K. 高频处电机滞后会压低增益, 只取低频段:
+    # 闭环带宽一半以下的频点, 带宽未知时取最低的四分之一
+    omega = 2.0 * np.pi * freq[good]
+    k = plant_gain[good] * omega
+    if result["bandwidth_hz"] is not None and np.count_nonzero(f <= result["bandwidth_hz"] / 2) >= 2:
+        low = f <= result["bandwidth_hz"] / 2
+    else:
+        low = np.arange(f.size) < max(2, f.size // 4)
+    result["plant_k"] = float(np.median(k[low]))
+
+    # 等效延迟: 去掉积分环节的-90°后, 相位 = -ωτ, 按相干值加权过原点拟合
+    excess = np.unwrap(plant_phase[good]) + np.pi / 2.0
+    excess -= 2.0 * np.pi * np.round(excess[0] / (2.0 * np.pi))
+    w = coherence[good]
+    tau = -np.sum(w * omega * excess) / np.sum(w * omega * omega)
+    result["delay_ms"] = float(max(tau, 0.0) * 1000.0)
+
+    return result
+
+
+def analyze_step(samples: np.ndarray, sample_rate_hz: float) -> Dict[str, Optional[float]]:
+    """
+    分析阶跃激励的时域响应
+
+    Args:
+        samples: N×3数组（期望角速度 度/秒, 陀螺仪 度/秒, 内环输出）
+        sample_rate_hz: 采样率
+
+    Returns:
+        dict: step_dps, delay_ms（到10%）, rise_ms（10%→90%）, overshoot_pct
+    """
+    rate, gyro = samples[:, 0], samples[:, 1]
+    result = {"step_dps": None, "delay_ms": None, "rise_ms": None, "overshoot_pct": None}
+
+    diff = np.diff(rate)
+    if diff.size == 0:
+        return result
+    edge = int(np.argmax(np.abs(diff))) + 1
+    fall = edge + 1 + int(np.argmax(np.abs(diff[edge:]))) if edge < diff.size else rate.size
+    if fall <= edge + 1:
+        fall = rate.size
+
+    before = gyro[max(0, edge - edge // 2) : edge].mean() if edge > 1 else gyro[0]
+    step = rate[edge:fall].mean() - rate[:edge].mean()
+    if abs(step) < 1e-3:
+        return result
+
+    # 响应归一化到0..1, 稳态取阶跃段最后20%的平均值
+    response = (gyro[edge:fall] - before) / step
+    final = response[int(response.size * 0.8) :].mean()
+    dt_ms = 1000.0 / sample_rate_hz
+
+    def first_crossing(level: float) -> Optional[float]:
+        idx = np.nonzero(response >= level * final)[0]
+        if idx.size == 0:
+            return None
+        i = idx[0]
+        if i == 0:
+            return 0.0
+        t = (level * final - response[i - 1]) / (response[i] - response[i - 1])
+        return float((i - 1 + t) * dt_ms)
+
+    t10, t90 = first_crossing(0.1), first_crossing(0.9)
+    result["step_dps"] = float(step)
+    result["delay_ms"] = t10
+    result["rise_ms"] = t90 - t10 if t10 is not None and t90 is not None else None
+    if final > 0:
+        result["overshoot_pct"] = float(max(0.0, (response.max() - final) / final * 100.0))
+    return result
+
+
+def suggest_rate_gains(
+    plant_k: float,
+    delay_ms: float,
+    phase_margin_deg: float = TARGET_PHASE_MARGIN_DEG,
+) -> Optional[Dict[str, float]]:
+    """
+    按积分+延迟对象计算角速度环PI增益
+
+    开环 L = Kp·K·e^(-sτ)/s, 穿越频率 ωc = Kp·K, 相位裕度 = 90° - ωc·τ - PI零点滞后,
+    令其等于目标裕度求ωc, 再取 Kp = ωc/K, Ki = Kp·ωc/PI_ZERO_RATIO.
+
+    Returns:
+        dict: kp, ki, crossover_hz; 参数无效时返回None
+    """
+    if not plant_k or plant_k <= 0 or not delay_ms or delay_ms <= 0:
+        return None
+
+    budget = math.radians(90.0 - phase_margin_deg) - math.atan(1.0 / PI_ZERO_RATIO)
+    if budget <= 0:
+        return None
+
+    omega_c = budget / (delay_ms / 1000.0)
+    kp = omega_c / plant_k
+    return {
+        "kp": kp,
+        "ki": kp * omega_c / PI_ZERO_RATIO,
+        "crossover_hz": omega_c / (2.0 * math.pi),
+    }
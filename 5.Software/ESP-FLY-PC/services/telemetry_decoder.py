@@ -0,0 +1,140 @@
+"""
+TelemetryDecoder - 遥测批量解码
+在网络接收线程中把一批数据报解码为高频数据的numpy结构化数组和其他数据包列表
+"""
+
+import struct
+from dataclasses import dataclass, field
+from typing import List, Sequence, Tuple
+
+import numpy as np
+
+from . import packet_defs
+from .packet_defs import PacketType
+from .protocol_service import ParsedPacket, ProtocolService
+
+# struct格式字符 → numpy类型（小端）
+_NUMPY_TYPES = {
+    "b": "i1",
+    "B": "u1",
+    "h": "<i2",
+    "H": "<u2",
+    "i": "<i4",
+    "I": "<u4",
+    "f": "<f4",
+}
+
+
+def struct_dtype(packer: struct.Struct, fields: Sequence[str]) -> np.dtype:
+    """
+    根据预编译的struct格式生成布局相同的numpy结构化dtype（紧凑排列，无对齐填充）
+
+    Args:
+        packer: packet_defs中的payload结构（如HIGH_FREQ_DATA_STRUCT）
+        fields: 对应的字段名元组
+
+    Returns:
+        np.dtype: itemsize与packer.size相同
+    """
+    types = []
+    count = ""
+    for ch in packer.format.lstrip("<"):
+        if ch.isdigit():
+            count += ch
+            continue
+        types.extend([_NUMPY_TYPES[ch]] * int(count or 1))
+        count = ""
+
+    dtype = np.dtype(list(zip(fields, types)))
+    assert dtype.itemsize == packer.size
+    return dtype
+
+
+# 高频飞行数据，字段与packet_defs.HIGH_FREQ_DATA_FIELDS一致
+HIGH_FREQ_DTYPE = struct_dtype(
+    packet_defs.HIGH_FREQ_DATA_STRUCT, packet_defs.HIGH_FREQ_DATA_FIELDS
+)
+
+
+@dataclass
+class TelemetryBatch:
+    """一批数据报的解码结果（按接收顺序）"""
+
+    high_freq: np.ndarray  # HIGH_FREQ_DTYPE结构化数组，每个元素一帧高频数据
+    packets: List[ParsedPacket] = field(default_factory=list)  # 其他类型的数据包
+    datagrams: int = 0  # 本批数据报数量
+    high_freq_rx_us: np.ndarray = None  # 每帧高频数据所在数据报的接收时刻（us，int64）
+    frames: List[Tuple[int, int, bytes]] = field(default_factory=list)  # 其他数据包的原始帧 (接收时刻us, 类型, payload)，供记录
+
+
+class TelemetryDecoder:
+    """
+    遥测批量解码器
+
+    在NetworkService的接收线程中调用：
+    - 高频数据只做校验和拼接，整批用一次np.frombuffer转为结构化数组，不创建逐帧字典
+    - 其他数据包仍由ProtocolService解码（频率低）
+    - PONG附带接收时刻的上位机时间rx_host_us，不受批量延迟影响
+    - 设置了记录器时，每批解码结果同时交给记录器写入文件
+    """
+
+    def __init__(self, protocol_service: ProtocolService):
+        self._protocol_service = protocol_service
+        self._high_freq_size = HIGH_FREQ_DTYPE.itemsize
+        self._recorder = None
+
+    def set_recorder(self, recorder):
+        """
+        设置记录器（可在接收过程中切换）
+
+        Args:
+            recorder: 提供record(batch)方法的对象（TelemetryRecorder），None停止记录
+        """
+        self._recorder = recorder
+
+    def decode(self, datagrams: List[Tuple[bytes, int]]) -> TelemetryBatch:
+        """
+        解码一批数据报
+
+        Args:
+            datagrams: (数据报, 接收时刻us) 列表，接收时刻为time.perf_counter_ns() // 1000，
+                与LinkHealthViewModel记录发送时刻的时钟相同
+
+        Returns:
+            TelemetryBatch: 解码结果
+        """
+        high_freq = bytearray()
+        rx_times = []
+        packets = []
+        frames = []
+        size = self._high_freq_size
+
+        for data, rx_host_us in datagrams:
+            for packet_id, payload in self._protocol_service.split_datagram(data):
+                if packet_id == PacketType.HIGH_FREQ_DATA:
+                    if len(payload) >= size:
+                        high_freq += payload[:size]
+                        rx_times.append(rx_host_us)
+                    continue
+
+                packet = self._protocol_service.decode_frame(packet_id, payload)
+                if packet is None:
+                    continue
+                if packet.packet_type == PacketType.PONG:
+                    packet.data["rx_host_us"] = rx_host_us
+                packets.append(packet)
+                frames.append((rx_host_us, packet_id, bytes(payload)))
+
+        batch = TelemetryBatch(
+            high_freq=np.frombuffer(bytes(high_freq), dtype=HIGH_FREQ_DTYPE),
+            packets=packets,
+            datagrams=len(datagrams),
+            high_freq_rx_us=np.array(rx_times, dtype=np.int64),
+            frames=frames,
+        )
+
+        # 接收线程中交给记录器（只做拼接，压缩和写盘在记录器的写线程中）
+        recorder = self._recorder
+        if recorder is not None:
+            recorder.record(batch)
+        return batch
@@ -0,0 +1,501 @@
+"""
+TelemetryRecorder - 遥测记录
+把解码后的遥测追加写入列式记录文件（.eflog），按块压缩，带时间索引
+
+TelemetryLog - 遥测记录读取
+内存映射打开记录文件，按时间二分定位，随机读取任意时间段用于回放
+"""
+
+import json
+import mmap
+import os
+import queue
+import struct
+import threading
+import time
+import zlib
+from collections import OrderedDict
+from typing import Dict, List, Optional, Tuple
+
+import numpy as np
+
+from .telemetry_decoder import HIGH_FREQ_DTYPE, TelemetryBatch
+
+# 文件格式（小端）:
+#
+#     文件头:  FILE_HEADER + schema(JSON, utf-8)
+#     数据块:  CHUNK_HEADER + 数据，按写入顺序追加
+#     索引:    INDEX_ENTRY × 块数（正常关闭时写入）
+#     文件尾:  TRAILER
+#
+# schema: {"columns": [[列名, numpy类型], ...], "start_epoch_us": 记录开始的系统时间}
+# 第0列固定为t_us（int64，相对记录开始的上位机接收时刻，单调不减），其余为高频数据字段。
+#
+# 高频数据块(KIND_HIGH_FREQ): count行，按列存储——每列count个元素连续排列，列顺序同schema；
+# 事件块(KIND_EVENTS): count个 EVENT_HEADER + payload，保存高频数据以外的原始数据包。
+# codec为CODEC_ZLIB时整块数据用zlib压缩；CODEC_SHUFFLE_ZLIB（只用于高频数据块）先把每列
+# 按字节重排（所有元素的第0字节、第1字节……依次排列），缓变信号的高位字节连成一片，压缩率更高；
+# 未压缩的高频数据块可直接从内存映射零拷贝读取。
+#
+# 没有文件尾（程序异常退出）时顺序扫描块头重建索引，最后一个不完整的块被忽略。
+
+MAGIC = b"ESPFLYLG"
+VERSION = 1
+FILE_HEADER = struct.Struct("<8sHHI")  # magic, version, reserved, schema长度
+CHUNK_HEADER = struct.Struct("<4sBBHIIqq")  # tag, kind, codec, reserved, count, 数据长度, 首/末行t_us
+EVENT_HEADER = struct.Struct("<qBH")  # t_us, 数据包类型, payload长度
+INDEX_ENTRY = struct.Struct("<QqqIB3x")  # 块头偏移, 首/末行t_us, count, kind
+TRAILER = struct.Struct("<QI8s")  # 索引偏移, 块数, 结束标记
+
+CHUNK_TAG = b"CHNK"
+TRAILER_MAGIC = b"EFLGEND\0"
+
+KIND_HIGH_FREQ = 0
+KIND_EVENTS = 1
+
+CODEC_RAW = 0
+CODEC_ZLIB = 1
+CODEC_SHUFFLE_ZLIB = 2
+
+FILE_EXTENSION = ".eflog"
+
+
+def _shuffle_columns(data: bytes, itemsizes: List[int], count: int, inverse: bool = False) -> bytes:
+    """按列字节重排（inverse=True时还原）"""
+    parts, pos = [], 0
+    for itemsize in itemsizes:
+        column = np.frombuffer(data, dtype=np.uint8, count=count * itemsize, offset=pos)
+        shape = (itemsize, count) if inverse else (count, itemsize)
+        parts.append(column.reshape(shape).T.tobytes())
+        pos += count * itemsize
+    return b"".join(parts)
+
+
+class TelemetryRecorder:
+    """
+    遥测记录器
+
+    record()在网络接收线程中调用，只把每批数据追加到待写列表；
+    攒够chunk_records行或距上次写出超过flush_interval秒时整理成一个块，
+    交给写线程压缩并写盘，接收线程不做压缩和文件IO。
+
+    Args:
+        path: 记录文件路径（已存在时覆盖）
+        chunk_records: 每个高频数据块的行数
+        flush_interval: 最长写出间隔（秒），异常退出时最多丢失这段时间的数据
+        compress: 是否按块zlib压缩
+    """
+
+    ZLIB_LEVEL = 1  # 记录时优先速度
+
+    def __init__(
+        self,
+        path: str,
+        chunk_records: int = 4096,
+        flush_interval: float = 2.0,
+        compress: bool = True,
+    ):
+        self._path = path
+        self._chunk_records = chunk_records
+        self._flush_interval = flush_interval
+        self._compress = compress
+
+        self._columns = [("t_us", "<i8")] + [
+            (name, HIGH_FREQ_DTYPE.fields[name][0].str) for name in HIGH_FREQ_DTYPE.names
+        ]
+        self._itemsizes = [np.dtype(dtype).itemsize for _, dtype in self._columns]
+        self._start_us = None  # 第一次record时的接收时刻（perf_counter，us）
+        self._start_epoch_us = time.time_ns() // 1000
+
+        # 待写数据（接收线程）
+        self._lock = threading.Lock()
+        self._pending_t: List[np.ndarray] = []
+        self._pending_hf: List[np.ndarray] = []
+        self._pending_count = 0
+        self._pending_events: List[Tuple[int, int, bytes]] = []
+        self._last_flush = time.monotonic()
+
+        # 写线程
+        self._file = None
+        self._queue: "queue.Queue" = queue.Queue()
+        self._thread: Optional[threading.Thread] = None
+        self._index: List[Tuple[int, int, int, int, int]] = []
+
+        # 统计（写线程更新）
+        self._records = 0
+        self._events = 0
+        self._raw_bytes = 0
+        self._file_bytes = 0
+
+    # ========== Properties ==========
+
+    @property
+    def path(self) -> str:
+        return self._path
+
+    @property
+    def is_open(self) -> bool:
+        return self._file is not None
+
+    def get_stats(self) -> Dict[str, float]:
+        """已写入的行数、事件数、文件大小和压缩比"""
+        return {
+            "records": self._records,
+            "events": self._events,
+            "file_bytes": self._file_bytes,
+            "ratio": self._raw_bytes / self._file_bytes if self._file_bytes else 1.0,
+        }
+
+    # ========== 公共接口 ==========
+
+    def open(self):
+        """创建文件、写入文件头并启动写线程"""
+        directory = os.path.dirname(self._path)
+        if directory:
+            os.makedirs(directory, exist_ok=True)
+
+        schema = json.dumps(
+            {"columns": self._columns, "start_epoch_us": self._start_epoch_us}
+        ).encode("utf-8")
+        self._file = open(self._path, "wb")
+        self._file.write(FILE_HEADER.pack(MAGIC, VERSION, 0, len(schema)))
+        self._file.write(schema)
+        self._file_bytes = self._file.tell()
+
+        self._thread = threading.Thread(target=self._write_loop, daemon=True)
+        self._thread.start()
+
+    def record(self, batch: TelemetryBatch):
+        """
+        追加一批解码结果（接收线程调用）
+
+        Args:
+            batch: TelemetryDecoder.decode()的结果，需带high_freq_rx_us和frames
+        """
+        if self._file is None:
+            return
+
+        with self._lock:
+            if self._start_us is None:
+                first = [int(batch.high_freq_rx_us[0])] if len(batch.high_freq) else []
+                first += [frame[0] for frame in batch.frames[:1]]
+                if not first:
+                    return
+                self._start_us = min(first)
+
+            if len(batch.high_freq):
+                self._pending_t.append(batch.high_freq_rx_us - self._start_us)
+                self._pending_hf.append(batch.high_freq)
+                self._pending_count += len(batch.high_freq)
+            for rx_us, packet_id, payload in batch.frames:
+                self._pending_events.append((rx_us - self._start_us, packet_id, payload))
+
+            if (
+                self._pending_count >= self._chunk_records
+                or time.monotonic() - self._last_flush >= self._flush_interval
+            ):
+                self._flush_locked()
+
+    def close(self):
+        """写出剩余数据、索引和文件尾，关闭文件"""
+        if self._file is None:
+            return
+        with self._lock:
+            self._flush_locked()
+        self._queue.put(None)
+        self._thread.join()
+
+        index_offset = self._file.tell()
+        for entry in self._index:
+            self._file.write(INDEX_ENTRY.pack(*entry))
+        self._file.write(TRAILER.pack(index_offset, len(self._index), TRAILER_MAGIC))
+        self._file.close()
+        self._file = None
+
+    # ========== Private Methods ==========
+
+    def _flush_locked(self):
+        """把待写数据整理成块交给写线程（调用方持有_lock）"""
+        self._last_flush = time.monotonic()
+
+        if self._pending_count:
+            t_us = np.concatenate(self._pending_t)
+            high_freq = np.concatenate(self._pending_hf)
+            # 按列拼接: t_us列在前，其余列顺序同HIGH_FREQ_DTYPE
+            data = t_us.tobytes() + b"".join(
+                np.ascontiguousarray(high_freq[name]).tobytes() for name in HIGH_FREQ_DTYPE.names
+            )
+            self._queue.put(
+                (KIND_HIGH_FREQ, len(t_us), int(t_us[0]), int(t_us[-1]), data)
+            )
+            self._pending_t, self._pending_hf, self._pending_count = [], [], 0
+
+        if self._pending_events:
+            events = self._pending_events
+            data = b"".join(
+                EVENT_HEADER.pack(t_us, packet_id, len(payload)) + payload
+                for t_us, packet_id, payload in events
+            )
+            self._queue.put((KIND_EVENTS, len(events), events[0][0], events[-1][0], data))
+            self._pending_events = []
+
+    def _write_loop(self):
+        """写线程: 压缩并追加数据块"""
+        while True:
+            item = self._queue.get()
+            if item is None:
+                break
+
+            kind, count, t_first, t_last, data = item
+            raw_size = len(data)
+            codec = CODEC_RAW
+            if self._compress:
+                if kind == KIND_HIGH_FREQ:
+                    compressed = zlib.compress(
+                        _shuffle_columns(data, self._itemsizes, count), self.ZLIB_LEVEL
+                    )
+                    packed_codec = CODEC_SHUFFLE_ZLIB
+                else:
+                    compressed = zlib.compress(data, self.ZLIB_LEVEL)
+                    packed_codec = CODEC_ZLIB
+                if len(compressed) < raw_size:
+                    codec, data = packed_codec, compressed
+
+            offset = self._file.tell()
+            self._file.write(
+                CHUNK_HEADER.pack(CHUNK_TAG, kind, codec, 0, count, len(data), t_first, t_last)
+            )
+            self._file.write(data)
+            self._file.flush()
+            self._index.append((offset, t_first, t_last, count, kind))
+
+            if kind == KIND_HIGH_FREQ:
+                self._records += count
+            else:
+                self._events += count
+            self._raw_bytes += CHUNK_HEADER.size + raw_size
+            self._file_bytes = self._file.tell()
+
+
+class TelemetryLog:
+    """
+    遥测记录读取
+
+    打开时只读取文件头和块索引（每块一项），数据按需解码:
+    - 时间定位: 先在各块的末行时间上二分找到块，再在块内t_us列上二分
+    - 未压缩的块直接从内存映射零拷贝取列，压缩块解压（并还原字节重排）后缓存最近CACHE_CHUNKS个
+
+    Args:
+        path: 记录文件路径
+    """
+
+    CACHE_CHUNKS = 16
+
+    def __init__(self, path: str):
+        self._path = path
+        self._file = open(path, "rb")
+        try:
+            self._mmap = mmap.mmap(self._file.fileno(), 0, access=mmap.ACCESS_READ)
+        except ValueError:
+            self._file.close()
+            raise ValueError("记录文件为空")
+
+        try:
+            self._read_header()
+            entries = self._read_index() or self._scan_chunks()
+        except Exception:
+            self.close()
+            raise
+
+        # 按类型拆分索引: 块头偏移、首/末行时间、行数前缀和
+        self._chunks = {}
+        for kind in (KIND_HIGH_FREQ, KIND_EVENTS):
+            rows = [e for e in entries if e[4] == kind]
+            counts = np.array([e[3] for e in rows], dtype=np.int64)
+            self._chunks[kind] = {
+                "offset": [e[0] for e in rows],
+                "first": np.array([e[1] for e in rows], dtype=np.int64),
+                "last": np.array([e[2] for e in rows], dtype=np.int64),
+                "start": np.concatenate(([0], np.cumsum(counts))),
+            }
+        self._cache: "OrderedDict[Tuple[int, int], object]" = OrderedDict()
+
+    # ========== Properties ==========
+
+    @property
+    def path(self) -> str:
+        return self._path
+
+    @property
+    def start_epoch_us(self) -> int:
+        """记录开始时的系统时间（us）"""
+        return self._start_epoch_us
+
+    @property
+    def record_count(self) -> int:
+        """高频数据总行数"""
+        return int(self._chunks[KIND_HIGH_FREQ]["start"][-1])
+
+    @property
+    def duration_us(self) -> int:
+        """记录时长（us，最后一行的t_us）"""
+        last = [int(c["last"][-1]) for c in self._chunks.values() if len(c["last"])]
+        return max(last) if last else 0
+
+    # ========== 公共接口 ==========
+
+    def index_at(self, t_us: int) -> int:
+        """t_us之前（不含）的高频数据行数"""
+        chunks = self._chunks[KIND_HIGH_FREQ]
+        c = int(np.searchsorted(chunks["last"], t_us, side="left"))
+        if c >= len(chunks["offset"]):
+            return self.record_count
+        column = self._high_freq_chunk(c)["t_us"]
+        return int(chunks["start"][c]) + int(np.searchsorted(column, t_us, side="left"))
+
+    def read_rows(self, i0: int, i1: int) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        读取第[i0, i1)行高频数据
+
+        Returns:
+            tuple: (t_us数组, HIGH_FREQ_DTYPE结构化数组)；
+            记录文件中没有的字段（旧版本记录）填0
+        """
+        chunks = self._chunks[KIND_HIGH_FREQ]
+        i0 = max(0, i0)
+        i1 = min(i1, self.record_count)
+        t_us = np.empty(max(i1 - i0, 0), dtype=np.int64)
+        high_freq = np.zeros(len(t_us), dtype=HIGH_FREQ_DTYPE)
+        if i1 <= i0:
+            return t_us, high_freq
+
+        c0 = int(np.searchsorted(chunks["start"], i0, side="right")) - 1
+        c1 = int(np.searchsorted(chunks["start"], i1, side="left"))
+        names = [name for name in HIGH_FREQ_DTYPE.names if name in self._column_types]
+        pos = 0
+        for c in range(c0, c1):
+            columns = self._high_freq_chunk(c)
+            start = int(chunks["start"][c])
+            a, b = max(i0, start) - start, min(i1, int(chunks["start"][c + 1])) - start
+            t_us[pos : pos + b - a] = columns["t_us"][a:b]
+            for name in names:
+                high_freq[name][pos : pos + b - a] = columns[name][a:b]
+            pos += b - a
+        return t_us, high_freq
+
+    def read(self, t0_us: int, t1_us: int) -> Tuple[np.ndarray, np.ndarray]:
+        """读取时间范围[t0_us, t1_us)内的高频数据"""
+        return self.read_rows(self.index_at(t0_us), self.index_at(t1_us))
+
+    def events(self, t0_us: int, t1_us: int) -> List[Tuple[int, int, bytes]]:
+        """读取时间范围[t0_us, t1_us)内的其他数据包 (t_us, 类型, payload)"""
+        chunks = self._chunks[KIND_EVENTS]
+        c0 = int(np.searchsorted(chunks["last"], t0_us, side="left"))
+        c1 = int(np.searchsorted(chunks["first"], t1_us, side="left"))
+        result = []
+        for c in range(c0, c1):
+            result.extend(e for e in self._event_chunk(c) if t0_us <= e[0] < t1_us)
+        return result
+
+    def close(self):
+        self._cache = OrderedDict()
+        if self._mmap is not None:
+            self._mmap.close()
+            self._mmap = None
+        self._file.close()
+
+    # ========== Private Methods ==========
+
+    def _read_header(self):
+        magic, version, _, schema_len = FILE_HEADER.unpack_from(self._mmap, 0)
+        if magic != MAGIC:
+            raise ValueError("不是ESP-FLY遥测记录文件")
+        if version > VERSION:
+            raise ValueError(f"不支持的记录文件版本: {version}")
+
+        schema = json.loads(
+            bytes(self._mmap[FILE_HEADER.size : FILE_HEADER.size + schema_len]).decode("utf-8")
+        )
+        self._columns = [(name, np.dtype(dtype)) for name, dtype in schema["columns"]]
+        self._itemsizes = [dtype.itemsize for _, dtype in self._columns]
+        self._column_types = dict(self._columns)
+        self._start_epoch_us = schema.get("start_epoch_us", 0)
+        self._data_offset = FILE_HEADER.size + schema_len
+
+    def _read_index(self) -> Optional[list]:
+        """读取文件尾的块索引，没有文件尾时返回None"""
+        size = len(self._mmap)
+        if size < self._data_offset + TRAILER.size:
+            return None
+        index_offset, count, magic = TRAILER.unpack_from(self._mmap, size - TRAILER.size)
+        if magic != TRAILER_MAGIC or index_offset + count * INDEX_ENTRY.size != size - TRAILER.size:
+            return None
+        return [
+            INDEX_ENTRY.unpack_from(self._mmap, index_offset + i * INDEX_ENTRY.size)
+            for i in range(count)
+        ]
+
+    def _scan_chunks(self) -> list:
+        """顺序扫描块头重建索引（异常退出的记录文件）"""
+        entries = []
+        offset, size = self._data_offset, len(self._mmap)
+        while offset + CHUNK_HEADER.size <= size:
+            tag, kind, _, _, count, length, t_first, t_last = CHUNK_HEADER.unpack_from(
+                self._mmap, offset
+            )
+            if tag != CHUNK_TAG or offset + CHUNK_HEADER.size + length > size:
+                break
+            entries.append((offset, t_first, t_last, count, kind))
+            offset += CHUNK_HEADER.size + length
+        return entries
+
+    def _chunk_data(self, offset: int):
+        """块数据: 未压缩时为内存映射上的memoryview，否则为解压后的bytes"""
+        _, kind, codec, _, count, length, _, _ = CHUNK_HEADER.unpack_from(self._mmap, offset)
+        start = offset + CHUNK_HEADER.size
+        data = memoryview(self._mmap)[start : start + length]
+        if codec == CODEC_ZLIB:
+            data = zlib.decompress(data)
+        elif codec == CODEC_SHUFFLE_ZLIB:
+            data = _shuffle_columns(zlib.decompress(data), self._itemsizes, count, inverse=True)
+        return count, data
+
+    def _cached(self, kind: int, c: int, build):
+        key = (kind, c)
+        value = self._cache.get(key)
+        if value is None:
+            value = build(self._chunks[kind]["offset"][c])
+            self._cache[key] = value
+            if len(self._cache) > self.CACHE_CHUNKS:
+                self._cache.popitem(last=False)
+        else:
+            self._cache.move_to_end(key)
+        return value
+
+    def _high_freq_chunk(self, c: int) -> Dict[str, np.ndarray]:
+        """第c个高频数据块的各列（只读数组）"""
+
+        def build(offset):
+            count, data = self._chunk_data(offset)
+            columns, pos = {}, 0
+            for name, dtype in self._columns:
+                columns[name] = np.frombuffer(data, dtype=dtype, count=count, offset=pos)
+                pos += count * dtype.itemsize
+            return columns
+
+        return self._cached(KIND_HIGH_FREQ, c, build)
+
+    def _event_chunk(self, c: int) -> List[Tuple[int, int, bytes]]:
+        """第c个事件块中的数据包"""
+
+        def build(offset):
+            count, data = self._chunk_data(offset)
+            events, pos = [], 0
+            for _ in range(count):
+                t_us, packet_id, length = EVENT_HEADER.unpack_from(data, pos)
+                pos += EVENT_HEADER.size
+                events.append((t_us, packet_id, bytes(data[pos : pos + length])))
+                pos += length
+            return events
+
+        return self._cached(KIND_EVENTS, c, build)
@@ -0,0 +1,111 @@
+"""
+EnvelopeRingBuffer 回归测试
+包络必须覆盖可见范围内保留的全部原始样本（最小/最大值与原始数据一致），
+且时间不早于最早保留的样本
+
+运行: python -m unittest discover tests
+"""
+
+import os
+import sys
+import unittest
+
+import numpy as np
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), ".."))
+
+from services.ring_buffer import EnvelopeRingBuffer  # noqa: E402
+
+COLUMNS = ("t", "v")
+
+
+def make_rows(t0: int, n: int, rng=None) -> np.ndarray:
+    """时间为t0, t0+1, ...的n行，数值为随机数（rng为None时为0）"""
+    rows = np.zeros((n, 2))
+    rows[:, 0] = np.arange(t0, t0 + n)
+    if rng is not None:
+        rows[:, 1] = rng.standard_normal(n)
+    return rows
+
+
+class EnvelopeRingBufferTest(unittest.TestCase):
+    def assert_envelope_covers(self, buf: EnvelopeRingBuffer, x0: float, x1: float, max_points: int):
+        times = buf.view("t")
+        values = buf.view("v")
+        x, y = buf.envelope("v", x0, x1, max_points)
+
+        i0 = max(int(np.searchsorted(times, x0, side="left")) - 1, 0)
+        i1 = min(int(np.searchsorted(times, x1, side="right")) + 1, len(times))
+        self.assertGreaterEqual(x[0], times[0])
+        self.assertTrue(np.all(np.diff(x) >= 0))
+        self.assertLessEqual(x[0], times[i0])
+        # 包络的块可以超出可见范围，但不能漏掉范围内的样本
+        self.assertLessEqual(np.nanmin(y), np.nanmin(values[i0:i1]))
+        self.assertGreaterEqual(np.nanmax(y), np.nanmax(values[i0:i1]))
+        # 也不能包含已淘汰的样本
+        self.assertGreaterEqual(np.nanmin(y), np.nanmin(values))
+        self.assertLessEqual(np.nanmax(y), np.nanmax(values))
+        return x, y
+
+    def test_oversize_extend_keeps_head(self):
+        buf = EnvelopeRingBuffer(1000, COLUMNS)
+        buf.extend(make_rows(1, 50))
+        rows = make_rows(51, 1007)
+        spike = (rows[:, 0] >= 58) & (rows[:, 0] <= 256)
+        rows[spike, 1] = 10.0
+        buf.extend(rows)
+
+        self.assertEqual(buf.view("t")[0], 58)
+        for max_points in (8, 20, 64, 200):
+            x, y = self.assert_envelope_covers(buf, 0, 2000, max_points)
+            self.assertEqual(x[0], 58)
+            self.assertEqual(y.max(), 10.0)
+
+    def test_evicted_spike_leaves_boundary_block(self):
+        buf = EnvelopeRingBuffer(1000, COLUMNS)
+        rows = make_rows(0, 1000)
+        rows[10, 1] = 99.0
+        buf.extend(rows)
+        for row in make_rows(1000, 20):
+            buf.append(row)
+
+        self.assertEqual(buf.view("v").max(), 0.0)
+        for max_points in (8, 20, 100, 200):
+            x, y = self.assert_envelope_covers(buf, -np.inf, np.inf, max_points)
+            self.assertEqual(y.max(), 0.0)
+            self.assertEqual(x[0], 20)
+
+    def test_oversize_extend_on_empty_and_full_buffer(self):
+        rng = np.random.default_rng(1)
+        for before in (0, 999, 1000, 1500):
+            buf = EnvelopeRingBuffer(1000, COLUMNS)
+            if before:
+                buf.extend(make_rows(0, before, rng))
+            buf.extend(make_rows(before, 2345, rng))
+            for max_points in (8, 30, 100):
+                self.assert_envelope_covers(buf, -1, 1e9, max_points)
+
+    def test_wraparound(self):
+        rng = np.random.default_rng(2)
+        buf = EnvelopeRingBuffer(1000, COLUMNS, merge_batch=100)
+        t = 0
+        for step in range(300):
+            # 交替逐个追加和批量追加，覆盖各级环形缓冲区的多次回绕
+            n = int(rng.integers(1, 60))
+            rows = make_rows(t, n, rng)
+            if step % 3 == 0:
+                for row in rows:
+                    buf.append(row)
+            else:
+                buf.extend(rows)
+            t += n
+
+            times = buf.view("t")
+            x0 = times[int(rng.integers(0, len(times)))]
+            x1 = x0 + float(rng.integers(1, 1200))
+            self.assert_envelope_covers(buf, x0, x1, int(rng.integers(4, 80)))
+            self.assert_envelope_covers(buf, -1, 1e9, 16)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,647 @@
+#!/usr/bin/env python3
+"""
+drone_emulator - 飞控模拟器
+
+不接飞机即可运行上位机，并可把高频数据提高到固件50Hz以上做压力测试:
+- 与wifi_esp32.c相同的端口: 监听2390接收命令，向客户端的2399端口发送遥测
+  (按IP登记客户端，3秒无数据注销；无客户端时广播)
+- 与固件相同的协议行为: 心跳响应、订阅分频、PING/PONG、收到v2数据报后按v2发送
+- 合成姿态/陀螺仪/加速度计/控制量/电机数据 (简单一阶姿态模型跟随飞行控制命令)，
+  1Hz发送电池状态与PID参数，收到的命令以控制台日志回显
+- 可配置高频数据速率和下行丢包率
+- 基准模式: 在本进程中运行上位机接收链路 (NetworkService → TelemetryDecoder →
+  DroneViewModel → WaveformView)，逐档测量端到端延迟、丢帧和界面卡顿
+
+用法:
+    python tools/drone_emulator.py                        # 50Hz，与飞控相同
+    python tools/drone_emulator.py --hf-rate 500 --loss 0.05
+    python tools/drone_emulator.py --bench 50,100,200,500,1000 --bench-duration 5
+
+上位机连接模拟器: 在config.ini中设置 [network] drone_ip = 127.0.0.1
+"""
+
+import argparse
+import math
+import os
+import random
+import socket
+import sys
+import threading
+import time
+from typing import Dict, List, Optional
+
+PC_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+sys.path.insert(0, PC_DIR)
+
+from models.pid_config_model import PidConfigModel  # noqa: E402
+from services import packet_defs  # noqa: E402
+from services.packet_defs import PacketType  # noqa: E402
+from services.protocol_service import ProtocolService  # noqa: E402
+
+SERVER_PORT = 2390  # wifi_esp32.c UDP_SERVER_PORT
+CLIENT_PORT = 2399  # wifi_esp32.c UDP_BROADCAST_PORT
+MAX_CLIENTS = 4  # TRANSPORT_MAX_CLIENTS
+CLIENT_TIMEOUT = 3.0  # WIFI_CLIENT_TIMEOUT_MS
+V2_TIMEOUT = 3.0  # PROTOCOL_V2_TIMEOUT
+FIRMWARE_HF_RATE = 50  # 固件高频数据速率
+BUFFER_SIZE = 256
+
+GRAVITY = 9.81
+ATTITUDE_TAU = 0.15  # 姿态跟随命令的时间常数（秒）
+
+
+class _Client:
+    """一个已登记的客户端（与固件客户端注册表对应）"""
+
+    def __init__(self, ip: str, now: float):
+        self.ip = ip
+        self.last_seen = now
+        self.protocol = ProtocolService()  # 每个客户端独立的v2序号
+        self.last_v2 = None  # 最近一次收到v2数据报的时刻
+        self.divider = 1  # 高频数据分频
+        self.ping_expected = None
+        self.ping_lost = 0
+        self.jitter_us = 0.0
+        self.last_transit = None
+
+    def version(self, now: float) -> int:
+        if self.last_v2 is not None and now - self.last_v2 <= V2_TIMEOUT:
+            return ProtocolService.V2_VERSION
+        return 1
+
+
+class DroneEmulator:
+    """
+    飞控模拟器
+
+    接收线程处理命令，发送线程按高频速率合成并发送遥测。
+
+    Args:
+        bind: 监听地址
+        port: 命令端口
+        client_port: 客户端接收遥测的端口
+        hf_rate: 高频数据速率（Hz）
+        loss: 下行数据报丢弃概率（0~1）
+        echo: 是否以控制台日志回显收到的命令
+        broadcast: 无客户端时的广播地址
+        seed: 随机数种子（噪声与丢包可复现）
+    """
+
+    def __init__(
+        self,
+        bind: str = "0.0.0.0",
+        port: int = SERVER_PORT,
+        client_port: int = CLIENT_PORT,
+        hf_rate: float = FIRMWARE_HF_RATE,
+        loss: float = 0.0,
+        echo: bool = True,
+        broadcast: str = "255.255.255.255",
+        seed: Optional[int] = None,
+    ):
+        self._bind = (bind, port)
+        self._client_port = client_port
+        self._hf_rate = float(hf_rate)
+        self._loss = float(loss)
+        self._echo = echo
+        self._broadcast = broadcast
+
+        self._socket: Optional[socket.socket] = None
+        self._running = False
+        self._threads: List[threading.Thread] = []
+        self._lock = threading.Lock()
+        self._clients: Dict[str, _Client] = {}
+        self._random = random.Random(seed)
+
+        # 模拟时钟: 时间戳 = 自启动以来的毫秒数低16位（与固件相同）
+        self.epoch = time.perf_counter()
+
+        # 飞行状态
+        self._setpoint = [0.0, 0.0, 0.0]  # roll, pitch, yaw（度）
+        self._thrust = 0
+        self._attitude = [0.0, 0.0, 0.0]
+        self._motor_test: Optional[List[int]] = None
+        self._pid = self._default_pid()
+        self._battery_mv = 4150.0
+
+        # 统计
+        self.hf_frames = 0  # 已生成的高频帧
+        self.hf_sent = 0  # 实际交给socket的高频帧（每个目标各计一次，不含按丢包率丢弃的）
+        self.sent_datagrams = 0
+        self.dropped_datagrams = 0
+
+    # ========== 公共接口 ==========
+
+    @property
+    def hf_rate(self) -> float:
+        return self._hf_rate
+
+    @property
+    def client_count(self) -> int:
+        return len(self._clients)
+
+    def set_hf_rate(self, hz: float):
+        """修改高频数据速率（运行中生效）"""
+        with self._lock:
+            self._hf_rate = float(hz)
+
+    def reset_stats(self):
+        with self._lock:
+            self.hf_frames = 0
+            self.hf_sent = 0
+            self.sent_datagrams = 0
+            self.dropped_datagrams = 0
+
+    def start(self):
+        self._socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self._socket.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        self._socket.setsockopt(socket.SOL_SOCKET, socket.SO_BROADCAST, 1)
+        self._socket.bind(self._bind)
+        self._socket.settimeout(0.1)
+
+        self._running = True
+        self._threads = [
+            threading.Thread(target=self._receive_loop, daemon=True),
+            threading.Thread(target=self._send_loop, daemon=True),
+        ]
+        for thread in self._threads:
+            thread.start()
+        print(
+            f"[Emulator] 监听 {self._bind[0]}:{self._bind[1]}，遥测发往客户端:{self._client_port}，"
+            f"高频 {self._hf_rate:g}Hz，丢包率 {self._loss:.1%}"
+        )
+
+    def stop(self):
+        self._running = False
+        for thread in self._threads:
+            thread.join(timeout=1.0)
+        if self._socket:
+            self._socket.close()
+            self._socket = None
+
+    def now_ms(self) -> float:
+        """模拟时钟（毫秒），与高频数据时间戳同源"""
+        return (time.perf_counter() - self.epoch) * 1000.0
+
+    # ========== 接收 ==========
+
+    def _receive_loop(self):
+        while self._running:
+            try:
+                data, addr = self._socket.recvfrom(BUFFER_SIZE)
+            except socket.timeout:
+                continue
+            except OSError:
+                break
+
+            if len(data) > ProtocolService.V2_MAX_DATAGRAM:
+                # 与飞控UDP接收端一致，超长数据报直接丢弃
+                continue
+
+            rx_us = int(self.now_ms() * 1000) & 0xFFFFFFFF
+            now = time.monotonic()
+            with self._lock:
+                client = self._touch_client(addr[0], now)
+                if client is None:
+                    continue
+                if (
+                    len(data) > 2
+                    and data[0] == ProtocolService.V2_MAGIC
+                    and data[1] == ProtocolService.V2_VERSION
+                ):
+                    client.last_v2 = now
+                frames = client.protocol.split_datagram(data)
+
+            for packet_id, payload in frames:
+                self._handle_frame(client, packet_id, payload, rx_us)
+
+    def _touch_client(self, ip: str, now: float) -> Optional[_Client]:
+        """按IP登记/刷新客户端，超时的客户端先注销"""
+        for key in [k for k, c in self._clients.items() if now - c.last_seen > CLIENT_TIMEOUT]:
+            print(f"[Emulator] 客户端 {key} 超时注销")
+            del self._clients[key]
+
+        client = self._clients.get(ip)
+        if client is None:
+            if len(self._clients) >= MAX_CLIENTS:
+                return None
+            client = self._clients[ip] = _Client(ip, now)
+            print(f"[Emulator] 客户端 {ip} 登记")
+        client.last_seen = now
+        return client
+
+    def _handle_frame(self, client: _Client, packet_id: int, payload: bytes, rx_us: int):
+        data = packet_defs.decode_payload(packet_id, payload)
+
+        if packet_id == PacketType.HEARTBEAT:
+            self._send_to(client, [packet_defs.encode_heartbeat_resp()])
+        elif packet_id == PacketType.SUBSCRIBE and data:
+            rate = data["hf_rate_hz"]
+            with self._lock:
+                client.divider = max(1, int(self._hf_rate // rate)) if 0 < rate < self._hf_rate else 1
+            self._log(client, f"[SUB] HF rate {self._hf_rate / client.divider:g}Hz")
+        elif packet_id == PacketType.PING and data:
+            self._send_to(client, [self._pong(client, data, rx_us)])
+        elif packet_id == PacketType.FLIGHT_CONTROL and data:
+            with self._lock:
+                self._setpoint = [data["roll"], data["pitch"], data["yaw"]]
+                self._thrust = data["thrust"]
+            self._log(
+                client,
+                f"[CTRL] Roll={data['roll']:.2f}, Pitch={data['pitch']:.2f}, "
+                f"Yaw={data['yaw']:.2f}, Thrust={data['thrust']}",
+            )
+        elif packet_id == PacketType.PID_CONFIG and data:
+            with self._lock:
+                self._pid = dict(data)
+            self._log(client, "[PID] Received all PID parameters")
+        elif packet_id == PacketType.MOTOR_TEST and data:
+            motors = [data[f"motor{i}_pwm"] for i in range(1, 5)]
+            with self._lock:
+                self._motor_test = motors if data["enable"] else None
+            self._log(client, f"[MOTOR] Enable={data['enable']}, M1-4={motors}")
+        elif data is not None:
+            self._log(client, f"[EMU] 0x{packet_id:02X} 未模拟，已忽略")
+
+    def _pong(self, client: _Client, ping: dict, rx_us: int) -> bytes:
+        """与link_monitor.c相同: 统计上行丢包和到达抖动（RFC 3550）"""
+        seq = ping["seq"]
+        if client.ping_expected is not None:
+            delta = (seq - client.ping_expected) & 0xFFFF
+            if delta < 0x8000:
+                client.ping_lost += delta
+        client.ping_expected = (seq + 1) & 0xFFFF
+
+        transit = (rx_us - ping["host_time_us"]) & 0xFFFFFFFF
+        if client.last_transit is not None:
+            d = (transit - client.last_transit + 0x80000000) % 0x100000000 - 0x80000000
+            client.jitter_us += (abs(d) - client.jitter_us) / 16.0
+        client.last_transit = transit
+
+        return packet_defs.encode_pong(
+            seq,
+            ping["host_time_us"],
+            rx_us,
+            int(self.now_ms() * 1000) & 0xFFFFFFFF,
+            -45 + self._random.randint(-3, 3),
+            min(client.ping_lost, 0xFFFF),
+            min(int(client.jitter_us), 0xFFFF),
+        )
+
+    def _log(self, client: _Client, text: str):
+        """回显命令（飞控的DEBUG_PRINT_LOCAL同样以控制台日志发送）"""
+        if self._echo:
+            self._send_to(client, [packet_defs.encode_console_log(text.encode("utf-8")[:120])])
+
+    # ========== 发送 ==========
+
+    def _send_loop(self):
+        """按高频速率发送遥测；sleep精度不够时一次补发所有到期的帧，保证平均速率"""
+        start = time.perf_counter()
+        rate = self._hf_rate
+        sent = 0
+        tick = 0
+        next_lf = start
+
+        while self._running:
+            now = time.perf_counter()
+            if self._hf_rate != rate:
+                rate, start, sent = self._hf_rate, now, 0
+
+            due = int((now - start) * rate) - sent
+            for _ in range(min(due, max(1, int(rate)))):
+                self._send_high_freq(tick, 1.0 / rate)
+                tick += 1
+            sent += due
+
+            if now >= next_lf:
+                next_lf += 1.0
+                self._send_low_freq()
+
+            next_hf = start + (sent + 1) / rate
+            time.sleep(max(0.0, min(next_hf, next_lf) - time.perf_counter()))
+
+    def _send_high_freq(self, tick: int, dt: float):
+        with self._lock:
+            frame = self._synthesize(dt)
+            self.hf_frames += 1
+            clients = list(self._clients.values())
+
+        sent = 0
+        if not clients:
+            sent += self._send_datagram((self._broadcast, self._client_port), frame)
+        for client in clients:
+            if client.divider <= 1 or tick % client.divider == 0:
+                sent += self._send_to(client, [frame])
+        with self._lock:
+            self.hf_sent += sent
+
+    def _send_low_freq(self):
+        with self._lock:
+            self._battery_mv = max(3300.0, self._battery_mv - 0.5)
+            mv = self._battery_mv
+            pid = self._pid
+            clients = list(self._clients.values())
+
+        percentage = int(max(0.0, min(100.0, (mv - 3300.0) / 9.0)))
+        state = 3 if percentage < 20 else 0
+        frames = [
+            packet_defs.encode_pid_response(
+                *[pid[name] for name in packet_defs.PID_RESPONSE_FIELDS]
+            ),
+            packet_defs.encode_battery_status(mv / 1000.0, int(mv), percentage, state),
+        ]
+        if not clients:
+            for frame in frames:
+                self._send_datagram((self._broadcast, self._client_port), frame)
+        for client in clients:
+            self._send_to(client, frames)
+
+    def _send_to(self, client: _Client, frames: List[bytes]) -> int:
+        """
+        按客户端协商的版本发送（v2时合并为一个数据报，放不下则分多个）
+
+        Returns:
+            int: 实际发出的帧数
+        """
+        addr = (client.ip, self._client_port)
+        if client.version(time.monotonic()) < ProtocolService.V2_VERSION:
+            return sum(self._send_datagram(addr, frame) for frame in frames)
+
+        sent = 0
+        batch, size = [], 0
+        for frame in frames:
+            if not client.protocol.fits_v2(len(frame)):
+                # 单帧封装后已超长，按v1单帧发送
+                sent += self._send_datagram(addr, frame)
+                continue
+            if batch and not client.protocol.fits_v2(size + len(frame)):
+                sent += len(batch) * self._send_datagram(addr, client.protocol.wrap_v2(batch, int(self.now_ms())))
+                batch, size = [], 0
+            batch.append(frame)
+            size += len(frame)
+        if batch:
+            sent += len(batch) * self._send_datagram(addr, client.protocol.wrap_v2(batch, int(self.now_ms())))
+        return sent
+
+    def _send_datagram(self, addr, data: bytes) -> bool:
+        """发送一个数据报，按丢包率随机丢弃"""
+        with self._lock:
+            if self._loss > 0 and self._random.random() < self._loss:
+                self.dropped_datagrams += 1
+                return False
+            self.sent_datagrams += 1
+        try:
+            self._socket.sendto(data, addr)
+        except OSError:
+            return False
+        return True
+
+    # ========== 飞行数据合成 ==========
+
+    def _synthesize(self, dt: float) -> bytes:
+        """一阶姿态模型 + 噪声，生成一帧HIGH_FREQ_DATA（调用方持有锁）"""
+        t = self.now_ms() / 1000.0
+        flying = self._thrust > 0
+        alpha = min(1.0, dt / ATTITUDE_TAU)
+
+        rates = []
+        for axis in range(3):
+            target = self._setpoint[axis] if flying else 0.0
+            step = (target - self._attitude[axis]) * alpha
+            self._attitude[axis] += step
+            rates.append(step / dt)
+        roll, pitch, yaw = self._attitude
+
+        # 油门越大振动越大，另加一个低频摆动便于观察波形
+        noise = 0.5 + 4.0 * self._thrust / 65535.0
+        gyro = [r + self._random.gauss(0.0, noise) for r in rates]
+        gyro[0] += 2.0 * math.sin(2.0 * math.pi * 1.3 * t)
+
+        desired = [
+            self._pid["angle_roll_kp"] * (self._setpoint[0] - roll),
+            self._pid["angle_pitch_kp"] * (self._setpoint[1] - pitch),
+            self._pid["angle_yaw_kp"] * (self._setpoint[2] - yaw),
+        ]
+        control = [
+            int(max(-32768, min(32767, self._pid[f"rate_{axis}_kp"] * (d - g))))
+            for axis, d, g in zip(("roll", "pitch", "yaw"), desired, gyro)
+        ]
+
+        if self._motor_test is not None:
+            motors = self._motor_test
+        elif flying:
+            r, p, y = (c // 2 for c in control)
+            mix = (-r + p + y, -r - p - y, r - p + y, r + p - y)
+            motors = [int(max(0, min(65535, self._thrust + m))) for m in mix]
+        else:
+            motors = [0, 0, 0, 0]
+
+        rr, pr = math.radians(roll), math.radians(pitch)
+        acc = [
+            -GRAVITY * math.sin(pr) + self._random.gauss(0.0, noise * 0.05),
+            GRAVITY * math.sin(rr) * math.cos(pr) + self._random.gauss(0.0, noise * 0.05),
+            GRAVITY * math.cos(rr) * math.cos(pr) + self._random.gauss(0.0, noise * 0.05),
+        ]
+
+        return packet_defs.encode_high_freq_data(
+            roll, pitch, yaw,
+            *desired,
+            *control,
+            *motors,
+            *gyro,
+            *acc,
+            int(self.now_ms()) & 0xFFFF,
+        )
+
+    @staticmethod
+    def _default_pid() -> Dict[str, float]:
+        """上位机默认PID参数，作为模拟飞控的初始值"""
+        model = PidConfigModel()
+        pid = {}
+        for loop in ("angle", "rate"):
+            for axis in ("roll", "pitch", "yaw"):
+                config = getattr(model, f"{loop}_{axis}")
+                for term in ("kp", "ki", "kd"):
+                    pid[f"{loop}_{axis}_{term}"] = getattr(config, term)
+        return pid
+
+
+# ============================================================================
+# 基准模式
+# ============================================================================
+
+
+def _percentile(values: List[float], p: float) -> float:
+    if not values:
+        return float("nan")
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(len(ordered) * p))]
+
+
+DRAIN_TIME = 0.2  # 测量窗口结束后继续接收的时间（秒）
+
+
+def run_benchmark(emulator: DroneEmulator, rates: List[float], duration: float, warmup: float = 1.0):
+    """
+    在本进程中运行上位机接收链路，逐档测量:
+    - 端到端延迟: 模拟器生成帧 → GUI线程中DroneViewModel发出高频数据块（含攒批时间）
+    - 丢帧: 模拟器交给socket的高频帧中未到达GUI的数量（不含按--loss主动丢弃的）
+    - 界面卡顿: 5ms定时器的最大间隔（事件循环被阻塞的最长时间）
+    """
+    from PyQt6.QtCore import QElapsedTimer, QTimer
+    from PyQt6.QtWidgets import QApplication
+
+    from services.network_service import NetworkService
+    from services.telemetry_decoder import TelemetryDecoder
+    from viewmodels.drone_view_model import DroneViewModel
+    from views.waveform_view import WaveformView
+
+    app = QApplication.instance() or QApplication(sys.argv)
+
+    protocol = ProtocolService()
+    network = NetworkService(drone_ip="127.0.0.1")
+    decoder = TelemetryDecoder(protocol)
+    drone_vm = DroneViewModel(protocol_service=protocol)
+    waveform = WaveformView()
+    waveform.resize(1000, 700)
+    waveform.show()
+
+    network.set_batch_decoder(decoder.decode)
+    network.batch_received.connect(drone_vm.on_telemetry_batch)
+    drone_vm.high_freq_block_changed.connect(waveform.update_waveform_block)
+
+    # 只统计在测量窗口 [window[0], window[1]) 内生成的帧；窗口结束后再接收一段时间，
+    # 避免把仍在攒批/传输中的帧算作丢帧
+    state = {"latency": [], "frames": 0, "stall": 0.0, "measure": False, "window": (0.0, 0.0)}
+
+    def on_block(block):
+        start, end = state["window"]
+        now = emulator.now_ms()
+        for ts in block["timestamp"]:
+            latency = (now - int(ts)) % 65536
+            if start <= now - latency < end:
+                state["latency"].append(latency)
+                state["frames"] += 1
+
+    drone_vm.high_freq_block_changed.connect(on_block)
+
+    # 心跳 + 订阅保持客户端登记（与ConnectionViewModel相同）
+    def keepalive():
+        network.send_packet(protocol.build_heartbeat_packet())
+        network.send_packet(protocol.build_subscribe_packet(0))
+
+    keepalive_timer = QTimer()
+    keepalive_timer.timeout.connect(keepalive)
+
+    clock = QElapsedTimer()
+    stall_timer = QTimer()
+
+    def on_stall_tick():
+        if state["measure"]:
+            state["stall"] = max(state["stall"], clock.restart())
+        else:
+            clock.restart()
+
+    stall_timer.timeout.connect(on_stall_tick)
+
+    if not network.connect():
+        print("[Bench] 无法绑定上位机端口")
+        return
+    keepalive()
+    keepalive_timer.start(1000)
+    clock.start()
+    stall_timer.start(5)
+
+    def run_for(seconds: float):
+        QTimer.singleShot(int(seconds * 1000), app.quit)
+        app.exec()
+
+    print(
+        f"{'速率Hz':>8} {'发出':>8} {'到达':>8} {'丢帧%':>7} "
+        f"{'延迟p50':>8} {'p95':>7} {'max':>7} {'卡顿max':>8}"
+    )
+    results = []
+    for rate in rates:
+        emulator.set_hf_rate(rate)
+        run_for(warmup)
+
+        state.update(latency=[], frames=0, stall=0.0, measure=True)
+        emulator.reset_stats()
+        state["window"] = (emulator.now_ms(), float("inf"))
+        run_for(duration)
+        state["window"] = (state["window"][0], emulator.now_ms())
+        sent = emulator.hf_sent
+        state["measure"] = False
+        run_for(DRAIN_TIME)
+
+        frames = state["frames"]
+        lost = max(0, sent - frames)
+        latency = state["latency"]
+        row = {
+            "rate": rate,
+            "sent": sent,
+            "received": frames,
+            "lost_pct": 100.0 * lost / sent if sent else 0.0,
+            "latency_p50": _percentile(latency, 0.5),
+            "latency_p95": _percentile(latency, 0.95),
+            "latency_max": max(latency) if latency else float("nan"),
+            "stall_max": state["stall"],
+        }
+        results.append(row)
+        print(
+            f"{rate:>8g} {sent:>8} {frames:>8} {row['lost_pct']:>6.2f}% "
+            f"{row['latency_p50']:>6.1f}ms {row['latency_p95']:>5.1f}ms "
+            f"{row['latency_max']:>5.1f}ms {row['stall_max']:>6.0f}ms"
+        )
+
+    keepalive_timer.stop()
+    stall_timer.stop()
+    network.disconnect()
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description="ESP-FLY 飞控模拟器")
+    parser.add_argument("--bind", default="0.0.0.0", help="监听地址")
+    parser.add_argument("--port", type=int, default=SERVER_PORT, help="命令端口 (默认2390)")
+    parser.add_argument("--client-port", type=int, default=CLIENT_PORT, help="遥测目标端口 (默认2399)")
+    parser.add_argument("--broadcast", default="255.255.255.255", help="无客户端时的广播地址")
+    parser.add_argument("--hf-rate", type=float, default=FIRMWARE_HF_RATE, help="高频数据速率Hz (默认50)")
+    parser.add_argument("--loss", type=float, default=0.0, help="下行丢包率 0~1")
+    parser.add_argument("--no-echo", action="store_true", help="不回显收到的命令")
+    parser.add_argument("--seed", type=int, help="随机数种子（噪声与丢包可复现）")
+    parser.add_argument("--bench", help="基准模式: 逗号分隔的高频速率列表，如 50,100,200,500,1000")
+    parser.add_argument("--bench-duration", type=float, default=5.0, help="基准模式每档测量时长（秒）")
+    args = parser.parse_args()
+
+    bench_rates = [float(r) for r in args.bench.split(",")] if args.bench else None
+    emulator = DroneEmulator(
+        bind="127.0.0.1" if bench_rates else args.bind,
+        port=args.port,
+        client_port=args.client_port,
+        hf_rate=bench_rates[0] if bench_rates else args.hf_rate,
+        loss=args.loss,
+        echo=not args.no_echo,
+        broadcast="127.0.0.1" if bench_rates else args.broadcast,
+        seed=args.seed,
+    )
+    emulator.start()
+
+    try:
+        if bench_rates:
+            run_benchmark(emulator, bench_rates, args.bench_duration)
+        else:
+            while True:
+                time.sleep(5.0)
+                print(
+                    f"[Emulator] 客户端 {emulator.client_count}，高频帧 {emulator.hf_frames}，"
+                    f"数据报 {emulator.sent_datagrams}，丢弃 {emulator.dropped_datagrams}"
+                )
+    except KeyboardInterrupt:
+        pass
+    finally:
+        emulator.stop()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,280 @@
+#!/usr/bin/env python3
+"""
+telemetry_cli - 无界面遥测记录与分析
+
+不需要图形界面、pyvista或显示器，可在外场笔记本或CI机器上运行:
+- capture: 连接飞机（心跳+订阅保活、PING测RTT），记录为.eflog，每秒打印链路统计，
+  结束（Ctrl+C或--duration到时）后打印飞行统计
+- analyze: 对已有的记录文件做飞行统计（遥测间隔直方图、各轴角速度跟踪误差、
+  电机饱和时间、电池压降）和各轴阶跃响应指标；给出多个文件时可对比不同PID参数
+
+用法:
+    python tools/telemetry_cli.py capture --ip 192.168.43.42 --duration 120
+    python tools/telemetry_cli.py capture --ip 127.0.0.1 --rate 200 -o flight.eflog
+    python tools/telemetry_cli.py analyze data/recordings/flight_20260118_101500.eflog --json
+
+与GUI使用同一套NetworkService/ProtocolService/TelemetryDecoder/TelemetryRecorder，
+只依赖PyQt6.QtCore（QCoreApplication事件循环），不创建任何窗口。
+"""
+
+import argparse
+import json
+import os
+import signal
+import sys
+import time
+from datetime import datetime
+
+PC_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+sys.path.insert(0, PC_DIR)
+
+from common.resource_path import get_config_path  # noqa: E402
+from services import flight_analysis, step_response  # noqa: E402
+from services.config_service import ConfigService  # noqa: E402
+from services.packet_defs import PacketType  # noqa: E402
+from services.telemetry_recorder import FILE_EXTENSION, TelemetryLog  # noqa: E402
+
+STATS_INTERVAL_MS = 1000
+KEEPALIVE_INTERVAL_MS = 1000  # 与ConnectionViewModel心跳间隔相同
+PING_INTERVAL_MS = 200
+
+
+class CaptureSession:
+    """
+    一次无界面记录
+
+    在QCoreApplication事件循环中运行：接收线程批量解码并写入记录文件，
+    GUI线程（主线程）只统计每批数据并定时打印
+    """
+
+    def __init__(self, args, config: ConfigService):
+        from PyQt6.QtCore import QCoreApplication, QTimer
+
+        from services.network_service import NetworkService
+        from services.protocol_service import ProtocolService
+        from services.telemetry_decoder import TelemetryDecoder
+        from services.telemetry_recorder import TelemetryRecorder
+
+        self._app = QCoreApplication.instance() or QCoreApplication(sys.argv)
+        self._args = args
+
+        self._protocol = ProtocolService(
+            preferred_version=config.get_int("protocol", "version", 2)
+        )
+        self._network = NetworkService(
+            drone_ip=args.ip or config.get_string("network", "drone_ip", "192.168.43.42"),
+            port=config.get_int("network", "port", 2390),
+            config_service=config,
+        )
+        self._decoder = TelemetryDecoder(self._protocol)
+        self._recorder = TelemetryRecorder(args.output)
+        self._rate = args.rate if args.rate is not None else config.get_int(
+            "protocol", "telemetry_rate", 0
+        )
+
+        # 统计（主线程）
+        self._start = time.monotonic()
+        self._last_print = self._start
+        self._frames = 0
+        self._frames_last = 0
+        self._datagrams = 0
+        self._datagrams_last = 0
+        self._battery = None
+        self._ping_seq = 0
+        self._pings = {}  # seq -> 发送时刻us
+        self._rtts = []  # 本周期RTT（ms）
+        self._ping_lost = 0
+        self._drone_rssi = None
+
+        self._network.set_batch_decoder(self._decoder.decode)
+        self._network.batch_received.connect(self._on_batch)
+        self._network.error_occurred.connect(lambda msg: print(f"[Capture] {msg}"))
+
+        self._timers = []
+        for interval, slot in (
+            (KEEPALIVE_INTERVAL_MS, self._send_keepalive),
+            (PING_INTERVAL_MS, self._send_ping),
+            (STATS_INTERVAL_MS, self._print_stats),
+            (200, lambda: None),  # 让Python解释器定期运行，及时响应Ctrl+C
+        ):
+            timer = QTimer()
+            timer.timeout.connect(slot)
+            self._timers.append((timer, interval))
+        self._duration_timer = QTimer()
+        self._duration_timer.setSingleShot(True)
+        self._duration_timer.timeout.connect(self._app.quit)
+
+    def run(self) -> int:
+        self._recorder.open()
+        self._decoder.set_recorder(self._recorder)
+        if not self._network.connect():
+            self._decoder.set_recorder(None)
+            self._recorder.close()
+            return 1
+
+        print(f"[Capture] 记录到 {self._args.output}，Ctrl+C结束")
+        signal.signal(signal.SIGINT, lambda *_: self._app.quit())
+        self._start = self._last_print = time.monotonic()
+        self._send_keepalive()
+        for timer, interval in self._timers:
+            timer.start(interval)
+        if self._args.duration:
+            self._duration_timer.start(int(self._args.duration * 1000))
+        self._app.exec()
+
+        for timer, _ in self._timers:
+            timer.stop()
+        self._network.disconnect()
+        self._decoder.set_recorder(None)
+        self._recorder.close()
+        stats = self._recorder.get_stats()
+        print(
+            f"[Capture] 已保存 {self._args.output}: {stats['records']} 帧, "
+            f"{stats['file_bytes'] / 1024:.0f} KB (压缩比 {stats['ratio']:.2f})"
+        )
+        return 0
+
+    # ========== Private Methods ==========
+
+    def _now_us(self) -> int:
+        return time.perf_counter_ns() // 1000
+
+    def _send_keepalive(self):
+        """心跳+订阅保活（与ConnectionViewModel相同）"""
+        self._network.send_packet(self._protocol.build_heartbeat_packet())
+        self._network.send_packet(self._protocol.build_subscribe_packet(self._rate))
+
+    def _send_ping(self):
+        now = self._now_us()
+        expired = [s for s, t in self._pings.items() if now - t > 1_000_000]
+        for seq in expired:
+            del self._pings[seq]
+        self._ping_lost += len(expired)
+
+        self._pings[self._ping_seq] = now
+        self._network.send_packet(self._protocol.build_ping_packet(self._ping_seq, now))
+        self._ping_seq = (self._ping_seq + 1) & 0xFFFF
+
+    def _on_batch(self, batch):
+        self._frames += len(batch.high_freq)
+        self._datagrams += batch.datagrams
+        for packet in batch.packets:
+            if packet.packet_type == PacketType.BATTERY_STATUS:
+                self._battery = packet.data
+            elif packet.packet_type == PacketType.PONG:
+                sent = self._pings.pop(packet.data["seq"], None)
+                if sent is not None:
+                    self._rtts.append((packet.data["rx_host_us"] - sent) / 1000.0)
+                self._drone_rssi = packet.data.get("rssi")
+            elif packet.packet_type == PacketType.CONSOLE_LOG and self._args.console:
+                print(f"[MCU] {packet.data.get('text', '')}")
+
+    def _print_stats(self):
+        """每秒一行: 数据报/高频数据速率、v2丢包、RTT、RSSI、电池、记录大小"""
+        now = time.monotonic()
+        elapsed = now - self._start
+        interval = max(now - self._last_print, 1e-3)
+        self._last_print = now
+        hf_rate = (self._frames - self._frames_last) / interval
+        dg_rate = (self._datagrams - self._datagrams_last) / interval
+        self._frames_last, self._datagrams_last = self._frames, self._datagrams
+
+        link = self._protocol.get_link_stats()
+        total = link["received"] + link["lost"]
+        loss = f"{100.0 * link['lost'] / total:.1f}%" if total else "--"
+        rtt = (
+            f"{sorted(self._rtts)[len(self._rtts) // 2]:.1f}ms/{max(self._rtts):.1f}ms"
+            if self._rtts
+            else "--"
+        )
+        self._rtts = []
+        battery = f"{self._battery['voltage']:.2f}V" if self._battery else "--"
+        rssi = f"{self._drone_rssi}dBm" if self._drone_rssi else "--"
+        record = self._recorder.get_stats()
+
+        print(
+            f"{elapsed:7.1f}s  v{link['version']}  数据报 {dg_rate:5.0f}/s  高频 {hf_rate:6.1f}Hz  "
+            f"丢包 {loss:>5}  RTT中位/最大 {rtt:>13}  PING丢失 {self._ping_lost}  "
+            f"RSSI {rssi:>7}  电池 {battery:>6}  记录 {record['records']}帧 "
+            f"{record['file_bytes'] / 1024:.0f}KB",
+            flush=True,
+        )
+
+
+def _analyze_file(path: str, as_json: bool):
+    log = TelemetryLog(path)
+    try:
+        summary = flight_analysis.analyze_log(log)
+        _, high_freq = log.read_rows(0, log.record_count)
+    finally:
+        log.close()
+
+    # 阶跃响应只输出指标（不含曲线）
+    steps = step_response.analyze_high_freq(high_freq)["axes"]
+    summary["step_response"] = {
+        axis: {key: value for key, value in estimate.items() if key not in ("t", "response")}
+        for axis, estimate in steps.items()
+    }
+
+    if as_json:
+        print(json.dumps(summary, ensure_ascii=False, indent=2))
+    else:
+        print(f"== {path}")
+        print(flight_analysis.format_summary(summary))
+        print("阶跃响应 (飞行数据反卷积):")
+        for axis, metrics in summary["step_response"].items():
+            if metrics["steady"] is None:
+                print(f"  {axis:<5} 无有效窗口")
+                continue
+
+            def ms(key):
+                return "--" if metrics[key] is None else f"{metrics[key]:.0f}ms"
+
+            print(
+                f"  {axis:<5} 延迟 {ms('delay_ms'):>6}  上升 {ms('rise_ms'):>6}  "
+                f"超调 {metrics['overshoot_pct']:5.1f}%  调节 {ms('settling_ms'):>6}  "
+                f"窗口 {metrics['used']}/{metrics['windows']}"
+            )
+
+
+def main():
+    parser = argparse.ArgumentParser(description="ESP-FLY无界面遥测记录与分析")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    capture = sub.add_parser("capture", help="连接飞机并记录遥测")
+    capture.add_argument("--ip", help="飞机IP（默认取config.ini [network] drone_ip）")
+    capture.add_argument("--rate", type=int, help="订阅的高频数据速率Hz（0=飞控默认50Hz）")
+    capture.add_argument("--duration", type=float, help="记录时长（秒），默认直到Ctrl+C")
+    capture.add_argument("-o", "--output", help="记录文件路径（默认data/recordings/flight_日期_时间.eflog）")
+    capture.add_argument("--config", help="配置文件路径（默认与GUI相同）")
+    capture.add_argument("--console", action="store_true", help="打印飞控控制台日志")
+    capture.add_argument("--no-summary", action="store_true", help="结束后不打印飞行统计")
+
+    analyze = sub.add_parser("analyze", help="统计记录文件")
+    analyze.add_argument("files", nargs="+", help=f"记录文件（{FILE_EXTENSION}）")
+    analyze.add_argument("--json", action="store_true", help="以JSON输出")
+
+    args = parser.parse_args()
+
+    if args.command == "analyze":
+        for path in args.files:
+            _analyze_file(path, args.json)
+        return 0
+
+    config = ConfigService(args.config)
+    if not args.output:
+        directory = config.get_string(
+            "recording", "directory", os.path.join(os.path.dirname(get_config_path()), "recordings")
+        )
+        args.output = os.path.join(
+            directory, datetime.now().strftime("flight_%Y%m%d_%H%M%S") + FILE_EXTENSION
+        )
+
+    code = CaptureSession(args, config).run()
+    if code == 0 and not args.no_summary:
+        _analyze_file(args.output, as_json=False)
+    return code
+
+
+if __name__ == "__main__":
+    sys.exit(main())
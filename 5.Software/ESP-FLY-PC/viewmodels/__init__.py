@@ -8,6 +8,7 @@ from .flight_control_view_model import FlightControlViewModel
 from .pid_config_view_model import PidConfigViewModel
 from .motor_test_view_model import MotorTestViewModel
 from .connection_view_model import ConnectionViewModel
+from .link_health_view_model import LinkHealthViewModel
 
 __all__ = [
     'DroneViewModel',
@@ -15,4 +16,5 @@ __all__ = [
     'PidConfigViewModel',
     'MotorTestViewModel',
     'ConnectionViewModel',
+    'LinkHealthViewModel',
 ]
@@ -9,6 +9,7 @@ import re
 from PyQt6.QtCore import QObject, QTimer, pyqtSignal, pyqtSlot
 from models.connection_state_model import ConnectionStateModel
 from services.network_service import NetworkService
+from services.protocol_service import ProtocolService
 
 
 class ConnectionViewModel(QObject):
@@ -35,7 +36,12 @@ class ConnectionViewModel(QObject):
     # 事件信号
     connection_error = pyqtSignal(str)
 
-    def __init__(self, network_service: NetworkService):
+    def __init__(
+        self,
+        network_service: NetworkService,
+        protocol_service: ProtocolService = None,
+        telemetry_rate: int = 0,
+    ):
         super().__init__()
 
         # Model
@@ -43,6 +49,8 @@ class ConnectionViewModel(QObject):
 
         # Service
         self._network_service = network_service
+        self._protocol_service = protocol_service
+        self._telemetry_rate = telemetry_rate
 
         # 连接NetworkService信号
         self._network_service.connected.connect(self._on_connected)
@@ -53,6 +61,10 @@ class ConnectionViewModel(QObject):
         self._signal_refresh_timer = QTimer()
         self._signal_refresh_timer.timeout.connect(self.refresh_signal_command)
 
+        # 心跳定时器（1秒间隔），同时用于协议v2协商和遥测订阅保活
+        self._heartbeat_timer = QTimer()
+        self._heartbeat_timer.timeout.connect(self._send_heartbeat)
+
     # ========== Properties ==========
 
     @property
@@ -129,6 +141,26 @@ class ConnectionViewModel(QObject):
         self.recv_packets_changed.emit(recv)
         self.stats_changed.emit(sent, recv)
 
+    @pyqtSlot()
+    def kernel_bench_command(self):
+        """请求飞控执行一轮内核微基准测试"""
+        if not self._model.is_connected or self._protocol_service is None:
+            return
+
+        self._network_service.send_packet(
+            self._protocol_service.build_bench_request_packet()
+        )
+
+    @pyqtSlot(int)
+    def motor_char_command(self, action: int):
+        """请求飞控查询/执行/清除电机推力标定"""
+        if not self._model.is_connected or self._protocol_service is None:
+            return
+
+        self._network_service.send_packet(
+            self._protocol_service.build_motor_char_request_packet(action)
+        )
+
     @pyqtSlot(int, int)
     def on_stats_updated(self, sent_count: int, recv_count: int):
         """处理NetworkService统计更新"""
@@ -151,10 +183,21 @@ class ConnectionViewModel(QObject):
         # 立即刷新一次信号强度
         self.refresh_signal_command()
 
+        # 启动心跳
+        if self._protocol_service is not None:
+            self._heartbeat_timer.start(1000)
+            self._send_heartbeat()
+
     def _on_disconnected(self):
         """断开连接"""
         # 停止WiFi信号强度刷新定时器
         self._signal_refresh_timer.stop()
+        self._heartbeat_timer.stop()
+        if self._protocol_service is not None:
+            self._protocol_service.reset_link()
+            for session in self._network_service.sessions:
+                if session.protocol_service is not None:
+                    session.protocol_service.reset_link()
 
         self._model.is_connected = False
         self._model.reset()
@@ -167,6 +210,17 @@ class ConnectionViewModel(QObject):
 
     # ========== Private Methods ==========
 
+    def _send_heartbeat(self):
+        """
+        向每架无人机发送心跳包和订阅包（飞控超时注销客户端后可重新按订阅速率发送）
+
+        不只是当前无人机，其他会话也保持订阅，切换时无需重新等待遥测
+        """
+        for session in self._network_service.sessions:
+            protocol = session.protocol_service or self._protocol_service
+            session.send_packet(protocol.build_heartbeat_packet())
+            session.send_packet(protocol.build_subscribe_packet(self._telemetry_rate))
+
     def _check_network(self) -> tuple:
         """检查网络连接状态"""
         try:
@@ -4,9 +4,34 @@ DroneViewModel - 核心ViewModel
 """
 
 import time
+import numpy as np
 from PyQt6.QtCore import QObject, pyqtSignal, pyqtSlot, QTimer
 from models.drone_state_model import DroneStateModel
+from services import packet_defs
 from services.protocol_service import ProtocolService, PacketType
+from services.telemetry_decoder import HIGH_FREQ_DTYPE, TelemetryBatch
+
+# 高频数据字段名 → WaveformView曲线名（其余字段同名）
+_WAVEFORM_NAMES = {
+    "roll_control_output": "roll_control",
+    "pitch_control_output": "pitch_control",
+    "yaw_control_output": "yaw_control",
+    "motor1_pwm": "motor1",
+    "motor2_pwm": "motor2",
+    "motor3_pwm": "motor3",
+    "motor4_pwm": "motor4",
+    "timestamp_ms": "timestamp",
+}
+
+# 与HIGH_FREQ_DTYPE布局相同、按曲线名命名的dtype，用于零拷贝改名
+WAVEFORM_DTYPE = np.dtype(
+    {
+        "names": [_WAVEFORM_NAMES.get(n, n) for n in HIGH_FREQ_DTYPE.names],
+        "formats": [HIGH_FREQ_DTYPE.fields[n][0] for n in HIGH_FREQ_DTYPE.names],
+        "offsets": [HIGH_FREQ_DTYPE.fields[n][1] for n in HIGH_FREQ_DTYPE.names],
+        "itemsize": HIGH_FREQ_DTYPE.itemsize,
+    }
+)
 
 
 class DroneViewModel(QObject):
@@ -93,6 +118,9 @@ class DroneViewModel(QObject):
     # 高频数据全部更新（用于波形显示）
     high_freq_data_changed = pyqtSignal(dict)
 
+    # 高频数据批量更新（WAVEFORM_DTYPE结构化数组，批量解码时每批一次）
+    high_freq_block_changed = pyqtSignal(object)
+
     # PID配置参数上报（用于终端监控显示）
     pid_config_reported = pyqtSignal(dict, dict)  # angle_params, rate_params
 
@@ -105,6 +133,12 @@ class DroneViewModel(QObject):
     # 统计信息
     packet_count_changed = pyqtSignal(int)
 
+    # 链路测量响应（附带上位机接收时间 rx_host_us）
+    pong_received = pyqtSignal(dict)
+
+    # 系统辨识数据包（SYSID_STATUS/SYSID_FRF/SYSID_SAMPLES）
+    sysid_packet_received = pyqtSignal(int, dict)  # packet_type, data
+
     def __init__(self, protocol_service: ProtocolService = None, config_service=None):
         super().__init__()
 
@@ -191,18 +225,60 @@ class DroneViewModel(QObject):
         Args:
             data: 原始数据包
         """
-        packet = self._protocol_service.parse_packet(data)
-        if packet is None:
-            return
+        # v2数据报可能包含多帧
+        for packet in self._protocol_service.parse_datagram(data):
+            if packet.packet_type == PacketType.HIGH_FREQ_DATA:
+                self._update_high_freq_data(packet.data)
+            else:
+                self._dispatch_packet(packet)
+
+    @pyqtSlot(object)
+    def on_telemetry_batch(self, batch: TelemetryBatch):
+        """
+        处理接收线程解码好的一批数据
+
+        高频数据整块转发给波形视图，Model和姿态只按最新一帧更新一次
 
-        if packet.packet_type == PacketType.HIGH_FREQ_DATA:
-            self._update_high_freq_data(packet.data)
-        elif packet.packet_type == PacketType.BATTERY_STATUS:
+        Args:
+            batch: TelemetryDecoder.decode()的结果
+        """
+        block = batch.high_freq
+        if len(block):
+            latest = block[-1]
+            for name in packet_defs.HIGH_FREQ_DATA_FIELDS:
+                setattr(self._model, name, latest[name].item())
+            self._model.last_update_time = time.time()
+            self._model.packet_count += len(block)
+
+            self.attitude_changed.emit(self._model.roll, self._model.pitch, self._model.yaw)
+            self.high_freq_block_changed.emit(block.view(WAVEFORM_DTYPE))
+            self.packet_count_changed.emit(self._model.packet_count)
+
+        for packet in batch.packets:
+            self._dispatch_packet(packet)
+
+    def _dispatch_packet(self, packet):
+        """处理高频数据以外的数据包"""
+        if packet.packet_type == PacketType.BATTERY_STATUS:
             self._update_battery_data(packet.data)
         elif packet.packet_type == PacketType.PID_RESPONSE:
             self._update_pid_config_data(packet.data)
         elif packet.packet_type == PacketType.CONSOLE_LOG:
             self._update_console_text(packet.data.get("text", ""))
+        elif packet.packet_type == PacketType.PONG:
+            # 批量解码时接收线程已记录接收时刻
+            packet.data.setdefault("rx_host_us", time.perf_counter_ns() // 1000)
+            self.pong_received.emit(packet.data)
+        elif packet.packet_type == PacketType.BENCH_RESULT:
+            self._update_bench_result(packet.data)
+        elif packet.packet_type == PacketType.MOTOR_CHAR_RESULT:
+            self._update_motor_char_result(packet.data)
+        elif packet.packet_type in (
+            PacketType.SYSID_STATUS,
+            PacketType.SYSID_SAMPLES,
+            PacketType.SYSID_FRF,
+        ):
+            self.sysid_packet_received.emit(int(packet.packet_type), packet.data)
 
     def _update_high_freq_data(self, data: dict):
         """更新高频数据（50Hz）"""
@@ -376,6 +452,46 @@ class DroneViewModel(QObject):
         }
         self.pid_config_reported.emit(angle_params, rate_params)
 
+    def _update_bench_result(self, data: dict):
+        """内核微基准测试结果以文本形式输出到控制台"""
+        if data["kernel"] == 0:
+            self.console_text_received.emit(
+                f"[BENCH] fw {data['fw_version']}, {data['cpu_mhz']} MHz, "
+                f"{data['iterations']} iterations"
+            )
+        self.console_text_received.emit(
+            f"[BENCH] {data['kernel'] + 1}/{data['kernel_count']} {data['name']:<16} "
+            f"min {data['cycles_min']:>6}  mean {data['cycles_mean']:>6}  "
+            f"max {data['cycles_max']:>6} cycles  ({data['mean_us']:.2f} us)"
+        )
+
+    def _update_motor_char_result(self, data: dict):
+        """电机推力标定结果以文本形式输出到控制台"""
+        status = data["status"]
+        if status == 2:
+            self.console_text_received.emit("[MOTOR] 标定中, 电机将逐级加速...")
+            return
+        if status == 3:
+            self.console_text_received.emit(
+                "[MOTOR] 标定被拒绝或中止 (需陀螺仪零偏校准完成、电机停转且电池电量充足)"
+            )
+            return
+        if status == 4:
+            self.console_text_received.emit(
+                "[MOTOR] 标定已中止 (中止请求、关闭电机测试、紧急停止或链路丢失), 电机已停止"
+            )
+            return
+
+        if data["step"] == 0:
+            source = "NVS标定曲线" if status == 1 else "理想曲线 (未标定)"
+            rest = f", 静止电压 {data['rest_mv']} mV" if data["rest_mv"] else ""
+            self.console_text_received.emit(f"[MOTOR] {source}{rest}")
+        loaded = f"{data['loaded_mv']:>5} mV" if data["loaded_mv"] else "    -   "
+        self.console_text_received.emit(
+            f"[MOTOR] {data['step'] + 1}/{data['step_count']} "
+            f"duty {data['duty_pct']:5.1f}%  {loaded}  thrust {data['thrust_pct']:5.1f}%"
+        )
+
     def _update_console_text(self, text: str):
         """更新控制台文本（来自MCU的调试输出）"""
         self.console_text_received.emit(text)
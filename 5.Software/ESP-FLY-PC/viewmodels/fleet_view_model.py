@@ -0,0 +1,149 @@
+"""
+FleetViewModel - 多机会话ViewModel
+汇总每架无人机的在线状态、电池、姿态和遥测速率，叠加显示各机的同一通道，切换当前无人机
+"""
+
+import time
+
+import numpy as np
+from PyQt6.QtCore import QObject, QTimer, pyqtSignal, pyqtSlot
+
+from services.network_service import NetworkService
+from services.packet_defs import PacketType
+from services.ring_buffer import ColumnRingBuffer
+
+UPDATE_INTERVAL_MS = 500  # 列表和叠加曲线刷新间隔
+OFFLINE_SECONDS = 1.5  # 超过该时长未收到数据视为离线
+OVERLAY_SECONDS = 10.0  # 叠加曲线显示的时长
+OVERLAY_CAPACITY = 20000  # 每架无人机缓存的高频数据行数（1kHz约20秒）
+OVERLAY_CHANNELS = ("roll", "pitch", "yaw", "gyro_x", "gyro_y", "gyro_z", "acc_z")
+
+
+class _DroneTrack:
+    """一架无人机的汇总状态（GUI线程）"""
+
+    def __init__(self, ip: str):
+        self.ip = ip
+        # 横轴为上位机接收时刻（秒），各机的飞控时间戳互不相关
+        self.buffer = ColumnRingBuffer(OVERLAY_CAPACITY, ("t",) + OVERLAY_CHANNELS)
+        self.attitude = None  # (roll, pitch, yaw)
+        self.battery = None  # (voltage, percentage)
+        self.frames = 0  # 上次刷新后收到的高频帧数
+        self.hf_rate = 0.0
+
+
+class FleetViewModel(QObject):
+    """
+    多机会话ViewModel
+
+    职责：
+    - 订阅每个DroneSession的batch_received（解码已在接收线程中按会话完成），
+      缓存各机最近的高频数据和最新电池/姿态
+    - 按UPDATE_INTERVAL_MS发出各机汇总和所选通道的叠加曲线
+    - 切换当前无人机（NetworkService.set_active_drone），其余ViewModel随之作用于新的无人机
+    """
+
+    fleet_changed = pyqtSignal(list)  # 每架一个dict: ip, active, online, recv_packets, hf_rate, attitude, battery
+    overlay_changed = pyqtSignal(dict)  # channel, curves{ip: (t, values)}
+
+    def __init__(self, network_service: NetworkService):
+        super().__init__()
+        self._network_service = network_service
+        self._channel = OVERLAY_CHANNELS[0]
+        self._epoch_us = time.perf_counter_ns() // 1000
+        self._last_update = time.monotonic()
+
+        self._tracks = {}
+        for session in network_service.sessions:
+            self._tracks[session.ip] = _DroneTrack(session.ip)
+            session.batch_received.connect(self._on_session_batch)
+
+        self._update_timer = QTimer()
+        self._update_timer.timeout.connect(self._emit_fleet)
+        self._update_timer.start(UPDATE_INTERVAL_MS)
+
+    # ========== Commands ==========
+
+    @pyqtSlot(str)
+    def select_drone_command(self, ip: str):
+        """切换当前无人机"""
+        if self._network_service.set_active_drone(ip):
+            self._emit_fleet()
+
+    @pyqtSlot(str)
+    def select_channel_command(self, channel: str):
+        """选择叠加显示的通道（OVERLAY_CHANNELS之一）"""
+        if channel in OVERLAY_CHANNELS:
+            self._channel = channel
+            self._emit_overlay()
+
+    @pyqtSlot()
+    def clear_command(self):
+        """清空各机缓存的曲线"""
+        for track in self._tracks.values():
+            track.buffer.clear()
+        self._emit_overlay()
+
+    # ========== Event Handlers ==========
+
+    @pyqtSlot(object)
+    def _on_session_batch(self, batch):
+        """某个会话的一批解码结果（sender为DroneSession）"""
+        track = self._tracks.get(self.sender().ip)
+        if track is None:
+            return
+
+        block = batch.high_freq
+        if len(block):
+            rows = np.empty((len(block), len(track.buffer.columns)), dtype=np.float64)
+            rows[:, 0] = (batch.high_freq_rx_us - self._epoch_us) / 1e6
+            for i, name in enumerate(OVERLAY_CHANNELS, start=1):
+                rows[:, i] = block[name]
+            track.buffer.extend(rows)
+            track.frames += len(block)
+            latest = block[-1]
+            track.attitude = (float(latest["roll"]), float(latest["pitch"]), float(latest["yaw"]))
+
+        for packet in batch.packets:
+            if packet.packet_type == PacketType.BATTERY_STATUS:
+                track.battery = (packet.data["voltage"], packet.data["percentage"])
+
+    # ========== Private Methods ==========
+
+    def _emit_fleet(self):
+        now = time.monotonic()
+        elapsed = max(now - self._last_update, 1e-3)
+        self._last_update = now
+
+        active = self._network_service.active_session
+        wall = time.time()
+        drones = []
+        for session in self._network_service.sessions:
+            track = self._tracks[session.ip]
+            track.hf_rate = track.frames / elapsed
+            track.frames = 0
+            drones.append(
+                {
+                    "ip": session.ip,
+                    "active": session is active,
+                    "online": self._network_service.is_connected
+                    and session.last_recv_time > 0
+                    and wall - session.last_recv_time < OFFLINE_SECONDS,
+                    "recv_packets": session.recv_packets,
+                    "hf_rate": track.hf_rate,
+                    "attitude": track.attitude,
+                    "battery": track.battery,
+                }
+            )
+        self.fleet_changed.emit(drones)
+        self._emit_overlay()
+
+    def _emit_overlay(self):
+        t_now = (time.perf_counter_ns() // 1000 - self._epoch_us) / 1e6
+        curves = {}
+        for ip, track in self._tracks.items():
+            t = track.buffer.view("t")
+            start = np.searchsorted(t, t_now - OVERLAY_SECONDS)
+            # 横轴为相对当前时刻的秒数（负值）
+            curves[ip] = (t[start:] - t_now, track.buffer.view(self._channel)[start:].copy())
+        self.overlay_changed.emit({"channel": self._channel, "curves": curves})
@@ -3,10 +3,9 @@ FlightControlViewModel - 飞行控制ViewModel
 管理飞行控制参数，负责50Hz周期发送控制命令
 """
 
-import threading
-import time
-from PyQt6.QtCore import QObject, pyqtSignal, pyqtSlot
+from PyQt6.QtCore import QObject, QTimer, pyqtSignal, pyqtSlot
 from models.flight_control_model import FlightControlModel
+from services.command_sender import CommandSender
 from services.network_service import NetworkService
 from services.protocol_service import ProtocolService
 
@@ -18,7 +17,8 @@ class FlightControlViewModel(QObject):
     职责：
     - 管理FlightControlModel数据
     - 处理用户控制输入
-    - 50Hz周期发送控制命令
+    - 50Hz周期发送控制命令（CommandSender: 绝对截止时刻调度，UI只写最新命令槽）
+    - 统计发送间隔抖动
     - 发射属性变化信号供View绑定
     """
     
@@ -32,8 +32,12 @@ class FlightControlViewModel(QObject):
     # 命令结果信号
     command_sent = pyqtSignal(bool)
     
+    # 发送间隔统计（CommandSender.get_stats()）
+    send_stats_changed = pyqtSignal(dict)
+    
     # 发送频率
     CONTROL_FREQUENCY = 50  # Hz
+    STATS_INTERVAL_MS = 1000  # 发送期间统计刷新间隔
     
     def __init__(self, network_service: NetworkService, protocol_service: ProtocolService):
         super().__init__()
@@ -46,11 +50,18 @@ class FlightControlViewModel(QObject):
         self._protocol_service = protocol_service
         
         # 发送线程
-        self._send_thread = None
-        self._is_sending = False
+        self._sender = CommandSender(
+            self.CONTROL_FREQUENCY,
+            self._build_control_packet,
+            self._network_service.send_packet,
+            self._on_command_sent,
+        )
+        self._publish_command()
         
         # 统计
         self._command_count = 0
+        self._stats_timer = QTimer()
+        self._stats_timer.timeout.connect(self._emit_send_stats)
     
     # ========== Properties ==========
     
@@ -122,6 +133,10 @@ class FlightControlViewModel(QObject):
     def command_count(self) -> int:
         return self._command_count
     
+    @property
+    def _is_sending(self) -> bool:
+        return self._sender.is_running
+    
     # ========== Commands ==========
     
     @pyqtSlot()
@@ -157,6 +172,7 @@ class FlightControlViewModel(QObject):
         self.target_pitch_changed.emit(0.0)
         self.target_yaw_changed.emit(0.0)
         self.thrust_changed.emit(0)
+        self._publish_command()
         
         # 如果已连接，强制发送一次全零命令
         if self._network_service.is_connected:
@@ -218,6 +234,7 @@ class FlightControlViewModel(QObject):
     
     def _update_sending_state(self):
         """根据控制输入状态自动启动或停止发送"""
+        self._publish_command()
         if not self._network_service.is_connected:
             return
         
@@ -237,41 +254,49 @@ class FlightControlViewModel(QObject):
         # 停止发送循环
         self.disable_control_command()
     
+    def _publish_command(self):
+        """把当前控制参数写入发送线程的最新命令槽"""
+        self._sender.set_command(
+            (
+                self._model.target_roll,
+                self._model.target_pitch,
+                self._model.target_yaw,
+                self._model.thrust,
+            )
+        )
+    
     def _start_sending_loop(self):
         """启动50Hz发送循环"""
         if self._is_sending:
             return
         
-        self._is_sending = True
-        self._send_thread = threading.Thread(target=self._send_loop, daemon=True)
-        self._send_thread.start()
+        self._sender.reset_stats()
+        self._sender.start()
+        self._stats_timer.start(self.STATS_INTERVAL_MS)
     
     def _stop_sending_loop(self):
-        """停止发送循环"""
-        self._is_sending = False
-        if self._send_thread and self._send_thread.is_alive():
-            self._send_thread.join(timeout=1.0)
-        self._send_thread = None
-    
-    def _send_loop(self):
-        """发送循环（50Hz）"""
-        period = 1.0 / self.CONTROL_FREQUENCY
-        
-        while self._is_sending:
-            start_time = time.time()
-            
-            # 发送控制命令
-            success = self._send_control_packet()
-            self.command_sent.emit(success)
-            
-            # 保持固定频率
-            elapsed = time.time() - start_time
-            sleep_time = period - elapsed
-            if sleep_time > 0:
-                time.sleep(sleep_time)
+        """停止发送循环（保留最后一次统计）"""
+        was_sending = self._is_sending
+        self._sender.stop()
+        self._stats_timer.stop()
+        if was_sending:
+            self._emit_send_stats()
+    
+    def _emit_send_stats(self):
+        self.send_stats_changed.emit(self._sender.get_stats())
+    
+    def _on_command_sent(self, success: bool):
+        """每次周期发送后（发送线程）"""
+        if success:
+            self._command_count += 1
+        self.command_sent.emit(success)
+    
+    def _build_control_packet(self, command) -> bytes:
+        """命令槽中的 (roll, pitch, yaw, thrust) → 控制数据包（发送线程）"""
+        return self._protocol_service.build_flight_control_packet(*command)
     
     def _send_control_packet(self) -> bool:
-        """发送控制数据包"""
+        """立即发送一次当前控制参数（GUI线程）"""
         if not self._network_service.is_connected:
             return False
         
@@ -290,4 +315,4 @@ class FlightControlViewModel(QObject):
     
     def __del__(self):
         """析构函数"""
-        self._stop_sending_loop()
+        self._sender.stop()
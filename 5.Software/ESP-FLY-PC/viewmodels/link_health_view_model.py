@@ -0,0 +1,161 @@
+"""
+LinkHealthViewModel - 链路质量ViewModel
+周期发送PING，根据PONG统计往返时延、抖动、丢包和RSSI
+"""
+
+import time
+from collections import deque
+from typing import Dict
+
+from PyQt6.QtCore import QObject, QTimer, pyqtSignal, pyqtSlot
+from models.link_health_model import LinkHealthModel
+from services.network_service import NetworkService
+from services.protocol_service import ProtocolService
+
+
+class LinkHealthViewModel(QObject):
+    """
+    链路质量ViewModel
+
+    职责：
+    - 连接期间按固定间隔发送PING
+    - 匹配PONG计算RTT（上位机时钟），超时未响应计为丢失
+    - 汇总飞控侧统计（RSSI、上行丢包、上行抖动）
+    - 发射link_stats_changed信号供View绑定
+
+    RTT包含飞控处理耗时与上位机事件循环延迟，飞控处理耗时由PONG中的
+    rx/tx时间戳单独给出。
+    """
+
+    link_stats_changed = pyqtSignal(dict)
+
+    PING_TIMEOUT_US = 1_000_000  # PONG超时（微秒），超时计为丢失
+    WINDOW = 100  # 统计窗口（最近N个PING）
+
+    def __init__(
+        self,
+        network_service: NetworkService,
+        protocol_service: ProtocolService,
+        ping_interval_ms: int = 200,
+    ):
+        super().__init__()
+
+        # Model
+        self._model = LinkHealthModel()
+
+        # Service
+        self._network_service = network_service
+        self._protocol_service = protocol_service
+
+        # 测量状态
+        self._seq = 0
+        self._pending: Dict[int, int] = {}  # seq -> 发送时间（微秒）
+        self._rtts = deque(maxlen=self.WINDOW)  # 最近的RTT（微秒）
+        self._outcomes = deque(maxlen=self.WINDOW)  # True=收到PONG, False=超时
+        self._last_rtt_us = None
+        self._jitter_us = 0.0
+
+        # 连接NetworkService信号
+        self._network_service.connected.connect(self._on_connected)
+        self._network_service.disconnected.connect(self._on_disconnected)
+        self._network_service.active_drone_changed.connect(self._on_active_drone_changed)
+
+        # PING定时器
+        self._ping_interval_ms = ping_interval_ms
+        self._ping_timer = QTimer()
+        self._ping_timer.timeout.connect(self._send_ping)
+
+    # ========== Properties ==========
+
+    @property
+    def model(self) -> LinkHealthModel:
+        """获取底层Model（只读）"""
+        return self._model
+
+    # ========== Slots ==========
+
+    @pyqtSlot(dict)
+    def on_pong_received(self, data: dict):
+        """处理PONG，计算RTT和抖动"""
+        sent_us = self._pending.pop(data.get("seq"), None)
+        if sent_us is None:
+            # 已超时或重复的响应
+            return
+
+        rtt_us = data["rx_host_us"] - sent_us
+        self._rtts.append(rtt_us)
+        self._outcomes.append(True)
+
+        # RTT抖动: J += (|D| - J) / 16 (RFC 3550)
+        if self._last_rtt_us is not None:
+            self._jitter_us += (abs(rtt_us - self._last_rtt_us) - self._jitter_us) / 16
+        self._last_rtt_us = rtt_us
+
+        m = self._model
+        m.rtt_last_ms = rtt_us / 1000
+        m.rtt_min_ms = min(self._rtts) / 1000
+        m.rtt_max_ms = max(self._rtts) / 1000
+        m.rtt_avg_ms = sum(self._rtts) / len(self._rtts) / 1000
+        m.jitter_ms = self._jitter_us / 1000
+        m.drone_rssi = data.get("rssi", 0)
+        m.uplink_lost = data.get("uplink_lost", 0)
+        m.uplink_jitter_ms = data.get("uplink_jitter_us", 0) / 1000
+        m.drone_processing_us = (data["tx_time_us"] - data["rx_time_us"]) & 0xFFFFFFFF
+        self._update_loss()
+
+        self.link_stats_changed.emit(m.to_dict())
+
+    # ========== Private Methods ==========
+
+    @staticmethod
+    def _now_us() -> int:
+        return time.perf_counter_ns() // 1000
+
+    def _send_ping(self):
+        """发送PING，并把超时的请求计为丢失"""
+        now = self._now_us()
+
+        expired = [s for s, t in self._pending.items() if now - t > self.PING_TIMEOUT_US]
+        for seq in expired:
+            del self._pending[seq]
+            self._outcomes.append(False)
+        if expired:
+            self._update_loss()
+            self.link_stats_changed.emit(self._model.to_dict())
+
+        seq = self._seq
+        self._seq = (self._seq + 1) & 0xFFFF
+        self._pending[seq] = now
+        self._network_service.send_packet(
+            self._protocol_service.build_ping_packet(seq, now)
+        )
+
+    def _update_loss(self):
+        m = self._model
+        m.sent = len(self._outcomes)
+        m.received = sum(self._outcomes)
+        m.loss_percent = 100.0 * (m.sent - m.received) / m.sent if m.sent else 0.0
+
+    def _on_connected(self):
+        """连接成功，开始测量"""
+        self._reset()
+        self._ping_timer.start(self._ping_interval_ms)
+
+    def _on_disconnected(self):
+        """断开连接，停止测量"""
+        self._ping_timer.stop()
+        self._reset()
+        self.link_stats_changed.emit(self._model.to_dict())
+
+    def _on_active_drone_changed(self, ip: str):
+        """切换无人机，重新开始测量（未返回的PING属于上一架）"""
+        self._reset()
+        self.link_stats_changed.emit(self._model.to_dict())
+
+    def _reset(self):
+        self._pending.clear()
+        self._rtts.clear()
+        self._outcomes.clear()
+        self._last_rtt_us = None
+        self._jitter_us = 0.0
+        self._model.reset()
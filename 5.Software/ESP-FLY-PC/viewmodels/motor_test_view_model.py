@@ -52,6 +52,11 @@ class MotorTestViewModel(QObject):
 
     # ========== Properties ==========
 
+    @property
+    def is_sending(self) -> bool:
+        """是否正在循环发送电机测试命令"""
+        return self._is_sending
+
     @property
     def motor1_pwm(self) -> int:
         return self._model.motor1_pwm
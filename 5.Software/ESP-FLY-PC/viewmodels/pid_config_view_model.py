@@ -122,6 +122,18 @@ class PidConfigViewModel(QObject):
                 config = self._model.rate_yaw
                 self.rate_yaw_changed.emit(config.kp, config.ki, config.kd)
 
+    @pyqtSlot(str, float, float)
+    def set_rate_pi_command(self, axis: str, kp: float, ki: float):
+        """
+        设置角速度环P、I参数命令（D参数保持不变，用于应用系统辨识的增益建议）
+
+        Args:
+            axis: 'roll', 'pitch', 'yaw'
+            kp, ki: PI参数值
+        """
+        config = self._model.get_axis_config("rate", axis)
+        self.set_pid_command("rate", axis, kp, ki, config.kd)
+
     @pyqtSlot()
     def send_config_command(self) -> bool:
         """发送PID配置到ESP32命令"""
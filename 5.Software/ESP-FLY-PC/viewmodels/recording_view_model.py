@@ -0,0 +1,269 @@
+"""
+RecordingViewModel - 记录回放ViewModel
+把实时遥测记录到文件；打开记录文件后按任意倍速回放，或跳转到任意时刻
+"""
+
+import os
+import time
+from datetime import datetime
+from typing import Optional
+
+from PyQt6.QtCore import QObject, QTimer, pyqtSignal, pyqtSlot
+
+from services.network_service import NetworkService
+from services.packet_defs import PacketType
+from services.protocol_service import ProtocolService
+from services.telemetry_decoder import TelemetryBatch, TelemetryDecoder
+from services.telemetry_recorder import FILE_EXTENSION, TelemetryLog, TelemetryRecorder
+
+REPLAY_INTERVAL_MS = 20  # 回放定时器间隔（与接收攒批时长相同）
+STATS_INTERVAL_MS = 1000  # 记录统计刷新间隔
+SEEK_RECORDS = 30000  # 跳转时预先载入的高频数据行数（与波形缓冲区容量相同）
+SEEK_STATE_WINDOW_US = 5_000_000  # 跳转时在该时间窗内查找最近一次的状态数据包
+
+# 跳转时补发的状态类数据包（每种只补发最近一次，控制台日志等不补发）
+SEEK_STATE_PACKETS = (PacketType.BATTERY_STATUS, PacketType.PID_RESPONSE)
+
+
+class RecordingViewModel(QObject):
+    """
+    记录回放ViewModel
+
+    职责：
+    - 开始/停止记录: 创建TelemetryRecorder并挂到当前无人机会话的TelemetryDecoder，
+      记录在接收线程中进行；切换无人机时结束记录（每个文件只包含一架无人机）
+    - 打开记录文件，按倍速把各时间段的数据组装成TelemetryBatch发出，
+      与实时数据走同一条路径（DroneViewModel.on_telemetry_batch）
+    - 跳转: 清空波形后载入跳转点之前SEEK_RECORDS行，波形按记录时间显示
+
+    回放只在未连接时进行，连接成功后自动关闭回放。
+    """
+
+    recording_changed = pyqtSignal(bool)
+    recording_stats_changed = pyqtSignal(dict)  # path, records, events, file_bytes, ratio
+    replay_opened = pyqtSignal(str, float)  # path（空字符串表示已关闭）, duration_s
+    replay_playing_changed = pyqtSignal(bool)
+    replay_position_changed = pyqtSignal(float)  # 秒
+    replay_batch = pyqtSignal(object)  # TelemetryBatch
+    waveform_reset = pyqtSignal(float)  # 跳转后波形第一帧的时间（秒）
+    error_occurred = pyqtSignal(str)
+
+    def __init__(
+        self,
+        network_service: NetworkService,
+        protocol_service: ProtocolService,
+        directory: str,
+    ):
+        super().__init__()
+
+        # Service
+        self._network_service = network_service
+        self._protocol_service = protocol_service
+
+        # 记录
+        self._directory = directory
+        self._recorder: Optional[TelemetryRecorder] = None
+        self._recording_decoder: Optional[TelemetryDecoder] = None
+        self._stats_timer = QTimer()
+        self._stats_timer.timeout.connect(self._emit_recording_stats)
+
+        # 回放
+        self._log: Optional[TelemetryLog] = None
+        self._position_us = 0
+        self._speed = 1.0
+        self._last_tick = 0.0
+        self._replay_timer = QTimer()
+        self._replay_timer.timeout.connect(self._on_replay_tick)
+
+        # 连接后实时数据优先
+        self._network_service.connected.connect(self.close_replay_command)
+        self._network_service.active_drone_changed.connect(self._on_active_drone_changed)
+
+    # ========== Properties ==========
+
+    @property
+    def is_recording(self) -> bool:
+        return self._recorder is not None
+
+    @property
+    def is_replaying(self) -> bool:
+        return self._log is not None
+
+    @property
+    def directory(self) -> str:
+        return self._directory
+
+    # ========== Commands: 记录 ==========
+
+    @pyqtSlot()
+    def start_recording_command(self):
+        """开始记录（文件名按当前时间生成）"""
+        if self._recorder is not None:
+            return
+
+        session = self._network_service.active_session
+        decoder = session.telemetry_decoder if session is not None else None
+        if decoder is None:
+            self.error_occurred.emit("当前无人机没有遥测解码器，无法记录")
+            return
+
+        name = datetime.now().strftime("flight_%Y%m%d_%H%M%S")
+        if len(self._network_service.sessions) > 1:
+            name += "_" + session.ip.replace(".", "-")
+        recorder = TelemetryRecorder(os.path.join(self._directory, name + FILE_EXTENSION))
+        try:
+            recorder.open()
+        except OSError as e:
+            self.error_occurred.emit(f"无法创建记录文件: {e}")
+            return
+
+        self._recorder = recorder
+        self._recording_decoder = decoder
+        decoder.set_recorder(recorder)
+        self._stats_timer.start(STATS_INTERVAL_MS)
+        self.recording_changed.emit(True)
+        self._emit_recording_stats()
+
+    @pyqtSlot()
+    def stop_recording_command(self):
+        """停止记录，写入索引并关闭文件"""
+        if self._recorder is None:
+            return
+
+        self._recording_decoder.set_recorder(None)
+        self._recording_decoder = None
+        self._stats_timer.stop()
+        try:
+            self._recorder.close()
+        except OSError as e:
+            self.error_occurred.emit(f"记录文件写入失败: {e}")
+        self._emit_recording_stats()
+        self._recorder = None
+        self.recording_changed.emit(False)
+
+    # ========== Commands: 回放 ==========
+
+    @pyqtSlot(str)
+    def open_replay_command(self, path: str):
+        """打开记录文件，定位到开头"""
+        if self._network_service.is_connected:
+            self.error_occurred.emit("请先断开连接再回放记录")
+            return
+
+        try:
+            log = TelemetryLog(path)
+        except (OSError, ValueError) as e:
+            self.error_occurred.emit(f"无法打开记录文件: {e}")
+            return
+
+        self.close_replay_command()
+        self._log = log
+        self.replay_opened.emit(path, log.duration_us / 1e6)
+        self.seek_command(0.0)
+
+    @pyqtSlot()
+    def close_replay_command(self):
+        """关闭回放"""
+        if self._log is None:
+            return
+
+        self.pause_command()
+        self._log.close()
+        self._log = None
+        self.replay_opened.emit("", 0.0)
+
+    @pyqtSlot()
+    def play_command(self):
+        """开始/继续回放（已到结尾时从头开始）"""
+        if self._log is None or self._replay_timer.isActive():
+            return
+
+        if self._position_us >= self._log.duration_us:
+            self.seek_command(0.0)
+        self._last_tick = time.perf_counter()
+        self._replay_timer.start(REPLAY_INTERVAL_MS)
+        self.replay_playing_changed.emit(True)
+
+    @pyqtSlot()
+    def pause_command(self):
+        """暂停回放"""
+        if self._replay_timer.isActive():
+            self._replay_timer.stop()
+            self.replay_playing_changed.emit(False)
+
+    @pyqtSlot(float)
+    def set_speed_command(self, speed: float):
+        """设置回放倍速"""
+        self._speed = max(speed, 0.01)
+
+    @pyqtSlot(float)
+    def seek_command(self, seconds: float):
+        """
+        跳转到记录中的某一时刻
+
+        清空波形后载入该时刻之前的SEEK_RECORDS行，并补发最近一次的电池状态和PID参数，
+        回放从该时刻继续
+        """
+        if self._log is None:
+            return
+
+        t_us = int(min(max(seconds, 0.0), self._log.duration_us / 1e6) * 1e6)
+        end = self._log.index_at(t_us)
+        rows_t, rows = self._log.read_rows(end - SEEK_RECORDS, end)
+
+        latest = {}
+        for event in self._log.events(max(0, t_us - SEEK_STATE_WINDOW_US), t_us):
+            if event[1] in SEEK_STATE_PACKETS:
+                latest[event[1]] = event
+
+        self.waveform_reset.emit(rows_t[0] / 1e6 if len(rows_t) else t_us / 1e6)
+        self._emit_batch(rows_t, rows, sorted(latest.values()))
+        self._position_us = t_us
+        self._last_tick = time.perf_counter()
+        self.replay_position_changed.emit(t_us / 1e6)
+
+    # ========== Private Methods ==========
+
+    def _on_active_drone_changed(self, ip: str):
+        """切换无人机后结束当前记录"""
+        self.stop_recording_command()
+
+    def _on_replay_tick(self):
+        """按实际经过的时间×倍速推进回放位置"""
+        now = time.perf_counter()
+        t0 = self._position_us
+        t1 = t0 + int((now - self._last_tick) * self._speed * 1e6)
+        self._last_tick = now
+
+        rows_t, rows = self._log.read(t0, t1)
+        self._emit_batch(rows_t, rows, self._log.events(t0, t1))
+        self._position_us = min(t1, self._log.duration_us)
+        self.replay_position_changed.emit(self._position_us / 1e6)
+
+        if t1 > self._log.duration_us:
+            self.pause_command()
+
+    def _emit_batch(self, rows_t, rows, events):
+        """把记录中的一段数据组装成TelemetryBatch发出"""
+        packets = []
+        for _, packet_id, payload in events:
+            packet = self._protocol_service.decode_frame(packet_id, payload)
+            if packet is not None:
+                packets.append(packet)
+        if len(rows) == 0 and not packets:
+            return
+
+        self.replay_batch.emit(
+            TelemetryBatch(
+                high_freq=rows,
+                packets=packets,
+                high_freq_rx_us=rows_t,
+                frames=list(events),
+            )
+        )
+
+    def _emit_recording_stats(self):
+        if self._recorder is not None:
+            stats = self._recorder.get_stats()
+            stats["path"] = self._recorder.path
+            self.recording_stats_changed.emit(stats)
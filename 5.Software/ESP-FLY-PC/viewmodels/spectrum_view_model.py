@@ -0,0 +1,97 @@
+"""
+SpectrumViewModel - 频谱分析ViewModel
+对高频数据增量计算陀螺仪/D项/PID输出的功率谱密度和油门-频率谱图
+"""
+
+from PyQt6.QtCore import QObject, QTimer, pyqtSignal, pyqtSlot
+
+from services.spectrum_analyzer import AXES, SIGNALS, SpectrumAnalyzer
+
+UPDATE_INTERVAL_MS = 200  # 频谱显示刷新间隔（有新分段时）
+
+
+class SpectrumViewModel(QObject):
+    """
+    频谱分析ViewModel
+
+    职责：
+    - 每批高频数据追加到SpectrumAnalyzer（只计算新凑满的分段）
+    - 按UPDATE_INTERVAL_MS节流，发出当前所选信号三个轴的PSD和所选轴的油门谱图
+    - 连接、清空波形或回放跳转后重新开始
+
+    实时数据和回放数据都来自DroneViewModel.high_freq_block_changed
+    """
+
+    spectrum_changed = pyqtSignal(dict)  # fs, segment_length, segments, skipped, freqs, psd{axis: 数组}
+    spectrogram_changed = pyqtSignal(dict)  # freqs, matrix(油门档×频点), counts
+
+    def __init__(self):
+        super().__init__()
+        self._analyzer = SpectrumAnalyzer()
+        self._signal = SIGNALS[0]
+        self._axis = AXES[0][0]
+        self._dirty = False
+
+        self._update_timer = QTimer()
+        self._update_timer.timeout.connect(self._emit_spectrum)
+        self._update_timer.start(UPDATE_INTERVAL_MS)
+
+    # ========== Commands ==========
+
+    @pyqtSlot(str, str)
+    def select_command(self, signal: str, axis: str):
+        """
+        选择显示的信号和谱图的轴
+
+        Args:
+            signal: SIGNALS之一（gyro/dterm/control）
+            axis: roll/pitch/yaw
+        """
+        self._signal = signal
+        self._axis = axis
+        self._dirty = True
+        self._emit_spectrum()
+
+    @pyqtSlot()
+    def reset_command(self):
+        """清空频谱，重新估计采样率"""
+        self._analyzer.reset()
+        self._dirty = True
+        self._emit_spectrum()
+
+    # ========== Event Handlers ==========
+
+    @pyqtSlot(object)
+    def on_high_freq_block(self, block):
+        """追加一批高频数据（WAVEFORM_DTYPE结构化数组）"""
+        if self._analyzer.extend(block):
+            self._dirty = True
+
+    # ========== Private Methods ==========
+
+    def _emit_spectrum(self):
+        if not self._dirty:
+            return
+        self._dirty = False
+
+        analyzer = self._analyzer
+        psd = analyzer.psd() or {}
+        self.spectrum_changed.emit(
+            {
+                "fs": analyzer.sample_rate,
+                "segment_length": analyzer.segment_length,
+                "segments": analyzer.segments,
+                "skipped": analyzer.skipped,
+                "freqs": analyzer.freqs,
+                "psd": {
+                    axis[0]: psd[f"{self._signal}_{axis[0]}"]
+                    for axis in AXES
+                    if f"{self._signal}_{axis[0]}" in psd
+                },
+            }
+        )
+
+        matrix, counts = analyzer.spectrogram(f"{self._signal}_{self._axis}")
+        self.spectrogram_changed.emit(
+            {"freqs": analyzer.freqs, "matrix": matrix, "counts": counts}
+        )
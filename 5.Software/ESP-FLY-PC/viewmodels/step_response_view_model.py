@@ -0,0 +1,117 @@
+"""
+StepResponseViewModel - 阶跃响应分析ViewModel
+从飞行中的期望角速度和陀螺仪估计各轴阶跃响应，发送新PID参数后与上一组参数的结果对比
+"""
+
+import numpy as np
+from PyQt6.QtCore import QObject, QTimer, pyqtSignal, pyqtSlot
+
+from services.flight_analysis import RATE_AXES
+from services.ring_buffer import ColumnRingBuffer
+from services import step_response
+
+BUFFER_CAPACITY = 60000  # 参与分析的最近样本数（50Hz约20分钟，1kHz约60秒）
+ANALYZE_INTERVAL_MS = 1000  # 有新数据时重新分析的间隔
+
+
+class StepResponseViewModel(QObject):
+    """
+    阶跃响应分析ViewModel
+
+    职责：
+    - 缓存高频数据中的期望角速度和陀螺仪（实时和回放）
+    - 每秒对缓存的全部数据做一次整批反卷积（step_response.analyze_axes）
+    - 发送新的PID参数后：当前结果转为基线，清空缓存，之后的数据只反映新参数
+    """
+
+    result_changed = pyqtSignal(dict)  # current, baseline（分析结果或None）, current_gains, baseline_gains
+
+    def __init__(self):
+        super().__init__()
+        columns = ["timestamp"]
+        for axis, *_ in RATE_AXES:
+            columns += [f"{axis}_setpoint", f"{axis}_gyro"]
+        self._buffer = ColumnRingBuffer(BUFFER_CAPACITY, columns)
+        self._dirty = False
+
+        self._current = None
+        self._current_gains = None  # 轴名 → (kp, ki, kd)，None表示未发送过
+        self._baseline = None
+        self._baseline_gains = None
+
+        self._analyze_timer = QTimer()
+        self._analyze_timer.timeout.connect(self._analyze)
+        self._analyze_timer.start(ANALYZE_INTERVAL_MS)
+
+    # ========== Commands ==========
+
+    @pyqtSlot(dict)
+    def gains_changed_command(self, gains: dict):
+        """
+        已发送新的角速度环参数：当前结果作为基线，重新开始收集
+
+        Args:
+            gains: 轴名 → (kp, ki, kd)
+        """
+        if self._current is not None:
+            self._baseline = self._current
+            self._baseline_gains = self._current_gains
+        self._current_gains = dict(gains)
+        self.clear_command()
+
+    @pyqtSlot()
+    def set_baseline_command(self):
+        """把当前结果设为基线"""
+        if self._current is None:
+            return
+        self._baseline = self._current
+        self._baseline_gains = self._current_gains
+        self._emit_result()
+
+    @pyqtSlot()
+    def clear_command(self):
+        """清空缓存的数据和当前结果（保留基线）"""
+        self._buffer.clear()
+        self._current = None
+        self._dirty = False
+        self._emit_result()
+
+    # ========== Event Handlers ==========
+
+    @pyqtSlot(object)
+    def on_high_freq_block(self, block):
+        """追加一批高频数据（WAVEFORM_DTYPE结构化数组）"""
+        if len(block) == 0:
+            return
+        rows = np.empty((len(block), len(self._buffer.columns)), dtype=np.float64)
+        rows[:, 0] = block["timestamp"]
+        for i, (_, desired, gyro, sign) in enumerate(RATE_AXES):
+            rows[:, 1 + 2 * i] = block[desired]
+            rows[:, 2 + 2 * i] = sign * block[gyro]
+        self._buffer.extend(rows)
+        self._dirty = True
+
+    # ========== Private Methods ==========
+
+    def _analyze(self):
+        if not self._dirty:
+            return
+        self._dirty = False
+
+        buffer = self._buffer
+        self._current = step_response.analyze_axes(
+            buffer.view("timestamp").astype(np.int64),
+            {axis: buffer.view(f"{axis}_setpoint") for axis, *_ in RATE_AXES},
+            {axis: buffer.view(f"{axis}_gyro") for axis, *_ in RATE_AXES},
+        )
+        self._emit_result()
+
+    def _emit_result(self):
+        self.result_changed.emit(
+            {
+                "current": self._current,
+                "baseline": self._baseline,
+                "current_gains": self._current_gains,
+                "baseline_gains": self._baseline_gains,
+            }
+        )
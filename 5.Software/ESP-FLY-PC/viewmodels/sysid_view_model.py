@@ -0,0 +1,225 @@
+"""
+SysidViewModel - 系统辨识ViewModel
+发送阶跃/扫频辨识请求，收集飞控返回的频率响应与原始记录，估计带宽和延迟并给出角速度环增益建议
+"""
+
+from typing import Dict, List, Optional
+
+import numpy as np
+from PyQt6.QtCore import QObject, pyqtSignal, pyqtSlot
+
+from services import sysid_analysis
+from services.network_service import NetworkService
+from services.packet_defs import PacketType
+from services.protocol_service import ProtocolService
+
+AXES = ("roll", "pitch", "yaw")
+
+SIGNAL_STEP = 0
+SIGNAL_CHIRP = 1
+SIGNAL_ABORT = 255
+
+# SYSID_STATUS.state
+STATE_DONE = 0
+STATE_RUNNING = 1
+STATE_ANALYZING = 2
+STATE_REJECTED = 3
+STATE_ABORTED = 4
+
+# SYSID_STATUS.reason（与固件sysid.h一致）
+REASON_TEXT = {
+    1: "上一次辨识尚未结束",
+    2: "零偏校准未完成",
+    3: "参数超出范围",
+    4: "飞控内存不足",
+    5: "油门为0或飞行指令超时",
+    6: "倾角超限",
+    7: "已手动中止",
+}
+
+MAX_MISSING_RATIO = 0.05  # 原始记录丢包超过该比例时不做时域分析
+
+
+class SysidViewModel(QObject):
+    """
+    系统辨识ViewModel
+
+    职责：
+    - 构建并发送SYSID_REQUEST（开始/中止）
+    - 按序号收集SYSID_SAMPLES，收集SYSID_FRF频点
+    - 收到完成状态后调用sysid_analysis分析，发射结果信号供View绑定
+    - 应用建议时发射rate_gains_suggested，由PidConfigViewModel更新角速度环参数
+    """
+
+    status_changed = pyqtSignal(str)
+    running_changed = pyqtSignal(bool)
+    frequency_response_changed = pyqtSignal(dict)  # freq, closed_db, plant_db, coherence
+    time_response_changed = pyqtSignal(dict)  # t, rate, gyro
+    result_changed = pyqtSignal(dict)
+    rate_gains_suggested = pyqtSignal(str, float, float)  # axis, kp, ki
+
+    def __init__(self, network_service: NetworkService, protocol_service: ProtocolService):
+        super().__init__()
+
+        # Service
+        self._network_service = network_service
+        self._protocol_service = protocol_service
+
+        # 当前辨识
+        self._axis = 0
+        self._signal = SIGNAL_STEP
+        self._sample_rate_hz = 500
+        self._samples: Optional[np.ndarray] = None
+        self._received: Optional[np.ndarray] = None
+        self._bins: Dict[int, dict] = {}
+        self._suggestion: Optional[dict] = None
+
+    # ========== Commands ==========
+
+    @pyqtSlot(int, int, float, float, float, int)
+    def start_command(
+        self,
+        axis: int,
+        signal: int,
+        amplitude: float,
+        f_start: float,
+        f_end: float,
+        duration_ms: int,
+    ):
+        """发送辨识请求"""
+        if not self._network_service.is_connected:
+            self.status_changed.emit("未连接")
+            return
+
+        self._axis = axis
+        self._signal = signal
+        self._samples = None
+        self._received = None
+        self._bins.clear()
+        self._suggestion = None
+
+        self._network_service.send_packet(
+            self._protocol_service.build_sysid_request_packet(
+                axis, signal, duration_ms, amplitude, f_start, f_end
+            )
+        )
+        self.status_changed.emit("已发送辨识请求...")
+
+    @pyqtSlot()
+    def abort_command(self):
+        """中止正在进行的激励"""
+        if self._network_service.is_connected:
+            self._network_service.send_packet(
+                self._protocol_service.build_sysid_request_packet(self._axis, SIGNAL_ABORT)
+            )
+
+    @pyqtSlot()
+    def apply_suggestion_command(self):
+        """把增益建议写入角速度环参数（D参数不变）"""
+        if self._suggestion:
+            self.rate_gains_suggested.emit(
+                AXES[self._axis], self._suggestion["kp"], self._suggestion["ki"]
+            )
+
+    # ========== Slots ==========
+
+    @pyqtSlot(int, dict)
+    def on_sysid_packet(self, packet_type: int, data: dict):
+        """处理飞控返回的辨识数据包"""
+        if packet_type == PacketType.SYSID_STATUS:
+            self._on_status(data)
+        elif packet_type == PacketType.SYSID_FRF:
+            self._bins[data["bin"]] = data
+        elif packet_type == PacketType.SYSID_SAMPLES and self._samples is not None:
+            index = data["index"]
+            rows = data["samples"][: max(0, len(self._samples) - index)]
+            if rows:
+                self._samples[index : index + len(rows)] = rows
+                self._received[index : index + len(rows)] = True
+
+    # ========== Private Methods ==========
+
+    def _on_status(self, data: dict):
+        state = data["state"]
+        self._axis = data["axis"]
+        self._signal = data["signal"]
+
+        if state == STATE_RUNNING:
+            self._sample_rate_hz = data["sample_rate_hz"] or 500
+            count = data["sample_count"]
+            self._samples = np.zeros((count, 3), dtype=np.float64)
+            self._received = np.zeros(count, dtype=bool)
+            self.running_changed.emit(True)
+            self.status_changed.emit(
+                f"激励中: {AXES[self._axis]}轴, {count / self._sample_rate_hz:.1f} s"
+            )
+        elif state == STATE_ANALYZING:
+            self.status_changed.emit("飞控分析中，接收数据...")
+        elif state == STATE_DONE:
+            self.running_changed.emit(False)
+            self._analyze()
+        else:
+            self.running_changed.emit(False)
+            action = "请求被拒绝" if state == STATE_REJECTED else "辨识已中止"
+            self.status_changed.emit(f"{action}: {REASON_TEXT.get(data['reason'], '未知原因')}")
+
+    def _analyze(self):
+        result = {"axis": AXES[self._axis], "signal": self._signal}
+        messages: List[str] = []
+
+        if self._bins:
+            bins = [self._bins[k] for k in sorted(self._bins)]
+            self.frequency_response_changed.emit(
+                {
+                    "freq": [b["freq"] for b in bins],
+                    "closed_db": [20 * np.log10(max(b["closed_gain"], 1e-6)) for b in bins],
+                    "plant_db": [20 * np.log10(max(b["plant_gain"], 1e-9)) for b in bins],
+                    "coherence": [b["coherence"] for b in bins],
+                }
+            )
+            result.update(sysid_analysis.analyze_frequency_response(bins))
+            self._suggestion = sysid_analysis.suggest_rate_gains(
+                result["plant_k"], result["delay_ms"]
+            )
+            if self._suggestion:
+                result.update(
+                    {f"suggested_{k}": v for k, v in self._suggestion.items()}
+                )
+            else:
+                messages.append("相干频点不足，无法给出增益建议")
+
+        if self._samples is not None and len(self._samples):
+            missing = int(np.count_nonzero(~self._received))
+            result["missing_samples"] = missing
+            if missing <= len(self._samples) * MAX_MISSING_RATIO:
+                samples = self._fill_missing()
+                t = np.arange(len(samples)) / self._sample_rate_hz
+                self.time_response_changed.emit(
+                    {
+                        "t": t.tolist(),
+                        "rate": samples[:, 0].tolist(),
+                        "gyro": samples[:, 1].tolist(),
+                    }
+                )
+                if self._signal == SIGNAL_STEP:
+                    result.update(
+                        sysid_analysis.analyze_step(samples, self._sample_rate_hz)
+                    )
+            else:
+                messages.append(f"原始记录丢失{missing}个样本，跳过时域分析")
+
+        self.result_changed.emit(result)
+        self.status_changed.emit("辨识完成" + ("，" + "；".join(messages) if messages else ""))
+
+    def _fill_missing(self) -> np.ndarray:
+        """丢失的样本按相邻样本线性插值"""
+        samples = self._samples.copy()
+        if self._received.all() or not self._received.any():
+            return samples
+
+        index = np.arange(len(samples))
+        for c in range(samples.shape[1]):
+            samples[~self._received, c] = np.interp(
+                index[~self._received], index[self._received], samples[self._received, c]
+            )
+        return samples
@@ -5,6 +5,7 @@ Views - 视图层
 
 from .main_view import MainView
 from .status_view import StatusView
+from .link_health_view import LinkHealthView
 from .control_view import ControlView
 from .pid_view import PidView
 from .motor_test_view import MotorTestView
@@ -15,6 +16,7 @@ from .attitude_3d_view import Attitude3DView
 __all__ = [
     'MainView',
     'StatusView',
+    'LinkHealthView',
     'ControlView',
     'PidView',
     'MotorTestView',
@@ -0,0 +1,146 @@
+"""
+FleetView - 多机面板
+列出所有无人机会话的状态，切换当前无人机，并叠加显示各机的同一通道
+"""
+
+from PyQt6.QtWidgets import (
+    QWidget,
+    QVBoxLayout,
+    QHBoxLayout,
+    QLabel,
+    QComboBox,
+    QPushButton,
+    QTableWidget,
+    QTableWidgetItem,
+    QHeaderView,
+    QAbstractItemView,
+)
+from PyQt6.QtCore import pyqtSignal, pyqtSlot
+from PyQt6.QtGui import QFont
+import pyqtgraph as pg
+
+CHANNEL_ITEMS = (
+    ("roll", "Roll (°)"),
+    ("pitch", "Pitch (°)"),
+    ("yaw", "Yaw (°)"),
+    ("gyro_x", "Gyro X (°/s)"),
+    ("gyro_y", "Gyro Y (°/s)"),
+    ("gyro_z", "Gyro Z (°/s)"),
+    ("acc_z", "Acc Z (g)"),
+)
+CURVE_COLORS = ("#f44336", "#4caf50", "#2196f3", "#ff9800", "#9c27b0", "#00bcd4")
+TABLE_HEADERS = ("无人机", "状态", "电池", "姿态 R/P/Y (°)", "高频速率", "收包")
+
+
+class FleetView(QWidget):
+    """
+    多机面板View（纯View，无业务逻辑）
+
+    上方: 每架无人机一行，双击或点击"设为当前"切换当前无人机
+    下方: 所选通道各机最近的曲线叠加（横轴为相对当前时刻的秒数）
+    """
+
+    # 用户操作信号
+    drone_selected = pyqtSignal(str)  # ip
+    channel_changed = pyqtSignal(str)
+    clear_requested = pyqtSignal()
+
+    def __init__(self, parent=None):
+        super().__init__(parent)
+        self._ips = []
+        self._curves = {}
+        self._init_ui()
+
+    def _init_ui(self):
+        """初始化UI"""
+        layout = QVBoxLayout(self)
+        layout.setContentsMargins(5, 5, 5, 5)
+
+        # 无人机列表
+        self._table = QTableWidget(0, len(TABLE_HEADERS))
+        self._table.setHorizontalHeaderLabels(TABLE_HEADERS)
+        self._table.horizontalHeader().setSectionResizeMode(QHeaderView.ResizeMode.Stretch)
+        self._table.verticalHeader().setVisible(False)
+        self._table.setSelectionBehavior(QAbstractItemView.SelectionBehavior.SelectRows)
+        self._table.setSelectionMode(QAbstractItemView.SelectionMode.SingleSelection)
+        self._table.setEditTriggers(QAbstractItemView.EditTrigger.NoEditTriggers)
+        self._table.cellDoubleClicked.connect(lambda row, _: self._select_row(row))
+        layout.addWidget(self._table)
+
+        control_layout = QHBoxLayout()
+        select_btn = QPushButton("设为当前")
+        select_btn.clicked.connect(lambda: self._select_row(self._table.currentRow()))
+        control_layout.addWidget(select_btn)
+
+        self._channel_combo = QComboBox()
+        self._channel_combo.addItems([text for _, text in CHANNEL_ITEMS])
+        self._channel_combo.currentIndexChanged.connect(
+            lambda index: self.channel_changed.emit(CHANNEL_ITEMS[index][0])
+        )
+        control_layout.addWidget(QLabel("叠加通道:"))
+        control_layout.addWidget(self._channel_combo)
+        control_layout.addStretch()
+
+        clear_btn = QPushButton("清空曲线")
+        clear_btn.clicked.connect(self.clear_requested.emit)
+        control_layout.addWidget(clear_btn)
+        layout.addLayout(control_layout)
+
+        # 各机叠加曲线
+        self._plot = pg.PlotWidget()
+        self._plot.setBackground("#1a1a1a")
+        self._plot.setLabel("bottom", "时间", units="s", color="w")
+        self._plot.showGrid(x=True, y=True, alpha=0.3)
+        self._plot.addLegend()
+        layout.addWidget(self._plot, 1)
+
+        hint = QLabel("其他面板（波形、3D、控制、PID、记录等）作用于当前无人机；切换前会先停止对上一架的控制和电机测试。")
+        hint.setWordWrap(True)
+        layout.addWidget(hint)
+
+    def _select_row(self, row: int):
+        if 0 <= row < len(self._ips):
+            self.drone_selected.emit(self._ips[row])
+
+    def _curve(self, ip: str):
+        curve = self._curves.get(ip)
+        if curve is None:
+            color = CURVE_COLORS[len(self._curves) % len(CURVE_COLORS)]
+            curve = self._plot.plot(pen=pg.mkPen(color, width=2), name=ip)
+            self._curves[ip] = curve
+        return curve
+
+    # ========== Data Binding Slots ==========
+
+    @pyqtSlot(list)
+    def update_fleet(self, drones: list):
+        """更新无人机列表"""
+        self._ips = [drone["ip"] for drone in drones]
+        if self._table.rowCount() != len(drones):
+            self._table.setRowCount(len(drones))
+
+        for row, drone in enumerate(drones):
+            attitude, battery = drone["attitude"], drone["battery"]
+            cells = (
+                ("● " if drone["active"] else "") + drone["ip"],
+                "在线" if drone["online"] else "离线",
+                f"{battery[0]:.2f}V {battery[1]}%" if battery else "--",
+                "/".join(f"{v:.1f}" for v in attitude) if attitude else "--",
+                f"{drone['hf_rate']:.0f} Hz",
+                str(drone["recv_packets"]),
+            )
+            for col, text in enumerate(cells):
+                item = self._table.item(row, col)
+                if item is None:
+                    item = QTableWidgetItem()
+                    self._table.setItem(row, col, item)
+                item.setText(text)
+                font = QFont(item.font())
+                font.setBold(drone["active"])
+                item.setFont(font)
+
+    @pyqtSlot(dict)
+    def update_overlay(self, overlay: dict):
+        """更新叠加曲线"""
+        for ip, (t, values) in overlay["curves"].items():
+            self._curve(ip).setData(t, values)
@@ -0,0 +1,127 @@
+"""
+LinkHealthView - 链路质量面板
+显示往返时延、抖动、丢包率以及飞控侧测得的RSSI和上行统计
+"""
+
+from PyQt6.QtWidgets import (
+    QWidget,
+    QVBoxLayout,
+    QGridLayout,
+    QGroupBox,
+    QLabel,
+)
+from PyQt6.QtCore import pyqtSlot
+
+
+class LinkHealthView(QWidget):
+    """
+    链路质量面板（纯View，无业务逻辑）
+
+    通过pyqtSlot接收LinkHealthViewModel的统计信号自动更新UI
+    """
+
+    def __init__(self, parent=None):
+        super().__init__(parent)
+        self._labels = {}
+        self._init_ui()
+
+    def _init_ui(self):
+        """初始化UI"""
+        layout = QVBoxLayout(self)
+
+        layout.addWidget(
+            self._create_group(
+                "往返时延（上位机测量）",
+                [
+                    ("rtt_last_ms", "当前RTT:"),
+                    ("rtt_min_ms", "最小RTT:"),
+                    ("rtt_avg_ms", "平均RTT:"),
+                    ("rtt_max_ms", "最大RTT:"),
+                    ("jitter_ms", "RTT抖动:"),
+                    ("loss_percent", "丢包率:"),
+                ],
+            )
+        )
+        layout.addWidget(
+            self._create_group(
+                "飞控侧统计",
+                [
+                    ("drone_rssi", "飞控测得RSSI:"),
+                    ("pc_rssi", "上位机测得RSSI:"),
+                    ("uplink_lost", "上行丢包数:"),
+                    ("uplink_jitter_ms", "上行抖动:"),
+                    ("drone_processing_us", "飞控处理耗时:"),
+                ],
+            )
+        )
+
+        layout.addStretch()
+
+    def _create_group(self, title: str, rows: list) -> QGroupBox:
+        """创建统计组"""
+        group = QGroupBox(title)
+        grid = QGridLayout(group)
+
+        for row, (key, text) in enumerate(rows):
+            grid.addWidget(QLabel(text), row, 0)
+            value_label = QLabel("--")
+            grid.addWidget(value_label, row, 1)
+            self._labels[key] = value_label
+
+        grid.setColumnStretch(1, 1)
+        return group
+
+    # ========== Data Binding Slots ==========
+
+    @pyqtSlot(dict)
+    def update_link_stats(self, stats: dict):
+        """更新链路统计"""
+        if stats.get("received", 0) == 0:
+            for key, label in self._labels.items():
+                if key != "pc_rssi":
+                    label.setText("--")
+                    label.setStyleSheet("")
+            if stats.get("sent", 0) > 0:
+                self._set_loss(stats["loss_percent"], stats["sent"])
+            return
+
+        for key in ("rtt_last_ms", "rtt_min_ms", "rtt_avg_ms", "rtt_max_ms", "jitter_ms"):
+            self._labels[key].setText(f"{stats[key]:.1f} ms")
+        self._set_loss(stats["loss_percent"], stats["sent"])
+
+        self._set_rssi(self._labels["drone_rssi"], stats["drone_rssi"])
+        self._labels["uplink_lost"].setText(str(stats["uplink_lost"]))
+        self._labels["uplink_jitter_ms"].setText(f"{stats['uplink_jitter_ms']:.1f} ms")
+        self._labels["drone_processing_us"].setText(f"{stats['drone_processing_us']} us")
+
+    @pyqtSlot(int)
+    def update_signal_strength(self, rssi: int):
+        """更新上位机侧信号强度"""
+        self._set_rssi(self._labels["pc_rssi"], rssi)
+
+    def _set_loss(self, loss_percent: float, sent: int):
+        label = self._labels["loss_percent"]
+        label.setText(f"{loss_percent:.1f} % ({sent}个)")
+
+        if loss_percent < 1.0:
+            color = "#4caf50"  # 绿色
+        elif loss_percent < 5.0:
+            color = "#ff9800"  # 橙色
+        else:
+            color = "#d32f2f"  # 红色
+        label.setStyleSheet(f"color: {color};")
+
+    def _set_rssi(self, label: QLabel, rssi: int):
+        if rssi == 0:
+            label.setText("-- dBm")
+            label.setStyleSheet("")
+            return
+
+        label.setText(f"{rssi} dBm")
+        if rssi >= -50:
+            color = "#4caf50"  # 绿色 - 信号很好
+        elif rssi >= -70:
+            color = "#ff9800"  # 橙色 - 信号一般
+        else:
+            color = "#d32f2f"  # 红色 - 信号较差
+        label.setStyleSheet(f"color: {color};")
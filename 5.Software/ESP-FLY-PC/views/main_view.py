@@ -22,10 +22,14 @@ from PyQt6.QtGui import QIcon
 
 from common.resource_path import resource_path
 from .status_view import StatusView
+from .link_health_view import LinkHealthView
 from .control_view import ControlView
 from .pid_view import PidView
 from .motor_test_view import MotorTestView
 from .terminal_view import TerminalView
+from .recording_view import RecordingView
+from .spectrum_view import SpectrumView
+from .fleet_view import FleetView
 from .waveform_view import WaveformView
 from .attitude_3d_view import Attitude3DView
 
@@ -35,8 +39,8 @@ class MainView(QMainWindow):
     主窗口View
 
     组合所有子View，提供：
-    - 左侧：3D姿态显示 + 波形显示
-    - 右侧：Tab页签（状态/控制/电机测试/PID/终端）
+    - 左侧：3D姿态显示 / 波形显示 / 频谱分析 / 多机
+    - 右侧：Tab页签（状态/控制/电机测试/PID/终端/记录回放）
     - 连接/断开按钮
     """
 
@@ -49,11 +53,15 @@ class MainView(QMainWindow):
 
         # 子View引用
         self.status_view = None
+        self.link_health_view = None
         self.control_view = None
         self.pid_view = None
         self.motor_test_view = None
         self.terminal_view = None
+        self.recording_view = None
         self.waveform_view = None
+        self.spectrum_view = None
+        self.fleet_view = None
         self.attitude_3d_view = None
 
         self._init_ui()
@@ -96,7 +104,7 @@ class MainView(QMainWindow):
         self.main_splitter = main_splitter
 
     def _create_visualization_area(self) -> QWidget:
-        """创建可视化区域 - 3D视图和波形面板切换显示"""
+        """创建可视化区域 - 3D视图、波形面板、频谱分析和多机面板切换显示"""
         widget = QWidget()
         layout = QVBoxLayout(widget)
         layout.setContentsMargins(5, 5, 5, 5)
@@ -106,10 +114,14 @@ class MainView(QMainWindow):
 
         self.view_3d_btn = QRadioButton("3D姿态视图")
         self.view_waveform_btn = QRadioButton("波形面板")
+        self.view_spectrum_btn = QRadioButton("频谱分析")
+        self.view_fleet_btn = QRadioButton("多机")
         self.view_3d_btn.setChecked(True)  # 默认显示3D视图
 
         button_layout.addWidget(self.view_3d_btn)
         button_layout.addWidget(self.view_waveform_btn)
+        button_layout.addWidget(self.view_spectrum_btn)
+        button_layout.addWidget(self.view_fleet_btn)
         button_layout.addStretch()
 
         layout.addLayout(button_layout)
@@ -130,6 +142,14 @@ class MainView(QMainWindow):
         self.waveform_view = WaveformView()
         self.view_stack.addWidget(self.waveform_view)
 
+        # 频谱分析面板
+        self.spectrum_view = SpectrumView()
+        self.view_stack.addWidget(self.spectrum_view)
+
+        # 多机面板
+        self.fleet_view = FleetView()
+        self.view_stack.addWidget(self.fleet_view)
+
         view_group_layout.addWidget(self.view_stack)
         layout.addWidget(view_group)
 
@@ -140,6 +160,12 @@ class MainView(QMainWindow):
         self.view_waveform_btn.toggled.connect(
             lambda checked: self.view_stack.setCurrentIndex(1) if checked else None
         )
+        self.view_spectrum_btn.toggled.connect(
+            lambda checked: self.view_stack.setCurrentIndex(2) if checked else None
+        )
+        self.view_fleet_btn.toggled.connect(
+            lambda checked: self.view_stack.setCurrentIndex(3) if checked else None
+        )
 
         return widget
 
@@ -156,6 +182,10 @@ class MainView(QMainWindow):
         self.status_view = StatusView()
         tab_widget.addTab(self.status_view, "状态信息")
 
+        # 链路质量面板
+        self.link_health_view = LinkHealthView()
+        tab_widget.addTab(self.link_health_view, "链路质量")
+
         # 控制面板
         self.control_view = ControlView()
         tab_widget.addTab(self.control_view, "飞行控制")
@@ -172,6 +202,10 @@ class MainView(QMainWindow):
         self.terminal_view = TerminalView()
         tab_widget.addTab(self.terminal_view, "终端监控")
 
+        # 记录回放
+        self.recording_view = RecordingView()
+        tab_widget.addTab(self.recording_view, "记录回放")
+
         layout.addWidget(tab_widget)
 
         # 连接按钮
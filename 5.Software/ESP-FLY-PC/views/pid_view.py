@@ -16,6 +16,9 @@ from PyQt6.QtWidgets import (
 from PyQt6.QtCore import pyqtSignal, pyqtSlot, QTimer
 from PyQt6.QtGui import QMouseEvent
 
+from .sysid_view import SysidView
+from .step_response_view import StepResponseView
+
 
 class EditableDoubleSpinBox(QDoubleSpinBox):
     """
@@ -70,6 +73,14 @@ class PidView(QWidget):
         rate_tab = self._create_pid_tab("rate")
         tab_widget.addTab(rate_tab, "角速度环 (内环)")
 
+        # 角速度环系统辨识
+        self.sysid_view = SysidView()
+        tab_widget.addTab(self.sysid_view, "系统辨识")
+
+        # 飞行数据阶跃响应
+        self.step_response_view = StepResponseView()
+        tab_widget.addTab(self.step_response_view, "阶跃响应")
+
         layout.addWidget(tab_widget)
 
         # 控制按钮
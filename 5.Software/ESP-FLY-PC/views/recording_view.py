@@ -0,0 +1,199 @@
+"""
+RecordingView - 记录回放面板
+开始/停止记录遥测，打开记录文件回放（倍速、暂停、拖动跳转）
+"""
+
+import os
+
+from PyQt6.QtWidgets import (
+    QWidget,
+    QVBoxLayout,
+    QHBoxLayout,
+    QGridLayout,
+    QGroupBox,
+    QLabel,
+    QComboBox,
+    QPushButton,
+    QSlider,
+    QFileDialog,
+)
+from PyQt6.QtCore import Qt, pyqtSignal, pyqtSlot
+
+SPEEDS = (0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 64.0)
+
+
+def _format_time(seconds: float) -> str:
+    seconds = int(seconds)
+    hours, rest = divmod(seconds, 3600)
+    return f"{hours}:{rest // 60:02d}:{rest % 60:02d}" if hours else f"{rest // 60:02d}:{rest % 60:02d}"
+
+
+class RecordingView(QWidget):
+    """
+    记录回放面板View（纯View，无业务逻辑）
+
+    用户操作通过信号发送给RecordingViewModel
+    """
+
+    # 用户操作信号
+    start_recording_requested = pyqtSignal()
+    stop_recording_requested = pyqtSignal()
+    open_requested = pyqtSignal(str)  # 记录文件路径
+    close_requested = pyqtSignal()
+    play_requested = pyqtSignal()
+    pause_requested = pyqtSignal()
+    speed_changed = pyqtSignal(float)
+    seek_requested = pyqtSignal(float)  # 秒
+
+    def __init__(self, parent=None):
+        super().__init__(parent)
+        self._recording = False
+        self._playing = False
+        self._directory = ""
+        self._duration = 0.0
+        self._updating_slider = False
+        self._init_ui()
+
+    def _init_ui(self):
+        """初始化UI"""
+        layout = QVBoxLayout(self)
+
+        # 记录
+        record_group = QGroupBox("记录")
+        record_layout = QGridLayout(record_group)
+
+        self._record_btn = QPushButton("开始记录")
+        self._record_btn.clicked.connect(self._on_record_clicked)
+        record_layout.addWidget(self._record_btn, 0, 0, 1, 2)
+
+        self._record_labels = {}
+        for row, (key, text) in enumerate(
+            [("file", "文件:"), ("records", "高频数据:"), ("size", "文件大小:")], 1
+        ):
+            record_layout.addWidget(QLabel(text), row, 0)
+            label = QLabel("--")
+            label.setWordWrap(True)
+            record_layout.addWidget(label, row, 1)
+            self._record_labels[key] = label
+        record_layout.setColumnStretch(1, 1)
+        layout.addWidget(record_group)
+
+        # 回放
+        replay_group = QGroupBox("回放")
+        replay_layout = QVBoxLayout(replay_group)
+
+        file_layout = QHBoxLayout()
+        self._open_btn = QPushButton("打开记录...")
+        self._open_btn.clicked.connect(self._on_open_clicked)
+        file_layout.addWidget(self._open_btn)
+        self._close_btn = QPushButton("关闭")
+        self._close_btn.clicked.connect(self.close_requested.emit)
+        file_layout.addWidget(self._close_btn)
+        replay_layout.addLayout(file_layout)
+
+        self._replay_file_label = QLabel("--")
+        self._replay_file_label.setWordWrap(True)
+        replay_layout.addWidget(self._replay_file_label)
+
+        self._slider = QSlider(Qt.Orientation.Horizontal)
+        self._slider.setTracking(False)  # 松开滑块时才跳转
+        self._slider.valueChanged.connect(self._on_slider_changed)
+        replay_layout.addWidget(self._slider)
+
+        control_layout = QHBoxLayout()
+        self._play_btn = QPushButton("播放")
+        self._play_btn.clicked.connect(self._on_play_clicked)
+        control_layout.addWidget(self._play_btn)
+
+        self._speed_combo = QComboBox()
+        self._speed_combo.addItems([f"{speed:g}x" for speed in SPEEDS])
+        self._speed_combo.setCurrentIndex(SPEEDS.index(1.0))
+        self._speed_combo.currentIndexChanged.connect(
+            lambda index: self.speed_changed.emit(SPEEDS[index])
+        )
+        control_layout.addWidget(self._speed_combo)
+
+        self._time_label = QLabel("--")
+        control_layout.addWidget(self._time_label)
+        control_layout.addStretch()
+        replay_layout.addLayout(control_layout)
+
+        layout.addWidget(replay_group)
+        layout.addStretch()
+
+        self.update_replay_opened("", 0.0)
+
+    def _on_record_clicked(self):
+        if self._recording:
+            self.stop_recording_requested.emit()
+        else:
+            self.start_recording_requested.emit()
+
+    def _on_open_clicked(self):
+        path, _ = QFileDialog.getOpenFileName(
+            self, "打开记录", self._directory, "ESP-FLY记录 (*.eflog);;所有文件 (*)"
+        )
+        if path:
+            self.open_requested.emit(path)
+
+    def _on_play_clicked(self):
+        if self._playing:
+            self.pause_requested.emit()
+        else:
+            self.play_requested.emit()
+
+    def _on_slider_changed(self, value: int):
+        """拖动或点击进度条时跳转（回放推进引起的变化不跳转）"""
+        if not self._updating_slider:
+            self.seek_requested.emit(value / 1000.0)
+
+    # ========== Data Binding Slots ==========
+
+    def set_directory(self, directory: str):
+        """设置打开记录对话框的默认目录"""
+        self._directory = directory
+
+    @pyqtSlot(bool)
+    def update_recording(self, recording: bool):
+        """更新记录状态"""
+        self._recording = recording
+        self._record_btn.setText("停止记录" if recording else "开始记录")
+
+    @pyqtSlot(dict)
+    def update_recording_stats(self, stats: dict):
+        """更新记录统计"""
+        self._record_labels["file"].setText(os.path.basename(stats["path"]))
+        self._record_labels["records"].setText(f"{stats['records']} 帧, 其他 {stats['events']} 个")
+        self._record_labels["size"].setText(
+            f"{stats['file_bytes'] / 1024:.0f} KB (压缩比 {stats['ratio']:.2f})"
+        )
+
+    @pyqtSlot(str, float)
+    def update_replay_opened(self, path: str, duration: float):
+        """打开/关闭记录文件"""
+        opened = bool(path)
+        self._duration = duration
+        self._replay_file_label.setText(os.path.basename(path) if opened else "--")
+        self._close_btn.setEnabled(opened)
+        self._play_btn.setEnabled(opened)
+        self._slider.setEnabled(opened)
+        self._updating_slider = True
+        self._slider.setRange(0, int(duration * 1000))
+        self._slider.setValue(0)
+        self._updating_slider = False
+        self._time_label.setText(f"00:00 / {_format_time(duration)}" if opened else "--")
+
+    @pyqtSlot(bool)
+    def update_playing(self, playing: bool):
+        """更新播放状态"""
+        self._playing = playing
+        self._play_btn.setText("暂停" if playing else "播放")
+
+    @pyqtSlot(float)
+    def update_position(self, seconds: float):
+        """更新回放位置（正在拖动滑块时不移动滑块）"""
+        if not self._slider.isSliderDown():
+            self._updating_slider = True
+            self._slider.setValue(int(seconds * 1000))
+            self._updating_slider = False
+        self._time_label.setText(f"{_format_time(seconds)} / {_format_time(self._duration)}")
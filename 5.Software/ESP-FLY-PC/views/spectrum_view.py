@@ -0,0 +1,155 @@
+"""
+SpectrumView - 频谱分析面板
+显示陀螺仪/D项/角速度PID输出的滚动功率谱密度，以及油门-频率谱图，用于查找桨叶和机架共振
+"""
+
+import numpy as np
+from PyQt6.QtWidgets import (
+    QWidget,
+    QVBoxLayout,
+    QHBoxLayout,
+    QLabel,
+    QComboBox,
+    QPushButton,
+)
+from PyQt6.QtCore import Qt, QRectF, pyqtSignal, pyqtSlot
+import pyqtgraph as pg
+
+# 固件陀螺仪二阶低通截止频率（sensors_mpu6050.c: GYRO_LPF_CUTOFF_FREQ）
+GYRO_LPF_CUTOFF_FREQ = 80
+
+SIGNAL_ITEMS = (
+    ("gyro", "陀螺仪 (°/s)"),
+    ("dterm", "D项 - 误差微分 (°/s²)"),
+    ("control", "角速度PID输出"),
+)
+AXIS_ITEMS = (("roll", "Roll", "red"), ("pitch", "Pitch", "green"), ("yaw", "Yaw", "blue"))
+
+DB_RANGE = 60.0  # 谱图颜色范围（最大值以下dB）
+
+
+def _to_db(psd: np.ndarray) -> np.ndarray:
+    return 10.0 * np.log10(np.maximum(psd, 1e-12))
+
+
+class SpectrumView(QWidget):
+    """
+    频谱分析面板View（纯View，无业务逻辑）
+
+    上图: 所选信号三个轴最近若干分段的平均PSD（dB）
+    下图: 所选信号和轴按油门分档的平均PSD（横轴油门%，纵轴频率）
+    """
+
+    # 用户操作信号
+    selection_changed = pyqtSignal(str, str)  # signal, axis
+    clear_requested = pyqtSignal()
+
+    def __init__(self, parent=None):
+        super().__init__(parent)
+        self._init_ui()
+
+    def _init_ui(self):
+        """初始化UI"""
+        layout = QVBoxLayout(self)
+        layout.setContentsMargins(5, 5, 5, 5)
+
+        # 信号/轴选择
+        control_layout = QHBoxLayout()
+        self._signal_combo = QComboBox()
+        self._signal_combo.addItems([text for _, text in SIGNAL_ITEMS])
+        self._signal_combo.currentIndexChanged.connect(self._on_selection_changed)
+        control_layout.addWidget(QLabel("信号:"))
+        control_layout.addWidget(self._signal_combo)
+
+        self._axis_combo = QComboBox()
+        self._axis_combo.addItems([text for _, text, _ in AXIS_ITEMS])
+        self._axis_combo.currentIndexChanged.connect(self._on_selection_changed)
+        control_layout.addWidget(QLabel("谱图轴:"))
+        control_layout.addWidget(self._axis_combo)
+
+        self._status_label = QLabel("--")
+        control_layout.addWidget(self._status_label)
+        control_layout.addStretch()
+
+        clear_btn = QPushButton("清空频谱")
+        clear_btn.clicked.connect(self.clear_requested.emit)
+        control_layout.addWidget(clear_btn)
+        layout.addLayout(control_layout)
+
+        # 功率谱密度
+        self._psd_plot = pg.PlotWidget()
+        self._psd_plot.setBackground("#1a1a1a")
+        self._psd_plot.setTitle("功率谱密度", color="w", size="12pt")
+        self._psd_plot.setLabel("bottom", "频率", units="Hz", color="w")
+        self._psd_plot.setLabel("left", "PSD", units="dB", color="w")
+        self._psd_plot.showGrid(x=True, y=True, alpha=0.3)
+        self._psd_plot.addLegend()
+        self._psd_curves = {
+            axis: self._psd_plot.plot(pen=pg.mkPen(color, width=2), name=text)
+            for axis, text, color in AXIS_ITEMS
+        }
+        self._psd_plot.addItem(
+            pg.InfiniteLine(
+                pos=GYRO_LPF_CUTOFF_FREQ,
+                angle=90,
+                pen=pg.mkPen("w", width=1, style=Qt.PenStyle.DashLine),
+                label=f"陀螺仪LPF {GYRO_LPF_CUTOFF_FREQ}Hz",
+                labelOpts={"position": 0.9, "color": "w"},
+            )
+        )
+        layout.addWidget(self._psd_plot, 1)
+
+        # 油门-频率谱图
+        self._spectrogram_plot = pg.PlotWidget()
+        self._spectrogram_plot.setBackground("#1a1a1a")
+        self._spectrogram_plot.setTitle("油门-频率谱图", color="w", size="12pt")
+        self._spectrogram_plot.setLabel("bottom", "油门", units="%", color="w")
+        self._spectrogram_plot.setLabel("left", "频率", units="Hz", color="w")
+        self._spectrogram_plot.setMouseEnabled(x=False, y=True)
+        self._image = pg.ImageItem()
+        self._image.setColorMap(pg.colormap.get("inferno"))
+        self._spectrogram_plot.addItem(self._image)
+        layout.addWidget(self._spectrogram_plot, 1)
+
+    def _on_selection_changed(self):
+        self.selection_changed.emit(
+            SIGNAL_ITEMS[self._signal_combo.currentIndex()][0],
+            AXIS_ITEMS[self._axis_combo.currentIndex()][0],
+        )
+
+    # ========== Data Binding Slots ==========
+
+    @pyqtSlot(dict)
+    def update_spectrum(self, spectrum: dict):
+        """更新功率谱密度曲线和状态"""
+        freqs = spectrum["freqs"]
+        for axis, curve in self._psd_curves.items():
+            psd = spectrum["psd"].get(axis)
+            if psd is None:
+                curve.setData([], [])
+            else:
+                # 不显示直流分量
+                curve.setData(freqs[1:], _to_db(psd[1:]))
+
+        if spectrum["fs"]:
+            self._status_label.setText(
+                f"采样率 {spectrum['fs']:.0f} Hz, 分段 {spectrum['segment_length']} 点 "
+                f"(分辨率 {spectrum['fs'] / spectrum['segment_length']:.1f} Hz), "
+                f"已分析 {spectrum['segments']} 段, 丢帧跳过 {spectrum['skipped']} 段"
+            )
+        else:
+            self._status_label.setText("等待高频数据...")
+
+    @pyqtSlot(dict)
+    def update_spectrogram(self, spectrogram: dict):
+        """更新油门-频率谱图（没有数据的油门档显示为最低颜色）"""
+        freqs, matrix = spectrogram["freqs"], spectrogram["matrix"]
+        if matrix.shape[1] < 2 or not np.isfinite(matrix).any():
+            self._image.clear()
+            return
+
+        image = _to_db(np.nan_to_num(matrix[:, 1:], nan=0.0))
+        top = float(image[np.isfinite(matrix[:, 1:])].max())
+        self._image.setImage(image, levels=(top - DB_RANGE, top))
+        # 图像第一维为油门档，第二维为频点
+        self._image.setRect(QRectF(0.0, float(freqs[1]), 100.0, float(freqs[-1] - freqs[1])))
@@ -41,6 +41,10 @@ class StatusView(QWidget):
         stats_group = self._create_stats_group()
         layout.addWidget(stats_group)
 
+        # 控制命令发送组
+        command_group = self._create_command_group()
+        layout.addWidget(command_group)
+
         layout.addStretch()
 
     def _create_connection_group(self) -> QGroupBox:
@@ -91,6 +95,23 @@ class StatusView(QWidget):
 
         return group
 
+    def _create_command_group(self) -> QGroupBox:
+        """创建控制命令发送组"""
+        group = QGroupBox("控制命令发送")
+        layout = QVBoxLayout(group)
+
+        self._command_rate_label = QLabel("发送频率: --")
+        self._command_interval_label = QLabel("间隔: --")
+        self._command_deviation_label = QLabel("偏差: --")
+        self._command_late_label = QLabel("调度延迟: --")
+
+        layout.addWidget(self._command_rate_label)
+        layout.addWidget(self._command_interval_label)
+        layout.addWidget(self._command_deviation_label)
+        layout.addWidget(self._command_late_label)
+
+        return group
+
     # ========== Data Binding Slots ==========
 
     @pyqtSlot(bool)
@@ -158,3 +179,32 @@ class StatusView(QWidget):
                 color = "#d32f2f"  # 红色 - 信号较差
 
             self._signal_label.setStyleSheet(f"color: {color};")
+
+    @pyqtSlot(dict)
+    def update_command_stats(self, stats: dict):
+        """更新控制命令发送间隔统计"""
+        if "rate_hz" not in stats:
+            self._command_rate_label.setText(f"发送频率: -- (目标周期 {stats['period_ms']:.1f}ms)")
+            self._command_interval_label.setText("间隔: --")
+            self._command_deviation_label.setText("偏差: --")
+            self._command_late_label.setText("调度延迟: --")
+            return
+
+        self._command_rate_label.setText(
+            f"发送频率: {stats['rate_hz']:.1f} Hz  已发送 {stats['sent']}  跳过周期 {stats['missed']}"
+        )
+        self._command_interval_label.setText(
+            f"间隔: {stats['interval_mean_ms']:.2f} ± {stats['jitter_ms']:.3f} ms "
+            f"({stats['interval_min_ms']:.2f} ~ {stats['interval_max_ms']:.2f})"
+        )
+        self._command_deviation_label.setText(
+            f"偏差: p99 {stats['deviation_p99_ms']:.3f} ms (目标周期 {stats['period_ms']:.1f}ms)"
+        )
+        self._command_late_label.setText(
+            f"调度延迟: 平均 {stats['late_mean_ms']:.3f} ms  最大 {stats['late_max_ms']:.3f} ms  "
+            f"自旋余量 {stats['spin_margin_ms']:.2f} ms"
+        )
+
+        # 偏差超过周期的10%时提示
+        color = "#d32f2f" if stats["deviation_p99_ms"] > 0.1 * stats["period_ms"] else ""
+        self._command_deviation_label.setStyleSheet(f"color: {color};" if color else "")
@@ -0,0 +1,143 @@
+"""
+StepResponseView - 阶跃响应面板
+显示从飞行数据估计的各轴角速度环阶跃响应，以及与上一组PID参数（基线）的对比
+"""
+
+from PyQt6.QtWidgets import (
+    QWidget,
+    QVBoxLayout,
+    QHBoxLayout,
+    QLabel,
+    QComboBox,
+    QPushButton,
+)
+from PyQt6.QtCore import Qt, pyqtSignal, pyqtSlot
+import pyqtgraph as pg
+
+AXIS_ITEMS = (("roll", "Roll"), ("pitch", "Pitch"), ("yaw", "Yaw"))
+
+
+def _format_gains(gains, axis: str) -> str:
+    if not gains or axis not in gains:
+        return ""
+    kp, ki, kd = gains[axis]
+    return f" (P{kp:.2f} I{ki:.2f} D{kd:.2f})"
+
+
+def _format_metrics(result: dict) -> str:
+    if result is None or result.get("response") is None:
+        return "无有效窗口（需要有操纵的飞行数据）"
+
+    def fmt(key: str, unit: str) -> str:
+        value = result.get(key)
+        return "--" if value is None else f"{value:.0f}{unit}"
+
+    return (
+        f"延迟 {fmt('delay_ms', 'ms')}  上升 {fmt('rise_ms', 'ms')}  "
+        f"超调 {fmt('overshoot_pct', '%')}  调节 {fmt('settling_ms', 'ms')}  "
+        f"稳态 {result['steady']:.2f}  窗口 {result['used']}/{result['windows']}"
+    )
+
+
+class StepResponseView(QWidget):
+    """
+    阶跃响应面板View（纯View，无业务逻辑）
+
+    用户操作通过信号发送给StepResponseViewModel
+    """
+
+    # 用户操作信号
+    set_baseline_requested = pyqtSignal()
+    clear_requested = pyqtSignal()
+
+    def __init__(self, parent=None):
+        super().__init__(parent)
+        self._result = None
+        self._init_ui()
+
+    def _init_ui(self):
+        """初始化UI"""
+        layout = QVBoxLayout(self)
+
+        control_layout = QHBoxLayout()
+        self._axis_combo = QComboBox()
+        self._axis_combo.addItems([text for _, text in AXIS_ITEMS])
+        self._axis_combo.currentIndexChanged.connect(lambda _: self._update_plot())
+        control_layout.addWidget(QLabel("轴:"))
+        control_layout.addWidget(self._axis_combo)
+        control_layout.addStretch()
+
+        baseline_btn = QPushButton("设为基线")
+        baseline_btn.clicked.connect(self.set_baseline_requested.emit)
+        control_layout.addWidget(baseline_btn)
+
+        clear_btn = QPushButton("清空")
+        clear_btn.clicked.connect(self.clear_requested.emit)
+        control_layout.addWidget(clear_btn)
+        layout.addLayout(control_layout)
+
+        self._status_label = QLabel("--")
+        layout.addWidget(self._status_label)
+
+        # 阶跃响应曲线: 当前参数实线, 基线虚线
+        self._plot = pg.PlotWidget()
+        self._plot.addLegend()
+        self._plot.showGrid(x=True, y=True)
+        self._plot.setMinimumHeight(180)
+        self._plot.setLabel("bottom", "时间", units="s")
+        self._plot.setLabel("left", "响应")
+        self._plot.addItem(pg.InfiniteLine(pos=1.0, angle=0, pen=pg.mkPen("#888888", width=1)))
+        self._current_curve = self._plot.plot(pen=pg.mkPen("#2196f3", width=2), name="当前")
+        self._baseline_curve = self._plot.plot(
+            pen=pg.mkPen("#ff9800", width=2, style=Qt.PenStyle.DashLine), name="基线"
+        )
+        layout.addWidget(self._plot)
+
+        # 各轴指标
+        self._metrics_label = QLabel("")
+        self._metrics_label.setWordWrap(True)
+        layout.addWidget(self._metrics_label)
+
+        hint = QLabel("飞行中做快速的横滚/俯仰/偏航打杆，每秒自动重新估计；发送PID参数后上一组参数的结果自动转为基线。")
+        hint.setWordWrap(True)
+        layout.addWidget(hint)
+
+    def _update_plot(self):
+        axis = AXIS_ITEMS[self._axis_combo.currentIndex()][0]
+        for key, curve in (("current", self._current_curve), ("baseline", self._baseline_curve)):
+            analysis = self._result.get(key) if self._result else None
+            estimate = analysis["axes"].get(axis) if analysis else None
+            if estimate is None or estimate["response"] is None:
+                curve.setData([], [])
+            else:
+                curve.setData(estimate["t"], estimate["response"])
+
+    # ========== Data Binding Slots ==========
+
+    @pyqtSlot(dict)
+    def update_result(self, result: dict):
+        """更新阶跃响应曲线和指标"""
+        self._result = result
+        self._update_plot()
+
+        current, baseline = result["current"], result["baseline"]
+        if current is None or current["sample_rate_hz"] is None:
+            self._status_label.setText("等待飞行数据...")
+        else:
+            self._status_label.setText(
+                f"数据 {current['duration_s']:.0f} s, 采样率 {current['sample_rate_hz']:.0f} Hz"
+            )
+
+        lines = []
+        for axis, text in AXIS_ITEMS:
+            if current is not None and axis in current["axes"]:
+                lines.append(
+                    f"{text} 当前{_format_gains(result['current_gains'], axis)}: "
+                    f"{_format_metrics(current['axes'][axis])}"
+                )
+            if baseline is not None and axis in baseline["axes"]:
+                lines.append(
+                    f"{text} 基线{_format_gains(result['baseline_gains'], axis)}: "
+                    f"{_format_metrics(baseline['axes'][axis])}"
+                )
+        self._metrics_label.setText("\n".join(lines))
@@ -0,0 +1,212 @@
+"""
+SysidView - 系统辨识面板
+设置阶跃/扫频激励，显示频率响应或时域响应以及角速度环增益建议
+"""
+
+from PyQt6.QtWidgets import (
+    QWidget,
+    QVBoxLayout,
+    QHBoxLayout,
+    QGridLayout,
+    QGroupBox,
+    QLabel,
+    QComboBox,
+    QDoubleSpinBox,
+    QSpinBox,
+    QPushButton,
+    QMessageBox,
+)
+from PyQt6.QtCore import pyqtSignal, pyqtSlot
+import pyqtgraph as pg
+
+
+class SysidView(QWidget):
+    """
+    系统辨识面板View（纯View，无业务逻辑）
+
+    用户操作通过信号发送给SysidViewModel
+    """
+
+    # 用户操作信号
+    start_requested = pyqtSignal(int, int, float, float, float, int)  # axis, signal, amplitude, f_start, f_end, duration_ms
+    abort_requested = pyqtSignal()
+    apply_requested = pyqtSignal()
+
+    def __init__(self, parent=None):
+        super().__init__(parent)
+        self._init_ui()
+
+    def _init_ui(self):
+        """初始化UI"""
+        layout = QVBoxLayout(self)
+
+        # 激励参数
+        group = QGroupBox("激励参数")
+        grid = QGridLayout(group)
+
+        self._axis_combo = QComboBox()
+        self._axis_combo.addItems(["Roll", "Pitch", "Yaw"])
+        grid.addWidget(QLabel("轴:"), 0, 0)
+        grid.addWidget(self._axis_combo, 0, 1)
+
+        self._signal_combo = QComboBox()
+        self._signal_combo.addItems(["阶跃", "扫频"])
+        self._signal_combo.setCurrentIndex(1)
+        self._signal_combo.currentIndexChanged.connect(self._on_signal_changed)
+        grid.addWidget(QLabel("信号:"), 0, 2)
+        grid.addWidget(self._signal_combo, 0, 3)
+
+        self._amplitude_spin = QDoubleSpinBox()
+        self._amplitude_spin.setRange(10.0, 400.0)
+        self._amplitude_spin.setValue(60.0)
+        self._amplitude_spin.setSuffix(" °/s")
+        grid.addWidget(QLabel("幅值:"), 1, 0)
+        grid.addWidget(self._amplitude_spin, 1, 1)
+
+        self._duration_spin = QSpinBox()
+        self._duration_spin.setRange(200, 4000)
+        self._duration_spin.setSingleStep(500)
+        self._duration_spin.setValue(4000)
+        self._duration_spin.setSuffix(" ms")
+        grid.addWidget(QLabel("时长:"), 1, 2)
+        grid.addWidget(self._duration_spin, 1, 3)
+
+        self._f_start_spin = QDoubleSpinBox()
+        self._f_start_spin.setRange(0.5, 50.0)
+        self._f_start_spin.setValue(2.0)
+        self._f_start_spin.setSuffix(" Hz")
+        grid.addWidget(QLabel("起始频率:"), 2, 0)
+        grid.addWidget(self._f_start_spin, 2, 1)
+
+        self._f_end_spin = QDoubleSpinBox()
+        self._f_end_spin.setRange(5.0, 200.0)
+        self._f_end_spin.setValue(80.0)
+        self._f_end_spin.setSuffix(" Hz")
+        grid.addWidget(QLabel("终止频率:"), 2, 2)
+        grid.addWidget(self._f_end_spin, 2, 3)
+
+        layout.addWidget(group)
+
+        # 控制按钮
+        button_layout = QHBoxLayout()
+        self._start_btn = QPushButton("开始辨识")
+        self._start_btn.clicked.connect(self._on_start_clicked)
+        button_layout.addWidget(self._start_btn)
+
+        self._abort_btn = QPushButton("中止")
+        self._abort_btn.setEnabled(False)
+        self._abort_btn.clicked.connect(self.abort_requested.emit)
+        button_layout.addWidget(self._abort_btn)
+        layout.addLayout(button_layout)
+
+        self._status_label = QLabel("--")
+        layout.addWidget(self._status_label)
+
+        # 响应曲线: 扫频显示幅频特性, 阶跃显示时域响应
+        self._plot = pg.PlotWidget()
+        self._plot.addLegend()
+        self._plot.showGrid(x=True, y=True)
+        self._plot.setMinimumHeight(180)
+        layout.addWidget(self._plot)
+
+        # 结果
+        self._result_label = QLabel("")
+        self._result_label.setWordWrap(True)
+        layout.addWidget(self._result_label)
+
+        self._apply_btn = QPushButton("应用建议")
+        self._apply_btn.setEnabled(False)
+        self._apply_btn.clicked.connect(self.apply_requested.emit)
+        layout.addWidget(self._apply_btn)
+
+    def _on_signal_changed(self, index: int):
+        chirp = index == 1
+        self._f_start_spin.setEnabled(chirp)
+        self._f_end_spin.setEnabled(chirp)
+
+    def _on_start_clicked(self):
+        """开始按钮点击（需要确认）"""
+        reply = QMessageBox.question(
+            self,
+            "系统辨识",
+            "辨识时飞控会在期望角速度上叠加激励, 须先给油门。\n"
+            "请确认飞机已固定在只允许被测轴转动的测试台上。\n\n"
+            "是否开始?",
+            QMessageBox.StandardButton.Yes | QMessageBox.StandardButton.No,
+            QMessageBox.StandardButton.No,
+        )
+        if reply != QMessageBox.StandardButton.Yes:
+            return
+
+        self._result_label.setText("")
+        self._apply_btn.setEnabled(False)
+        self.start_requested.emit(
+            self._axis_combo.currentIndex(),
+            self._signal_combo.currentIndex(),
+            self._amplitude_spin.value(),
+            self._f_start_spin.value(),
+            self._f_end_spin.value(),
+            self._duration_spin.value(),
+        )
+
+    # ========== Data Binding Slots ==========
+
+    @pyqtSlot(str)
+    def update_status(self, text: str):
+        """更新状态文字"""
+        self._status_label.setText(text)
+
+    @pyqtSlot(bool)
+    def update_running(self, running: bool):
+        """激励进行中时禁用开始按钮"""
+        self._start_btn.setEnabled(not running)
+        self._abort_btn.setEnabled(running)
+
+    @pyqtSlot(dict)
+    def update_frequency_response(self, data: dict):
+        """显示幅频特性（dB）"""
+        self._plot.clear()
+        self._plot.setLogMode(x=True, y=False)
+        self._plot.setLabel("bottom", "频率", units="Hz")
+        self._plot.setLabel("left", "幅值", units="dB")
+        self._plot.plot(data["freq"], data["closed_db"], pen=pg.mkPen("#2196f3", width=2), name="闭环")
+        self._plot.plot(data["freq"], data["plant_db"], pen=pg.mkPen("#ff9800", width=2), name="对象")
+
+    @pyqtSlot(dict)
+    def update_time_response(self, data: dict):
+        """显示时域响应（阶跃时替换频率响应曲线）"""
+        if self._signal_combo.currentIndex() == 1:
+            return
+
+        self._plot.clear()
+        self._plot.setLogMode(x=False, y=False)
+        self._plot.setLabel("bottom", "时间", units="s")
+        self._plot.setLabel("left", "角速度", units="°/s")
+        self._plot.plot(data["t"], data["rate"], pen=pg.mkPen("#2196f3", width=2), name="期望")
+        self._plot.plot(data["t"], data["gyro"], pen=pg.mkPen("#ff9800", width=2), name="陀螺仪")
+
+    @pyqtSlot(dict)
+    def update_result(self, result: dict):
+        """显示分析结果与增益建议"""
+        lines = []
+
+        def fmt(key: str, text: str, unit: str, digits: int = 1):
+            value = result.get(key)
+            if value is not None:
+                lines.append(f"{text}: {value:.{digits}f}{unit}")
+
+        fmt("bandwidth_hz", "闭环带宽", " Hz")
+        fmt("delay_ms", "等效延迟", " ms")
+        fmt("plant_k", "对象增益K", " °/s²/单位", 3)
+        fmt("rise_ms", "上升时间", " ms")
+        fmt("overshoot_pct", "超调", " %")
+        if "suggested_kp" in result:
+            lines.append(
+                f"建议 {result['axis']} 角速度环: Kp={result['suggested_kp']:.2f}, "
+                f"Ki={result['suggested_ki']:.2f} (穿越频率 {result['suggested_crossover_hz']:.1f} Hz)"
+            )
+        if result.get("missing_samples"):
+            lines.append(f"丢失样本: {result['missing_samples']}")
+
+        self._result_label.setText("\n".join(lines) if lines else "无有效结果")
+        self._apply_btn.setEnabled("suggested_kp" in result)
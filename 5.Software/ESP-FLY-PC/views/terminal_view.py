@@ -5,7 +5,7 @@ TerminalView - 终端监控面板
 
 import time
 from collections import deque
-from PyQt6.QtWidgets import QWidget, QVBoxLayout, QTextEdit, QPushButton, QHBoxLayout
+from PyQt6.QtWidgets import QWidget, QVBoxLayout, QTextEdit, QPushButton, QHBoxLayout, QMessageBox
 from PyQt6.QtCore import Qt, QTimer, pyqtSignal, pyqtSlot
 from PyQt6.QtGui import QTextCursor, QFont
 
@@ -22,6 +22,8 @@ class TerminalView(QWidget):
     
     # 用户操作信号
     clear_requested = pyqtSignal()
+    bench_requested = pyqtSignal()
+    motor_char_requested = pyqtSignal(int)  # MotorCharAction: 0=查询 1=标定 2=复位 3=中止
     
     def __init__(self, max_lines: int = 100, parent=None):
         super().__init__(parent)
@@ -68,6 +70,26 @@ class TerminalView(QWidget):
         clear_btn = QPushButton("清空终端")
         clear_btn.clicked.connect(self._on_clear_clicked)
         button_layout.addWidget(clear_btn)
+
+        bench_btn = QPushButton("内核测试")
+        bench_btn.setToolTip("请求飞控测量关键内核的CPU周期 (电机停转时执行)")
+        bench_btn.clicked.connect(self.bench_requested.emit)
+        button_layout.addWidget(bench_btn)
+
+        char_btn = QPushButton("电机标定")
+        char_btn.setToolTip("逐级驱动四个电机测量带载电压, 生成推力曲线并保存 (须固定在测试台上)")
+        char_btn.clicked.connect(self._on_motor_char_clicked)
+        button_layout.addWidget(char_btn)
+
+        char_abort_btn = QPushButton("中止标定")
+        char_abort_btn.setToolTip("立即停止正在进行的电机标定 (关闭电机测试同样会中止)")
+        char_abort_btn.clicked.connect(lambda: self.motor_char_requested.emit(3))
+        button_layout.addWidget(char_abort_btn)
+
+        curve_btn = QPushButton("推力曲线")
+        curve_btn.setToolTip("查询飞控当前使用的推力曲线")
+        curve_btn.clicked.connect(lambda: self.motor_char_requested.emit(0))
+        button_layout.addWidget(curve_btn)
         
         button_layout.addStretch()
         
@@ -99,6 +121,20 @@ class TerminalView(QWidget):
         """清空按钮点击"""
         self.clear_terminal()
         self.clear_requested.emit()
+
+    def _on_motor_char_clicked(self):
+        """电机标定按钮点击, 电机会逐级转到满油门, 需先确认"""
+        reply = QMessageBox.question(
+            self,
+            "电机标定",
+            "标定时四个电机将逐级转到满油门, 约需10秒。\n"
+            "请确认飞机已固定在测试台上、桨叶周围无障碍物。\n\n"
+            "是否开始?",
+            QMessageBox.StandardButton.Yes | QMessageBox.StandardButton.No,
+            QMessageBox.StandardButton.No,
+        )
+        if reply == QMessageBox.StandardButton.Yes:
+            self.motor_char_requested.emit(1)
     
     def _refresh_display(self):
         """刷新显示（定时调用）"""
@@ -4,7 +4,6 @@ WaveformView - 波形显示面板
 """
 
 import time
-from collections import deque
 from functools import partial
 from PyQt6.QtWidgets import QWidget, QVBoxLayout, QTabWidget, QPushButton, QHBoxLayout
 from PyQt6.QtCore import QTimer, pyqtSignal, pyqtSlot
@@ -12,6 +11,8 @@ import pyqtgraph as pg
 import numpy as np
 import logging
 
+from services.ring_buffer import EnvelopeRingBuffer
+
 # ========== 性能日志配置（已禁用） ==========
 # 如需启用日志，取消下面的注释
 # logging.basicConfig(
@@ -29,6 +30,12 @@ logger = logging.getLogger(__name__)
 logger.addHandler(logging.NullHandler())
 logger.setLevel(logging.CRITICAL + 1)  # 禁用所有级别的日志
 
+# 每个页签的缓冲区样本数（50Hz下约10分钟，1kHz下约30秒）
+BUFFER_CAPACITY = 30000
+
+# 每个像素最多绘制的点数（包络每个块输出最小/最大两个点）
+POINTS_PER_PIXEL = 2
+
 
 class WaveformView(QWidget):
     """
@@ -66,6 +73,7 @@ class WaveformView(QWidget):
         self._last_raw_timestamp = None
         self._timestamp_offset = 0.0
         self._base_timestamp = None  # 基准时间戳，用于实现从0开始显示
+        self._time_origin = 0.0  # 第一帧显示的时间（秒），回放跳转时为记录中的时间
         
         # X轴同步缩放控制
         self._sync_lock = False  # 同步锁，防止递归触发
@@ -74,6 +82,10 @@ class WaveformView(QWidget):
         # 曲线字典
         self._curves = {}
         
+        # 每个页签一个列式环形缓冲区（第0列为时间），以及是否有未显示的新数据
+        self._buffers = {}
+        self._dirty = {}
+        
         self._init_ui()
         
         # 启动定时刷新（性能优化：降低刷新频率）
@@ -174,6 +186,16 @@ class WaveformView(QWidget):
         self._tab_groups["加速度计"] = tab6_plots
         self._setup_x_axis_sync(tab6_plots)
         
+        # 每个页签的曲线同时采样，共用一个缓冲区
+        for group, keys in self._tab_groups.items():
+            self._buffers[group] = EnvelopeRingBuffer(BUFFER_CAPACITY, ["t"] + keys)
+            self._dirty[group] = False
+            for key in keys:
+                self._curves[key]["group"] = group
+        
+        # 只刷新当前页签，切换页签时立即补刷新
+        self._tab_widget.currentChanged.connect(self._on_tab_changed)
+        
         layout.addWidget(self._tab_widget)
         
         # 控制按钮
@@ -210,7 +232,7 @@ class WaveformView(QWidget):
             layout: 要添加到的布局
         
         Returns:
-            dict: {'widget': PlotWidget, 'curve': PlotDataItem, 'buffer': deque}
+            dict: {'widget': PlotWidget, 'curve': PlotDataItem}
         """
         # 创建PlotWidget
         plot_widget = pg.PlotWidget()
@@ -230,16 +252,13 @@ class WaveformView(QWidget):
         # 禁用Y轴鼠标缩放/拖动，确保Y轴始终处于自动缩放状态
         plot_widget.setMouseEnabled(x=True, y=False)
         
-        # 创建曲线
-        curve = plot_widget.plot(pen=pg.mkPen(color, width=2))
-        
-        # 数据缓冲区（30000个点，50Hz下约10分钟）
-        data_buffer = deque(maxlen=30000)
+        # 创建曲线（update_single_curve写入的其他列为NaN，按有限值连线）
+        curve = plot_widget.plot(pen=pg.mkPen(color, width=2), connect="finite")
         
         # 添加到布局
         layout.addWidget(plot_widget)
         
-        return {"widget": plot_widget, "curve": curve, "buffer": data_buffer}
+        return {"widget": plot_widget, "curve": curve}
     
     def _setup_x_axis_sync(self, tab_plots: list):
         """
@@ -265,6 +284,11 @@ class WaveformView(QWidget):
             source_key: 触发变化的图表key
             tab_plots: 同一页签的图表key列表
         """
+        # 缩放/平移后按新范围重新取包络（下一次定时刷新时）
+        group = self._curves[source_key].get("group")
+        if group is not None:
+            self._dirty[group] = True
+        
         # 使用同步锁避免递归触发
         if self._sync_lock:
             return
@@ -311,46 +335,65 @@ class WaveformView(QWidget):
         
         # 如果是首次接收数据，记录基准时间戳
         if self._base_timestamp is None:
-            self._base_timestamp = absolute_timestamp
+            self._base_timestamp = absolute_timestamp - self._time_origin
         
         # 返回相对时间，从0开始
         return absolute_timestamp - self._base_timestamp
     
+    def _process_timestamps(self, raw_ts: np.ndarray) -> np.ndarray:
+        """
+        批量处理uint16时间戳溢出（与_process_timestamp逐个处理的结果相同）
+        
+        Args:
+            raw_ts: 原始时间戳数组（uint16，单位ms）
+        
+        Returns:
+            np.ndarray: 连续相对时间（秒，从0开始）
+        """
+        raw = raw_ts.astype(np.float64)
+        previous = raw[0] if self._last_raw_timestamp is None else self._last_raw_timestamp
+        
+        # 相邻时间戳跳变超过半个量程视为溢出，累加偏移
+        steps = np.diff(raw, prepend=previous)
+        wraps = np.where(steps < -32768, 65536.0, 0.0) - np.where(steps > 32768, 65536.0, 0.0)
+        absolute = (raw + self._timestamp_offset + np.cumsum(wraps)) / 1000.0
+        
+        self._timestamp_offset += wraps.sum()
+        self._last_raw_timestamp = int(raw[-1])
+        
+        # 如果是首次接收数据，记录基准时间戳
+        if self._base_timestamp is None:
+            self._base_timestamp = absolute[0] - self._time_origin
+        
+        # 返回相对时间，从0开始
+        return absolute - self._base_timestamp
+    
+    def _on_tab_changed(self, index: int):
+        """切换页签后立即刷新新页签"""
+        group = self._tab_widget.tabText(index)
+        if group in self._dirty:
+            self._dirty[group] = True
+            self._refresh_all_curves()
+    
     def _on_clear_clicked(self):
         """清空按钮点击"""
         self.clear_all_waveforms()
         self.clear_requested.emit()
     
     def _refresh_all_curves(self):
-        """刷新所有曲线显示（20fps，性能优化）"""
+        """刷新当前页签的曲线（20fps，按可见范围和像素宽度取最小/最大包络）"""
         start_time = time.perf_counter()
         
         curves_updated = 0
         total_points = 0
-        sampled_curves = 0
         
-        for curve_name, curve_data in self._curves.items():
-            buffer = curve_data["buffer"]
-            if len(buffer) > 0:
-                buffer_len = len(buffer)
-                total_points += buffer_len
-                
-                # ========== 性能优化：数据降采样 ==========
-                # 如果数据点过多，进行降采样以提升性能
-                if buffer_len > 2000:  # 降低阈值（从5000改为2000），更早触发降采样
-                    # 每隔2个点取1个（降采样50%）
-                    buffer_list = list(buffer)
-                    sampled_data = buffer_list[::2]
-                    times, values = zip(*sampled_data)
-                    sampled_curves += 1
-                else:
-                    times, values = zip(*buffer)
-                
-                # 使用numpy数组提高大数据量下的性能
-                times_array = np.array(times, dtype=np.float64)
-                values_array = np.array(values, dtype=np.float64)
-                curve_data["curve"].setData(times_array, values_array)
-                curves_updated += 1
+        group = self._tab_widget.tabText(self._tab_widget.currentIndex())
+        buffer = self._buffers.get(group)
+        if buffer is not None and self._dirty[group] and len(buffer) > 0:
+            latest_x = buffer.last("t")
+            
+            for curve_name in self._tab_groups[group]:
+                curve_data = self._curves[curve_name]
                 
                 # 确保X轴跟随最新数据（实现自动推移）
                 plot_widget = curve_data["widget"]
@@ -361,13 +404,25 @@ class WaveformView(QWidget):
                 
                 # 获取当前视图范围
                 x_range = vb.viewRange()[0]
-                latest_x = times[-1]
                 
                 # 如果最新点到达或超过了当前视图的右边界，自动推移范围
                 if latest_x >= x_range[1]:
                     width = x_range[1] - x_range[0]
                     if width > 0:
                         vb.setXRange(latest_x - width, latest_x, padding=0)
+                        x_range = [latest_x - width, latest_x]
+                
+                # X轴自动缩放时需要全部数据，否则只取可见范围
+                if vb.autoRangeEnabled()[0]:
+                    x_range = [-np.inf, np.inf]
+                max_points = max(int(vb.width()), 100) * POINTS_PER_PIXEL
+                times, values = buffer.envelope(curve_name, x_range[0], x_range[1], max_points)
+                curve_data["curve"].setData(times, values)
+                curves_updated += 1
+                total_points += len(times)
+            
+            # 放在自动推移之后，推移本身引起的范围变化不触发重绘
+            self._dirty[group] = False
         
         # 性能统计
         elapsed = (time.perf_counter() - start_time) * 1000  # 转换为毫秒
@@ -383,8 +438,7 @@ class WaveformView(QWidget):
                 f"[波形刷新] 次数:{self._refresh_count} | "
                 f"本次:{elapsed:.2f}ms | 平均:{avg_time:.2f}ms | "
                 f"最大:{self._max_refresh_time:.2f}ms | "
-                f"曲线数:{curves_updated} | 总点数:{total_points} | "
-                f"降采样:{sampled_curves}条"
+                f"曲线数:{curves_updated} | 总点数:{total_points}"
             )
         
         # 警告：如果刷新耗时超过阈值
@@ -419,13 +473,19 @@ class WaveformView(QWidget):
         raw_ts = high_freq_data.get("timestamp")
         timestamp = self._process_timestamp(raw_ts)
         
-        # 更新每条曲线的缓冲区
+        # 每个页签追加一行（缺失的字段记为NaN）
         updated_curves = 0
-        for key in self._curves.keys():
-            if key in high_freq_data:
-                value = high_freq_data[key]
-                self._curves[key]["buffer"].append((timestamp, value))
-                updated_curves += 1
+        for group, keys in self._tab_groups.items():
+            row = [timestamp]
+            for key in keys:
+                value = high_freq_data.get(key)
+                if value is None:
+                    row.append(np.nan)
+                else:
+                    row.append(value)
+                    updated_curves += 1
+            self._buffers[group].append(row)
+            self._dirty[group] = True
         
         # 每500次数据更新打印一次日志
         if hasattr(self, '_data_update_count'):
@@ -436,15 +496,41 @@ class WaveformView(QWidget):
         if self._data_update_count % 500 == 0:
             logger.info(f"[数据更新] 已接收 {self._data_update_count} 次数据包，更新了 {updated_curves} 条曲线")
     
+    @pyqtSlot(object)
+    def update_waveform_block(self, block: np.ndarray):
+        """
+        批量更新波形数据（接收线程批量解码后每批一次）
+        
+        Args:
+            block: 结构化数组，字段名与曲线名相同，另含timestamp（uint16，ms）
+        """
+        if len(block) == 0:
+            return
+        
+        timestamps = self._process_timestamps(block["timestamp"])
+        
+        # 每个页签整块追加
+        for group, keys in self._tab_groups.items():
+            rows = np.empty((len(block), len(keys) + 1), dtype=np.float64)
+            rows[:, 0] = timestamps
+            for i, key in enumerate(keys, 1):
+                rows[:, i] = block[key]
+            self._buffers[group].extend(rows)
+            self._dirty[group] = True
+    
     @pyqtSlot()
     def clear_all_waveforms(self):
         """清空所有波形数据，重置时间戳"""
         self._last_raw_timestamp = None
         self._timestamp_offset = 0.0
         self._base_timestamp = None
+        self._time_origin = 0.0
+        
+        for group, buffer in self._buffers.items():
+            buffer.clear()
+            self._dirty[group] = False
         
         for curve_data in self._curves.values():
-            curve_data["buffer"].clear()
             curve_data["curve"].setData([], [])
             
             # 重置视图范围
@@ -455,6 +541,17 @@ class WaveformView(QWidget):
             vb.setXRange(0, 10, padding=0)
             vb.autoRange()
     
+    @pyqtSlot(float)
+    def reset_waveforms(self, start_time: float):
+        """
+        清空波形，之后第一帧显示在start_time处（回放跳转时按记录时间显示）
+        
+        Args:
+            start_time: 时间（秒）
+        """
+        self.clear_all_waveforms()
+        self._time_origin = start_time
+    
     @pyqtSlot(str, float, float)
     def update_single_curve(self, curve_name: str, timestamp: float, value: float):
         """
@@ -466,4 +563,10 @@ class WaveformView(QWidget):
             value: 数值
         """
         if curve_name in self._curves:
-            self._curves[curve_name]["buffer"].append((timestamp, value))
+            group = self._curves[curve_name]["group"]
+            buffer = self._buffers[group]
+            row = np.full(len(buffer.columns), np.nan)
+            row[0] = timestamp
+            row[buffer.index(curve_name)] = value
+            buffer.append(row)
+            self._dirty[group] = True